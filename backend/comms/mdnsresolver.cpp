@@ -0,0 +1,417 @@
+#include "mdnsresolver.h"
+#include "../core/constants.h"
+#include "../core/logger.h"
+#include <QNetworkDatagram>
+#include <QNetworkInterface>
+#include <QMutexLocker>
+#include <QSet>
+#include <QtEndian>
+
+// mDNS constants (RFC 6762)
+static const quint16 MDNS_PORT = 5353;
+static const char *MDNS_GROUP_IPV4 = "224.0.0.251";
+static const quint16 TYPE_A = 1;
+static const quint16 TYPE_AAAA = 28;
+static const quint16 CLASS_IN = 1;
+static const quint16 CLASS_MASK = 0x7FFF;      // Top bit is cache-flush / unicast-response
+static const quint16 UNICAST_RESPONSE = 0x8000;
+static const quint16 CACHE_FLUSH = 0x8000;
+static const qint64 CACHE_FLUSH_DELAY_MS = 1000;
+static const int RETRY_INTERVAL_MS = 250;
+static const int MAX_NAME_JUMPS = 16;
+static const int CACHE_PRUNE_THRESHOLD = 256;  // Names, on a busy field network
+
+MdnsResolver::MdnsResolver(QObject *parent)
+    : QObject(parent)
+    , m_socket(new QUdpSocket(this))
+    , m_retryTimer(new QTimer(this))
+    , m_listening(false)
+{
+    m_retryTimer->setInterval(RETRY_INTERVAL_MS);
+    connect(m_retryTimer, &QTimer::timeout, this, &MdnsResolver::onRetryTimer);
+    connect(m_socket, &QUdpSocket::readyRead, this, &MdnsResolver::readDatagrams);
+
+    openSocket();
+}
+
+MdnsResolver::~MdnsResolver()
+{
+    m_retryTimer->stop();
+}
+
+void MdnsResolver::openSocket()
+{
+    // Share 5353 with any system responder so we still see announcements
+    m_listening = m_socket->bind(QHostAddress::AnyIPv4, MDNS_PORT,
+                                 QUdpSocket::ShareAddress | QUdpSocket::ReuseAddressHint);
+
+    if (!m_listening) {
+        m_socket->bind(QHostAddress::AnyIPv4, 0);
+        YADS_LOG_WARNING(Constants::LogCategories::NETWORK,
+                         "UDP 5353 unavailable, falling back to legacy unicast queries");
+        return;
+    }
+
+    m_socket->setSocketOption(QAbstractSocket::MulticastTtlOption, 255);
+    m_socket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, 1);
+
+    const QHostAddress group(MDNS_GROUP_IPV4);
+    int joined = 0;
+    const QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+    for (const QNetworkInterface &iface : interfaces) {
+        const auto flags = iface.flags();
+        if ((flags & QNetworkInterface::IsUp) && (flags & QNetworkInterface::CanMulticast)
+            && m_socket->joinMulticastGroup(group, iface)) {
+            joined++;
+        }
+    }
+
+    YADS_LOG_INFO(Constants::LogCategories::NETWORK,
+                  QString("Listening for mDNS on %1 interfaces").arg(joined));
+}
+
+QString MdnsResolver::normalize(const QString &hostName)
+{
+    QString name = hostName.toLower();
+    if (name.endsWith('.')) {
+        name.chop(1);
+    }
+    return name;
+}
+
+QList<QHostAddress> MdnsResolver::cachedAddresses(const QString &hostName) const
+{
+    QList<QHostAddress> addresses;
+
+    QMutexLocker locker(&m_cacheMutex);
+    auto it = m_cache.constFind(normalize(hostName));
+    if (it == m_cache.constEnd()) {
+        return addresses;
+    }
+
+    for (const CacheEntry &entry : it.value()) {
+        if (!entry.expiry.hasExpired()) {
+            addresses.append(entry.address);
+        }
+    }
+    return addresses;
+}
+
+int MdnsResolver::cacheSize() const
+{
+    QMutexLocker locker(&m_cacheMutex);
+    return m_cache.size();
+}
+
+bool MdnsResolver::resolve(const QString &hostName, int timeoutMs)
+{
+    const QString name = normalize(hostName);
+
+    bool refresh = false;
+    QList<QHostAddress> addresses;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+        auto it = m_cache.find(name);
+        if (it != m_cache.end()) {
+            for (CacheEntry &entry : it.value()) {
+                if (entry.expiry.hasExpired()) {
+                    continue;
+                }
+                addresses.append(entry.address);
+                // RFC 6762 5.2: refresh once 80% of the TTL has passed; the answer
+                // replaces the entry, so each record lifetime asks only once
+                if (!entry.refreshSent && entry.expiry.remainingTime() < qint64(entry.ttl) * 200) {
+                    entry.refreshSent = true;
+                    refresh = true;
+                }
+            }
+        }
+    }
+
+    if (!addresses.isEmpty()) {
+        if (refresh) {
+            sendQuery(name);
+        }
+        return true;
+    }
+
+    if (!m_pending.contains(name)) {
+        PendingQuery query;
+        query.deadline = QDeadlineTimer(timeoutMs);
+        query.nextAttempt = QDeadlineTimer(RETRY_INTERVAL_MS);
+        query.attempts = 1;
+        m_pending.insert(name, query);
+        sendQuery(name);
+    }
+
+    if (!m_retryTimer->isActive()) {
+        m_retryTimer->start();
+    }
+    return false;
+}
+
+void MdnsResolver::sendQuery(const QString &hostName)
+{
+    // Legacy unicast queries get a direct reply to our ephemeral port
+    const QByteArray query = buildQuery(hostName, !m_listening);
+    const QHostAddress group(MDNS_GROUP_IPV4);
+
+    if (!m_listening) {
+        m_socket->writeDatagram(query, group, MDNS_PORT);
+        return;
+    }
+
+    // Ask on every interface; the robot may be on USB, Ethernet or the radio
+    const QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+    for (const QNetworkInterface &iface : interfaces) {
+        const auto flags = iface.flags();
+        if (!(flags & QNetworkInterface::IsUp) || !(flags & QNetworkInterface::CanMulticast)) {
+            continue;
+        }
+        m_socket->setMulticastInterface(iface);
+        m_socket->writeDatagram(query, group, MDNS_PORT);
+    }
+}
+
+void MdnsResolver::onRetryTimer()
+{
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        const QString name = it.key();
+
+        if (!cachedAddresses(name).isEmpty()) {
+            it = m_pending.erase(it);
+            continue;
+        }
+
+        if (it->deadline.hasExpired()) {
+            YADS_LOG_DEBUG(Constants::LogCategories::NETWORK,
+                           QString("No mDNS answer for %1").arg(name));
+            it = m_pending.erase(it);
+            emit resolveFailed(name);
+            continue;
+        }
+
+        // Back off 250 ms, 500 ms, 1 s, ...
+        if (it->nextAttempt.hasExpired()) {
+            it->attempts++;
+            it->nextAttempt = QDeadlineTimer(RETRY_INTERVAL_MS << qMin(it->attempts - 1, 4));
+            sendQuery(name);
+        }
+        ++it;
+    }
+
+    if (m_pending.isEmpty()) {
+        m_retryTimer->stop();
+    }
+}
+
+void MdnsResolver::readDatagrams()
+{
+    while (m_socket->hasPendingDatagrams()) {
+        QNetworkDatagram datagram = m_socket->receiveDatagram();
+
+        QList<Record> records;
+        if (parseMessage(datagram.data(), records) && !records.isEmpty()) {
+            storeRecords(records);
+        }
+    }
+}
+
+void MdnsResolver::storeRecords(const QList<Record> &records)
+{
+    QSet<QString> updatedNames;
+    {
+        QMutexLocker locker(&m_cacheMutex);
+
+        // Passive caching sees every host on the link; drop names that have expired
+        if (m_cache.size() > CACHE_PRUNE_THRESHOLD) {
+            for (auto it = m_cache.begin(); it != m_cache.end();) {
+                bool alive = false;
+                for (const CacheEntry &entry : it.value()) {
+                    alive = alive || !entry.expiry.hasExpired();
+                }
+                it = alive ? std::next(it) : m_cache.erase(it);
+            }
+        }
+
+        for (const Record &record : records) {
+            const QString name = normalize(record.name);
+            QList<CacheEntry> &entries = m_cache[name];
+
+            // Replace any existing entry for this address
+            for (int i = entries.size() - 1; i >= 0; --i) {
+                if (entries[i].address == record.address || entries[i].expiry.hasExpired()) {
+                    entries.removeAt(i);
+                }
+            }
+
+            if (record.ttl == 0) {
+                // Goodbye packet: RFC 6762 10.1
+                if (entries.isEmpty()) {
+                    m_cache.remove(name);
+                }
+                continue;
+            }
+
+            // Cache-flush: RFC 6762 10.2, other records of this type that are more
+            // than a second old expire in a second instead of at their TTL
+            if (record.cacheFlush) {
+                for (CacheEntry &stale : entries) {
+                    const qint64 ageMs = qint64(stale.ttl) * 1000 - stale.expiry.remainingTime();
+                    if (stale.address.protocol() == record.address.protocol()
+                        && ageMs > CACHE_FLUSH_DELAY_MS
+                        && stale.expiry.remainingTime() > CACHE_FLUSH_DELAY_MS) {
+                        stale.expiry = QDeadlineTimer(CACHE_FLUSH_DELAY_MS);
+                    }
+                }
+            }
+
+            CacheEntry entry;
+            entry.address = record.address;
+            entry.ttl = record.ttl;
+            entry.expiry = QDeadlineTimer(qint64(record.ttl) * 1000);
+            entry.refreshSent = false;
+            entries.append(entry);
+            updatedNames.insert(name);
+        }
+    }
+
+    for (const QString &name : updatedNames) {
+        if (m_pending.remove(name) > 0) {
+            emit resolved(name, cachedAddresses(name));
+        }
+    }
+}
+
+QByteArray MdnsResolver::buildQuery(const QString &hostName, bool unicastResponse)
+{
+    QByteArray query;
+    query.reserve(12 + 2 * (hostName.size() + 6));
+
+    // Header: id 0, flags 0, two questions
+    const char header[12] = {0, 0, 0, 0, 0, 2, 0, 0, 0, 0, 0, 0};
+    query.append(header, sizeof(header));
+
+    QByteArray encodedName;
+    const QStringList labels = hostName.split('.', Qt::SkipEmptyParts);
+    for (const QString &label : labels) {
+        const QByteArray utf8 = label.toUtf8().left(63);
+        encodedName.append(char(utf8.size()));
+        encodedName.append(utf8);
+    }
+    encodedName.append('\0');
+
+    const quint16 qclass = CLASS_IN | (unicastResponse ? UNICAST_RESPONSE : 0);
+    for (quint16 type : {TYPE_A, TYPE_AAAA}) {
+        query.append(encodedName);
+        uchar tail[4];
+        qToBigEndian(type, tail);
+        qToBigEndian(qclass, tail + 2);
+        query.append(reinterpret_cast<const char *>(tail), sizeof(tail));
+    }
+
+    return query;
+}
+
+// Reads a possibly compressed domain name starting at offset; advances offset past it
+static bool readName(const uchar *data, int size, int &offset, QString &name)
+{
+    QByteArray result;
+    int position = offset;
+    int jumps = 0;
+    bool jumped = false;
+
+    while (true) {
+        if (position >= size) {
+            return false;
+        }
+
+        const uchar length = data[position];
+        if ((length & 0xC0) == 0xC0) {
+            if (position + 1 >= size || ++jumps > MAX_NAME_JUMPS) {
+                return false;
+            }
+            if (!jumped) {
+                offset = position + 2;
+                jumped = true;
+            }
+            position = ((length & 0x3F) << 8) | data[position + 1];
+            continue;
+        }
+
+        if (length == 0) {
+            if (!jumped) {
+                offset = position + 1;
+            }
+            break;
+        }
+
+        if (position + 1 + length > size) {
+            return false;
+        }
+        if (!result.isEmpty()) {
+            result.append('.');
+        }
+        result.append(reinterpret_cast<const char *>(data + position + 1), length);
+        position += 1 + length;
+    }
+
+    name = QString::fromUtf8(result);
+    return true;
+}
+
+bool MdnsResolver::parseMessage(const QByteArray &message, QList<Record> &records)
+{
+    const uchar *data = reinterpret_cast<const uchar *>(message.constData());
+    const int size = message.size();
+    if (size < 12) {
+        return false;
+    }
+
+    // Only responses carry records we care about
+    const quint16 flags = qFromBigEndian<quint16>(data + 2);
+    if (!(flags & 0x8000)) {
+        return true;
+    }
+
+    const int questions = qFromBigEndian<quint16>(data + 4);
+    const int answers = qFromBigEndian<quint16>(data + 6) + qFromBigEndian<quint16>(data + 8)
+                      + qFromBigEndian<quint16>(data + 10);
+
+    int offset = 12;
+    QString name;
+    for (int i = 0; i < questions; ++i) {
+        if (!readName(data, size, offset, name) || offset + 4 > size) {
+            return false;
+        }
+        offset += 4;
+    }
+
+    for (int i = 0; i < answers; ++i) {
+        if (!readName(data, size, offset, name) || offset + 10 > size) {
+            return false;
+        }
+
+        const quint16 type = qFromBigEndian<quint16>(data + offset);
+        const quint16 rawClass = qFromBigEndian<quint16>(data + offset + 2);
+        const quint16 rrClass = rawClass & CLASS_MASK;
+        const bool cacheFlush = (rawClass & CACHE_FLUSH) != 0;
+        const quint32 ttl = qFromBigEndian<quint32>(data + offset + 4);
+        const quint16 length = qFromBigEndian<quint16>(data + offset + 8);
+        offset += 10;
+
+        if (offset + length > size) {
+            return false;
+        }
+
+        if (rrClass == CLASS_IN && type == TYPE_A && length == 4) {
+            records.append({name, QHostAddress(qFromBigEndian<quint32>(data + offset)), ttl, cacheFlush});
+        } else if (rrClass == CLASS_IN && type == TYPE_AAAA && length == 16) {
+            records.append({name, QHostAddress(data + offset), ttl, cacheFlush});
+        }
+
+        offset += length;
+    }
+
+    return true;
+}
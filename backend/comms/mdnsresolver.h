@@ -0,0 +1,96 @@
+#ifndef MDNSRESOLVER_H
+#define MDNSRESOLVER_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QTimer>
+#include <QHostAddress>
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+
+/**
+ * @brief In-process multicast DNS querier and cache
+ *
+ * This class manages:
+ * - Sending A/AAAA queries for .local names on every multicast-capable interface
+ * - Passively caching every address record announced on the link, honouring TTLs
+ *   (including TTL 0 "goodbye" records)
+ * - Answering lookups from memory, re-querying names that are close to expiring
+ *   once per record lifetime
+ * - Cache-flush records (RFC 6762 section 10.2), which retire other addresses
+ *   cached for the same name one second later
+ *
+ * It does not depend on Avahi/Bonjour being installed. If another responder
+ * already owns UDP 5353 exclusively, it falls back to one-shot legacy
+ * unicast queries (RFC 6762 section 5.1) from an ephemeral port.
+ *
+ * The communication handler owns the resolver on the GUI thread and feeds its
+ * answers to robot discovery. cachedAddresses() may be called from any thread.
+ */
+class MdnsResolver : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MdnsResolver(QObject *parent = nullptr);
+    ~MdnsResolver();
+
+    // Returns cached addresses immediately; empty if unknown or expired
+    QList<QHostAddress> cachedAddresses(const QString &hostName) const;
+
+    // Answers from cache if possible (returns true), otherwise queries the link and
+    // later emits resolved() or resolveFailed() once for the outstanding name
+    bool resolve(const QString &hostName, int timeoutMs = 3000);
+
+    bool isListening() const { return m_listening; }
+    int cacheSize() const;
+
+    // Wire format helpers, static so tools can reuse them
+    struct Record {
+        QString name;
+        QHostAddress address;
+        quint32 ttl;
+        bool cacheFlush;    // Other addresses for this name and type are stale
+    };
+    static bool parseMessage(const QByteArray &message, QList<Record> &records);
+    static QByteArray buildQuery(const QString &hostName, bool unicastResponse);
+
+signals:
+    void resolved(const QString &hostName, const QList<QHostAddress> &addresses);
+    void resolveFailed(const QString &hostName);
+
+private slots:
+    void readDatagrams();
+    void onRetryTimer();
+
+private:
+    struct CacheEntry {
+        QHostAddress address;
+        quint32 ttl;
+        QDeadlineTimer expiry;
+        bool refreshSent;   // The 80% TTL re-query went out for this record
+    };
+
+    struct PendingQuery {
+        QDeadlineTimer deadline;
+        QDeadlineTimer nextAttempt;
+        int attempts;
+    };
+
+    void openSocket();
+    void sendQuery(const QString &hostName);
+    void storeRecords(const QList<Record> &records);
+    static QString normalize(const QString &hostName);
+
+    QUdpSocket *m_socket;
+    QTimer *m_retryTimer;
+    bool m_listening;
+
+    mutable QMutex m_cacheMutex;
+    QHash<QString, QList<CacheEntry>> m_cache;
+    QHash<QString, PendingQuery> m_pending;
+};
+
+#endif // MDNSRESOLVER_H
@@ -0,0 +1,226 @@
+#include "robotdiscovery.h"
+#include "../core/constants.h"
+#include "../core/logger.h"
+#include <QNetworkInterface>
+#include <QSettings>
+
+// Discovery timing
+static const int DISCOVERY_TIMEOUT_MS = 5000;
+static const int PROBE_INTERVAL_MS = 250;
+static const int LAST_KNOWN_HEAD_START_MS = 50;
+
+RobotDiscovery::RobotDiscovery(QUdpSocket *socket, quint16 robotPort, QObject *parent)
+    : QObject(parent)
+    , m_socket(socket)
+    , m_robotPort(robotPort)
+    , m_probeTimer(new QTimer(this))
+    , m_timeoutTimer(new QTimer(this))
+    , m_running(false)
+    , m_teamNumber(0)
+{
+    // Fires at the head-start granularity so staggered candidates start on time
+    m_probeTimer->setInterval(LAST_KNOWN_HEAD_START_MS);
+    connect(m_probeTimer, &QTimer::timeout, this, &RobotDiscovery::onProbeTimer);
+
+    m_timeoutTimer->setSingleShot(true);
+    m_timeoutTimer->setInterval(DISCOVERY_TIMEOUT_MS);
+    connect(m_timeoutTimer, &QTimer::timeout, this, &RobotDiscovery::onDiscoveryTimeout);
+}
+
+RobotDiscovery::~RobotDiscovery()
+{
+    stop();
+}
+
+void RobotDiscovery::start(int teamNumber, const QList<QHostAddress> &candidates, const QByteArray &probePacket)
+{
+    stop();
+
+    m_running = true;
+    m_teamNumber = teamNumber;
+    m_probePacket = probePacket;
+    m_elapsed.start();
+
+    // The last known good address goes first, but only if the interface it was
+    // reached through is still up; after a tether swap it gets no head start
+    QHostAddress lastKnown = lastKnownAddress(teamNumber);
+    bool headStart = !lastKnown.isNull() && isInterfaceUp(lastKnownInterface(teamNumber));
+    if (headStart) {
+        m_candidates.append({lastKnown, "last known good", 0, 0});
+    }
+
+    for (const QHostAddress &address : candidates) {
+        addCandidate(address, "static");
+    }
+
+    YADS_LOG_INFO(Constants::LogCategories::NETWORK,
+                  QString("Probing %1 candidates in parallel%2")
+                  .arg(m_candidates.size())
+                  .arg(headStart ? QString(", %1 first").arg(lastKnown.toString()) : QString()));
+
+    onProbeTimer();
+    m_probeTimer->start();
+    m_timeoutTimer->start();
+}
+
+void RobotDiscovery::addCandidate(const QHostAddress &address, const QString &source)
+{
+    if (!m_running || address.isNull()) {
+        return;
+    }
+
+    for (const Candidate &candidate : m_candidates) {
+        if (sameAddress(candidate.address, address)) {
+            return;
+        }
+    }
+
+    bool lastKnownFirst = !m_candidates.isEmpty() && m_candidates.first().source == "last known good";
+    qint64 startAt = lastKnownFirst ? LAST_KNOWN_HEAD_START_MS : 0;
+    m_candidates.append({address, source, qMax(startAt, m_elapsed.elapsed()), 0});
+
+    // Late additions (e.g. an mDNS answer) are probed right away
+    if (m_elapsed.elapsed() >= startAt) {
+        probe(m_candidates.last());
+    }
+}
+
+void RobotDiscovery::stop()
+{
+    m_running = false;
+    m_probeTimer->stop();
+    m_timeoutTimer->stop();
+    m_candidates.clear();
+}
+
+bool RobotDiscovery::handleResponse(const QHostAddress &sender)
+{
+    if (!m_running) {
+        return false;
+    }
+
+    for (const Candidate &candidate : m_candidates) {
+        if (candidate.probesSent == 0 || !sameAddress(candidate.address, sender)) {
+            continue;
+        }
+
+        qint64 elapsed = m_elapsed.elapsed();
+        QString interfaceName = interfaceForAddress(candidate.address);
+
+        YADS_LOG_INFO(Constants::LogCategories::NETWORK,
+                      QString("Robot answered at %1 (%2) via %3 after %4 ms")
+                      .arg(candidate.address.toString())
+                      .arg(candidate.source)
+                      .arg(interfaceName.isEmpty() ? "default route" : interfaceName)
+                      .arg(elapsed));
+
+        QHostAddress address = candidate.address;
+        stop();
+        saveLastKnown(address, interfaceName);
+        emit robotFound(address, interfaceName, elapsed);
+        return true;
+    }
+
+    return false;
+}
+
+void RobotDiscovery::onProbeTimer()
+{
+    qint64 now = m_elapsed.elapsed();
+
+    for (Candidate &candidate : m_candidates) {
+        if (now < candidate.startAtMs) {
+            continue;
+        }
+
+        qint64 nextProbeAt = candidate.startAtMs + qint64(candidate.probesSent) * PROBE_INTERVAL_MS;
+        if (now >= nextProbeAt) {
+            probe(candidate);
+        }
+    }
+}
+
+void RobotDiscovery::onDiscoveryTimeout()
+{
+    YADS_LOG_WARNING(Constants::LogCategories::NETWORK,
+                     QString("No response from %1 candidates").arg(m_candidates.size()));
+    stop();
+    emit discoveryFailed();
+}
+
+void RobotDiscovery::probe(Candidate &candidate)
+{
+    candidate.probesSent++;
+
+    if (m_socket->writeDatagram(m_probePacket, candidate.address, m_robotPort) == -1) {
+        // Usually "network unreachable" for an interface that is not plugged in
+        YADS_LOG_DEBUG(Constants::LogCategories::NETWORK,
+                       QString("Probe to %1 failed: %2")
+                       .arg(candidate.address.toString())
+                       .arg(m_socket->errorString()));
+    }
+}
+
+QHostAddress RobotDiscovery::lastKnownAddress(int teamNumber) const
+{
+    QSettings settings;
+    settings.beginGroup("RobotDiscovery");
+    return QHostAddress(settings.value(QString("team%1/address").arg(teamNumber)).toString());
+}
+
+QString RobotDiscovery::lastKnownInterface(int teamNumber) const
+{
+    QSettings settings;
+    settings.beginGroup("RobotDiscovery");
+    return settings.value(QString("team%1/interface").arg(teamNumber)).toString();
+}
+
+void RobotDiscovery::forgetLastKnown(int teamNumber)
+{
+    QSettings settings;
+    settings.beginGroup("RobotDiscovery");
+    settings.remove(QString("team%1").arg(teamNumber));
+}
+
+void RobotDiscovery::saveLastKnown(const QHostAddress &address, const QString &interfaceName)
+{
+    QSettings settings;
+    settings.beginGroup("RobotDiscovery");
+    settings.setValue(QString("team%1/address").arg(m_teamNumber), address.toString());
+    settings.setValue(QString("team%1/interface").arg(m_teamNumber), interfaceName);
+}
+
+QString RobotDiscovery::interfaceForAddress(const QHostAddress &address)
+{
+    // The interface whose subnet contains the robot is the one the OS routes through
+    const QList<QNetworkInterface> interfaces = QNetworkInterface::allInterfaces();
+    for (const QNetworkInterface &iface : interfaces) {
+        if (!(iface.flags() & QNetworkInterface::IsUp)) {
+            continue;
+        }
+        for (const QNetworkAddressEntry &entry : iface.addressEntries()) {
+            if (entry.prefixLength() > 0 && address.isInSubnet(entry.ip(), entry.prefixLength())) {
+                return iface.name();
+            }
+        }
+    }
+    return QString();
+}
+
+bool RobotDiscovery::isInterfaceUp(const QString &interfaceName)
+{
+    if (interfaceName.isEmpty()) {
+        // Reached through the default route last time; nothing to check
+        return true;
+    }
+
+    QNetworkInterface iface = QNetworkInterface::interfaceFromName(interfaceName);
+    return iface.isValid() && (iface.flags() & QNetworkInterface::IsUp)
+        && (iface.flags() & QNetworkInterface::IsRunning);
+}
+
+bool RobotDiscovery::sameAddress(const QHostAddress &a, const QHostAddress &b)
+{
+    // Replies on a dual-stack socket arrive as IPv4-mapped IPv6 addresses
+    return a.isEqual(b, QHostAddress::TolerantConversion);
+}
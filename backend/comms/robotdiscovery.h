@@ -0,0 +1,79 @@
+#ifndef ROBOTDISCOVERY_H
+#define ROBOTDISCOVERY_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QTimer>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QList>
+
+/**
+ * @brief Parallel ("happy eyeballs") robot discovery
+ *
+ * This class manages:
+ * - Probing every candidate robot address at the same time
+ * - Taking the first candidate that answers and reporting the interface it was reached on
+ * - Remembering the last known good address and interface per team on disk
+ * - Giving the last known good address a short head start on the next discovery
+ *
+ * Probes are sent through the communication socket owned by the caller,
+ * which forwards received datagrams to handleResponse() while discovery
+ * is running. Nothing here blocks the event loop.
+ */
+class RobotDiscovery : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RobotDiscovery(QUdpSocket *socket, quint16 robotPort, QObject *parent = nullptr);
+    ~RobotDiscovery();
+
+    void start(int teamNumber, const QList<QHostAddress> &candidates, const QByteArray &probePacket);
+    void addCandidate(const QHostAddress &address, const QString &source);
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    // Returns true if the sender completed discovery
+    bool handleResponse(const QHostAddress &sender);
+
+    QHostAddress lastKnownAddress(int teamNumber) const;
+    QString lastKnownInterface(int teamNumber) const;
+    void forgetLastKnown(int teamNumber);
+
+    static QString interfaceForAddress(const QHostAddress &address);
+
+signals:
+    void robotFound(const QHostAddress &address, const QString &interfaceName, qint64 elapsedMs);
+    void discoveryFailed();
+
+private slots:
+    void onProbeTimer();
+    void onDiscoveryTimeout();
+
+private:
+    struct Candidate {
+        QHostAddress address;
+        QString source;
+        qint64 startAtMs;   // Relative to discovery start
+        int probesSent;
+    };
+
+    void probe(Candidate &candidate);
+    void saveLastKnown(const QHostAddress &address, const QString &interfaceName);
+    static bool isInterfaceUp(const QString &interfaceName);
+    static bool sameAddress(const QHostAddress &a, const QHostAddress &b);
+
+    QUdpSocket *m_socket;
+    quint16 m_robotPort;
+    QTimer *m_probeTimer;
+    QTimer *m_timeoutTimer;
+    QElapsedTimer m_elapsed;
+
+    bool m_running;
+    int m_teamNumber;
+    QByteArray m_probePacket;
+    QList<Candidate> m_candidates;
+};
+
+#endif // ROBOTDISCOVERY_H
@@ -18,9 +18,8 @@
 using namespace FRCDriverStation;
 using namespace FRCDriverStation::Constants;
 
-ControllerHIDDevice::ControllerHIDDevice(const QString &devicePath, std::shared_ptr<Logger> logger, QObject *parent)
+ControllerHIDDevice::ControllerHIDDevice(const QString &devicePath, QObject *parent)
     : QObject(parent)
-    , m_logger(logger)
     , m_devicePath(devicePath)
     , m_vendorId(0)
     , m_productId(0)
@@ -51,24 +50,25 @@ ControllerHIDDevice::~ControllerHIDDevice()
     closeDevice();
 }
 
-ControllerHIDDevice* ControllerHIDDevice::createFromPath(const QString &devicePath, std::shared_ptr<Logger> logger)
+ControllerHIDDevice* ControllerHIDDevice::createFromPath(const QString &devicePath)
 {
-    ControllerHIDDevice *device = new ControllerHIDDevice(devicePath, logger);
+    ControllerHIDDevice *device = new ControllerHIDDevice(devicePath);
     
     if (device->openDevice() && device->readDeviceInfo() && device->readCapabilities()) {
         device->m_connected = true;
-        logger->debug("Controller Device", "Device created successfully", 
-                     QString("Path: %1, Name: %2").arg(devicePath).arg(device->m_name));
+        YADS_LOG_DEBUG(::Constants::LogCategories::CONTROLLERS,
+                       QString("Device created: %2 (%1)").arg(devicePath).arg(device->m_name));
         return device;
     } else {
-        logger->debug("Controller Device", "Failed to create device", devicePath);
+        YADS_LOG_DEBUG(::Constants::LogCategories::CONTROLLERS,
+                       QString("Failed to create device for %1").arg(devicePath));
         delete device;
         return nullptr;
     }
 }
 
 #ifdef Q_OS_MACOS
-ControllerHIDDevice* ControllerHIDDevice::createFromIOHIDDevice(IOHIDDeviceRef hidDevice, std::shared_ptr> logger)
+ControllerHIDDevice* ControllerHIDDevice::createFromIOHIDDevice(IOHIDDeviceRef hidDevice)
 {
     // Get device path from IOHIDDevice
     CFStringRef pathRef = (CFStringRef)IOHIDDeviceGetProperty(hidDevice, CFSTR(kIOHIDLocationIDKey));
@@ -87,17 +87,17 @@ ControllerHIDDevice* ControllerHIDDevice::createFromIOHIDDevice(IOHIDDeviceRef h
         devicePath = QString("macos_hid_%1").arg(reinterpret_cast<quintptr>(hidDevice));
     }
     
-    ControllerHIDDevice *device = new ControllerHIDDevice(devicePath, logger);
+    ControllerHIDDevice *device = new ControllerHIDDevice(devicePath);
     device->m_hidDevice = hidDevice;
     CFRetain(hidDevice);
     
     if (device->readDeviceInfo() && device->readCapabilities()) {
         device->m_connected = true;
-        logger->debug("Controller Device", "macOS device created successfully", 
-                     QString("Name: %1").arg(device->m_name));
+        YADS_LOG_DEBUG(::Constants::LogCategories::CONTROLLERS,
+                       QString("macOS device created: %1").arg(device->m_name));
         return device;
     } else {
-        logger->debug("Controller Device", "Failed to create macOS device");
+        YADS_LOG_DEBUG(::Constants::LogCategories::CONTROLLERS, "Failed to create macOS device");
         delete device;
         return nullptr;
     }
@@ -16,8 +16,6 @@
 
 namespace FRCDriverStation {
 
-class Logger;
-
 /**
  * @brief Represents a single HID controller device
  * 
@@ -41,10 +39,10 @@ public:
     ~ControllerHIDDevice();
 
     // Factory methods for platform-specific creation
-    static ControllerHIDDevice* createFromPath(const QString &devicePath, std::shared_ptr<Logger> logger);
+    static ControllerHIDDevice* createFromPath(const QString &devicePath);
     
 #ifdef Q_OS_MACOS
-    static ControllerHIDDevice* createFromIOHIDDevice(IOHIDDeviceRef device, std::shared_ptr<Logger> logger);
+    static ControllerHIDDevice* createFromIOHIDDevice(IOHIDDeviceRef device);
 #endif
 
     // Device identification
@@ -74,7 +72,7 @@ signals:
     void disconnected();
 
 private:
-    explicit ControllerHIDDevice(const QString &devicePath, std::shared_ptr<Logger> logger, QObject *parent = nullptr);
+    explicit ControllerHIDDevice(const QString &devicePath, QObject *parent = nullptr);
     
     bool openDevice();
     void closeDevice();
@@ -82,7 +80,6 @@ private:
     bool readCapabilities();
     void normalizeAxisValue(int axis, int rawValue);
     
-    std::shared_ptr<Logger> m_logger;
     QString m_devicePath;
     QString m_deviceId;
     QString m_name;
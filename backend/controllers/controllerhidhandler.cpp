@@ -1,6 +1,7 @@
 #include "controllerhidhandler.h"
 #include "../core/logger.h"
 #include "../core/constants.h"
+#include "../core/tracing.h"
 #include <QDebug>
 
 #ifdef Q_OS_WIN
@@ -20,9 +21,8 @@
 using namespace FRCDriverStation;
 using namespace FRCDriverStation::Constants;
 
-ControllerHIDHandler::ControllerHIDHandler(std::shared_ptr<Logger> logger, QObject *parent)
+ControllerHIDHandler::ControllerHIDHandler(QObject *parent)
     : QObject(parent)
-    , m_logger(logger)
     , m_pollTimer(std::make_unique<QTimer>(this))
     , m_detectTimer(std::make_unique<QTimer>(this))
     , m_polling(false)
@@ -35,13 +35,13 @@ ControllerHIDHandler::ControllerHIDHandler(std::shared_ptr<Logger> logger, QObje
     m_detectTimer->setInterval(2000);
     connect(m_detectTimer.get(), &QTimer::timeout, this, &ControllerHIDHandler::detectControllers);
     
-    m_logger->info("Controller Handler", "Controller HID handler initialized");
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS, "Controller HID handler initialized");
 }
 
 ControllerHIDHandler::~ControllerHIDHandler()
 {
     stopPolling();
-    m_logger->info("Controller Handler", "Controller HID handler destroyed");
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS, "Controller HID handler destroyed");
 }
 
 void ControllerHIDHandler::startPolling()
@@ -53,7 +53,7 @@ void ControllerHIDHandler::startPolling()
     m_pollTimer->start();
     m_detectTimer->start();
     
-    m_logger->info("Controller Handler", "Started controller polling");
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS, "Started controller polling");
 }
 
 void ControllerHIDHandler::stopPolling()
@@ -64,7 +64,7 @@ void ControllerHIDHandler::stopPolling()
     m_pollTimer->stop();
     m_detectTimer->stop();
     
-    m_logger->info("Controller Handler", "Stopped controller polling");
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS, "Stopped controller polling");
 }
 
 void ControllerHIDHandler::refreshControllers()
@@ -110,13 +110,15 @@ void ControllerHIDHandler::refreshControllers()
 bool ControllerHIDHandler::bindControllerToSlot(const QString &deviceId, int slot)
 {
     if (slot < 0 || slot >= MAX_CONTROLLER_SLOTS) {
-        m_logger->warning("Controller Binding", "Invalid slot number", QString("Slot: %1").arg(slot));
+        YADS_LOG_WARNING(::Constants::LogCategories::CONTROLLERS,
+                         QString("Invalid slot number %1").arg(slot));
         return false;
     }
     
     ControllerHIDDevice *controller = getControllerById(deviceId);
     if (!controller) {
-        m_logger->warning("Controller Binding", "Controller not found", deviceId);
+        YADS_LOG_WARNING(::Constants::LogCategories::CONTROLLERS,
+                         QString("Controller not found: %1").arg(deviceId));
         return false;
     }
     
@@ -134,8 +136,8 @@ bool ControllerHIDHandler::bindControllerToSlot(const QString &deviceId, int slo
     // Bind controller to slot
     m_slotBindings[slot] = controller;
     
-    m_logger->info("Controller Binding", "Controller bound to slot", 
-                  QString("Device: %1, Slot: %2").arg(controller->name()).arg(slot));
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Controller %1 bound to slot %2").arg(controller->name()).arg(slot));
     
     emit controllerBound(controller, slot);
     return true;
@@ -152,8 +154,8 @@ void ControllerHIDHandler::unbindControllerFromSlot(int slot)
     
     m_slotBindings.remove(slot);
     
-    m_logger->info("Controller Binding", "Controller unbound from slot", 
-                  QString("Device: %1, Slot: %2").arg(controller->name()).arg(slot));
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Controller %1 unbound from slot %2").arg(controller->name()).arg(slot));
     
     emit controllerUnbound(deviceId, slot);
 }
@@ -211,6 +213,7 @@ int ControllerHIDHandler::getBoundControllerCount() const
 
 void ControllerHIDHandler::pollControllers()
 {
+    TRACE_SCOPE("ControllerHIDHandler::pollControllers");
     updateControllerData();
 }
 
@@ -224,8 +227,8 @@ void ControllerHIDHandler::addController(ControllerHIDDevice *controller)
     QString deviceId = controller->deviceId();
     m_controllers[deviceId] = std::unique_ptr<ControllerHIDDevice>(controller);
     
-    m_logger->info("Controller Detection", "Controller connected", 
-                  QString("Name: %1, ID: %2").arg(controller->name()).arg(deviceId));
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Controller connected: %1 (%2)").arg(controller->name()).arg(deviceId));
     
     emit controllerConnected(controller);
 }
@@ -249,8 +252,8 @@ void ControllerHIDHandler::removeController(const QString &deviceId)
     // Remove from controllers map
     m_controllers.erase(it);
     
-    m_logger->info("Controller Detection", "Controller disconnected", 
-                  QString("Name: %1, ID: %2").arg(name).arg(deviceId));
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Controller disconnected: %1 (%2)").arg(name).arg(deviceId));
     
     emit controllerDisconnected(deviceId);
 }
@@ -302,7 +305,7 @@ QList<ControllerHIDDevice*> ControllerHIDHandler::enumerateHIDDevices()
                                               deviceInterfaceDetailData, requiredSize, NULL, NULL)) {
                 
                 QString devicePath = QString::fromWCharArray(deviceInterfaceDetailData->DevicePath);
-                ControllerHIDDevice *device = ControllerHIDDevice::createFromPath(devicePath, m_logger);
+                ControllerHIDDevice *device = ControllerHIDDevice::createFromPath(devicePath);
                 
                 if (device && device->isGameController()) {
                     devices.append(device);
@@ -336,7 +339,7 @@ QList<ControllerHIDDevice*> ControllerHIDHandler::enumerateHIDDevices()
         const char *devnode = udev_device_get_devnode(dev);
         if (devnode && strstr(devnode, "/dev/input/event")) {
             QString devicePath = QString::fromUtf8(devnode);
-            ControllerHIDDevice *device = ControllerHIDDevice::createFromPath(devicePath, m_logger);
+            ControllerHIDDevice *device = ControllerHIDDevice::createFromPath(devicePath);
             
             if (device && device->isGameController()) {
                 devices.append(device);
@@ -367,7 +370,7 @@ QList<ControllerHIDDevice*> ControllerHIDHandler::enumerateHIDDevices()
             
             for (CFIndex i = 0; i < deviceCount; i++) {
                 IOHIDDeviceRef device = deviceArray[i];
-                ControllerHIDDevice *controller = ControllerHIDDevice::createFromIOHIDDevice(device, m_logger);
+                ControllerHIDDevice *controller = ControllerHIDDevice::createFromIOHIDDevice(device);
                 
                 if (controller && controller->isGameController()) {
                     devices.append(controller);
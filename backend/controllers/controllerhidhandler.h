@@ -10,8 +10,6 @@
 
 namespace FRCDriverStation {
 
-class Logger;
-
 /**
  * @brief Manages HID controller detection, binding, and data collection
  * 
@@ -34,7 +32,7 @@ class ControllerHIDHandler : public QObject
 public:
     static constexpr int MAX_CONTROLLER_SLOTS = 6;
 
-    explicit ControllerHIDHandler(std::shared_ptr<Logger> logger, QObject *parent = nullptr);
+    explicit ControllerHIDHandler(QObject *parent = nullptr);
     ~ControllerHIDHandler();
 
     // Controller management
@@ -75,7 +73,6 @@ private:
     void updateControllerData();
     QList<ControllerHIDDevice*> enumerateHIDDevices();
 
-    std::shared_ptr<Logger> m_logger;
     std::unique_ptr<QTimer> m_pollTimer;
     std::unique_ptr<QTimer> m_detectTimer;
     
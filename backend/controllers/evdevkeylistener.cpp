@@ -0,0 +1,269 @@
+#include "evdevkeylistener.h"
+#include <QDir>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/inotify.h>
+#include <linux/input.h>
+
+using namespace FRCDriverStation;
+
+// Older kernel headers only have the struct timeval member
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
+
+static const char *INPUT_DIRECTORY = "/dev/input";
+
+namespace {
+
+bool testBit(const unsigned long *bits, int bit) {
+    const int bitsPerLong = 8 * sizeof(unsigned long);
+    return (bits[bit / bitsPerLong] >> (bit % bitsPerLong)) & 1UL;
+}
+
+qint64 monotonicNowUs() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return qint64(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+} // namespace
+
+struct EvdevKeyListener::Keyboard {
+    int fd;
+    QString path;
+    QString name;
+    bool monotonicTimestamps;
+};
+
+EvdevKeyListener::EvdevKeyListener(QObject *parent)
+    : QObject(parent)
+    , m_running(false)
+    , m_keyboardCount(0)
+    , m_wakePipe{-1, -1}
+    , m_inotifyFd(-1)
+{
+}
+
+EvdevKeyListener::~EvdevKeyListener() {
+    stop();
+}
+
+bool EvdevKeyListener::start() {
+    if (isRunning()) {
+        return true;
+    }
+
+    if (pipe2(m_wakePipe, O_CLOEXEC | O_NONBLOCK) != 0) {
+        emit errorOccurred(QString("Cannot create wake pipe: %1").arg(strerror(errno)));
+        return false;
+    }
+
+    // Hotplug is a convenience; without it, keyboards present at start still work
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd >= 0
+        && inotify_add_watch(m_inotifyFd, INPUT_DIRECTORY, IN_CREATE | IN_ATTRIB) < 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+    if (m_inotifyFd < 0) {
+        emit errorOccurred("Keyboard hotplug detection unavailable");
+    }
+
+    m_running.store(true, std::memory_order_release);
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("EvdevKeys");
+    m_thread->start(QThread::TimeCriticalPriority);
+    return true;
+}
+
+void EvdevKeyListener::stop() {
+    if (!isRunning()) {
+        return;
+    }
+
+    m_running.store(false, std::memory_order_release);
+    const char wake = 0;
+    if (write(m_wakePipe[1], &wake, 1) < 0) {
+        // The pipe is non-blocking and only ever needs one byte
+    }
+    m_thread->wait();
+    m_thread.reset();
+
+    close(m_wakePipe[0]);
+    close(m_wakePipe[1]);
+    m_wakePipe[0] = m_wakePipe[1] = -1;
+    if (m_inotifyFd >= 0) {
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+    }
+}
+
+void EvdevKeyListener::run() {
+    std::vector<Keyboard> keyboards;
+    scanDevices(keyboards);
+
+    if (keyboards.empty()) {
+        emit errorOccurred("No readable keyboards under /dev/input (is the user in the 'input' group?)");
+    }
+
+    std::vector<struct pollfd> fds;
+
+    while (m_running.load(std::memory_order_acquire)) {
+        // Slot 0 is the wake pipe, slot 1 the inotify descriptor, then one per keyboard
+        fds.clear();
+        fds.push_back({m_wakePipe[0], POLLIN, 0});
+        fds.push_back({m_inotifyFd, POLLIN, 0});
+        for (const Keyboard &keyboard : keyboards) {
+            fds.push_back({keyboard.fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            emit errorOccurred(QString("poll() failed: %1").arg(strerror(errno)));
+            break;
+        }
+
+        if (fds[0].revents) {
+            break;
+        }
+
+        // Keyboards first: a key press must not wait behind hotplug handling
+        for (size_t i = keyboards.size(); i-- > 0;) {
+            const short revents = fds[i + 2].revents;
+            if (!revents) {
+                continue;
+            }
+
+            bool removed = (revents & (POLLHUP | POLLERR | POLLNVAL)) != 0;
+            if (!removed) {
+                readKeyboard(keyboards[i], removed);
+            }
+
+            if (removed) {
+                close(keyboards[i].fd);
+                emit keyboardRemoved(keyboards[i].path, keyboards[i].name);
+                keyboards.erase(keyboards.begin() + i);
+                m_keyboardCount.store(int(keyboards.size()), std::memory_order_relaxed);
+            }
+        }
+
+        if (fds[1].revents & POLLIN) {
+            alignas(struct inotify_event) char buffer[4096];
+            ssize_t length;
+            while ((length = read(m_inotifyFd, buffer, sizeof(buffer))) > 0) {
+                for (char *p = buffer; p < buffer + length;) {
+                    const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+                    p += sizeof(struct inotify_event) + event->len;
+
+                    // udev creates the node first and fixes its permissions afterwards,
+                    // so IN_ATTRIB is what makes a new keyboard readable
+                    if (event->len > 0 && QString::fromLocal8Bit(event->name).startsWith("event")) {
+                        openKeyboard(QString("%1/%2").arg(INPUT_DIRECTORY).arg(event->name), keyboards);
+                    }
+                }
+            }
+        }
+    }
+
+    for (const Keyboard &keyboard : keyboards) {
+        close(keyboard.fd);
+    }
+    m_keyboardCount.store(0, std::memory_order_relaxed);
+}
+
+void EvdevKeyListener::scanDevices(std::vector<Keyboard> &keyboards) {
+    const QStringList nodes = QDir(INPUT_DIRECTORY).entryList(QStringList() << "event*", QDir::System);
+    for (const QString &node : nodes) {
+        openKeyboard(QString("%1/%2").arg(INPUT_DIRECTORY).arg(node), keyboards);
+    }
+}
+
+bool EvdevKeyListener::openKeyboard(const QString &path, std::vector<Keyboard> &keyboards) {
+    for (const Keyboard &keyboard : keyboards) {
+        if (keyboard.path == path) {
+            return false;
+        }
+    }
+
+    int fd = open(path.toLocal8Bit().constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Anything that can type both safety keys counts, including uinput devices
+    unsigned long keyBits[KEY_MAX / (8 * sizeof(unsigned long)) + 1] = {};
+    if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0
+        || !testBit(keyBits, KEY_SPACE) || !testBit(keyBits, KEY_ENTER)) {
+        close(fd);
+        return false;
+    }
+
+    char name[256] = {};
+    if (ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name) < 0) {
+        name[0] = '\0';
+    }
+
+    // Monotonic event timestamps let us measure kernel-to-dispatch latency
+    int clockId = CLOCK_MONOTONIC;
+    bool monotonic = ioctl(fd, EVIOCSCLOCKID, &clockId) == 0;
+
+    keyboards.push_back({fd, path, QString::fromLocal8Bit(name), monotonic});
+    m_keyboardCount.store(int(keyboards.size()), std::memory_order_relaxed);
+    emit keyboardAdded(path, keyboards.back().name);
+    return true;
+}
+
+void EvdevKeyListener::readKeyboard(Keyboard &keyboard, bool &removed) {
+    struct input_event events[64];
+
+    while (true) {
+        ssize_t length = read(keyboard.fd, events, sizeof(events));
+        if (length < 0) {
+            if (errno == ENODEV) {
+                removed = true;
+            }
+            return;
+        }
+        if (length == 0) {
+            return;
+        }
+
+        const int count = int(length / sizeof(struct input_event));
+        for (int i = 0; i < count; ++i) {
+            const struct input_event &event = events[i];
+
+            // Presses only; autorepeat (2) and release (0) are ignored
+            if (event.type != EV_KEY || event.value != 1) {
+                continue;
+            }
+
+            qint64 latencyUs = -1;
+            if (keyboard.monotonicTimestamps) {
+                latencyUs = monotonicNowUs()
+                    - (qint64(event.input_event_sec) * 1000000 + event.input_event_usec);
+            }
+
+            switch (event.code) {
+            case KEY_SPACE:
+                emit emergencyStopPressed(keyboard.name, latencyUs);
+                break;
+            case KEY_ENTER:
+            case KEY_KPENTER:
+                emit disablePressed(keyboard.name, latencyUs);
+                break;
+            default:
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#ifndef EVDEVKEYLISTENER_H
+#define EVDEVKEYLISTENER_H
+
+#include <QObject>
+#include <QThread>
+#include <QString>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Reads the safety keys straight from Linux evdev keyboards
+ *
+ * This class manages:
+ * - Finding every keyboard under /dev/input (any device reporting KEY_SPACE and KEY_ENTER)
+ * - Following hotplug through inotify, including virtual keyboards created with uinput
+ * - A poll() loop on its own thread that reports e-stop (Space) and disable (Enter)
+ *   key presses the moment the kernel delivers them
+ *
+ * Design principles:
+ * - Independent of X11/Wayland and of window focus; works while the GUI is busy
+ * - Never grabs a device (no EVIOCGRAB), so other applications still see every key
+ * - Key signals are emitted on the input thread; connect the transmit path with
+ *   Qt::DirectConnection and everything else with the default queued connection
+ * - Nothing is logged from the input thread; device changes are reported as signals
+ *
+ * Reading /dev/input/event* normally requires membership of the "input" group.
+ */
+class EvdevKeyListener : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit EvdevKeyListener(QObject *parent = nullptr);
+    ~EvdevKeyListener();
+
+    bool start();
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+    int keyboardCount() const { return m_keyboardCount.load(std::memory_order_relaxed); }
+
+signals:
+    // Emitted on the input thread; latencyUs is kernel event timestamp to dispatch
+    void emergencyStopPressed(const QString &device, qint64 latencyUs);
+    void disablePressed(const QString &device, qint64 latencyUs);
+
+    void keyboardAdded(const QString &path, const QString &name);
+    void keyboardRemoved(const QString &path, const QString &name);
+    void errorOccurred(const QString &error);
+
+private:
+    struct Keyboard;
+
+    void run();
+    void scanDevices(std::vector<Keyboard> &keyboards);
+    bool openKeyboard(const QString &path, std::vector<Keyboard> &keyboards);
+    void readKeyboard(Keyboard &keyboard, bool &removed);
+
+    std::unique_ptr<QThread> m_thread;
+    std::atomic<bool> m_running;
+    std::atomic<int> m_keyboardCount;
+    int m_wakePipe[2];
+    int m_inotifyFd;
+};
+
+} // namespace FRCDriverStation
+
+#endif // EVDEVKEYLISTENER_H
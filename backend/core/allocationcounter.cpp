@@ -0,0 +1,127 @@
+#include "allocationcounter.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace FRCDriverStation;
+
+#ifdef ENABLE_ALLOCATION_COUNTING
+
+namespace {
+
+std::atomic<quint64> s_allocations{0};
+std::atomic<quint64> s_bytes{0};
+thread_local quint64 t_allocations = 0;
+thread_local quint64 t_bytes = 0;
+
+void countAllocation(std::size_t size) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    s_bytes.fetch_add(size, std::memory_order_relaxed);
+    t_allocations++;
+    t_bytes += size;
+}
+
+} // namespace
+
+#ifdef ALLOCATION_COUNTING_HOOK_MALLOC
+// Qt containers allocate with malloc rather than operator new, so where CMake found
+// glibc's __libc_* entry points the malloc family is interposed as well; operator
+// new then counts through malloc
+
+extern "C" {
+
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t count, std::size_t size);
+void *__libc_realloc(void *p, std::size_t size);
+
+void *malloc(std::size_t size) {
+    countAllocation(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(std::size_t count, std::size_t size) {
+    countAllocation(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *p, std::size_t size) {
+    countAllocation(size);
+    return __libc_realloc(p, size);
+}
+
+} // extern "C"
+#endif
+
+namespace {
+
+void *countedAllocate(std::size_t size) {
+#ifndef ALLOCATION_COUNTING_HOOK_MALLOC
+    countAllocation(size);
+#endif
+    return std::malloc(size ? size : 1);
+}
+
+} // namespace
+
+void *operator new(std::size_t size) {
+    if (void *p = countedAllocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    if (void *p = countedAllocate(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAllocate(size);
+}
+
+void *operator new[](std::size_t size, const std::nothrow_t &) noexcept {
+    return countedAllocate(size);
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { std::free(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { std::free(p); }
+
+bool AllocationCounter::isEnabled() {
+    return true;
+}
+
+AllocationCounter::Snapshot AllocationCounter::process() {
+    Snapshot snapshot;
+    snapshot.allocations = s_allocations.load(std::memory_order_relaxed);
+    snapshot.bytes = s_bytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+AllocationCounter::Snapshot AllocationCounter::thread() {
+    Snapshot snapshot;
+    snapshot.allocations = t_allocations;
+    snapshot.bytes = t_bytes;
+    return snapshot;
+}
+
+#else
+
+bool AllocationCounter::isEnabled() {
+    return false;
+}
+
+AllocationCounter::Snapshot AllocationCounter::process() {
+    return Snapshot();
+}
+
+AllocationCounter::Snapshot AllocationCounter::thread() {
+    return Snapshot();
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <QtGlobal>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Heap allocation counters for benchmarks
+ *
+ * When built with ENABLE_ALLOCATION_COUNTING the global operator new is
+ * replaced by one that counts calls and bytes, process-wide and per thread.
+ * On glibc (ALLOCATION_COUNTING_HOOK_MALLOC, set by CMake's check) malloc,
+ * calloc and realloc are counted too, which is where Qt's containers allocate;
+ * elsewhere only operator new is. Without the flag nothing is replaced and every
+ * counter reads zero, so the calls can stay in place in normal builds.
+ */
+namespace AllocationCounter {
+
+struct Snapshot {
+    quint64 allocations = 0;
+    quint64 bytes = 0;
+};
+
+bool isEnabled();
+
+// Allocations made by every thread since startup
+Snapshot process();
+
+// Allocations made by the calling thread since it started
+Snapshot thread();
+
+} // namespace AllocationCounter
+
+} // namespace FRCDriverStation
+
+#endif // ALLOCATIONCOUNTER_H
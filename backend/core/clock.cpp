@@ -0,0 +1,196 @@
+#include "clock.h"
+#include <QCoreApplication>
+#include <QDateTime>
+
+namespace FRCDriverStation {
+
+Clock *Clock::system()
+{
+    static SystemClock clock;
+    return &clock;
+}
+
+QTimer &Clock::systemTimer(ClockTimer *timer)
+{
+    return timer->m_timer;
+}
+
+void Clock::fire(ClockTimer *timer)
+{
+    if (timer->m_singleShot) {
+        timer->m_active = false;
+    }
+    emit timer->timeout();
+}
+
+void Clock::release(ClockTimer *timer)
+{
+    timer->m_active = false;
+    timer->m_clock = system();
+}
+
+SystemClock::SystemClock()
+{
+    m_monotonic.start();
+}
+
+qint64 SystemClock::currentMSecsSinceEpoch() const
+{
+    return QDateTime::currentMSecsSinceEpoch();
+}
+
+void SystemClock::armTimer(ClockTimer *timer, int intervalMs)
+{
+    QTimer &qtimer = systemTimer(timer);
+    qtimer.setSingleShot(timer->isSingleShot());
+    qtimer.start(intervalMs);
+}
+
+void SystemClock::cancelTimer(ClockTimer *timer)
+{
+    systemTimer(timer).stop();
+}
+
+VirtualClock::VirtualClock(qint64 epochMs)
+    : m_nowNs(0)
+    , m_epochMs(epochMs)
+    , m_armed(0)
+{
+}
+
+VirtualClock::~VirtualClock()
+{
+    // Stopped and fired timers keep pointing here too, not just the armed ones
+    for (ClockTimer *timer : std::as_const(m_attached)) {
+        release(timer);
+    }
+}
+
+void VirtualClock::advance(qint64 ms)
+{
+    const qint64 targetNs = nowNs() + ms * NS_PER_MS;
+    while (!m_timers.empty() && m_timers.begin()->first.first <= targetNs) {
+        fireNext();
+    }
+    m_nowNs.store(targetNs, std::memory_order_relaxed);
+}
+
+bool VirtualClock::advanceToNextTimer()
+{
+    if (m_timers.empty()) {
+        return false;
+    }
+    const qint64 deadlineNs = m_timers.begin()->first.first;
+    while (!m_timers.empty() && m_timers.begin()->first.first == deadlineNs) {
+        fireNext();
+    }
+    return true;
+}
+
+void VirtualClock::armTimer(ClockTimer *timer, int intervalMs)
+{
+    cancelTimer(timer);
+    insert(timer, nowNs() + qMax(0, intervalMs) * NS_PER_MS);
+}
+
+void VirtualClock::cancelTimer(ClockTimer *timer)
+{
+    const auto it = m_keys.constFind(timer);
+    if (it != m_keys.constEnd()) {
+        m_timers.erase(it.value());
+        m_keys.erase(it);
+    }
+}
+
+void VirtualClock::attachTimer(ClockTimer *timer)
+{
+    m_attached.insert(timer);
+}
+
+void VirtualClock::detachTimer(ClockTimer *timer)
+{
+    cancelTimer(timer);
+    m_attached.remove(timer);
+}
+
+void VirtualClock::insert(ClockTimer *timer, qint64 deadlineNs)
+{
+    const Key key(deadlineNs, m_armed++);
+    m_timers.emplace(key, timer);
+    m_keys.insert(timer, key);
+}
+
+void VirtualClock::fireNext()
+{
+    const auto it = m_timers.begin();
+    const qint64 deadlineNs = it->first.first;
+    ClockTimer *timer = it->second;
+    m_timers.erase(it);
+    m_keys.remove(timer);
+    m_nowNs.store(deadlineNs, std::memory_order_relaxed);
+
+    // Re-armed before the handler runs, so a stop() or start() inside it wins
+    if (!timer->isSingleShot()) {
+        insert(timer, deadlineNs + qMax(1, timer->interval()) * NS_PER_MS);
+    }
+    fire(timer);
+
+    if (QCoreApplication::instance()) {
+        QCoreApplication::sendPostedEvents();
+    }
+}
+
+ClockTimer::ClockTimer(QObject *parent)
+    : QObject(parent)
+    , m_clock(Clock::system())
+    , m_interval(0)
+    , m_singleShot(false)
+    , m_active(false)
+{
+    connect(&m_timer, &QTimer::timeout, this, &ClockTimer::onSystemTimeout);
+}
+
+ClockTimer::~ClockTimer()
+{
+    stop();
+    m_clock->detachTimer(this);
+}
+
+void ClockTimer::setClock(Clock *clock)
+{
+    const bool wasActive = m_active;
+    stop();
+    m_clock->detachTimer(this);
+    m_clock = clock ? clock : Clock::system();
+    m_clock->attachTimer(this);
+    if (wasActive) {
+        start();
+    }
+}
+
+void ClockTimer::start()
+{
+    m_active = true;
+    m_clock->armTimer(this, m_interval);
+}
+
+void ClockTimer::start(int ms)
+{
+    m_interval = ms;
+    start();
+}
+
+void ClockTimer::stop()
+{
+    if (m_active) {
+        m_active = false;
+        m_clock->cancelTimer(this);
+    }
+}
+
+void ClockTimer::onSystemTimeout()
+{
+    Clock::fire(this);
+}
+
+} // namespace FRCDriverStation
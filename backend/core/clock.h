@@ -0,0 +1,174 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QSet>
+#include <QTimer>
+#include <atomic>
+#include <map>
+#include <utility>
+
+namespace FRCDriverStation {
+
+class ClockTimer;
+
+/**
+ * @brief Source of time and timers for time-based backend logic
+ *
+ * This class manages:
+ * - Monotonic time (for deadlines, timeouts and intervals) and wall-clock
+ *   time (for timestamps that leave the process)
+ * - Arming and cancelling the ClockTimers created on it
+ *
+ * Design principles:
+ * - Code that waits for something reads a Clock and uses ClockTimer instead
+ *   of QDateTime and QTimer, so it runs unchanged on system() in the app and
+ *   on a VirtualClock in benchmarks and tools
+ * - Injected with setClock() before the owner starts, like the other
+ *   set-once dependencies; system() is the default everywhere
+ * - nowNs() may be called from any thread
+ */
+class Clock
+{
+public:
+    static constexpr qint64 NS_PER_MS = 1000000;
+
+    virtual ~Clock() = default;
+
+    virtual qint64 nowNs() const = 0;
+    virtual qint64 currentMSecsSinceEpoch() const = 0;
+    qint64 nowMs() const { return nowNs() / NS_PER_MS; }
+
+    // The process-wide real clock
+    static Clock *system();
+
+protected:
+    friend class ClockTimer;
+
+    // Called by ClockTimer::start() and stop(); the clock fire()s the timer once the interval has passed
+    virtual void armTimer(ClockTimer *timer, int intervalMs) = 0;
+    virtual void cancelTimer(ClockTimer *timer) = 0;
+    // Called by ClockTimer::setClock() and its destructor, armed or not
+    virtual void attachTimer(ClockTimer *) {}
+    virtual void detachTimer(ClockTimer *) {}
+
+    // For subclasses, which cannot reach ClockTimer's privates themselves
+    static QTimer &systemTimer(ClockTimer *timer);
+    static void fire(ClockTimer *timer);
+    // Leaves the timer stopped on the system clock; for clocks that go away before their timers
+    static void release(ClockTimer *timer);
+};
+
+/**
+ * @brief The real monotonic clock; timers are Qt timers
+ */
+class SystemClock : public Clock
+{
+public:
+    SystemClock();
+
+    qint64 nowNs() const override { return m_monotonic.nsecsElapsed(); }
+    qint64 currentMSecsSinceEpoch() const override;
+
+protected:
+    void armTimer(ClockTimer *timer, int intervalMs) override;
+    void cancelTimer(ClockTimer *timer) override;
+
+private:
+    QElapsedTimer m_monotonic;
+};
+
+/**
+ * @brief A clock that only moves when told to
+ *
+ * advance() jumps straight from one timer deadline to the next and fires the
+ * timers in deadline order (creation order on ties), so a 150 s match with
+ * all its timeouts runs in however long its handlers take. Posted events are
+ * delivered after each timer, so queued connections behave as in real time.
+ * Timers must be armed and advanced from one thread. Timers still set to a
+ * VirtualClock when it is destroyed fall back to the system clock, stopped.
+ */
+class VirtualClock : public Clock
+{
+public:
+    explicit VirtualClock(qint64 epochMs = 0);
+    ~VirtualClock() override;
+
+    qint64 nowNs() const override { return m_nowNs.load(std::memory_order_relaxed); }
+    qint64 currentMSecsSinceEpoch() const override { return m_epochMs + nowMs(); }
+
+    // Moves time forward by ms, firing every timer that falls due on the way
+    void advance(qint64 ms);
+    // Moves to the next deadline and fires the timers due then; false if none is armed
+    bool advanceToNextTimer();
+    int pendingTimers() const { return int(m_timers.size()); }
+
+protected:
+    void armTimer(ClockTimer *timer, int intervalMs) override;
+    void cancelTimer(ClockTimer *timer) override;
+    void attachTimer(ClockTimer *timer) override;
+    void detachTimer(ClockTimer *timer) override;
+
+private:
+    void insert(ClockTimer *timer, qint64 deadlineNs);
+    void fireNext();
+
+    using Key = std::pair<qint64, quint64>;     // Deadline, then arming order
+    std::map<Key, ClockTimer *> m_timers;
+    QHash<ClockTimer *, Key> m_keys;
+    QSet<ClockTimer *> m_attached;              // Every timer set to this clock, armed or not
+    std::atomic<qint64> m_nowNs;
+    qint64 m_epochMs;
+    quint64 m_armed;
+};
+
+/**
+ * @brief QTimer look-alike that runs on a Clock
+ *
+ * The same calls as the QTimer subset the backend uses (interval, single
+ * shot, timer type, start, stop, timeout), so converting a QTimer member is
+ * a type change. On the system clock it is a QTimer.
+ */
+class ClockTimer : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ClockTimer(QObject *parent = nullptr);
+    ~ClockTimer();
+
+    // Re-arms an active timer on the new clock with its full interval
+    void setClock(Clock *clock);
+    Clock *clock() const { return m_clock; }
+
+    void setInterval(int ms) { m_interval = ms; }
+    int interval() const { return m_interval; }
+    void setSingleShot(bool singleShot) { m_singleShot = singleShot; }
+    bool isSingleShot() const { return m_singleShot; }
+    void setTimerType(Qt::TimerType type) { m_timer.setTimerType(type); }
+    bool isActive() const { return m_active; }
+
+    void start();
+    void start(int ms);
+    void stop();
+
+signals:
+    void timeout();
+
+private:
+    friend class Clock;
+
+    void onSystemTimeout();
+
+    Clock *m_clock;
+    QTimer m_timer;             // Only used on the system clock
+    int m_interval;
+    bool m_singleShot;
+    bool m_active;
+};
+
+} // namespace FRCDriverStation
+
+#endif // CLOCK_H
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <QString>
+#ifndef YADS_HEADLESS
 #include <QColor>
+#endif
 
 namespace Constants {
     // Application information
@@ -52,7 +54,8 @@ namespace Constants {
     constexpr int PRACTICE_MATCH_TELEOP_DURATION = 135;
     constexpr int PRACTICE_MATCH_TRANSITION_DURATION = 5;
     
-    // UI Colors
+#ifndef YADS_HEADLESS
+    // UI Colors (yads-daemon builds without Qt Gui)
     namespace Colors {
         const QColor ROBOT_CONNECTED = QColor("#4CAF50");      // Green
         const QColor ROBOT_DISCONNECTED = QColor("#F44336");   // Red
@@ -71,6 +74,7 @@ namespace Constants {
         const QColor SURFACE_DARK = QColor("#3C3C3C");
         const QColor SURFACE_LIGHT = QColor("#F5F5F5");
     }
+#endif
     
     // File paths
     namespace Paths {
@@ -129,5 +133,7 @@ namespace Constants {
         constexpr const char* BATTERY = "battery";
         constexpr const char* PRACTICE_MATCH = "practice.match";
         constexpr const char* GLOBAL_SHORTCUTS = "shortcuts";
+        constexpr const char* CONTROL_API = "control.api";
+        constexpr const char* EVENT_LOOP = "event.loop";
     }
 }
@@ -0,0 +1,182 @@
+#include "eventlogfiltermodel.h"
+#include "eventlogmodel.h"
+
+namespace FRCDriverStation {
+
+EventLogFilterModel::EventLogFilterModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_minimumLevel(0)
+{
+}
+
+void EventLogFilterModel::setSourceModel(EventLogModel *source)
+{
+    if (m_source == source) {
+        return;
+    }
+    if (m_source) {
+        disconnect(m_source, nullptr, this, nullptr);
+    }
+
+    m_source = source;
+    if (m_source) {
+        connect(m_source, &QAbstractItemModel::rowsInserted, this, &EventLogFilterModel::onRowsInserted);
+        connect(m_source, &QAbstractItemModel::rowsRemoved, this, &EventLogFilterModel::onRowsRemoved);
+        connect(m_source, &QAbstractItemModel::modelReset, this, &EventLogFilterModel::rebuild);
+    }
+    rebuild();
+    emit sourceModelChanged();
+}
+
+void EventLogFilterModel::setFilterText(const QString &text)
+{
+    if (text == m_filterText) {
+        return;
+    }
+
+    const QString lower = text.toLower();
+    const bool narrower = lower.contains(m_filterLower);
+    m_filterText = text;
+    m_filterLower = lower;
+    narrower ? narrow() : rebuild();
+    emit filterTextChanged();
+}
+
+void EventLogFilterModel::setCategory(const QString &category)
+{
+    if (category == m_category) {
+        return;
+    }
+
+    const bool narrower = m_category.isEmpty();
+    m_category = category;
+    narrower ? narrow() : rebuild();
+    emit categoryChanged();
+}
+
+void EventLogFilterModel::setMinimumLevel(int level)
+{
+    if (level == m_minimumLevel) {
+        return;
+    }
+
+    const bool narrower = level > m_minimumLevel;
+    m_minimumLevel = level;
+    narrower ? narrow() : rebuild();
+    emit minimumLevelChanged();
+}
+
+int EventLogFilterModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant EventLogFilterModel::data(const QModelIndex &index, int role) const
+{
+    if (!m_source || !index.isValid() || index.row() < 0 || index.row() >= count()) {
+        return QVariant();
+    }
+
+    const quint64 serial = m_serials[m_serials.size() - 1 - size_t(index.row())];
+    return m_source->data(m_source->index(int(serial - m_source->firstSerial())), role);
+}
+
+QHash<int, QByteArray> EventLogFilterModel::roleNames() const
+{
+    return m_source ? m_source->roleNames() : QHash<int, QByteArray>();
+}
+
+bool EventLogFilterModel::accepts(quint64 serial) const
+{
+    const EventLogModel::Entry &entry = m_source->entryAt(serial);
+    return entry.level >= m_minimumLevel
+        && (m_category.isEmpty() || entry.category == m_category)
+        && (m_filterLower.isEmpty() || entry.searchText.contains(m_filterLower));
+}
+
+void EventLogFilterModel::narrow()
+{
+    if (!m_source) {
+        return;
+    }
+
+    std::deque<quint64> matching;
+    for (quint64 serial : m_serials) {
+        if (accepts(serial)) {
+            matching.push_back(serial);
+        }
+    }
+    if (matching.size() == m_serials.size()) {
+        return;
+    }
+
+    beginResetModel();
+    m_serials.swap(matching);
+    endResetModel();
+    emit countChanged();
+}
+
+void EventLogFilterModel::rebuild()
+{
+    beginResetModel();
+    m_serials.clear();
+    if (m_source) {
+        for (quint64 serial = m_source->firstSerial(); serial < m_source->endSerial(); ++serial) {
+            if (accepts(serial)) {
+                m_serials.push_back(serial);
+            }
+        }
+    }
+    endResetModel();
+    emit countChanged();
+}
+
+void EventLogFilterModel::onRowsInserted(const QModelIndex &parent, int first, int last)
+{
+    if (parent.isValid()) {
+        return;
+    }
+
+    // The source only appends, so the new rows are the newest and go on top
+    std::deque<quint64> added;
+    const quint64 base = m_source->firstSerial();
+    for (int row = first; row <= last; ++row) {
+        if (accepts(base + quint64(row))) {
+            added.push_back(base + quint64(row));
+        }
+    }
+    if (added.empty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), 0, int(added.size()) - 1);
+    m_serials.insert(m_serials.end(), added.begin(), added.end());
+    endInsertRows();
+    emit countChanged();
+}
+
+void EventLogFilterModel::onRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+    Q_UNUSED(first);
+    Q_UNUSED(last);
+    if (parent.isValid()) {
+        return;
+    }
+
+    // The source only trims its oldest rows, which are our bottom rows
+    int dropped = 0;
+    const quint64 firstSerial = m_source->firstSerial();
+    while (size_t(dropped) < m_serials.size() && m_serials[size_t(dropped)] < firstSerial) {
+        ++dropped;
+    }
+    if (dropped == 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), count() - dropped, count() - 1);
+    m_serials.erase(m_serials.begin(), m_serials.begin() + dropped);
+    endRemoveRows();
+    emit countChanged();
+}
+
+} // namespace FRCDriverStation
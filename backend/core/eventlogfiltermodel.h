@@ -0,0 +1,89 @@
+#ifndef EVENTLOGFILTERMODEL_H
+#define EVENTLOGFILTERMODEL_H
+
+#include <QAbstractListModel>
+#include <QPointer>
+#include <QString>
+#include <deque>
+
+namespace FRCDriverStation {
+
+class EventLogModel;
+
+/**
+ * @brief Filtered, newest-first view of an EventLogModel
+ *
+ * This class manages:
+ * - Filtering by text (case-insensitive, over category and message), by
+ *   category and by minimum level
+ * - Presenting the matching entries newest first, as the event log shows them
+ *
+ * Design principles:
+ * - Incremental: new source rows are tested on their own and inserted at the
+ *   top; trimmed source rows drop off the bottom; nothing else is re-checked
+ * - A filter change that can only narrow the result (typing another
+ *   character, picking a category from "All", raising the level) re-tests
+ *   just the rows that currently match; only widening scans the whole source
+ * - Holds source serial numbers, which survive the source trimming its front
+ *   unchanged
+ */
+class EventLogFilterModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(FRCDriverStation::EventLogModel *sourceModel READ sourceModel WRITE setSourceModel NOTIFY sourceModelChanged)
+    Q_PROPERTY(QString filterText READ filterText WRITE setFilterText NOTIFY filterTextChanged)
+    // Empty matches every category
+    Q_PROPERTY(QString category READ category WRITE setCategory NOTIFY categoryChanged)
+    Q_PROPERTY(int minimumLevel READ minimumLevel WRITE setMinimumLevel NOTIFY minimumLevelChanged)
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+
+public:
+    explicit EventLogFilterModel(QObject *parent = nullptr);
+
+    EventLogModel *sourceModel() const { return m_source; }
+    void setSourceModel(EventLogModel *source);
+
+    QString filterText() const { return m_filterText; }
+    void setFilterText(const QString &text);
+    QString category() const { return m_category; }
+    void setCategory(const QString &category);
+    int minimumLevel() const { return m_minimumLevel; }
+    void setMinimumLevel(int level);
+
+    int count() const { return int(m_serials.size()); }
+
+    // QAbstractListModel; roles are the source model's
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+signals:
+    void sourceModelChanged();
+    void filterTextChanged();
+    void categoryChanged();
+    void minimumLevelChanged();
+    void countChanged();
+
+private:
+    bool accepts(quint64 serial) const;
+    // Re-tests only the rows that match now; for filters that got stricter
+    void narrow();
+    // Re-tests every source row
+    void rebuild();
+
+    void onRowsInserted(const QModelIndex &parent, int first, int last);
+    void onRowsRemoved(const QModelIndex &parent, int first, int last);
+
+    QPointer<EventLogModel> m_source;
+    // Matching source serials, oldest first; row r is m_serials[size - 1 - r]
+    std::deque<quint64> m_serials;
+    QString m_filterText;
+    QString m_filterLower;
+    QString m_category;
+    int m_minimumLevel;
+};
+
+} // namespace FRCDriverStation
+
+#endif // EVENTLOGFILTERMODEL_H
@@ -0,0 +1,192 @@
+#include "eventlogmodel.h"
+#include "logger.h"
+#include <QDateTime>
+#include <QFile>
+#include <QTextStream>
+#include <QTimer>
+
+namespace FRCDriverStation {
+
+EventLogModel::EventLogModel(QObject *parent)
+    : QAbstractListModel(parent)
+    , m_firstSerial(0)
+    , m_maxEntries(DEFAULT_MAX_ENTRIES)
+    , m_flushScheduled(false)
+{
+}
+
+void EventLogModel::attach(::Logger *logger)
+{
+    connect(logger, &::Logger::logMessage, this,
+            [this](qint64 timestampMs, ::Logger::LogLevel level, const QString &category, const QString &message) {
+        append(timestampMs, static_cast<int>(level), category, message);
+    }, Qt::DirectConnection);
+}
+
+void EventLogModel::append(qint64 timestampMs, int level, const QString &category, const QString &message)
+{
+    Entry entry{timestampMs, level, category, message, (category + ' ' + message).toLower()};
+
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending.append(std::move(entry));
+    if (m_flushScheduled) {
+        return;
+    }
+    m_flushScheduled = true;
+    locker.unlock();
+
+    // One flush per interval however many messages arrive, from whichever thread
+    QMetaObject::invokeMethod(this, [this]() {
+        QTimer::singleShot(FLUSH_INTERVAL_MS, this, &EventLogModel::flushPending);
+    }, Qt::QueuedConnection);
+}
+
+void EventLogModel::setMaxEntries(int maxEntries)
+{
+    maxEntries = qMax(maxEntries, 100);
+    if (maxEntries == m_maxEntries) {
+        return;
+    }
+    m_maxEntries = maxEntries;
+    if (count() > m_maxEntries) {
+        trim(m_maxEntries);
+    }
+    emit maxEntriesChanged();
+}
+
+QString EventLogModel::levelName(int level)
+{
+    static const char *const names[] = {"Debug", "Info", "Warning", "Critical", "Fatal"};
+    return level >= 0 && level < int(sizeof(names) / sizeof(names[0])) ? QString(names[level]) : QString();
+}
+
+int EventLogModel::rowCount(const QModelIndex &parent) const
+{
+    return parent.isValid() ? 0 : count();
+}
+
+QVariant EventLogModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || index.row() >= count()) {
+        return QVariant();
+    }
+
+    const Entry &entry = m_entries[size_t(index.row())];
+    switch (role) {
+    case TimestampRole:
+        return entry.timestampMs;
+    case TimeRole:
+        return QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("hh:mm:ss.zzz");
+    case LevelRole:
+        return entry.level;
+    case LevelNameRole:
+        return levelName(entry.level);
+    case CategoryRole:
+        return entry.category;
+    case Qt::DisplayRole:
+    case MessageRole:
+        return entry.message;
+    default:
+        return QVariant();
+    }
+}
+
+QHash<int, QByteArray> EventLogModel::roleNames() const
+{
+    return {
+        {TimestampRole, "timestamp"},
+        {TimeRole, "time"},
+        {LevelRole, "level"},
+        {LevelNameRole, "levelName"},
+        {CategoryRole, "category"},
+        {MessageRole, "message"}
+    };
+}
+
+void EventLogModel::clear()
+{
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        m_pending.clear();
+    }
+
+    beginResetModel();
+    m_firstSerial += m_entries.size();
+    m_entries.clear();
+    endResetModel();
+    emit countChanged();
+}
+
+bool EventLogModel::exportToFile(const QString &path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+
+    QTextStream stream(&file);
+    stream.setEncoding(QStringConverter::Utf8);
+    for (const Entry &entry : m_entries) {
+        stream << QDateTime::fromMSecsSinceEpoch(entry.timestampMs).toString("yyyy-MM-dd hh:mm:ss.zzz")
+               << " [" << levelName(entry.level).toUpper() << "] [" << entry.category << "] "
+               << entry.message << '\n';
+    }
+    stream.flush();
+    return stream.status() == QTextStream::Ok;
+}
+
+void EventLogModel::flushPending()
+{
+    QVector<Entry> batch;
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        batch.swap(m_pending);
+        m_flushScheduled = false;
+    }
+    if (batch.isEmpty()) {
+        return;
+    }
+
+    if (batch.size() >= m_maxEntries) {
+        // A burst bigger than the whole buffer replaces it; only its tail is kept
+        trim(0);
+        const int skipped = int(batch.size()) - m_maxEntries;
+        m_firstSerial += quint64(skipped);
+        batch.remove(0, skipped);
+    } else if (count() + batch.size() > m_maxEntries) {
+        trim(qMin(int(m_maxEntries * TRIM_FRACTION), m_maxEntries - int(batch.size())));
+    }
+
+    bool categoriesAdded = false;
+    beginInsertRows(QModelIndex(), count(), count() + int(batch.size()) - 1);
+    for (Entry &entry : batch) {
+        if (!m_categories.contains(entry.category)) {
+            m_categories.append(entry.category);
+            categoriesAdded = true;
+        }
+        m_entries.push_back(std::move(entry));
+    }
+    endInsertRows();
+
+    emit countChanged();
+    if (categoriesAdded) {
+        m_categories.sort(Qt::CaseInsensitive);
+        emit categoriesChanged();
+    }
+}
+
+void EventLogModel::trim(int keep)
+{
+    const int removed = count() - keep;
+    if (removed <= 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), 0, removed - 1);
+    m_entries.erase(m_entries.begin(), m_entries.begin() + removed);
+    m_firstSerial += quint64(removed);
+    endRemoveRows();
+    emit countChanged();
+}
+
+} // namespace FRCDriverStation
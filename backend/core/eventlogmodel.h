@@ -0,0 +1,115 @@
+#ifndef EVENTLOGMODEL_H
+#define EVENTLOGMODEL_H
+
+#include <QAbstractListModel>
+#include <QMutex>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <deque>
+
+class Logger;
+
+namespace FRCDriverStation {
+
+/**
+ * @brief In-memory event log fed by Logger::logMessage
+ *
+ * This class manages:
+ * - The most recent log messages, oldest first, with structured level and
+ *   category fields for views and filters
+ * - The list of categories seen so far, for category pickers
+ * - Export of the buffered entries as text
+ *
+ * Design principles:
+ * - append() is thread-safe and cheap: it queues the entry and the GUI thread
+ *   inserts everything queued in one batch, so a burst of debug logging is one
+ *   rowsInserted instead of thousands
+ * - Rows are only ever appended at the end or trimmed from the front, which
+ *   lets EventLogFilterModel update incrementally
+ * - Every entry has a serial number that never changes, so a filter can refer
+ *   to entries without re-mapping when the front is trimmed
+ * - The lowercased search text is built once per entry, not once per keystroke
+ */
+class EventLogModel : public QAbstractListModel
+{
+    Q_OBJECT
+
+    Q_PROPERTY(int count READ count NOTIFY countChanged)
+    Q_PROPERTY(QStringList categories READ categories NOTIFY categoriesChanged)
+    Q_PROPERTY(int maxEntries READ maxEntries WRITE setMaxEntries NOTIFY maxEntriesChanged)
+
+public:
+    enum Roles {
+        TimestampRole = Qt::UserRole + 1,
+        TimeRole,
+        LevelRole,
+        LevelNameRole,
+        CategoryRole,
+        MessageRole
+    };
+    Q_ENUM(Roles)
+
+    struct Entry {
+        qint64 timestampMs;
+        int level;
+        QString category;
+        QString message;
+        QString searchText;   // "category message", lowercased
+    };
+
+    static constexpr int DEFAULT_MAX_ENTRIES = 50000;
+    // When full, trim to this fraction so trimming is occasional, not per message
+    static constexpr double TRIM_FRACTION = 0.9;
+    static constexpr int FLUSH_INTERVAL_MS = 50;
+
+    explicit EventLogModel(QObject *parent = nullptr);
+
+    // Subscribes to logger->logMessage (direct connection; append() is thread-safe)
+    void attach(::Logger *logger);
+
+    // Callable from any thread; the row appears within FLUSH_INTERVAL_MS
+    void append(qint64 timestampMs, int level, const QString &category, const QString &message);
+
+    int count() const { return int(m_entries.size()); }
+    QStringList categories() const { return m_categories; }
+    int maxEntries() const { return m_maxEntries; }
+    void setMaxEntries(int maxEntries);
+
+    // Serials of the rows currently held: [firstSerial(), endSerial())
+    quint64 firstSerial() const { return m_firstSerial; }
+    quint64 endSerial() const { return m_firstSerial + m_entries.size(); }
+    const Entry &entryAt(quint64 serial) const { return m_entries[serial - m_firstSerial]; }
+
+    static QString levelName(int level);
+
+    // QAbstractListModel
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QHash<int, QByteArray> roleNames() const override;
+
+    Q_INVOKABLE void clear();
+    Q_INVOKABLE bool exportToFile(const QString &path) const;
+
+signals:
+    void countChanged();
+    void categoriesChanged();
+    void maxEntriesChanged();
+
+private:
+    void flushPending();
+    void trim(int keep);
+
+    std::deque<Entry> m_entries;
+    quint64 m_firstSerial;
+    int m_maxEntries;
+    QStringList m_categories;
+
+    QMutex m_pendingMutex;
+    QVector<Entry> m_pending;           // Guarded by m_pendingMutex
+    bool m_flushScheduled;              // Guarded by m_pendingMutex
+};
+
+} // namespace FRCDriverStation
+
+#endif // EVENTLOGMODEL_H
@@ -0,0 +1,278 @@
+#include "eventloopmonitor.h"
+#include "constants.h"
+#include "logger.h"
+#include <QVariantMap>
+#include <cerrno>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#define EVENT_LOOP_MONITOR_STACKS
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <cxxabi.h>
+#include <cstdlib>
+#endif
+
+namespace FRCDriverStation {
+
+#ifdef EVENT_LOOP_MONITOR_STACKS
+namespace {
+
+// Sent to the main thread to make it record its own stack
+constexpr int STACK_SIGNAL = SIGUSR2;
+constexpr int STACK_CAPTURE_TIMEOUT_MS = 100;
+// The handler itself and the kernel's signal trampoline
+constexpr int HANDLER_FRAMES = 2;
+
+pthread_t s_mainThread;
+void *s_stackFrames[EventLoopMonitor::MAX_STACK_FRAMES];
+std::atomic<int> s_stackFrameCount{0};
+std::atomic<bool> s_stackReady{false};
+
+void captureStackHandler(int)
+{
+    const int savedErrno = errno;
+    s_stackFrameCount.store(backtrace(s_stackFrames, EventLoopMonitor::MAX_STACK_FRAMES),
+                            std::memory_order_relaxed);
+    s_stackReady.store(true, std::memory_order_release);
+    errno = savedErrno;
+}
+
+// "binary(_ZN3Foo3barEv+0x1c) [0x...]" -> "binary(Foo::bar()+0x1c) [0x...]"
+QString demangleFrame(const char *symbol)
+{
+    QString frame = QString::fromLocal8Bit(symbol);
+    const int open = frame.indexOf('(');
+    const int plus = frame.indexOf('+', open);
+    if (open < 0 || plus <= open + 1) {
+        return frame;
+    }
+
+    const QByteArray mangled = frame.mid(open + 1, plus - open - 1).toLocal8Bit();
+    int status = 0;
+    char *demangled = abi::__cxa_demangle(mangled.constData(), nullptr, nullptr, &status);
+    if (status == 0 && demangled) {
+        frame.replace(open + 1, plus - open - 1, QString::fromLocal8Bit(demangled));
+    }
+    std::free(demangled);
+    return frame;
+}
+
+} // namespace
+#endif
+
+EventLoopMonitor::EventLoopMonitor(QObject *parent)
+    : QObject(parent)
+    , m_running(false)
+    , m_stallThresholdMs(DEFAULT_STALL_THRESHOLD_MS)
+    , m_heartbeatPending(false)
+    , m_heartbeatSentNs(0)
+    , m_stallReported(false)
+    , m_stallCount(0)
+    , m_lastStallMs(0.0)
+    , m_statisticsTimer(std::make_unique<QTimer>(this))
+{
+    m_clock.start();
+
+#ifdef EVENT_LOOP_MONITOR_STACKS
+    s_mainThread = pthread_self();
+
+    // backtrace() loads libgcc on first use, which is not safe inside a signal handler
+    void *warmUp[1];
+    backtrace(warmUp, 1);
+
+    struct sigaction action = {};
+    action.sa_handler = captureStackHandler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(STACK_SIGNAL, &action, nullptr);
+#endif
+
+    // The latency figures change continuously; refresh bindings at a readable rate
+    m_statisticsTimer->setInterval(STATISTICS_INTERVAL_MS);
+    connect(m_statisticsTimer.get(), &QTimer::timeout, this, &EventLoopMonitor::statisticsChanged);
+}
+
+EventLoopMonitor::~EventLoopMonitor()
+{
+    stop();
+}
+
+void EventLoopMonitor::start()
+{
+    if (m_running.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    m_heartbeatPending.store(false, std::memory_order_relaxed);
+    m_stallReported.store(false, std::memory_order_relaxed);
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("EventLoopMonitor");
+    m_thread->start(QThread::HighPriority);
+    m_statisticsTimer->start();
+}
+
+void EventLoopMonitor::stop()
+{
+    if (!m_running.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+
+    m_statisticsTimer->stop();
+    m_wake.release();
+    m_thread->wait();
+    m_thread.reset();
+}
+
+void EventLoopMonitor::setStallThresholdMs(int thresholdMs)
+{
+    // Below a few heartbeat intervals every busy frame would be reported
+    thresholdMs = qMax(thresholdMs, HEARTBEAT_INTERVAL_MS * 2);
+    if (m_stallThresholdMs.exchange(thresholdMs, std::memory_order_relaxed) != thresholdMs) {
+        emit stallThresholdMsChanged(thresholdMs);
+    }
+}
+
+QVariantList EventLoopMonitor::latencyBuckets() const
+{
+    QVariantList buckets;
+    for (int bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket) {
+        const quint64 count = m_latency.count(bucket);
+        if (count == 0) {
+            continue;
+        }
+
+        QString label;
+        if (bucket == LatencyHistogram::Buckets - 1) {
+            label = QString("> %1 ms").arg(LatencyHistogram::bucketLowerBound(bucket) / 1000);
+        } else {
+            const quint64 upperUs = LatencyHistogram::bucketUpperBound(bucket);
+            label = upperUs < 1000 ? QString("<= %1 us").arg(upperUs)
+                                   : QString("<= %1 ms").arg(upperUs / 1000.0, 0, 'f', 1);
+        }
+
+        QVariantMap entry;
+        entry["label"] = label;
+        entry["count"] = count;
+        buckets.append(entry);
+    }
+    return buckets;
+}
+
+void EventLoopMonitor::resetStatistics()
+{
+    m_latency.reset();
+    m_stallCount = 0;
+    m_lastStallMs = 0.0;
+    emit statisticsChanged();
+}
+
+bool EventLoopMonitor::canCaptureStacks()
+{
+#ifdef EVENT_LOOP_MONITOR_STACKS
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EventLoopMonitor::run()
+{
+    while (m_running.load(std::memory_order_acquire)) {
+        m_wake.tryAcquire(1, HEARTBEAT_INTERVAL_MS);
+        if (!m_running.load(std::memory_order_acquire)) {
+            break;
+        }
+
+        const qint64 nowNs = m_clock.nsecsElapsed();
+        if (!m_heartbeatPending.load(std::memory_order_acquire)) {
+            m_heartbeatSentNs.store(nowNs, std::memory_order_relaxed);
+            m_heartbeatPending.store(true, std::memory_order_release);
+            QMetaObject::invokeMethod(this, [this, nowNs]() { onHeartbeat(nowNs); }, Qt::QueuedConnection);
+            continue;
+        }
+
+        // Heartbeat still queued: the main thread is busy inside some handler
+        const qint64 stalledNs = nowNs - m_heartbeatSentNs.load(std::memory_order_relaxed);
+        if (stalledNs >= qint64(stallThresholdMs()) * 1000000
+            && !m_stallReported.exchange(true, std::memory_order_acq_rel)) {
+            reportStall(stalledNs);
+        }
+    }
+}
+
+void EventLoopMonitor::onHeartbeat(qint64 sentNs)
+{
+    const qint64 latencyNs = m_clock.nsecsElapsed() - sentNs;
+    m_latency.record(quint64(latencyNs / 1000));
+
+    const bool stackLogged = m_stallReported.exchange(false, std::memory_order_acq_rel);
+    m_heartbeatPending.store(false, std::memory_order_release);
+
+    if (latencyNs < qint64(stallThresholdMs()) * 1000000) {
+        return;
+    }
+
+    ++m_stallCount;
+    m_lastStallMs = latencyNs / 1000000.0;
+    YADS_LOG_WARNING(::Constants::LogCategories::EVENT_LOOP,
+                     QString("Main event loop resumed after a %1 ms stall%2")
+                     .arg(m_lastStallMs, 0, 'f', 1)
+                     .arg(stackLogged ? QString()
+                          : QString(" (ended before the watchdog captured a stack)")));
+    emit stallEnded(qint64(m_lastStallMs));
+    emit statisticsChanged();
+}
+
+void EventLoopMonitor::reportStall(qint64 stalledNs)
+{
+    // Logged from this thread on purpose: the main thread may never come back
+    if (!canCaptureStacks()) {
+        YADS_LOG_WARNING(::Constants::LogCategories::EVENT_LOOP,
+                         QString("Main event loop stalled for %1 ms (stack capture is not supported on this platform)")
+                         .arg(stalledNs / 1000000));
+        return;
+    }
+
+    const QStringList stack = captureMainThreadStack();
+    YADS_LOG_WARNING(::Constants::LogCategories::EVENT_LOOP,
+                     QString("Main event loop stalled for %1 ms, main thread stack:\n    %2")
+                     .arg(stalledNs / 1000000).arg(stack.join("\n    ")));
+}
+
+QStringList EventLoopMonitor::captureMainThreadStack()
+{
+    QStringList frames;
+#ifdef EVENT_LOOP_MONITOR_STACKS
+    s_stackReady.store(false, std::memory_order_relaxed);
+    if (pthread_kill(s_mainThread, STACK_SIGNAL) != 0) {
+        frames.append("<could not signal the main thread>");
+        return frames;
+    }
+
+    QElapsedTimer wait;
+    wait.start();
+    while (!s_stackReady.load(std::memory_order_acquire)) {
+        if (wait.elapsed() > STACK_CAPTURE_TIMEOUT_MS) {
+            frames.append("<main thread did not answer the stack capture signal>");
+            return frames;
+        }
+        QThread::msleep(1);
+    }
+
+    const int count = s_stackFrameCount.load(std::memory_order_relaxed);
+    char **symbols = backtrace_symbols(s_stackFrames, count);
+    if (!symbols) {
+        frames.append("<backtrace_symbols failed>");
+        return frames;
+    }
+    for (int i = HANDLER_FRAMES; i < count; ++i) {
+        frames.append(demangleFrame(symbols[i]));
+    }
+    std::free(symbols);
+#endif
+    return frames;
+}
+
+} // namespace FRCDriverStation
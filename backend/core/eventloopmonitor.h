@@ -0,0 +1,113 @@
+#ifndef EVENTLOOPMONITOR_H
+#define EVENTLOOPMONITOR_H
+
+#include <QObject>
+#include <QThread>
+#include <QSemaphore>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <QTimer>
+#include <QVariantList>
+#include <atomic>
+#include <memory>
+#include "histogram.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Watchdog for the GUI thread's event loop
+ *
+ * This class manages:
+ * - A watchdog thread that posts a heartbeat to the main event loop every
+ *   HEARTBEAT_INTERVAL_MS and measures how long it waits to be dispatched
+ * - A histogram of that dispatch latency, shown in the Diagnostics view
+ * - Stall detection: once a heartbeat is overdue by the stall threshold, the
+ *   main thread's stack is captured (Linux/glibc: signal + backtrace()) and logged
+ *
+ * Design principles:
+ * - Construct on the main thread; that is the thread being watched
+ * - Only one heartbeat is in flight, so a blocked loop is never flooded
+ * - Stalls are logged from the watchdog thread, while the main thread is still
+ *   stuck, so a hang that never returns still leaves a trace in the log
+ * - The signal handler only calls backtrace() into a static buffer; symbolizing
+ *   and logging happen on the watchdog thread
+ */
+class EventLoopMonitor : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(double p50LatencyMs READ p50LatencyMs NOTIFY statisticsChanged)
+    Q_PROPERTY(double p99LatencyMs READ p99LatencyMs NOTIFY statisticsChanged)
+    Q_PROPERTY(double maxLatencyMs READ maxLatencyMs NOTIFY statisticsChanged)
+    Q_PROPERTY(int stallCount READ stallCount NOTIFY statisticsChanged)
+    Q_PROPERTY(double lastStallMs READ lastStallMs NOTIFY statisticsChanged)
+    Q_PROPERTY(int stallThresholdMs READ stallThresholdMs WRITE setStallThresholdMs NOTIFY stallThresholdMsChanged)
+
+public:
+    // Microseconds; 24 buckets reach ~8 s
+    using LatencyHistogram = Log2Histogram<24>;
+
+    static constexpr int HEARTBEAT_INTERVAL_MS = 20;
+    static constexpr int DEFAULT_STALL_THRESHOLD_MS = 250;
+    static constexpr int STATISTICS_INTERVAL_MS = 1000;
+    static constexpr int MAX_STACK_FRAMES = 64;
+
+    explicit EventLoopMonitor(QObject *parent = nullptr);
+    ~EventLoopMonitor();
+
+    void start();
+    void stop();
+    bool isRunning() const { return m_running.load(std::memory_order_acquire); }
+
+    int stallThresholdMs() const { return m_stallThresholdMs.load(std::memory_order_relaxed); }
+    void setStallThresholdMs(int thresholdMs);
+
+    // Property getters
+    double p50LatencyMs() const { return m_latency.percentile(0.50) / 1000.0; }
+    double p99LatencyMs() const { return m_latency.percentile(0.99) / 1000.0; }
+    double maxLatencyMs() const { return m_latency.maxValue() / 1000.0; }
+    int stallCount() const { return m_stallCount; }
+    double lastStallMs() const { return m_lastStallMs; }
+
+    const LatencyHistogram &latencyHistogram() const { return m_latency; }
+
+    // Non-empty buckets as {label, count} maps for the Diagnostics view
+    Q_INVOKABLE QVariantList latencyBuckets() const;
+    Q_INVOKABLE void resetStatistics();
+
+    // Whether stalls come with a stack trace on this platform
+    static bool canCaptureStacks();
+
+signals:
+    // Emitted on the main thread once the loop runs again
+    void stallEnded(qint64 durationMs);
+    void statisticsChanged();
+    void stallThresholdMsChanged(int thresholdMs);
+
+private:
+    void run();
+    void onHeartbeat(qint64 sentNs);
+    void reportStall(qint64 stalledNs);
+    QStringList captureMainThreadStack();
+
+    std::unique_ptr<QThread> m_thread;
+    QSemaphore m_wake;
+    std::atomic<bool> m_running;
+    std::atomic<int> m_stallThresholdMs;
+
+    // Heartbeat state, shared by both threads; times are nanoseconds on m_clock
+    QElapsedTimer m_clock;
+    std::atomic<bool> m_heartbeatPending;
+    std::atomic<qint64> m_heartbeatSentNs;
+    std::atomic<bool> m_stallReported;
+
+    // Main thread only
+    LatencyHistogram m_latency;
+    int m_stallCount;
+    double m_lastStallMs;
+    std::unique_ptr<QTimer> m_statisticsTimer;
+};
+
+} // namespace FRCDriverStation
+
+#endif // EVENTLOOPMONITOR_H
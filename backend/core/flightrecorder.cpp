@@ -0,0 +1,504 @@
+#include "flightrecorder.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QStandardPaths>
+#include <QTextStream>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#ifdef Q_OS_UNIX
+#include <signal.h>
+#endif
+
+namespace FRCDriverStation {
+
+namespace {
+
+constexpr char MAGIC[8] = {'Y', 'A', 'D', 'S', 'F', 'L', 'T', '1'};
+constexpr quint32 VERSION = 1;
+constexpr int CATEGORY_CAPACITY = 24;
+constexpr int PACKET_HEX_BYTES = 32;
+
+enum RingState : quint32 {
+    Running = 1,
+    Closed = 2,
+    Crashed = 3
+};
+
+qint64 monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+template <typename T>
+void storeRelease(T *field, T value) {
+    reinterpret_cast<std::atomic<T> *>(field)->store(value, std::memory_order_release);
+}
+
+template <typename T>
+T loadAcquire(const T *field) {
+    return reinterpret_cast<const std::atomic<T> *>(field)->load(std::memory_order_acquire);
+}
+
+// Allocation-free UTF-8 encoding that stops at the last whole character that fits
+int encodeUtf8(const QString &text, char *out, int capacity) {
+    int written = 0;
+    const QChar *chars = text.constData();
+    const int length = text.size();
+    for (int i = 0; i < length; ++i) {
+        char32_t code = chars[i].unicode();
+        if (QChar::isHighSurrogate(code) && i + 1 < length && chars[i + 1].isLowSurrogate()) {
+            code = QChar::surrogateToUcs4(char16_t(code), chars[i + 1].unicode());
+            ++i;
+        } else if (QChar::isSurrogate(code)) {
+            code = 0xFFFD;
+        }
+
+        const int bytes = code < 0x80 ? 1 : code < 0x800 ? 2 : code < 0x10000 ? 3 : 4;
+        if (written + bytes > capacity) {
+            break;
+        }
+        switch (bytes) {
+        case 1:
+            out[written++] = char(code);
+            break;
+        case 2:
+            out[written++] = char(0xC0 | (code >> 6));
+            out[written++] = char(0x80 | (code & 0x3F));
+            break;
+        case 3:
+            out[written++] = char(0xE0 | (code >> 12));
+            out[written++] = char(0x80 | ((code >> 6) & 0x3F));
+            out[written++] = char(0x80 | (code & 0x3F));
+            break;
+        default:
+            out[written++] = char(0xF0 | (code >> 18));
+            out[written++] = char(0x80 | ((code >> 12) & 0x3F));
+            out[written++] = char(0x80 | ((code >> 6) & 0x3F));
+            out[written++] = char(0x80 | (code & 0x3F));
+            break;
+        }
+    }
+    return written;
+}
+
+// Set while a ring is mapped; the crash handler only marks the header
+std::atomic<quint32 *> s_crashState{nullptr};
+std::atomic<qint32 *> s_crashSignal{nullptr};
+
+#ifdef Q_OS_UNIX
+void crashSignalHandler(int signal) {
+    qint32 *crashSignal = s_crashSignal.load(std::memory_order_acquire);
+    quint32 *state = s_crashState.load(std::memory_order_acquire);
+    if (crashSignal && state) {
+        storeRelease(crashSignal, qint32(signal));
+        storeRelease(state, quint32(Crashed));
+    }
+    // SA_RESETHAND restored the default action; re-raise so the process still dies of this signal
+    raise(signal);
+}
+#endif
+
+} // namespace
+
+struct FlightRecorder::FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 slotSize;
+    quint64 slotCount;
+    quint64 head;                  // Slots claimed so far, i.e. the next event's sequence number
+    qint64 createdMsSinceEpoch;
+    qint64 createdMonotonicNs;
+    qint64 pid;
+    quint32 state;                 // RingState
+    qint32 crashSignal;
+    char reserved[SLOT_SIZE - 64];
+};
+
+struct FlightRecorder::Slot {
+    quint64 sequence;              // Claim number + 1, written last; 0 while being written
+    qint64 timestampNs;
+    quint8 kind;                   // EventKind
+    quint8 level;
+    quint8 categoryLength;
+    quint8 reserved0;
+    quint16 length;                // Bytes used in data
+    quint16 reserved1;
+    quint32 originalSize;          // Packets: full datagram size, data holds the start of it
+    quint32 reserved2;
+    char category[CATEGORY_CAPACITY];
+    char data[SLOT_SIZE - 56];
+};
+
+FlightRecorder::FlightRecorder(QObject *parent)
+    : QObject(parent)
+    , m_base(nullptr)
+    , m_header(nullptr)
+    , m_slots(nullptr)
+    , m_writers(0)
+    , m_slotCount(0)
+    , m_snapshotSeconds(DEFAULT_SNAPSHOT_SECONDS)
+    , m_lastSnapshotMs(0)
+{
+    static_assert(sizeof(FileHeader) == SLOT_SIZE, "FileHeader must fill exactly one slot");
+    static_assert(sizeof(Slot) == SLOT_SIZE, "Slot layout changed");
+}
+
+FlightRecorder::~FlightRecorder()
+{
+    stop();
+}
+
+QString FlightRecorder::defaultDirectory()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/flightrecorder";
+}
+
+bool FlightRecorder::start(const QString &directory, quint64 ringBytes)
+{
+    if (isRecording()) {
+        return true;
+    }
+
+    m_directory = directory.isEmpty() ? defaultDirectory() : directory;
+    if (!QDir().mkpath(m_directory)) {
+        emit recorderError(QString("Cannot create %1").arg(m_directory));
+        return false;
+    }
+
+    // A second instance must not reset the ring the first one is writing
+    m_lockFile = std::make_unique<QLockFile>(QDir(m_directory).filePath("flightrecorder.lock"));
+    if (!m_lockFile->tryLock(0)) {
+        emit recorderError("Flight recorder ring is in use by another instance");
+        m_lockFile.reset();
+        return false;
+    }
+
+    m_file.setFileName(QDir(m_directory).filePath("flightrecorder.ring"));
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        emit recorderError(QString("Cannot open %1: %2").arg(m_file.fileName(), m_file.errorString()));
+        m_lockFile.reset();
+        return false;
+    }
+
+    if (m_file.size() >= qint64(sizeof(FileHeader))) {
+        recoverPreviousRun();
+    }
+
+    m_slotCount = qMax<quint64>(ringBytes / SLOT_SIZE, 1024);
+    const qint64 fileSize = qint64(sizeof(FileHeader) + m_slotCount * SLOT_SIZE);
+    if (!m_file.resize(fileSize) || !(m_base = m_file.map(0, fileSize))) {
+        emit recorderError(QString("Cannot map %1: %2").arg(m_file.fileName(), m_file.errorString()));
+        m_file.close();
+        m_lockFile.reset();
+        return false;
+    }
+
+    // Old slots would pass validation in this run, so start from a clean ring
+    std::memset(m_base, 0, size_t(fileSize));
+    m_header = reinterpret_cast<FileHeader *>(m_base);
+    std::memcpy(m_header->magic, MAGIC, sizeof(MAGIC));
+    m_header->version = VERSION;
+    m_header->slotSize = SLOT_SIZE;
+    m_header->slotCount = m_slotCount;
+    m_header->createdMsSinceEpoch = QDateTime::currentMSecsSinceEpoch();
+    m_header->createdMonotonicNs = monotonicNs();
+    m_header->pid = QCoreApplication::applicationPid();
+    storeRelease(&m_header->state, quint32(Running));
+
+    s_crashSignal.store(&m_header->crashSignal, std::memory_order_release);
+    s_crashState.store(&m_header->state, std::memory_order_release);
+    m_slots.store(reinterpret_cast<Slot *>(m_base + sizeof(FileHeader)), std::memory_order_release);
+
+    pruneSnapshots();
+    return true;
+}
+
+void FlightRecorder::stop()
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    if (m_snapshotThread) {
+        m_snapshotThread->wait();
+        m_snapshotThread.reset();
+    }
+
+    // seq_cst on both sides: with acquire/release the slots store and the writers load
+    // may reorder, so stop() could see no writers while record() still sees the ring
+    m_slots.store(nullptr, std::memory_order_seq_cst);
+    while (m_writers.load(std::memory_order_seq_cst) != 0) {
+        QThread::yieldCurrentThread();
+    }
+
+    s_crashState.store(nullptr, std::memory_order_release);
+    s_crashSignal.store(nullptr, std::memory_order_release);
+    storeRelease(&m_header->state, quint32(Closed));
+
+    m_file.unmap(m_base);
+    m_file.close();
+    m_base = nullptr;
+    m_header = nullptr;
+    m_lockFile.reset();
+}
+
+void FlightRecorder::installCrashHandler()
+{
+#ifdef Q_OS_UNIX
+    struct sigaction action = {};
+    action.sa_handler = crashSignalHandler;
+    action.sa_flags = SA_RESETHAND;
+    sigemptyset(&action.sa_mask);
+    for (int signal : {SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT}) {
+        sigaction(signal, &action, nullptr);
+    }
+#endif
+}
+
+void FlightRecorder::recordMessage(int level, const QString &category, const QString &message)
+{
+    char categoryText[CATEGORY_CAPACITY];
+    const int categoryLength = qMin(category.size(), CATEGORY_CAPACITY);
+    for (int i = 0; i < categoryLength; ++i) {
+        categoryText[i] = category.at(i).toLatin1();
+    }
+    record(Message, level, categoryText, categoryLength, &message, nullptr, 0);
+}
+
+void FlightRecorder::recordPacket(const char *channel, const char *data, int size)
+{
+    record(Packet, 0, channel, int(qstrnlen(channel, CATEGORY_CAPACITY)), nullptr, data, size);
+}
+
+void FlightRecorder::record(EventKind kind, int level, const char *category, int categoryLength,
+                            const QString *text, const char *data, int dataLength)
+{
+    // Pairs with stop(): either stop() sees this writer or this load sees nullptr
+    m_writers.fetch_add(1, std::memory_order_seq_cst);
+    Slot *slots = m_slots.load(std::memory_order_seq_cst);
+    if (!slots) {
+        m_writers.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+
+    const quint64 sequence = reinterpret_cast<std::atomic<quint64> *>(&m_header->head)
+        ->fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = slots[sequence % m_slotCount];
+
+    // Invalidate first so a reader never pairs the old sequence with new contents
+    reinterpret_cast<std::atomic<quint64> *>(&slot.sequence)->store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.timestampNs = monotonicNs();
+    slot.kind = kind;
+    slot.level = quint8(level);
+    slot.categoryLength = quint8(qMin(categoryLength, CATEGORY_CAPACITY));
+    std::memcpy(slot.category, category, slot.categoryLength);
+    if (text) {
+        slot.length = quint16(encodeUtf8(*text, slot.data, int(sizeof(slot.data))));
+        slot.originalSize = quint32(slot.length);
+    } else {
+        slot.length = quint16(qBound(0, dataLength, int(sizeof(slot.data))));
+        slot.originalSize = quint32(qMax(0, dataLength));
+        std::memcpy(slot.data, data, slot.length);
+    }
+
+    storeRelease(&slot.sequence, sequence + 1);
+    m_writers.fetch_sub(1, std::memory_order_release);
+}
+
+void FlightRecorder::trigger(const QString &reason)
+{
+    if (!isRecording()) {
+        return;
+    }
+
+    // The marker shows up in this snapshot or, when coalesced, in the next one
+    const QString marker = QString("Snapshot trigger: %1").arg(reason);
+    record(Marker, 0, "flightrecorder", 14, &marker, nullptr, 0);
+
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+    if ((m_snapshotThread && m_snapshotThread->isRunning())
+        || now - m_lastSnapshotMs < MIN_SNAPSHOT_INTERVAL_MS) {
+        return;
+    }
+    m_lastSnapshotMs = now;
+    startSnapshot(reason);
+}
+
+void FlightRecorder::startSnapshot(const QString &reason)
+{
+    if (m_snapshotThread) {
+        m_snapshotThread->wait();
+    }
+
+    // The worker reads the live mapping; stop() waits for it before unmapping
+    const uchar *base = m_base;
+    const qint64 windowNs = qint64(m_snapshotSeconds) * 1000000000LL;
+    const QString path = snapshotPath(reason);
+    m_snapshotThread.reset(QThread::create([this, base, windowNs, reason, path]() {
+        QString error;
+        const int events = writeSnapshot(base, windowNs, reason, path, &error);
+        if (events < 0) {
+            emit recorderError(QString("Cannot write flight recorder snapshot %1: %2").arg(path, error));
+        } else {
+            emit snapshotWritten(reason, path, events);
+        }
+    }));
+    m_snapshotThread->setObjectName("FlightRecorderSnapshot");
+    m_snapshotThread->start(QThread::LowPriority);
+    pruneSnapshots();
+}
+
+bool FlightRecorder::recoverPreviousRun()
+{
+    const qint64 size = m_file.size();
+    uchar *base = m_file.map(0, size);
+    if (!base) {
+        return false;
+    }
+
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(base);
+    const bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+        && header->version == VERSION
+        && header->slotSize == quint32(SLOT_SIZE)
+        && qint64(sizeof(FileHeader) + header->slotCount * SLOT_SIZE) <= size;
+
+    bool recovered = false;
+    if (valid && header->state != Closed) {
+        const QString reason = header->state == Crashed
+            ? QString("crash-signal-%1").arg(header->crashSignal)
+            : QString("unclean-exit");
+        const QString path = snapshotPath(reason);
+        QString error;
+        const int events = writeSnapshot(base, qint64(m_snapshotSeconds) * 1000000000LL, reason, path, &error);
+        if (events < 0) {
+            emit recorderError(QString("Cannot write flight recorder snapshot %1: %2").arg(path, error));
+        } else {
+            emit snapshotWritten(reason, path, events);
+            recovered = true;
+        }
+    }
+
+    m_file.unmap(base);
+    return recovered;
+}
+
+int FlightRecorder::writeSnapshot(const uchar *base, qint64 windowNs, const QString &reason,
+                                  const QString &path, QString *errorString)
+{
+    const FileHeader *header = reinterpret_cast<const FileHeader *>(base);
+    const Slot *slots = reinterpret_cast<const Slot *>(base + sizeof(FileHeader));
+    const quint64 slotCount = header->slotCount;
+
+    // Per-slot seqlock read: keep a copy only if the sequence was stable around it
+    std::vector<Slot> events;
+    events.reserve(size_t(qMin<quint64>(loadAcquire(&header->head), slotCount)));
+    for (quint64 index = 0; index < slotCount; ++index) {
+        const quint64 before = loadAcquire(&slots[index].sequence);
+        if (before == 0 || (before - 1) % slotCount != index) {
+            continue;
+        }
+        Slot copy;
+        std::memcpy(&copy, &slots[index], sizeof(Slot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (loadAcquire(&slots[index].sequence) == before) {
+            copy.sequence = before;
+            events.push_back(copy);
+        }
+    }
+
+    std::sort(events.begin(), events.end(), [](const Slot &a, const Slot &b) {
+        return a.sequence < b.sequence;
+    });
+    const qint64 newestNs = events.empty() ? 0 : std::max_element(events.begin(), events.end(),
+        [](const Slot &a, const Slot &b) { return a.timestampNs < b.timestampNs; })->timestampNs;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return -1;
+    }
+
+    static const char *const levelNames[] = {"DEBUG", "INFO", "WARNING", "CRITICAL", "FATAL"};
+    QTextStream out(&file);
+    out.setEncoding(QStringConverter::Utf8);
+    out << "# YADS flight recorder snapshot\n"
+        << "# Reason: " << reason << "\n"
+        << "# Written: " << QDateTime::currentDateTime().toString(Qt::ISODateWithMs) << "\n"
+        << "# Recorded by pid " << header->pid << ", last " << windowNs / 1000000000LL << " s\n";
+    if (header->state == Crashed) {
+        out << "# Process crashed with signal " << header->crashSignal << "\n";
+    }
+
+    int written = 0;
+    for (const Slot &event : events) {
+        if (event.timestampNs < newestNs - windowNs) {
+            continue;
+        }
+
+        const qint64 wallMs = header->createdMsSinceEpoch
+            + (event.timestampNs - header->createdMonotonicNs) / 1000000;
+        const QString category = QString::fromLatin1(event.category, event.categoryLength);
+        out << QDateTime::fromMSecsSinceEpoch(wallMs).toString("hh:mm:ss.zzz") << ' ';
+
+        switch (event.kind) {
+        case Message:
+            out << (event.level < 5 ? levelNames[event.level] : "?") << " [" << category << "] "
+                << QString::fromUtf8(event.data, event.length);
+            break;
+        case Packet:
+            out << "PACKET [" << category << "] " << event.originalSize << " bytes: "
+                << QByteArray::fromRawData(event.data, qMin<int>(event.length, PACKET_HEX_BYTES)).toHex(' ');
+            if (event.originalSize > quint32(PACKET_HEX_BYTES)) {
+                out << " ...";
+            }
+            break;
+        case Marker:
+            out << "MARK [" << category << "] " << QString::fromUtf8(event.data, event.length);
+            break;
+        default:
+            continue;
+        }
+        out << '\n';
+        ++written;
+    }
+
+    out.flush();
+    if (file.error() != QFileDevice::NoError) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return -1;
+    }
+    return written;
+}
+
+QString FlightRecorder::snapshotPath(const QString &reason) const
+{
+    QString label = reason;
+    for (QChar &c : label) {
+        if (!c.isLetterOrNumber() && c != '-') {
+            c = '-';
+        }
+    }
+    return QDir(m_directory).filePath(QString("flight-%1-%2.log")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss-zzz"), label.left(40)));
+}
+
+void FlightRecorder::pruneSnapshots()
+{
+    QDir dir(m_directory);
+    const QFileInfoList snapshots = dir.entryInfoList({"flight-*.log"}, QDir::Files, QDir::Time);
+    for (int i = MAX_SNAPSHOT_FILES; i < snapshots.size(); ++i) {
+        QFile::remove(snapshots.at(i).absoluteFilePath());
+    }
+}
+
+} // namespace FRCDriverStation
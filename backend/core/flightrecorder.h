@@ -0,0 +1,113 @@
+#ifndef FLIGHTRECORDER_H
+#define FLIGHTRECORDER_H
+
+#include <QObject>
+#include <QFile>
+#include <QLockFile>
+#include <QByteArray>
+#include <QString>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Crash-safe ring of recent high-rate debug events
+ *
+ * This class manages:
+ * - A fixed-size, memory-mapped ring file of fixed-size slots holding log
+ *   messages (at every level, including debug) and packet summaries
+ * - Snapshots of the last few seconds of the ring to a text file when
+ *   something goes wrong: e-stop, connection loss, brownout or a crash
+ * - Recovery on startup: a ring left behind by a run that crashed or was
+ *   killed is written out as a snapshot before it is reused
+ *
+ * Design principles:
+ * - Recording is one atomic add, a few stores and a short copy into the
+ *   mapping; no locks, system calls or allocations
+ * - A slot is committed by writing its sequence number last, so a slot torn
+ *   by a crash or by a concurrent overwrite is recognised and skipped
+ * - The mapping is shared with the file, so the kernel keeps the data even
+ *   when the process dies; nothing has to run at crash time
+ * - Snapshots copy the ring on the caller's thread (a memcpy) and format and
+ *   write it on a worker thread
+ */
+class FlightRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum EventKind : quint8 {
+        Message = 1,
+        Packet = 2,
+        Marker = 3
+    };
+
+    static constexpr int SLOT_SIZE = 256;
+    static constexpr quint64 DEFAULT_RING_BYTES = 16ULL * 1024 * 1024;   // ~65k events
+    static constexpr int DEFAULT_SNAPSHOT_SECONDS = 30;
+    static constexpr int MIN_SNAPSHOT_INTERVAL_MS = 2000;
+    static constexpr int MAX_SNAPSHOT_FILES = 50;
+
+    explicit FlightRecorder(QObject *parent = nullptr);
+    ~FlightRecorder();
+
+    bool start(const QString &directory = QString(), quint64 ringBytes = DEFAULT_RING_BYTES);
+    void stop();
+    bool isRecording() const { return m_slots.load(std::memory_order_acquire) != nullptr; }
+
+    // Marks the ring on SIGSEGV/SIGBUS/SIGFPE/SIGILL/SIGABRT (Unix); call after start()
+    void installCrashHandler();
+
+    // Hot path; callable from any thread. level is a Logger::LogLevel value.
+    void recordMessage(int level, const QString &category, const QString &message);
+    void recordPacket(const char *channel, const char *data, int size);
+    void recordPacket(const char *channel, const QByteArray &data) {
+        recordPacket(channel, data.constData(), data.size());
+    }
+
+    int snapshotSeconds() const { return m_snapshotSeconds; }
+    void setSnapshotSeconds(int seconds) { m_snapshotSeconds = qMax(1, seconds); }
+
+    QString directory() const { return m_directory; }
+    static QString defaultDirectory();
+
+public slots:
+    // Writes the last snapshotSeconds() of events; reason ends up in the file name
+    void trigger(const QString &reason);
+
+signals:
+    // Emitted from the snapshot worker thread
+    void snapshotWritten(const QString &reason, const QString &path, int events);
+    void recorderError(const QString &error);
+
+private:
+    struct FileHeader;
+    struct Slot;
+
+    void record(EventKind kind, int level, const char *category, int categoryLength,
+                const QString *text, const char *data, int dataLength);
+    bool recoverPreviousRun();
+    void startSnapshot(const QString &reason);
+    static int writeSnapshot(const uchar *base, qint64 windowNs, const QString &reason,
+                             const QString &path, QString *errorString);
+    QString snapshotPath(const QString &reason) const;
+    void pruneSnapshots();
+
+    std::unique_ptr<QLockFile> m_lockFile;
+    QFile m_file;
+    uchar *m_base;
+    FileHeader *m_header;
+    std::atomic<Slot *> m_slots;
+    std::atomic<int> m_writers;
+    quint64 m_slotCount;
+    QString m_directory;
+    int m_snapshotSeconds;
+    qint64 m_lastSnapshotMs;
+    std::unique_ptr<QThread> m_snapshotThread;
+};
+
+} // namespace FRCDriverStation
+
+#endif // FLIGHTRECORDER_H
@@ -0,0 +1,117 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <QtGlobal>
+#include <QtAlgorithms>
+#include <QString>
+#include <array>
+#include <atomic>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Fixed-size power-of-two histogram
+ *
+ * Bucket 0 counts zero values and bucket i (i > 0) counts values in
+ * [2^(i-1), 2^i - 1]; the last bucket absorbs everything larger. Recording
+ * is a couple of relaxed atomic operations and never allocates, so a
+ * producer on any thread can share one histogram with a reader on the GUI
+ * thread. Percentiles are reported as the upper bound of the bucket they
+ * fall in, which is exact enough for "is this 2 ms or 200 ms" questions.
+ */
+template <int BucketCount = 32>
+class Log2Histogram
+{
+    static_assert(BucketCount > 1 && BucketCount <= 64, "Log2Histogram supports 2..64 buckets");
+
+public:
+    static constexpr int Buckets = BucketCount;
+
+    void record(quint64 value) {
+        m_counts[bucketFor(value)].fetch_add(1, std::memory_order_relaxed);
+
+        quint64 previous = m_max.load(std::memory_order_relaxed);
+        while (value > previous
+               && !m_max.compare_exchange_weak(previous, value, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset() {
+        for (auto &count : m_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    quint64 count(int bucket) const {
+        return (bucket >= 0 && bucket < BucketCount)
+            ? m_counts[bucket].load(std::memory_order_relaxed) : 0;
+    }
+
+    quint64 totalCount() const {
+        quint64 total = 0;
+        for (const auto &count : m_counts) {
+            total += count.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    quint64 maxValue() const {
+        return m_max.load(std::memory_order_relaxed);
+    }
+
+    /// Upper bound of the bucket containing the given fraction (0.0 - 1.0) of samples
+    quint64 percentile(double fraction) const {
+        const quint64 total = totalCount();
+        if (total == 0) {
+            return 0;
+        }
+
+        const quint64 target = qMax<quint64>(1, static_cast<quint64>(fraction * total + 0.5));
+        quint64 cumulative = 0;
+        for (int bucket = 0; bucket < BucketCount; ++bucket) {
+            cumulative += count(bucket);
+            if (cumulative >= target) {
+                return qMin(bucketUpperBound(bucket), maxValue());
+            }
+        }
+        return maxValue();
+    }
+
+    static quint64 bucketLowerBound(int bucket) {
+        return bucket <= 0 ? 0 : (quint64(1) << (bucket - 1));
+    }
+
+    static quint64 bucketUpperBound(int bucket) {
+        if (bucket <= 0) {
+            return 0;
+        }
+        if (bucket >= BucketCount - 1 || bucket >= 64) {
+            return ~quint64(0);
+        }
+        return (quint64(1) << bucket) - 1;
+    }
+
+    /// One-line summary for logs, e.g. "n=120 p50<=15 p99<=255 max=310 us"
+    QString summary(const QString &unit) const {
+        return QString("n=%1 p50<=%2 p99<=%3 max=%4 %5")
+            .arg(totalCount())
+            .arg(percentile(0.50))
+            .arg(percentile(0.99))
+            .arg(maxValue())
+            .arg(unit);
+    }
+
+private:
+    static int bucketFor(quint64 value) {
+        const int bucket = value == 0 ? 0 : 64 - qCountLeadingZeroBits(value);
+        return qMin(bucket, BucketCount - 1);
+    }
+
+    std::array<std::atomic<quint64>, BucketCount> m_counts{};
+    std::atomic<quint64> m_max{0};
+};
+
+} // namespace FRCDriverStation
+
+#endif // HISTOGRAM_H
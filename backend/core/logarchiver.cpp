@@ -0,0 +1,347 @@
+#include "logarchiver.h"
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <algorithm>
+#include <zlib.h>
+
+namespace FRCDriverStation {
+
+namespace {
+
+// zlib window bits for a gzip wrapper instead of a raw zlib stream
+constexpr int GZIP_WINDOW_BITS = 15 + 16;
+const QStringList LOG_FILE_PATTERNS = {"yads_*.log", "yads_*.log.gz"};
+
+} // namespace
+
+LogArchiver::LogArchiver(QObject *parent)
+    : QObject(parent)
+    , m_running(false)
+    , m_diskBudget(DEFAULT_DISK_BUDGET)
+{
+}
+
+LogArchiver::~LogArchiver()
+{
+    stop();
+}
+
+void LogArchiver::start(const QString &directory, const QString &activeFile)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_running) {
+        return;
+    }
+
+    m_directory = directory;
+    m_activeFile = activeFile;
+    m_running = true;
+
+    // Oldest first, so an interrupted backlog is worked through in order
+    const QDir dir(directory);
+    const QStringList leftovers = dir.entryList({"yads_*.log"}, QDir::Files, QDir::Name);
+    for (const QString &name : leftovers) {
+        const QString path = dir.absoluteFilePath(name);
+        if (path != activeFile && !m_queue.contains(path)) {
+            m_queue.enqueue(path);
+        }
+    }
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("LogArchiver");
+    m_thread->start(QThread::LowPriority);
+}
+
+void LogArchiver::stop()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!m_running) {
+            return;
+        }
+        m_running = false;
+        m_wake.wakeAll();
+    }
+
+    m_thread->wait();
+    m_thread.reset();
+}
+
+void LogArchiver::setActiveFile(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    m_activeFile = path;
+}
+
+void LogArchiver::enqueue(const QString &path)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_queue.contains(path)) {
+        m_queue.enqueue(path);
+        m_wake.wakeOne();
+    }
+}
+
+void LogArchiver::setDiskBudget(qint64 bytes)
+{
+    m_diskBudget.store(qMax<qint64>(bytes, 0), std::memory_order_relaxed);
+}
+
+QStringList LogArchiver::logFiles(const QString &directory)
+{
+    // Names embed the creation time, so name order is age order even after
+    // compression has touched the files
+    QStringList files = QDir(directory).entryList(LOG_FILE_PATTERNS, QDir::Files, QDir::Name);
+    std::reverse(files.begin(), files.end());
+    return files;
+}
+
+bool LogArchiver::compressFile(const QString &source, const QString &destination, QString *errorString)
+{
+    QFile input(source);
+    if (!input.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = QString("Cannot open %1: %2").arg(source, input.errorString());
+        }
+        return false;
+    }
+
+    // Written under a temporary name and renamed on commit
+    QSaveFile output(destination);
+    if (!output.open(QIODevice::WriteOnly)) {
+        if (errorString) {
+            *errorString = QString("Cannot create %1: %2").arg(destination, output.errorString());
+        }
+        return false;
+    }
+
+    z_stream stream = {};
+    if (deflateInit2(&stream, COMPRESSION_LEVEL, Z_DEFLATED, GZIP_WINDOW_BITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        if (errorString) {
+            *errorString = "zlib deflateInit2 failed";
+        }
+        return false;
+    }
+
+    QByteArray chunk(CHUNK_SIZE, Qt::Uninitialized);
+    QByteArray buffer(CHUNK_SIZE, Qt::Uninitialized);
+    QString error;
+    int flush = Z_NO_FLUSH;
+    do {
+        // A short read is fine, but no data before the end of the file means the
+        // source failed or shrank under us; looping on it would never finish
+        const qint64 length = input.read(chunk.data(), chunk.size());
+        if (length < 0 || (length == 0 && !input.atEnd())) {
+            error = QString("Cannot read %1: %2").arg(source, input.errorString());
+            break;
+        }
+        flush = input.atEnd() ? Z_FINISH : Z_NO_FLUSH;
+        stream.next_in = reinterpret_cast<Bytef *>(chunk.data());
+        stream.avail_in = uInt(length);
+
+        do {
+            stream.next_out = reinterpret_cast<Bytef *>(buffer.data());
+            stream.avail_out = uInt(buffer.size());
+            if (deflate(&stream, flush) == Z_STREAM_ERROR) {
+                error = QString("zlib deflate failed on %1").arg(source);
+                break;
+            }
+            const qint64 produced = buffer.size() - qint64(stream.avail_out);
+            if (produced > 0 && output.write(buffer.constData(), produced) != produced) {
+                error = QString("Cannot write %1: %2").arg(destination, output.errorString());
+                break;
+            }
+        } while (stream.avail_out == 0);
+    } while (error.isEmpty() && flush != Z_FINISH);
+    deflateEnd(&stream);
+
+    if (error.isEmpty() && !output.commit()) {
+        error = QString("Cannot write %1: %2").arg(destination, output.errorString());
+    }
+    if (!error.isEmpty()) {
+        // Drops the partial temporary file; the .gz only appears on a successful commit
+        output.cancelWriting();
+        if (errorString) {
+            *errorString = error;
+        }
+        return false;
+    }
+
+    // Keep the original timestamp for anyone sorting the directory by date
+    QFile archive(destination);
+    if (archive.open(QIODevice::Append)) {
+        archive.setFileTime(QFileInfo(source).lastModified(), QFileDevice::FileModificationTime);
+    }
+    return true;
+}
+
+QStringList LogArchiver::readLines(const QString &path, int maxLines, QString *errorString)
+{
+    QStringList lines;
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        if (errorString) {
+            *errorString = QString("Cannot open %1: %2").arg(path, file.errorString());
+        }
+        return lines;
+    }
+
+    // Splits complete lines out of pending, keeping at most maxLines of them
+    QByteArray pending;
+    auto takeLines = [&]() {
+        int start = 0;
+        for (int newline = pending.indexOf('\n'); newline >= 0; newline = pending.indexOf('\n', start)) {
+            int end = newline;
+            if (end > start && pending.at(end - 1) == '\r') {
+                --end;
+            }
+            lines.append(QString::fromUtf8(pending.constData() + start, end - start));
+            if (maxLines > 0 && lines.size() > maxLines) {
+                lines.removeFirst();
+            }
+            start = newline + 1;
+        }
+        pending.remove(0, start);
+    };
+
+    if (!path.endsWith(".gz")) {
+        while (!file.atEnd()) {
+            pending.append(file.read(CHUNK_SIZE));
+            takeLines();
+        }
+    } else {
+        z_stream stream = {};
+        if (inflateInit2(&stream, GZIP_WINDOW_BITS) != Z_OK) {
+            if (errorString) {
+                *errorString = "zlib inflateInit2 failed";
+            }
+            return lines;
+        }
+
+        QByteArray input;
+        QByteArray buffer(CHUNK_SIZE, Qt::Uninitialized);
+        int result = Z_OK;
+        while (result != Z_STREAM_END) {
+            if (stream.avail_in == 0) {
+                input = file.read(CHUNK_SIZE);
+                if (input.isEmpty()) {
+                    // Cut short; return what decoded so far
+                    if (errorString) {
+                        *errorString = QString("%1 is truncated").arg(path);
+                    }
+                    break;
+                }
+                stream.next_in = reinterpret_cast<Bytef *>(input.data());
+                stream.avail_in = uInt(input.size());
+            }
+
+            stream.next_out = reinterpret_cast<Bytef *>(buffer.data());
+            stream.avail_out = uInt(buffer.size());
+            result = inflate(&stream, Z_NO_FLUSH);
+            if (result != Z_OK && result != Z_STREAM_END) {
+                if (errorString) {
+                    *errorString = QString("%1 is corrupt: %2")
+                        .arg(path, QString::fromLatin1(stream.msg ? stream.msg : "inflate failed"));
+                }
+                break;
+            }
+            pending.append(buffer.constData(), buffer.size() - int(stream.avail_out));
+            takeLines();
+        }
+        inflateEnd(&stream);
+    }
+
+    if (!pending.isEmpty()) {
+        pending.append('\n');
+        takeLines();
+    }
+    return lines;
+}
+
+void LogArchiver::run()
+{
+    enforceDiskBudget();
+
+    for (;;) {
+        QString path;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (m_running && m_queue.isEmpty()) {
+                m_wake.wait(&m_mutex);
+            }
+            if (!m_running) {
+                return;
+            }
+            // Stays queued while it is being compressed so retention leaves it alone
+            path = m_queue.head();
+        }
+
+        archive(path);
+
+        {
+            QMutexLocker locker(&m_mutex);
+            m_queue.removeOne(path);
+        }
+        enforceDiskBudget();
+    }
+}
+
+void LogArchiver::archive(const QString &path)
+{
+    if (!QFile::exists(path)) {
+        return;
+    }
+
+    const QString destination = path + ".gz";
+    const qint64 originalBytes = QFileInfo(path).size();
+    QString error;
+    if (!compressFile(path, destination, &error)) {
+        emit archiveError(error);
+        return;
+    }
+    if (!QFile::remove(path)) {
+        emit archiveError(QString("Compressed %1 but could not remove the original").arg(path));
+    }
+    emit fileArchived(destination, originalBytes, QFileInfo(destination).size());
+}
+
+void LogArchiver::enforceDiskBudget()
+{
+    const qint64 budget = diskBudget();
+    if (budget <= 0) {
+        return;
+    }
+
+    QString activeFile;
+    QStringList busy;
+    {
+        QMutexLocker locker(&m_mutex);
+        activeFile = m_activeFile;
+        busy = m_queue;
+    }
+
+    // Oldest first
+    const QFileInfoList files = QDir(m_directory).entryInfoList(LOG_FILE_PATTERNS, QDir::Files, QDir::Name);
+    qint64 total = 0;
+    for (const QFileInfo &info : files) {
+        total += info.size();
+    }
+
+    for (const QFileInfo &info : files) {
+        if (total <= budget) {
+            break;
+        }
+        const QString path = info.absoluteFilePath();
+        if (path == activeFile || busy.contains(path)) {
+            continue;
+        }
+        if (QFile::remove(path)) {
+            total -= info.size();
+            emit fileRemoved(path);
+        }
+    }
+}
+
+} // namespace FRCDriverStation
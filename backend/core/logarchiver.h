@@ -0,0 +1,90 @@
+#ifndef LOGARCHIVER_H
+#define LOGARCHIVER_H
+
+#include <QObject>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QString>
+#include <QStringList>
+#include <QThread>
+#include <atomic>
+#include <memory>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Background compression and retention for rotated log files
+ *
+ * This class manages:
+ * - A worker thread that gzips closed log files (yads_*.log -> yads_*.log.gz)
+ *   and removes the originals
+ * - Retention by total disk usage: after each file, the oldest logs are
+ *   removed until the directory fits the disk budget
+ * - Transparent reading of plain and compressed logs for the log viewer
+ *
+ * Design principles:
+ * - The logging thread only queues a path; compression never runs under the
+ *   logger's mutex
+ * - A file is compressed to a temporary name and renamed into place, so a
+ *   crash mid-compression never loses the original
+ * - Plain logs left over from a previous run (crash, or the file that was
+ *   active at exit) are picked up when the archiver starts
+ * - Reading streams through the decompressor and keeps only the requested
+ *   tail, so a large archive never has to fit in memory
+ */
+class LogArchiver : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 DEFAULT_DISK_BUDGET = 256LL * 1024 * 1024;
+    static constexpr int COMPRESSION_LEVEL = 6;
+    static constexpr int CHUNK_SIZE = 64 * 1024;
+
+    explicit LogArchiver(QObject *parent = nullptr);
+    ~LogArchiver();
+
+    // Queues the leftover plain logs in directory, except activeFile
+    void start(const QString &directory, const QString &activeFile);
+    // Finishes the file in progress; anything still queued is picked up next start
+    void stop();
+
+    // The file being written; never compressed or removed
+    void setActiveFile(const QString &path);
+    void enqueue(const QString &path);
+
+    qint64 diskBudget() const { return m_diskBudget.load(std::memory_order_relaxed); }
+    void setDiskBudget(qint64 bytes);
+
+    // yads_*.log and yads_*.log.gz in directory, newest first
+    static QStringList logFiles(const QString &directory);
+    static bool compressFile(const QString &source, const QString &destination,
+                             QString *errorString = nullptr);
+    // Last maxLines lines (all if maxLines <= 0); .gz files are decompressed on the fly
+    static QStringList readLines(const QString &path, int maxLines, QString *errorString = nullptr);
+
+signals:
+    // Emitted from the worker thread
+    void fileArchived(const QString &archive, qint64 originalBytes, qint64 compressedBytes);
+    void fileRemoved(const QString &path);
+    void archiveError(const QString &error);
+
+private:
+    void run();
+    void archive(const QString &path);
+    void enforceDiskBudget();
+
+    QMutex m_mutex;
+    QWaitCondition m_wake;
+    QQueue<QString> m_queue;            // Guarded by m_mutex
+    QString m_directory;
+    QString m_activeFile;               // Guarded by m_mutex
+    bool m_running;                     // Guarded by m_mutex
+    std::atomic<qint64> m_diskBudget;
+    std::unique_ptr<QThread> m_thread;
+};
+
+} // namespace FRCDriverStation
+
+#endif // LOGARCHIVER_H
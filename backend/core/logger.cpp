@@ -1,5 +1,8 @@
 #include "logger.h"
 #include "constants.h"
+#include "tracing.h"
+#include "flightrecorder.h"
+#include "logarchiver.h"
 
 #include <QCoreApplication>
 #include <QStandardPaths>
@@ -23,13 +26,23 @@ Logger& Logger::instance()
 
 Logger::Logger(QObject *parent)
     : QObject(parent)
-    , m_logLevel(LogLevel::Info)
+    , m_logLevel(static_cast<int>(LogLevel::Info))
+    , m_lowestLevel(static_cast<int>(LogLevel::Info))
+    , m_flightRecorder(std::make_unique<FRCDriverStation::FlightRecorder>())
+    , m_flightRecorderLevel(static_cast<int>(LogLevel::Debug))
+    , m_captureLevel(CAPTURE_OFF)
     , m_fileLoggingEnabled(true)
     , m_consoleLoggingEnabled(true)
-    , m_maxLogFiles(10)
     , m_maxLogFileSize(10 * 1024 * 1024) // 10 MB
-    , m_rotationTimer(new QTimer(this))
+    , m_currentFileBytes(0)
+    , m_archiver(std::make_unique<FRCDriverStation::LogArchiver>())
 {
+    for (auto &level : m_categoryLevels) {
+        level.store(INHERIT_LEVEL, std::memory_order_relaxed);
+    }
+    m_categoryNames.append("general");
+    m_categoryIds.insert("general", GENERAL_CATEGORY);
+    
     // Set up log directory
     QString appDataDir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     m_logDirectory = QDir(appDataDir).absoluteFilePath(Constants::Paths::LOGS_DIR);
@@ -37,9 +50,20 @@ Logger::Logger(QObject *parent)
     // Create log directory if it doesn't exist
     QDir().mkpath(m_logDirectory);
     
-    // Set up log rotation timer (check every hour)
-    m_rotationTimer->setInterval(60 * 60 * 1000);
-    connect(m_rotationTimer, &QTimer::timeout, this, &Logger::rotateLogFiles);
+    // Reported from the archiver thread; queued back to this one
+    connect(m_archiver.get(), &FRCDriverStation::LogArchiver::fileArchived, this,
+            [this](const QString& archive, qint64 originalBytes, qint64 compressedBytes) {
+        debug(QString("Compressed %1 (%2 KB -> %3 KB)").arg(QFileInfo(archive).fileName())
+              .arg(originalBytes / 1024).arg(compressedBytes / 1024), "logger");
+    });
+    connect(m_archiver.get(), &FRCDriverStation::LogArchiver::fileRemoved, this,
+            [this](const QString& path) {
+        info(QString("Removed old log file to stay within the disk budget: %1").arg(QFileInfo(path).fileName()), "logger");
+    });
+    connect(m_archiver.get(), &FRCDriverStation::LogArchiver::archiveError, this,
+            [this](const QString& error) {
+        warning(error, "logger");
+    });
 }
 
 Logger::~Logger()
@@ -49,29 +73,21 @@ Logger::~Logger()
 
 void Logger::initialize()
 {
-    QMutexLocker locker(&m_logMutex);
-    
-    // Install custom message handler
-    qInstallMessageHandler(&Logger::messageHandler);
-    
-    // Create initial log file
-    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss");
-    QString logFileName = QString("yads_%1.log").arg(timestamp);
-    QString logFilePath = QDir(m_logDirectory).absoluteFilePath(logFileName);
-    
-    m_currentLogFile = std::make_unique<QFile>(logFilePath);
-    if (m_currentLogFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
-        m_logStream = std::make_unique<QTextStream>(m_currentLogFile.get());
-        m_logStream->setEncoding(QStringConverter::Utf8);
-    } else {
-        qWarning() << "Failed to open log file:" << logFilePath;
-        m_fileLoggingEnabled = false;
+    {
+        QMutexLocker locker(&m_logMutex);
+        
+        // Install custom message handler
+        qInstallMessageHandler(&Logger::messageHandler);
+        
+        if (!openLogFileLocked()) {
+            m_fileLoggingEnabled = false;
+        }
+        
+        // Compresses whatever earlier runs left uncompressed
+        m_archiver->start(m_logDirectory, m_currentLogFile ? m_currentLogFile->fileName() : QString());
     }
     
-    // Start rotation timer
-    m_rotationTimer->start();
-    
-    // Log initialization
+    // Log initialization; info() takes m_logMutex itself
     info("Logger initialized", "logger");
     info(QString("Log directory: %1").arg(m_logDirectory), "logger");
     info(QString("File logging: %1").arg(m_fileLoggingEnabled ? "enabled" : "disabled"), "logger");
@@ -80,11 +96,12 @@ void Logger::initialize()
 
 void Logger::shutdown()
 {
-    QMutexLocker locker(&m_logMutex);
-    
     info("Logger shutting down", "logger");
     
-    m_rotationTimer->stop();
+    // The file in progress is left for the next run's archiver
+    m_archiver->stop();
+    
+    QMutexLocker locker(&m_logMutex);
     
     if (m_logStream) {
         m_logStream->flush();
@@ -102,7 +119,8 @@ void Logger::shutdown()
 
 void Logger::setLogLevel(LogLevel level)
 {
-    m_logLevel = level;
+    m_logLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    updateLowestLevel();
     info(QString("Log level set to: %1").arg(static_cast<int>(level)), "logger");
 }
 
@@ -118,93 +136,239 @@ void Logger::setConsoleLoggingEnabled(bool enabled)
     info(QString("Console logging %1").arg(enabled ? "enabled" : "disabled"), "logger");
 }
 
-void Logger::setMaxLogFiles(int maxFiles)
-{
-    m_maxLogFiles = maxFiles;
-    info(QString("Max log files set to: %1").arg(maxFiles), "logger");
-}
-
 void Logger::setMaxLogFileSize(qint64 maxSize)
 {
     m_maxLogFileSize = maxSize;
     info(QString("Max log file size set to: %1 bytes").arg(maxSize), "logger");
 }
 
-void Logger::debug(const QString& message, const QString& category)
+void Logger::setLogDiskBudget(qint64 bytes)
 {
-    if (m_logLevel <= LogLevel::Debug) {
-        QString formattedMessage = formatMessage(LogLevel::Debug, category, message);
-        
-        if (m_fileLoggingEnabled) {
-            writeToFile(formattedMessage);
+    m_archiver->setDiskBudget(bytes);
+    info(QString("Log disk budget set to: %1 bytes").arg(bytes), "logger");
+}
+
+Logger::CategoryId Logger::categoryId(const QString& category)
+{
+    {
+        QReadLocker locker(&m_categoryLock);
+        const auto it = m_categoryIds.constFind(category);
+        if (it != m_categoryIds.constEnd()) {
+            return it.value();
         }
-        
-        if (m_consoleLoggingEnabled) {
-            writeToConsole(formattedMessage);
+    }
+    
+    QWriteLocker locker(&m_categoryLock);
+    const auto it = m_categoryIds.constFind(category);
+    if (it != m_categoryIds.constEnd()) {
+        return it.value();
+    }
+    if (m_categoryNames.size() >= MAX_CATEGORIES) {
+        // Categories are a small fixed set in practice; anything past the table shares "general"
+        return GENERAL_CATEGORY;
+    }
+    
+    const CategoryId id = m_categoryNames.size();
+    m_categoryNames.append(category);
+    m_categoryIds.insert(category, id);
+    return id;
+}
+
+QString Logger::categoryName(CategoryId id) const
+{
+    QReadLocker locker(&m_categoryLock);
+    return m_categoryNames.value(id, "general");
+}
+
+void Logger::setCategoryLogLevel(const QString& category, LogLevel level)
+{
+    m_categoryLevels[categoryId(category)].store(static_cast<int>(level), std::memory_order_relaxed);
+    updateLowestLevel();
+    info(QString("Log level for %1 set to: %2").arg(category).arg(static_cast<int>(level)), "logger");
+}
+
+void Logger::resetCategoryLogLevel(const QString& category)
+{
+    m_categoryLevels[categoryId(category)].store(INHERIT_LEVEL, std::memory_order_relaxed);
+    updateLowestLevel();
+    info(QString("Log level for %1 follows the global level").arg(category), "logger");
+}
+
+void Logger::updateLowestLevel()
+{
+    int lowest = m_logLevel.load(std::memory_order_relaxed);
+    for (const auto &level : m_categoryLevels) {
+        const int threshold = level.load(std::memory_order_relaxed);
+        if (threshold != INHERIT_LEVEL) {
+            lowest = qMin(lowest, threshold);
         }
-        
-        emit logMessage(QDateTime::currentDateTime().toString(Qt::ISODate), 
-                       "DEBUG", category, message);
     }
+    m_lowestLevel.store(lowest, std::memory_order_relaxed);
 }
 
-void Logger::info(const QString& message, const QString& category)
+bool Logger::parseLogLevel(const QString& name, LogLevel& level)
 {
-    if (m_logLevel <= LogLevel::Info) {
-        QString formattedMessage = formatMessage(LogLevel::Info, category, message);
-        
-        if (m_fileLoggingEnabled) {
-            writeToFile(formattedMessage);
+    const QString lower = name.trimmed().toLower();
+    if (lower == "debug") {
+        level = LogLevel::Debug;
+    } else if (lower == "info") {
+        level = LogLevel::Info;
+    } else if (lower == "warning" || lower == "warn") {
+        level = LogLevel::Warning;
+    } else if (lower == "critical") {
+        level = LogLevel::Critical;
+    } else if (lower == "fatal") {
+        level = LogLevel::Fatal;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+bool Logger::applyLogLevelSpec(const QString& spec, QString* errorString)
+{
+    // Validate everything first so a typo does not leave half the spec applied
+    QList<QPair<QString, LogLevel>> categoryLevels;
+    bool hasGlobal = false;
+    LogLevel globalLevel = LogLevel::Info;
+    
+    for (const QString& entry : spec.split(',', Qt::SkipEmptyParts)) {
+        const int equals = entry.indexOf('=');
+        LogLevel level;
+        if (!parseLogLevel(equals < 0 ? entry : entry.mid(equals + 1), level)) {
+            if (errorString) {
+                *errorString = QString("Unknown log level in \"%1\"").arg(entry.trimmed());
+            }
+            return false;
         }
         
-        if (m_consoleLoggingEnabled) {
-            writeToConsole(formattedMessage);
+        if (equals < 0) {
+            hasGlobal = true;
+            globalLevel = level;
+        } else {
+            const QString category = entry.left(equals).trimmed();
+            if (category.isEmpty()) {
+                if (errorString) {
+                    *errorString = QString("Missing category in \"%1\"").arg(entry.trimmed());
+                }
+                return false;
+            }
+            categoryLevels.append(qMakePair(category, level));
         }
-        
-        emit logMessage(QDateTime::currentDateTime().toString(Qt::ISODate), 
-                       "INFO", category, message);
+    }
+    
+    if (hasGlobal) {
+        setLogLevel(globalLevel);
+    }
+    for (const auto& categoryLevel : categoryLevels) {
+        setCategoryLogLevel(categoryLevel.first, categoryLevel.second);
+    }
+    return true;
+}
+
+bool Logger::startFlightRecorder(const QString& directory)
+{
+    connect(m_flightRecorder.get(), &FRCDriverStation::FlightRecorder::snapshotWritten, this,
+            [this](const QString& reason, const QString& path, int events) {
+        warning(QString("Flight recorder snapshot (%1): %2 events written to %3").arg(reason).arg(events).arg(path),
+                "flightrecorder");
+    }, Qt::UniqueConnection);
+    connect(m_flightRecorder.get(), &FRCDriverStation::FlightRecorder::recorderError, this,
+            [this](const QString& error) {
+        warning(error, "flightrecorder");
+    }, Qt::UniqueConnection);
+    
+    if (!m_flightRecorder->start(directory)) {
+        return false;
+    }
+    m_flightRecorder->installCrashHandler();
+    m_captureLevel.store(m_flightRecorderLevel.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    info(QString("Flight recorder active in %1").arg(m_flightRecorder->directory()), "logger");
+    return true;
+}
+
+void Logger::stopFlightRecorder()
+{
+    m_captureLevel.store(CAPTURE_OFF, std::memory_order_relaxed);
+    m_flightRecorder->stop();
+}
+
+void Logger::setFlightRecorderLevel(LogLevel level)
+{
+    m_flightRecorderLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    if (m_flightRecorder->isRecording()) {
+        m_captureLevel.store(static_cast<int>(level), std::memory_order_relaxed);
+    }
+}
+
+void Logger::log(LogLevel level, CategoryId id, const QString& message)
+{
+    dispatch(level, id, categoryName(id), message);
+}
+
+void Logger::debug(const QString& message, const QString& category)
+{
+    if (!mayLog(LogLevel::Debug)) {
+        return;
+    }
+    const CategoryId id = categoryId(category);
+    if (shouldLog(id, LogLevel::Debug)) {
+        dispatch(LogLevel::Debug, id, category, message);
+    }
+}
+
+void Logger::info(const QString& message, const QString& category)
+{
+    if (!mayLog(LogLevel::Info)) {
+        return;
+    }
+    const CategoryId id = categoryId(category);
+    if (shouldLog(id, LogLevel::Info)) {
+        dispatch(LogLevel::Info, id, category, message);
     }
 }
 
 void Logger::warning(const QString& message, const QString& category)
 {
-    if (m_logLevel <= LogLevel::Warning) {
-        QString formattedMessage = formatMessage(LogLevel::Warning, category, message);
-        
-        if (m_fileLoggingEnabled) {
-            writeToFile(formattedMessage);
-        }
-        
-        if (m_consoleLoggingEnabled) {
-            writeToConsole(formattedMessage);
-        }
-        
-        emit logMessage(QDateTime::currentDateTime().toString(Qt::ISODate), 
-                       "WARNING", category, message);
+    if (!mayLog(LogLevel::Warning)) {
+        return;
+    }
+    const CategoryId id = categoryId(category);
+    if (shouldLog(id, LogLevel::Warning)) {
+        dispatch(LogLevel::Warning, id, category, message);
     }
 }
 
 void Logger::critical(const QString& message, const QString& category)
 {
-    if (m_logLevel <= LogLevel::Critical) {
-        QString formattedMessage = formatMessage(LogLevel::Critical, category, message);
-        
-        if (m_fileLoggingEnabled) {
-            writeToFile(formattedMessage);
-        }
-        
-        if (m_consoleLoggingEnabled) {
-            writeToConsole(formattedMessage);
-        }
-        
-        emit logMessage(QDateTime::currentDateTime().toString(Qt::ISODate), 
-                       "CRITICAL", category, message);
+    if (!mayLog(LogLevel::Critical)) {
+        return;
+    }
+    const CategoryId id = categoryId(category);
+    if (shouldLog(id, LogLevel::Critical)) {
+        dispatch(LogLevel::Critical, id, category, message);
     }
 }
 
 void Logger::fatal(const QString& message, const QString& category)
 {
-    QString formattedMessage = formatMessage(LogLevel::Fatal, category, message);
+    m_flightRecorder->recordMessage(static_cast<int>(LogLevel::Fatal), category, message);
+    write(LogLevel::Fatal, category, message);
+}
+
+void Logger::dispatch(LogLevel level, CategoryId id, const QString& category, const QString& message)
+{
+    if (static_cast<int>(level) >= m_captureLevel.load(std::memory_order_relaxed)) {
+        m_flightRecorder->recordMessage(static_cast<int>(level), category, message);
+    }
+    if (isEnabled(id, level)) {
+        write(level, category, message);
+    }
+}
+
+void Logger::write(LogLevel level, const QString& category, const QString& message)
+{
+    QString formattedMessage = formatMessage(level, category, message);
     
     if (m_fileLoggingEnabled) {
         writeToFile(formattedMessage);
@@ -214,8 +378,7 @@ void Logger::fatal(const QString& message, const QString& category)
         writeToConsole(formattedMessage);
     }
     
-    emit logMessage(QDateTime::currentDateTime().toString(Qt::ISODate), 
-                   "FATAL", category, message);
+    emit logMessage(QDateTime::currentMSecsSinceEpoch(), level, category, message);
 }
 
 QString Logger::getLogDirectory() const
@@ -225,81 +388,79 @@ QString Logger::getLogDirectory() const
 
 QStringList Logger::getLogFiles() const
 {
-    QDir logDir(m_logDirectory);
-    QStringList filters;
-    filters << "*.log";
-    return logDir.entryList(filters, QDir::Files, QDir::Time | QDir::Reversed);
+    return FRCDriverStation::LogArchiver::logFiles(m_logDirectory);
 }
 
 QString Logger::getLogContent(const QString& filename, int maxLines) const
 {
-    QString filePath = QDir(m_logDirectory).absoluteFilePath(filename);
-    QFile file(filePath);
-    
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        return QString("Error: Could not open log file %1").arg(filename);
-    }
-    
-    QStringList lines;
-    QTextStream stream(&file);
-    stream.setEncoding(QStringConverter::Utf8);
+    // Only names from getLogFiles(); never a path outside the log directory
+    QString filePath = QDir(m_logDirectory).absoluteFilePath(QFileInfo(filename).fileName());
     
-    while (!stream.atEnd()) {
-        lines.append(stream.readLine());
+    QString error;
+    const QStringList lines = FRCDriverStation::LogArchiver::readLines(filePath, maxLines, &error);
+    if (lines.isEmpty() && !error.isEmpty()) {
+        return QString("Error: %1").arg(error);
     }
-    
-    if (maxLines > 0 && lines.size() > maxLines) {
-        lines = lines.mid(lines.size() - maxLines);
-    }
-    
     return lines.join('\n');
 }
 
-void Logger::rotateLogFiles()
+bool Logger::openLogFileLocked()
 {
-    QMutexLocker locker(&m_logMutex);
-    
-    // Check if current log file is too large
-    if (m_currentLogFile && m_currentLogFile->size() > m_maxLogFileSize) {
-        info("Rotating log file due to size limit", "logger");
-        
-        // Close current file
-        if (m_logStream) {
-            m_logStream->flush();
-            m_logStream.reset();
-        }
-        m_currentLogFile->close();
-        
-        // Create new log file
-        QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss");
-        QString logFileName = QString("yads_%1.log").arg(timestamp);
-        QString logFilePath = QDir(m_logDirectory).absoluteFilePath(logFileName);
-        
-        m_currentLogFile = std::make_unique<QFile>(logFilePath);
-        if (m_currentLogFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
-            m_logStream = std::make_unique<QTextStream>(m_currentLogFile.get());
-            m_logStream->setEncoding(QStringConverter::Utf8);
-        }
+    QString timestamp = QDateTime::currentDateTime().toString("yyyy-MM-dd_hh-mm-ss");
+    QString logFilePath = QDir(m_logDirectory).absoluteFilePath(QString("yads_%1.log").arg(timestamp));
+    // Two rotations inside one second must not append to a file already queued for compression
+    for (int suffix = 1; QFile::exists(logFilePath) || QFile::exists(logFilePath + ".gz"); ++suffix) {
+        logFilePath = QDir(m_logDirectory).absoluteFilePath(QString("yads_%1_%2.log").arg(timestamp).arg(suffix));
     }
     
-    // Remove old log files
-    QStringList logFiles = getLogFiles();
-    while (logFiles.size() > m_maxLogFiles) {
-        QString oldestFile = logFiles.takeLast();
-        QString filePath = QDir(m_logDirectory).absoluteFilePath(oldestFile);
-        QFile::remove(filePath);
-        info(QString("Removed old log file: %1").arg(oldestFile), "logger");
+    m_currentLogFile = std::make_unique<QFile>(logFilePath);
+    if (!m_currentLogFile->open(QIODevice::WriteOnly | QIODevice::Append)) {
+        // Not qWarning(): that routes back into this logger while m_logMutex is held
+        std::cerr << "Failed to open log file: " << logFilePath.toStdString() << std::endl;
+        m_currentLogFile.reset();
+        return false;
     }
+    m_logStream = std::make_unique<QTextStream>(m_currentLogFile.get());
+    m_logStream->setEncoding(QStringConverter::Utf8);
+    m_currentFileBytes = 0;
+    m_archiver->setActiveFile(logFilePath);
+    return true;
+}
+
+QString Logger::rotateLogFileLocked()
+{
+    const QString previous = m_currentLogFile->fileName();
+    m_logStream->flush();
+    m_logStream.reset();
+    m_currentLogFile->close();
+    
+    openLogFileLocked();
+    m_archiver->enqueue(previous);
+    return previous;
 }
 
 void Logger::writeToFile(const QString& message)
 {
+    TRACE_SCOPE("Logger::writeToFile");
     QMutexLocker locker(&m_logMutex);
     
-    if (m_logStream) {
-        *m_logStream << message << Qt::endl;
-        m_logStream->flush();
+    if (!m_logStream) {
+        return;
     }
+    
+    *m_logStream << message << Qt::endl;
+    m_logStream->flush();
+    
+    // Checked on every write so a chatty session cannot run far past the limit
+    m_currentFileBytes += message.size() + 1;
+    if (m_currentFileBytes < m_maxLogFileSize) {
+        return;
+    }
+    
+    const QString rotated = rotateLogFileLocked();
+    locker.unlock();
+    info(QString("Rotated log file %1 at %2 KB; compressing in the background")
+         .arg(QFileInfo(rotated).fileName()).arg(m_maxLogFileSize / 1024), "logger");
 }
 
 void Logger::writeToConsole(const QString& message)
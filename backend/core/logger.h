@@ -3,13 +3,22 @@
 #include <QObject>
 #include <QLoggingCategory>
 #include <QMutex>
+#include <QReadWriteLock>
+#include <QHash>
+#include <QStringList>
 #include <QTextStream>
 #include <QFile>
-#include <QTimer>
+#include <array>
+#include <atomic>
 #include <memory>
 
 Q_DECLARE_LOGGING_CATEGORY(logger)
 
+namespace FRCDriverStation {
+class FlightRecorder;
+class LogArchiver;
+}
+
 class Logger : public QObject
 {
     Q_OBJECT
@@ -24,6 +33,11 @@ public:
     };
     Q_ENUM(LogLevel)
     
+    // Interned category; ids are stable for the life of the process
+    using CategoryId = int;
+    static constexpr int MAX_CATEGORIES = 256;
+    static constexpr CategoryId GENERAL_CATEGORY = 0;
+    
     static Logger& instance();
     
     void initialize();
@@ -32,8 +46,44 @@ public:
     void setLogLevel(LogLevel level);
     void setFileLoggingEnabled(bool enabled);
     void setConsoleLoggingEnabled(bool enabled);
-    void setMaxLogFiles(int maxFiles);
+    // Rotation happens on write once the current file passes maxSize
     void setMaxLogFileSize(qint64 maxSize);
+    // Rotated files are gzipped in the background; the oldest are removed past this total
+    void setLogDiskBudget(qint64 bytes);
+    
+    // Per-category levels; a category without its own level follows setLogLevel()
+    CategoryId categoryId(const QString& category);
+    QString categoryName(CategoryId id) const;
+    Q_INVOKABLE void setCategoryLogLevel(const QString& category, LogLevel level);
+    Q_INVOKABLE void resetCategoryLogLevel(const QString& category);
+    // "debug" sets the global level; "robot.communication=debug,network=warning" sets categories
+    bool applyLogLevelSpec(const QString& spec, QString* errorString = nullptr);
+    static bool parseLogLevel(const QString& name, LogLevel& level);
+    
+    // Whether a message goes to the file/console outputs
+    bool isEnabled(CategoryId id, LogLevel level) const {
+        int threshold = m_categoryLevels[id].load(std::memory_order_relaxed);
+        if (threshold == INHERIT_LEVEL) {
+            threshold = m_logLevel.load(std::memory_order_relaxed);
+        }
+        return static_cast<int>(level) >= threshold;
+    }
+    
+    // Whether a message is wanted anywhere, outputs or flight recorder; the
+    // YADS_LOG_* macros call this before building the message
+    bool shouldLog(CategoryId id, LogLevel level) const {
+        return static_cast<int>(level) >= m_captureLevel.load(std::memory_order_relaxed)
+            || isEnabled(id, level);
+    }
+    
+    // Flight recorder: keeps recent messages down to its own level (debug by
+    // default) in a crash-safe ring and snapshots them on trigger
+    bool startFlightRecorder(const QString& directory = QString());
+    void stopFlightRecorder();
+    void setFlightRecorderLevel(LogLevel level);
+    FRCDriverStation::FlightRecorder* flightRecorder() const { return m_flightRecorder.get(); }
+    
+    void log(LogLevel level, CategoryId id, const QString& message);
     
     void debug(const QString& message, const QString& category = "general");
     void info(const QString& message, const QString& category = "general");
@@ -41,16 +91,16 @@ public:
     void critical(const QString& message, const QString& category = "general");
     void fatal(const QString& message, const QString& category = "general");
     
-    QString getLogDirectory() const;
-    QStringList getLogFiles() const;
-    QString getLogContent(const QString& filename, int maxLines = -1) const;
+    Q_INVOKABLE QString getLogDirectory() const;
+    // Newest first; rotated files end in .log.gz
+    Q_INVOKABLE QStringList getLogFiles() const;
+    // Reads plain and compressed files alike; maxLines keeps the tail
+    Q_INVOKABLE QString getLogContent(const QString& filename, int maxLines = -1) const;
     
 signals:
-    void logMessage(const QString& timestamp, const QString& level, 
-                   const QString& category, const QString& message);
-
-private slots:
-    void rotateLogFiles();
+    // Emitted on the logging thread for every message that reaches the outputs
+    void logMessage(qint64 timestampMs, Logger::LogLevel level,
+                    const QString& category, const QString& message);
 
 private:
     explicit Logger(QObject *parent = nullptr);
@@ -58,22 +108,63 @@ private:
     
     void writeToFile(const QString& message);
     void writeToConsole(const QString& message);
-    void setupLogRotation();
+    bool openLogFileLocked();
+    QString rotateLogFileLocked();
     QString formatMessage(LogLevel level, const QString& category, const QString& message) const;
+    void dispatch(LogLevel level, CategoryId id, const QString& category, const QString& message);
+    void write(LogLevel level, const QString& category, const QString& message);
     
     static void messageHandler(QtMsgType type, const QMessageLogContext& context, const QString& message);
     
-    LogLevel m_logLevel;
+    static constexpr int INHERIT_LEVEL = -1;
+    
+    std::atomic<int> m_logLevel;
+    std::array<std::atomic<int>, MAX_CATEGORIES> m_categoryLevels;
+    std::atomic<int> m_lowestLevel;      // Minimum of m_logLevel and every category override
+    QStringList m_categoryNames;
+    QHash<QString, CategoryId> m_categoryIds;
+    mutable QReadWriteLock m_categoryLock;
+    
+    static constexpr int CAPTURE_OFF = 100;
+    std::unique_ptr<FRCDriverStation::FlightRecorder> m_flightRecorder;
+    std::atomic<int> m_flightRecorderLevel;
+    std::atomic<int> m_captureLevel;     // m_flightRecorderLevel while recording, else CAPTURE_OFF
     bool m_fileLoggingEnabled;
     bool m_consoleLoggingEnabled;
-    int m_maxLogFiles;
     qint64 m_maxLogFileSize;
     
     QString m_logDirectory;
     std::unique_ptr<QFile> m_currentLogFile;
     std::unique_ptr<QTextStream> m_logStream;
+    qint64 m_currentFileBytes;           // Approximate; counts UTF-16 units written
     QMutex m_logMutex;
-    QTimer* m_rotationTimer;
+    std::unique_ptr<FRCDriverStation::LogArchiver> m_archiver;
+    
+    // Lowest level any output or the flight recorder accepts; lets debug()/info()
+    // and friends drop a message before interning its category
+    bool mayLog(LogLevel level) const {
+        return static_cast<int>(level) >= m_lowestLevel.load(std::memory_order_relaxed)
+            || static_cast<int>(level) >= m_captureLevel.load(std::memory_order_relaxed);
+    }
+    void updateLowestLevel();
     
     static Logger* s_instance;
 };
+
+// Level-checked logging. The category is interned once per call site and the
+// message expression is only evaluated when its level is enabled for an output
+// or for the flight recorder:
+//   YADS_LOG_DEBUG(Constants::LogCategories::ROBOT_COMM, QString("Status %1").arg(index));
+// Named YADS_ because <syslog.h> already defines LOG_DEBUG and friends.
+#define YADS_LOG(level, category, message) \
+    do { \
+        static const ::Logger::CategoryId yadsLogCategory_ = ::Logger::instance().categoryId(category); \
+        if (::Logger::instance().shouldLog(yadsLogCategory_, level)) { \
+            ::Logger::instance().log(level, yadsLogCategory_, (message)); \
+        } \
+    } while (0)
+
+#define YADS_LOG_DEBUG(category, message) YADS_LOG(::Logger::LogLevel::Debug, category, message)
+#define YADS_LOG_INFO(category, message) YADS_LOG(::Logger::LogLevel::Info, category, message)
+#define YADS_LOG_WARNING(category, message) YADS_LOG(::Logger::LogLevel::Warning, category, message)
+#define YADS_LOG_CRITICAL(category, message) YADS_LOG(::Logger::LogLevel::Critical, category, message)
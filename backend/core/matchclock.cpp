@@ -0,0 +1,117 @@
+#include "matchclock.h"
+
+namespace FRCDriverStation {
+
+MatchClock::MatchClock(const Clock *clock)
+    : m_clock(clock)
+    , m_sequence(0)
+    , m_running(false)
+    , m_paused(false)
+    , m_originNs(0)
+    , m_pausedAtNs(0)
+    , m_autonomousEndNs(0)
+    , m_teleopEndNs(0)
+    , m_endgameEndNs(0)
+{
+}
+
+void MatchClock::start(int autonomousSeconds, int teleopSeconds, int endgameSeconds)
+{
+    const qint64 autonomousEnd = qMax(0, autonomousSeconds) * NS_PER_SECOND;
+    const qint64 teleopEnd = autonomousEnd + qMax(0, teleopSeconds) * NS_PER_SECOND;
+    const qint64 endgameEnd = teleopEnd + qMax(0, endgameSeconds) * NS_PER_SECOND;
+
+    beginWrite();
+    m_autonomousEndNs.store(autonomousEnd, std::memory_order_relaxed);
+    m_teleopEndNs.store(teleopEnd, std::memory_order_relaxed);
+    m_endgameEndNs.store(endgameEnd, std::memory_order_relaxed);
+    m_originNs.store(nowNs(), std::memory_order_relaxed);
+    m_paused.store(false, std::memory_order_relaxed);
+    m_running.store(true, std::memory_order_relaxed);
+    endWrite();
+}
+
+void MatchClock::pause()
+{
+    if (!m_running.load(std::memory_order_relaxed) || m_paused.load(std::memory_order_relaxed)) {
+        return;
+    }
+    beginWrite();
+    m_pausedAtNs.store(nowNs(), std::memory_order_relaxed);
+    m_paused.store(true, std::memory_order_relaxed);
+    endWrite();
+}
+
+void MatchClock::resume()
+{
+    if (!m_running.load(std::memory_order_relaxed) || !m_paused.load(std::memory_order_relaxed)) {
+        return;
+    }
+    const qint64 now = nowNs();
+    beginWrite();
+    // The paused interval does not count as match time
+    m_originNs.store(m_originNs.load(std::memory_order_relaxed) + now - m_pausedAtNs.load(std::memory_order_relaxed),
+                     std::memory_order_relaxed);
+    m_paused.store(false, std::memory_order_relaxed);
+    endWrite();
+}
+
+void MatchClock::stop()
+{
+    beginWrite();
+    m_running.store(false, std::memory_order_relaxed);
+    m_paused.store(false, std::memory_order_relaxed);
+    endWrite();
+}
+
+MatchClock::Reading MatchClock::readAt(qint64 nowNs) const
+{
+    Reading reading;
+    qint64 originNs, pausedAtNs, autonomousEnd, teleopEnd, endgameEnd;
+    quint32 before;
+    do {
+        before = m_sequence.load(std::memory_order_acquire);
+        reading.running = m_running.load(std::memory_order_relaxed);
+        reading.paused = m_paused.load(std::memory_order_relaxed);
+        originNs = m_originNs.load(std::memory_order_relaxed);
+        pausedAtNs = m_pausedAtNs.load(std::memory_order_relaxed);
+        autonomousEnd = m_autonomousEndNs.load(std::memory_order_relaxed);
+        teleopEnd = m_teleopEndNs.load(std::memory_order_relaxed);
+        endgameEnd = m_endgameEndNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((before & 1u) || before != m_sequence.load(std::memory_order_relaxed));
+
+    if (!reading.running) {
+        return reading;
+    }
+
+    const qint64 elapsed = qMax<qint64>(0, (reading.paused ? pausedAtNs : nowNs) - originNs);
+    reading.elapsedNs = elapsed;
+    if (elapsed < autonomousEnd) {
+        reading.phase = Autonomous;
+        reading.remainingNs = autonomousEnd - elapsed;
+    } else if (elapsed < teleopEnd) {
+        reading.phase = Teleop;
+        reading.remainingNs = teleopEnd - elapsed;
+    } else if (elapsed < endgameEnd) {
+        reading.phase = Endgame;
+        reading.remainingNs = endgameEnd - elapsed;
+    } else {
+        reading.phase = PostMatch;
+    }
+    return reading;
+}
+
+void MatchClock::beginWrite()
+{
+    m_sequence.fetch_add(1, std::memory_order_relaxed);
+    // The odd sequence must be visible before any of the field stores
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void MatchClock::endWrite()
+{
+    m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace FRCDriverStation
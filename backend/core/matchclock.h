@@ -0,0 +1,87 @@
+#ifndef MATCHCLOCK_H
+#define MATCHCLOCK_H
+
+#include <QtGlobal>
+#include <atomic>
+#include "clock.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Monotonic match schedule shared by the practice match UI and the transmit path
+ *
+ * This class manages:
+ * - The phase deadlines of one match (autonomous, teleop, endgame), computed
+ *   once at start as offsets on the monotonic clock
+ * - Pause and resume, which shift the origin instead of recomputing phases
+ * - Lock-free readings of the current phase and the exact time remaining in
+ *   it, in nanoseconds
+ *
+ * Design principles:
+ * - Monotonic time only, from an injectable Clock: wall-clock steps (NTP, manual changes) cannot move
+ *   a phase boundary
+ * - The transmit path asks for the phase of the packet it is building, so
+ *   the mode flips on the first packet at or after the deadline, not on
+ *   whichever UI tick happens to notice it
+ * - One writer (the thread that owns the practice match), any number of
+ *   readers: a sequence counter lets readers retry instead of locking
+ * - Not a QObject: it only answers questions; PracticeMatchManager turns
+ *   phase changes into signals
+ */
+class MatchClock
+{
+public:
+    // Same values as PracticeMatchManager::MatchPhase and YADS_SHM_PHASE_*
+    enum Phase {
+        PreMatch = 0,
+        Autonomous = 1,
+        Teleop = 2,
+        Endgame = 3,
+        PostMatch = 4
+    };
+
+    struct Reading {
+        bool running = false;       ///< Started and not stopped; also true while paused
+        bool paused = false;
+        Phase phase = PreMatch;
+        qint64 remainingNs = 0;     ///< Until the end of phase
+        qint64 elapsedNs = 0;       ///< Match time since start, pauses excluded
+    };
+
+    static constexpr qint64 NS_PER_SECOND = 1000000000;
+
+    explicit MatchClock(const Clock *clock = Clock::system());
+
+    // Before start(); a VirtualClock runs whole matches in virtual time
+    void setClock(const Clock *clock) { m_clock = clock ? clock : Clock::system(); }
+
+    // Writer side
+    void start(int autonomousSeconds, int teleopSeconds, int endgameSeconds);
+    void pause();
+    void resume();
+    void stop();
+
+    // Any thread
+    Reading read() const { return readAt(nowNs()); }
+    Reading readAt(qint64 nowNs) const;
+    qint64 nowNs() const { return m_clock->nowNs(); }
+
+private:
+    void beginWrite();
+    void endWrite();
+
+    const Clock *m_clock;
+
+    std::atomic<quint32> m_sequence;            // Odd while the writer is updating
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_paused;
+    std::atomic<qint64> m_originNs;             // Monotonic time of match time zero
+    std::atomic<qint64> m_pausedAtNs;
+    std::atomic<qint64> m_autonomousEndNs;      // Deadlines, relative to the origin
+    std::atomic<qint64> m_teleopEndNs;
+    std::atomic<qint64> m_endgameEndNs;
+};
+
+} // namespace FRCDriverStation
+
+#endif // MATCHCLOCK_H
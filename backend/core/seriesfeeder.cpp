@@ -0,0 +1,143 @@
+#include "seriesfeeder.h"
+#include <QGuiApplication>
+#include <QScreen>
+#include <cmath>
+
+namespace FRCDriverStation {
+
+SeriesFeeder::SeriesFeeder(QObject *parent)
+    : QObject(parent)
+    , m_head(0)
+    , m_size(0)
+    , m_capacity(0)
+    , m_timeRangeMs(DEFAULT_TIME_RANGE_MS)
+    , m_nextBuffer(0)
+    , m_windowEndMs(QDateTime::currentMSecsSinceEpoch())
+    , m_maximum(0.0)
+    , m_windowCount(0)
+{
+    setCapacity(DEFAULT_CAPACITY);
+
+    // One series update per display frame at most
+    const QScreen *screen = QGuiApplication::primaryScreen();
+    const qreal refreshHz = screen && screen->refreshRate() > 1.0 ? screen->refreshRate() : FALLBACK_REFRESH_HZ;
+    m_frameTimer.setSingleShot(true);
+    m_frameTimer.setTimerType(Qt::PreciseTimer);
+    m_frameTimer.setInterval(qMax(1, int(std::lround(1000.0 / refreshHz))));
+    connect(&m_frameTimer, &QTimer::timeout, this, &SeriesFeeder::flush);
+}
+
+void SeriesFeeder::setSeries(QAbstractSeries *series)
+{
+    QXYSeries *xySeries = qobject_cast<QXYSeries *>(series);
+    if (xySeries == m_series) {
+        return;
+    }
+    m_series = xySeries;
+    emit seriesChanged();
+    scheduleFlush();
+}
+
+void SeriesFeeder::setCapacity(int capacity)
+{
+    capacity = qMax(capacity, 2);
+    if (capacity == m_capacity) {
+        return;
+    }
+
+    // Keep the newest samples that fit
+    QVector<QPointF> ring(capacity);
+    const int kept = qMin(m_size, capacity);
+    for (int i = 0; i < kept; ++i) {
+        ring[i] = m_ring[(m_head - kept + i + m_capacity) % qMax(m_capacity, 1)];
+    }
+    m_ring.swap(ring);
+    m_size = kept;
+    m_head = kept % capacity;
+    m_capacity = capacity;
+
+    for (QList<QPointF> &buffer : m_buffers) {
+        buffer.reserve(capacity);
+    }
+    emit capacityChanged();
+    scheduleFlush();
+}
+
+void SeriesFeeder::setTimeRangeMs(qint64 rangeMs)
+{
+    rangeMs = qMax<qint64>(rangeMs, 1000);
+    if (rangeMs == m_timeRangeMs) {
+        return;
+    }
+    m_timeRangeMs = rangeMs;
+    emit timeRangeMsChanged();
+    scheduleFlush();
+}
+
+void SeriesFeeder::append(double value)
+{
+    appendAt(QDateTime::currentMSecsSinceEpoch(), value);
+}
+
+void SeriesFeeder::appendAt(qint64 timestampMs, double value)
+{
+    m_ring[m_head] = QPointF(qreal(timestampMs), value);
+    m_head = (m_head + 1) % m_capacity;
+    m_size = qMin(m_size + 1, m_capacity);
+    m_windowEndMs = qMax(m_windowEndMs, timestampMs);
+    scheduleFlush();
+}
+
+void SeriesFeeder::clear()
+{
+    m_head = 0;
+    m_size = 0;
+    m_windowEndMs = QDateTime::currentMSecsSinceEpoch();
+    scheduleFlush();
+}
+
+void SeriesFeeder::scheduleFlush()
+{
+    if (!m_frameTimer.isActive()) {
+        m_frameTimer.start();
+    }
+}
+
+void SeriesFeeder::flush()
+{
+    // The series still holds the other buffer, so this one is not shared
+    QList<QPointF> &points = m_buffers[m_nextBuffer];
+    points.clear();
+
+    const qreal windowStartMs = qreal(m_windowEndMs - m_timeRangeMs);
+    const int oldest = (m_head - m_size + m_capacity) % m_capacity;
+    auto at = [&](int i) -> const QPointF & { return m_ring[(oldest + i) % m_capacity]; };
+
+    // Samples are in time order; skip the ones that scrolled out of the window
+    int first = 0;
+    for (int last = m_size; first < last;) {
+        const int middle = (first + last) / 2;
+        if (at(middle).x() < windowStartMs) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+
+    double maximum = 0.0;
+    for (int i = first; i < m_size; ++i) {
+        const QPointF &point = at(i);
+        points.append(point);
+        maximum = qMax(maximum, point.y());
+    }
+
+    if (m_series) {
+        m_series->replace(points);
+        m_nextBuffer ^= 1;
+    }
+    m_maximum = maximum;
+    m_windowCount = int(points.size());
+    emit windowChanged();
+}
+
+} // namespace FRCDriverStation
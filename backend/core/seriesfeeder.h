@@ -0,0 +1,100 @@
+#ifndef SERIESFEEDER_H
+#define SERIESFEEDER_H
+
+#include <QObject>
+#include <QDateTime>
+#include <QList>
+#include <QPointer>
+#include <QPointF>
+#include <QTimer>
+#include <QVector>
+#include <QtCharts/QAbstractSeries>
+#include <QtCharts/QXYSeries>
+#include <array>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Feeds a chart series from a ring buffer of samples
+ *
+ * This class manages:
+ * - A fixed-capacity ring of (timestamp, value) samples for one metric
+ * - Pushing the samples inside the visible time window to a QXYSeries
+ * - The window bounds and maximum value, for binding chart axes
+ *
+ * Design principles:
+ * - Appending is O(1) and never touches the series
+ * - Series updates are coalesced to one replace() per display frame, however
+ *   many samples arrived in between
+ * - replace() alternates between two preallocated point lists, so the steady
+ *   state does not allocate: the series keeps one while the other is refilled
+ */
+class SeriesFeeder : public QObject
+{
+    Q_OBJECT
+
+    Q_PROPERTY(QAbstractSeries *series READ series WRITE setSeries NOTIFY seriesChanged)
+    Q_PROPERTY(int capacity READ capacity WRITE setCapacity NOTIFY capacityChanged)
+    Q_PROPERTY(qint64 timeRangeMs READ timeRangeMs WRITE setTimeRangeMs NOTIFY timeRangeMsChanged)
+    Q_PROPERTY(QDateTime windowStart READ windowStart NOTIFY windowChanged)
+    Q_PROPERTY(QDateTime windowEnd READ windowEnd NOTIFY windowChanged)
+    Q_PROPERTY(double maximum READ maximum NOTIFY windowChanged)
+    Q_PROPERTY(int count READ count NOTIFY windowChanged)
+
+public:
+    static constexpr int DEFAULT_CAPACITY = 6000;               // 10 minutes at 10 Hz
+    static constexpr qint64 DEFAULT_TIME_RANGE_MS = 60 * 1000;
+    static constexpr int FALLBACK_REFRESH_HZ = 60;
+
+    explicit SeriesFeeder(QObject *parent = nullptr);
+
+    QAbstractSeries *series() const { return m_series; }
+    void setSeries(QAbstractSeries *series);
+
+    int capacity() const { return m_capacity; }
+    void setCapacity(int capacity);
+
+    qint64 timeRangeMs() const { return m_timeRangeMs; }
+    void setTimeRangeMs(qint64 rangeMs);
+
+    QDateTime windowStart() const { return QDateTime::fromMSecsSinceEpoch(m_windowEndMs - m_timeRangeMs); }
+    QDateTime windowEnd() const { return QDateTime::fromMSecsSinceEpoch(m_windowEndMs); }
+    // Largest value inside the window; 0 when empty
+    double maximum() const { return m_maximum; }
+    // Samples inside the window
+    int count() const { return m_windowCount; }
+
+    // Stamped with the current time
+    Q_INVOKABLE void append(double value);
+    Q_INVOKABLE void appendAt(qint64 timestampMs, double value);
+    Q_INVOKABLE void clear();
+
+signals:
+    void seriesChanged();
+    void capacityChanged();
+    void timeRangeMsChanged();
+    void windowChanged();
+
+private:
+    void scheduleFlush();
+    void flush();
+
+    QPointer<QXYSeries> m_series;
+    QVector<QPointF> m_ring;
+    int m_head;                          // Next slot to write
+    int m_size;
+    int m_capacity;
+    qint64 m_timeRangeMs;
+
+    std::array<QList<QPointF>, 2> m_buffers;
+    int m_nextBuffer;
+    QTimer m_frameTimer;
+
+    qint64 m_windowEndMs;
+    double m_maximum;
+    int m_windowCount;
+};
+
+} // namespace FRCDriverStation
+
+#endif // SERIESFEEDER_H
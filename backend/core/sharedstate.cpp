@@ -0,0 +1,193 @@
+#include "sharedstate.h"
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+namespace FRCDriverStation {
+
+static_assert(sizeof(yads_shm_state) % 8 == 0, "yads_shm_state must keep 64-bit alignment");
+static_assert(offsetof(yads_shm_state, header) == 0, "the header starts the segment");
+static_assert(offsetof(yads_shm_header, sequence) % 4 == 0, "sequence must be naturally aligned");
+
+SharedState::Update::Update(SharedState *sharedState)
+    : m_sharedState(sharedState)
+{
+    m_sharedState->beginWrite();
+    m_state = m_sharedState->m_state;
+}
+
+SharedState::Update::~Update()
+{
+    m_state->header.updated_ms = QDateTime::currentMSecsSinceEpoch();
+    m_sharedState->endWrite();
+}
+
+SharedState::SharedState(QObject *parent)
+    : QObject(parent)
+    , m_mapped(nullptr)
+    , m_state(&m_private)
+{
+    std::memset(&m_private, 0, sizeof(m_private));
+    m_private.header.magic = YADS_SHM_MAGIC;
+    m_private.header.version_major = YADS_SHM_VERSION_MAJOR;
+    m_private.header.version_minor = YADS_SHM_VERSION_MINOR;
+    m_private.header.size = sizeof(yads_shm_state);
+    m_private.fms_alliance = YADS_SHM_ALLIANCE_UNKNOWN;
+    for (yads_shm_controller &controller : m_private.controllers) {
+        std::fill(std::begin(controller.povs), std::end(controller.povs), qint16(-1));
+    }
+}
+
+SharedState::~SharedState()
+{
+    stop();
+}
+
+QString SharedState::defaultPath()
+{
+#ifdef Q_OS_LINUX
+    // tmpfs: the pages never go to disk
+    if (QFileInfo(QStringLiteral("/dev/shm")).isDir()) {
+        return QStringLiteral("/dev/shm/" YADS_SHM_FILE_NAME);
+    }
+#endif
+    return QDir(QDir::tempPath()).filePath(QStringLiteral(YADS_SHM_FILE_NAME));
+}
+
+bool SharedState::start(const QString &path)
+{
+    if (m_mapped) {
+        return true;
+    }
+
+    m_file.setFileName(path.isEmpty() ? defaultPath() : path);
+    m_errorString.clear();
+
+    // The seqlock only serialises writers in this process; a second one would tear snapshots
+    const QString lockPath = m_file.fileName() + QStringLiteral(".lock");
+    m_lockFile = std::make_unique<QLockFile>(lockPath);
+    if (!m_lockFile->tryLock(0)) {
+        qint64 pid = 0;
+        QString hostname;
+        QString appname;
+        if (m_lockFile->error() == QLockFile::LockFailedError && m_lockFile->getLockInfo(&pid, &hostname, &appname)) {
+            m_errorString = QString("Already published by %1 (pid %2)").arg(appname).arg(pid);
+        } else {
+            m_errorString = QString("Cannot create %1").arg(lockPath);
+        }
+        m_lockFile.reset();
+        return false;
+    }
+
+    if (!m_file.open(QIODevice::ReadWrite)) {
+        m_errorString = m_file.errorString();
+        m_lockFile.reset();
+        return false;
+    }
+
+    // Keep the sequence of a previous run going up, for readers that still have it mapped
+    quint32 previousSequence = 0;
+    if (m_file.size() >= qint64(sizeof(yads_shm_header))) {
+        yads_shm_header previous;
+        if (m_file.read(reinterpret_cast<char *>(&previous), sizeof(previous)) == qint64(sizeof(previous))
+            && previous.magic == YADS_SHM_MAGIC) {
+            previousSequence = previous.sequence;
+        }
+    }
+
+    uchar *base = nullptr;
+    if (!m_file.resize(sizeof(yads_shm_state)) || !(base = m_file.map(0, sizeof(yads_shm_state)))) {
+        m_errorString = m_file.errorString();
+        m_file.close();
+        m_lockFile.reset();
+        return false;
+    }
+    yads_shm_state *mapped = reinterpret_cast<yads_shm_state *>(base);
+
+    // Readers see an odd sequence until the private state has been copied in
+    auto &mappedSequence = *reinterpret_cast<std::atomic<quint32> *>(&mapped->header.sequence);
+    mappedSequence.store(previousSequence | 1u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    while (m_writeLock.test_and_set(std::memory_order_acquire)) {
+    }
+    const std::size_t afterSequence = offsetof(yads_shm_header, sequence) + sizeof(quint32);
+    std::memcpy(mapped, &m_private, offsetof(yads_shm_header, sequence));
+    std::memcpy(reinterpret_cast<char *>(mapped) + afterSequence,
+                reinterpret_cast<const char *>(&m_private) + afterSequence,
+                sizeof(yads_shm_state) - afterSequence);
+    mapped->header.writer_pid = QCoreApplication::applicationPid();
+    mapped->header.updated_ms = QDateTime::currentMSecsSinceEpoch();
+    m_mapped = mapped;
+    m_state = mapped;
+    mappedSequence.store((previousSequence | 1u) + 1u, std::memory_order_release);
+    m_writeLock.clear(std::memory_order_release);
+    return true;
+}
+
+void SharedState::stop()
+{
+    if (!m_mapped) {
+        return;
+    }
+
+    {
+        Update update(this);
+        update->header.writer_pid = 0;
+    }
+
+    while (m_writeLock.test_and_set(std::memory_order_acquire)) {
+    }
+    std::memcpy(&m_private, m_mapped, sizeof(m_private));
+    m_private.header.sequence = 0;
+    m_state = &m_private;
+    yads_shm_state *mapped = m_mapped;
+    m_mapped = nullptr;
+    m_writeLock.clear(std::memory_order_release);
+
+    m_file.unmap(reinterpret_cast<uchar *>(mapped));
+    m_file.close();
+    m_lockFile.reset();
+}
+
+void SharedState::setMatch(quint8 phase, quint8 source, float timeRemaining)
+{
+    Update update(this);
+    update->match_phase = phase;
+    update->match_source = source;
+    update->match_time_remaining = timeRemaining;
+}
+
+void SharedState::setFms(bool connected, bool enabled, bool emergencyStop, quint8 alliance, quint16 matchNumber)
+{
+    Update update(this);
+    update->fms_connected = connected;
+    update->fms_enabled = enabled;
+    update->fms_emergency_stop = emergencyStop;
+    update->fms_alliance = alliance;
+    update->fms_match_number = matchNumber;
+}
+
+void SharedState::beginWrite()
+{
+    while (m_writeLock.test_and_set(std::memory_order_acquire)) {
+    }
+    std::atomic<quint32> &seq = sequence();
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    // The odd sequence must be visible before any of the field stores
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void SharedState::endWrite()
+{
+    std::atomic<quint32> &seq = sequence();
+    seq.store(seq.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    m_writeLock.clear(std::memory_order_release);
+}
+
+} // namespace FRCDriverStation
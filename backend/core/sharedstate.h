@@ -0,0 +1,107 @@
+#ifndef SHAREDSTATE_H
+#define SHAREDSTATE_H
+
+#include <QObject>
+#include <QFile>
+#include <QLockFile>
+#include <QString>
+#include <atomic>
+#include <memory>
+
+#include "yads_shm.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Publishes the latest driver station state to a shared-memory segment
+ *
+ * This class manages:
+ * - A small memory-mapped file (under /dev/shm on Linux, the temp directory
+ *   elsewhere) laid out as the yads_shm_state struct from sdk/yads_shm.h
+ * - Seqlock-protected updates, so external dashboards, pit displays and
+ *   scripts can take consistent snapshots with the C client in sdk/
+ *
+ * Design principles:
+ * - Writers never block on readers: an update is a few plain stores between
+ *   two sequence increments, with no system calls or allocations
+ * - Readers never block writers: they retry when the sequence was odd or
+ *   changed during their copy
+ * - Any thread may update; a spin lock only serialises concurrent writers
+ *   (the transmit path, the status path and the GUI thread) for the few
+ *   nanoseconds an update takes
+ * - Updates before start() or after stop() go to a private block, so call
+ *   sites do not have to care whether the segment is mapped
+ * - The file is reused across restarts with its sequence kept increasing, so
+ *   readers that kept it mapped see the new driver station without reopening
+ * - One writer process per segment: the spin lock cannot serialise against
+ *   another process, so start() takes a lock file next to the segment and
+ *   fails while the GUI or the daemon already publishes there
+ */
+class SharedState : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief One seqlock write section; fields are written through operator->
+     *
+     * Keep it short: readers spin while it is open.
+     */
+    class Update
+    {
+    public:
+        explicit Update(SharedState *sharedState);
+        ~Update();
+
+        yads_shm_state *operator->() const { return m_state; }
+
+        Update(const Update &) = delete;
+        Update &operator=(const Update &) = delete;
+
+    private:
+        SharedState *m_sharedState;
+        yads_shm_state *m_state;
+    };
+
+    explicit SharedState(QObject *parent = nullptr);
+    ~SharedState();
+
+    // Maps path (defaultPath() when empty); fails if another process publishes there
+    bool start(const QString &path = QString());
+    // Marks the segment as no longer written (writer_pid 0), unmaps it and releases the lock
+    void stop();
+    bool isActive() const { return m_mapped != nullptr; }
+
+    QString path() const { return m_file.fileName(); }
+    QString errorString() const { return m_errorString; }
+
+    // Same rule as yads_shm_default_path() in the C client
+    static QString defaultPath();
+
+    // Convenience writers for state that changes at event rate
+    void setMatch(quint8 phase, quint8 source, float timeRemaining);
+    void setFms(bool connected, bool enabled, bool emergencyStop, quint8 alliance, quint16 matchNumber);
+
+private:
+    static_assert(sizeof(std::atomic<quint32>) == sizeof(quint32), "sequence must map onto the header field");
+    static_assert(std::atomic<quint32>::is_always_lock_free, "sequence must be lock-free across processes");
+
+    std::atomic<quint32> &sequence() {
+        return *reinterpret_cast<std::atomic<quint32> *>(&m_state->header.sequence);
+    }
+
+    void beginWrite();
+    void endWrite();
+
+    std::unique_ptr<QLockFile> m_lockFile;
+    QFile m_file;
+    QString m_errorString;
+    yads_shm_state *m_mapped;
+    yads_shm_state m_private;                   // Used while nothing is mapped
+    yads_shm_state *m_state;                    // m_mapped or &m_private; guarded by m_writeLock
+    std::atomic_flag m_writeLock = ATOMIC_FLAG_INIT;
+};
+
+} // namespace FRCDriverStation
+
+#endif // SHAREDSTATE_H
@@ -0,0 +1,50 @@
+#include "statepublisher.h"
+#include <QtAlgorithms>
+
+namespace FRCDriverStation {
+
+StatePublisher::StatePublisher(QObject *parent)
+    : QObject(parent)
+    , m_dirty(0)
+{
+    for (auto &value : m_latest) {
+        value.store(0.0, std::memory_order_relaxed);
+    }
+    m_published.fill(0.0);
+    m_notifiers.reserve(MAX_SLOTS);
+
+    m_timer.setInterval(DEFAULT_INTERVAL_MS);
+    connect(&m_timer, &QTimer::timeout, this, &StatePublisher::flush);
+}
+
+int StatePublisher::addSlot(double initialValue, Notifier notifier)
+{
+    const int slot = int(m_notifiers.size());
+    Q_ASSERT_X(slot < MAX_SLOTS, "StatePublisher::addSlot", "too many slots");
+
+    m_latest[slot].store(initialValue, std::memory_order_relaxed);
+    m_published[slot] = initialValue;
+    m_notifiers.push_back(std::move(notifier));
+    return slot;
+}
+
+void StatePublisher::flush()
+{
+    quint64 dirty = m_dirty.exchange(0, std::memory_order_acquire);
+    while (dirty) {
+        const int slot = qCountTrailingZeroBits(dirty);
+        dirty &= dirty - 1;
+
+        const double value = m_latest[slot].load(std::memory_order_relaxed);
+        // Exact comparison on purpose: a value that came back to where it was needs no notification
+        if (value == m_published[slot]) {
+            continue;
+        }
+        m_published[slot] = value;
+        if (m_notifiers[size_t(slot)]) {
+            m_notifiers[size_t(slot)](value);
+        }
+    }
+}
+
+} // namespace FRCDriverStation
@@ -0,0 +1,81 @@
+#ifndef STATEPUBLISHER_H
+#define STATEPUBLISHER_H
+
+#include <QObject>
+#include <QTimer>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Coalesces high-rate state updates to one notification per UI tick
+ *
+ * This class manages:
+ * - A fixed block of numeric state slots that any thread can write
+ * - A GUI-thread tick (about 30 Hz by default) that collects the slots
+ *   written since the last tick and calls each changed slot's notifier once
+ *   with its newest value
+ *
+ * Design principles:
+ * - Writers never lock, allocate or post events: a relaxed store plus one
+ *   fetch_or on a dirty mask, so packet-rate producers can publish directly
+ *   from their own thread
+ * - UI cost follows the tick rate, not the producer rate: ten writes between
+ *   two ticks cause at most one NOTIFY signal, and none if the value ended up
+ *   unchanged
+ * - Notifiers run on the GUI thread only, so they can emit property change
+ *   signals that QML binds to
+ * - Safety-relevant state (enable, e-stop) does not belong here; it must not
+ *   wait for a tick
+ */
+class StatePublisher : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int MAX_SLOTS = 64;
+    static constexpr int DEFAULT_INTERVAL_MS = 33;
+
+    using Notifier = std::function<void(double)>;
+
+    explicit StatePublisher(QObject *parent = nullptr);
+
+    // GUI thread, before publishing starts; returns the slot index
+    int addSlot(double initialValue, Notifier notifier);
+
+    // Any thread; lock-free
+    void publish(int slot, double value) {
+        m_latest[slot].store(value, std::memory_order_relaxed);
+        m_dirty.fetch_or(quint64(1) << slot, std::memory_order_release);
+    }
+    // Any thread; the newest value, which the UI may not have seen yet
+    double latest(int slot) const { return m_latest[slot].load(std::memory_order_relaxed); }
+    // GUI thread; the value the last notification carried
+    double published(int slot) const { return m_published[slot]; }
+
+    int intervalMs() const { return m_timer.interval(); }
+    void setIntervalMs(int intervalMs) { m_timer.setInterval(qMax(1, intervalMs)); }
+
+    void start() { m_timer.start(); }
+    void stop() { m_timer.stop(); }
+
+public slots:
+    // Delivers everything pending now, without waiting for the next tick
+    void flush();
+
+private:
+    static_assert(MAX_SLOTS <= 64, "The dirty mask is one 64-bit word");
+
+    std::array<std::atomic<double>, MAX_SLOTS> m_latest;
+    std::atomic<quint64> m_dirty;
+    std::array<double, MAX_SLOTS> m_published;
+    std::vector<Notifier> m_notifiers;
+    QTimer m_timer;
+};
+
+} // namespace FRCDriverStation
+
+#endif // STATEPUBLISHER_H
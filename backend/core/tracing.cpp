@@ -0,0 +1,203 @@
+#include "tracing.h"
+
+#ifdef ENABLE_TRACING
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#endif
+
+namespace FRCDriverStation {
+
+#ifdef ENABLE_TRACING
+namespace {
+
+struct TraceEvent {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<qint64> startNs{0};
+    std::atomic<qint64> durationNs{0};
+};
+
+// Written only by its own thread; head counts every span ever recorded
+struct ThreadRing {
+    int threadId = 0;
+    QString threadName;                 // Guarded by s_registryMutex
+    std::array<TraceEvent, Tracing::RING_CAPACITY> events;
+    std::atomic<quint64> head{0};
+    std::atomic<quint64> clearedBefore{0};
+};
+
+std::atomic<bool> s_enabled{false};
+QMutex s_registryMutex;
+std::vector<std::shared_ptr<ThreadRing>> s_rings;
+thread_local std::shared_ptr<ThreadRing> t_ring;
+
+// The first span on a thread allocates its ring; every later one is allocation-free
+ThreadRing &threadRing() {
+    if (!t_ring) {
+        auto ring = std::make_shared<ThreadRing>();
+        QThread *thread = QThread::currentThread();
+        QMutexLocker locker(&s_registryMutex);
+        ring->threadId = int(s_rings.size()) + 1;
+        ring->threadName = thread ? thread->objectName() : QString();
+        if (ring->threadName.isEmpty()) {
+            const bool isMain = thread && QCoreApplication::instance()
+                && thread == QCoreApplication::instance()->thread();
+            ring->threadName = isMain ? QString("Main") : QString("Thread %1").arg(ring->threadId);
+        }
+        s_rings.push_back(ring);
+        t_ring = ring;
+    }
+    return *t_ring;
+}
+
+} // namespace
+#endif
+
+void Tracing::setEnabled(bool enabled)
+{
+#ifdef ENABLE_TRACING
+    s_enabled.store(enabled, std::memory_order_relaxed);
+#else
+    Q_UNUSED(enabled);
+#endif
+}
+
+bool Tracing::isEnabled()
+{
+#ifdef ENABLE_TRACING
+    return s_enabled.load(std::memory_order_relaxed);
+#else
+    return false;
+#endif
+}
+
+qint64 Tracing::nowNs()
+{
+#ifdef ENABLE_TRACING
+    static const auto epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count();
+#else
+    return 0;
+#endif
+}
+
+void Tracing::record(const char *name, qint64 startNs, qint64 endNs)
+{
+#ifdef ENABLE_TRACING
+    ThreadRing &ring = threadRing();
+    const quint64 index = ring.head.load(std::memory_order_relaxed);
+    TraceEvent &event = ring.events[index % RING_CAPACITY];
+    event.name.store(name, std::memory_order_relaxed);
+    event.startNs.store(startNs, std::memory_order_relaxed);
+    event.durationNs.store(endNs - startNs, std::memory_order_relaxed);
+    ring.head.store(index + 1, std::memory_order_release);
+#else
+    Q_UNUSED(name);
+    Q_UNUSED(startNs);
+    Q_UNUSED(endNs);
+#endif
+}
+
+void Tracing::setThreadName(const QString &name)
+{
+#ifdef ENABLE_TRACING
+    ThreadRing &ring = threadRing();
+    QMutexLocker locker(&s_registryMutex);
+    ring.threadName = name;
+#else
+    Q_UNUSED(name);
+#endif
+}
+
+bool Tracing::writeChromeTrace(const QString &path, QString *errorString)
+{
+#ifdef ENABLE_TRACING
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+
+    QMutexLocker locker(&s_registryMutex);
+    for (const std::shared_ptr<ThreadRing> &ring : s_rings) {
+        QJsonObject threadName;
+        threadName["ph"] = "M";
+        threadName["name"] = "thread_name";
+        threadName["pid"] = pid;
+        threadName["tid"] = ring->threadId;
+        threadName["args"] = QJsonObject{{"name", ring->threadName}};
+        events.append(threadName);
+
+        // Copy the published window, then drop anything the owner overwrote meanwhile
+        const quint64 head = ring->head.load(std::memory_order_acquire);
+        const quint64 first = qMax(ring->clearedBefore.load(std::memory_order_relaxed),
+                                   head > quint64(RING_CAPACITY) ? head - RING_CAPACITY : 0);
+        struct Span { quint64 index; const char *name; qint64 startNs; qint64 durationNs; };
+        std::vector<Span> spans;
+        spans.reserve(head - first);
+        for (quint64 index = first; index < head; ++index) {
+            const TraceEvent &event = ring->events[index % RING_CAPACITY];
+            spans.push_back({index, event.name.load(std::memory_order_relaxed),
+                             event.startNs.load(std::memory_order_relaxed),
+                             event.durationNs.load(std::memory_order_relaxed)});
+        }
+        const quint64 headAfter = ring->head.load(std::memory_order_acquire);
+        const quint64 firstValid = headAfter >= quint64(RING_CAPACITY) ? headAfter - RING_CAPACITY + 1 : 0;
+
+        for (const Span &span : spans) {
+            if (span.index < firstValid || !span.name) {
+                continue;
+            }
+            QJsonObject event;
+            event["ph"] = "X";
+            event["cat"] = "yads";
+            event["name"] = QString::fromLatin1(span.name);
+            event["pid"] = pid;
+            event["tid"] = ring->threadId;
+            event["ts"] = span.startNs / 1000.0;
+            event["dur"] = span.durationNs / 1000.0;
+            events.append(event);
+        }
+    }
+    locker.unlock();
+
+    QJsonObject trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+        || file.write(QJsonDocument(trace).toJson(QJsonDocument::Compact)) < 0) {
+        if (errorString) {
+            *errorString = file.errorString();
+        }
+        return false;
+    }
+    return true;
+#else
+    Q_UNUSED(path);
+    if (errorString) {
+        *errorString = "Tracing is not compiled in (build with -DENABLE_TRACING=ON)";
+    }
+    return false;
+#endif
+}
+
+void Tracing::clear()
+{
+#ifdef ENABLE_TRACING
+    QMutexLocker locker(&s_registryMutex);
+    for (const std::shared_ptr<ThreadRing> &ring : s_rings) {
+        ring->clearedBefore.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+#endif
+}
+
+} // namespace FRCDriverStation
@@ -0,0 +1,97 @@
+#ifndef TRACING_H
+#define TRACING_H
+
+#include <QtGlobal>
+#include <QString>
+
+namespace FRCDriverStation {
+
+#ifdef ENABLE_TRACING
+constexpr bool TRACING_COMPILED_IN = true;
+#else
+constexpr bool TRACING_COMPILED_IN = false;
+#endif
+
+/**
+ * @brief Hot-path span tracing with Chrome trace-event export
+ *
+ * This class manages:
+ * - Per-thread ring buffers of completed spans (name, start, duration)
+ * - A process-wide on/off switch checked when a span opens
+ * - Export of every buffered span as Chrome trace-event JSON, which
+ *   chrome://tracing and ui.perfetto.dev both open
+ *
+ * Design principles:
+ * - Compiled out entirely unless ENABLE_TRACING is defined: TRACE_SCOPE then
+ *   expands to an empty object the optimizer removes
+ * - Recording is lock-free and allocation-free: each thread writes only its own
+ *   ring, the exporter copies rings and drops entries overwritten meanwhile
+ * - Span names must be string literals; only the pointer is stored
+ * - Rings have a fixed size, so a long session keeps the most recent spans
+ */
+class Tracing
+{
+public:
+    // Spans per thread; at 50 Hz with a handful of spans per cycle this is over a minute
+    static constexpr int RING_CAPACITY = 16384;
+
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Span recording, normally reached through TRACE_SCOPE
+    static qint64 nowNs();
+    static void record(const char *name, qint64 startNs, qint64 endNs);
+
+    // Names the calling thread in exported traces (defaults to the QThread object name)
+    static void setThreadName(const QString &name);
+
+    static bool writeChromeTrace(const QString &path, QString *errorString = nullptr);
+    static void clear();
+};
+
+/**
+ * @brief RAII span; the disabled specialization is empty and compiles to nothing
+ */
+template <bool Enabled>
+class BasicTraceScope
+{
+public:
+    explicit BasicTraceScope(const char *name)
+        : m_name(name)
+        , m_startNs(Tracing::isEnabled() ? Tracing::nowNs() : -1)
+    {
+    }
+
+    ~BasicTraceScope() {
+        if (m_startNs >= 0) {
+            Tracing::record(m_name, m_startNs, Tracing::nowNs());
+        }
+    }
+
+    BasicTraceScope(const BasicTraceScope &) = delete;
+    BasicTraceScope &operator=(const BasicTraceScope &) = delete;
+
+private:
+    const char *m_name;
+    qint64 m_startNs;
+};
+
+template <>
+class BasicTraceScope<false>
+{
+public:
+    explicit constexpr BasicTraceScope(const char *) {}
+};
+
+using TraceScope = BasicTraceScope<TRACING_COMPILED_IN>;
+
+} // namespace FRCDriverStation
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Times the enclosing scope: TRACE_SCOPE("CommunicationHandler::sendControlPacket");
+#define TRACE_SCOPE(name) \
+    ::FRCDriverStation::TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+
+#endif // TRACING_H
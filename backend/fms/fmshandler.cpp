@@ -1,38 +1,34 @@
 #include "fmshandler.h"
 #include "backend/core/logger.h"
 #include <QDataStream>
-#include <QDateTime>
+#include <QtEndian>
+
+using FRCDriverStation::FmsState;
 
 FMSHandler::FMSHandler(QObject *parent)
     : QObject(parent)
     , m_socket(new QUdpSocket(this))
-    , m_heartbeatTimer(new QTimer(this))
-    , m_connectionTimer(new QTimer(this))
-    , m_connected(false)
+    , m_clock(FRCDriverStation::Clock::system())
+    , m_heartbeatTimer(new FRCDriverStation::ClockTimer(this))
+    , m_connectionTimer(new FRCDriverStation::ClockTimer(this))
     , m_teamNumber(0)
-    , m_matchState(Unknown)
-    , m_allianceColor(InvalidAlliance)
-    , m_matchNumber(0)
-    , m_matchTime(0)
-    , m_enabled(false)
-    , m_emergencyStop(false)
     , m_fmsAddress(QHostAddress("10.0.100.5"))
-    , m_fmsPort(1160)
-    , m_localPort(1110)
+    , m_fmsPort(FMS_STATUS_PORT)
+    , m_localPort(::Constants::DEFAULT_FMS_PORT)
 {
     // Setup timers
     m_heartbeatTimer->setInterval(HEARTBEAT_INTERVAL);
     m_heartbeatTimer->setSingleShot(false);
-    connect(m_heartbeatTimer, &QTimer::timeout, this, &FMSHandler::onHeartbeatTimer);
-    
+    connect(m_heartbeatTimer, &FRCDriverStation::ClockTimer::timeout, this, &FMSHandler::onHeartbeatTimer);
+
     m_connectionTimer->setInterval(CONNECTION_TIMEOUT);
     m_connectionTimer->setSingleShot(true);
-    connect(m_connectionTimer, &QTimer::timeout, this, &FMSHandler::onConnectionTimeout);
-    
+    connect(m_connectionTimer, &FRCDriverStation::ClockTimer::timeout, this, &FMSHandler::onConnectionTimeout);
+
     // Setup socket
     connect(m_socket, &QUdpSocket::readyRead, this, &FMSHandler::processPendingDatagrams);
-    
-    Logger::instance().log(Logger::Info, "FMS Handler initialized");
+
+    YADS_LOG_INFO(::Constants::LogCategories::FMS, "FMS Handler initialized");
 }
 
 FMSHandler::~FMSHandler()
@@ -40,23 +36,58 @@ FMSHandler::~FMSHandler()
     disconnectFromFMS();
 }
 
+FMSHandler::MatchState FMSHandler::matchState() const
+{
+    if (!m_snapshot.connected) {
+        return Unknown;
+    }
+    if (m_snapshot.emergencyStop || !m_snapshot.enabled) {
+        return Disabled;
+    }
+    if (m_snapshot.test) {
+        return Test;
+    }
+    return m_snapshot.autonomous ? Autonomous : Teleop;
+}
+
+void FMSHandler::setClock(FRCDriverStation::Clock *clock)
+{
+    m_clock = clock ? clock : FRCDriverStation::Clock::system();
+    m_state.setClock(m_clock);
+    m_heartbeatTimer->setClock(m_clock);
+    m_connectionTimer->setClock(m_clock);
+}
+
+void FMSHandler::setFmsAddressOverride(const QHostAddress &address)
+{
+    m_fmsAddressOverride = address;
+    if (!address.isNull()) {
+        m_fmsAddress = address;
+    }
+    YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                  QString("FMS address override: %1")
+                  .arg(address.isNull() ? QString("cleared") : address.toString()));
+}
+
 void FMSHandler::connectToFMS()
 {
-    if (m_connected) {
+    if (m_snapshot.connected) {
         return;
     }
-    
+
     if (!m_socket->bind(QHostAddress::Any, m_localPort)) {
-        Logger::instance().log(Logger::Error, QString("Failed to bind FMS socket to port %1").arg(m_localPort));
+        YADS_LOG_WARNING(::Constants::LogCategories::FMS,
+                         QString("Failed to bind FMS socket to port %1").arg(m_localPort));
         return;
     }
-    
+
     m_heartbeatTimer->start();
     m_connectionTimer->start();
-    
-    Logger::instance().log(Logger::Info, QString("Attempting to connect to FMS at %1:%2")
-                          .arg(m_fmsAddress.toString()).arg(m_fmsPort));
-    
+
+    YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                  QString("Attempting to connect to FMS at %1:%2")
+                  .arg(m_fmsAddress.toString()).arg(m_fmsPort));
+
     sendHeartbeat();
 }
 
@@ -65,10 +96,12 @@ void FMSHandler::disconnectFromFMS()
     m_heartbeatTimer->stop();
     m_connectionTimer->stop();
     m_socket->close();
-    
-    if (m_connected) {
-        updateConnectionStatus(false);
-        Logger::instance().log(Logger::Info, "Disconnected from FMS");
+
+    if (m_snapshot.connected) {
+        FmsState::Snapshot snapshot;
+        snapshot.receivedAtNs = m_state.nowNs();
+        publish(snapshot);
+        YADS_LOG_INFO(::Constants::LogCategories::FMS, "Disconnected from FMS");
     }
 }
 
@@ -76,16 +109,17 @@ void FMSHandler::setTeamNumber(int teamNumber)
 {
     if (m_teamNumber != teamNumber) {
         m_teamNumber = teamNumber;
-        
+
         // Update FMS address based on team number
-        if (teamNumber > 0) {
+        if (teamNumber > 0 && m_fmsAddressOverride.isNull()) {
             int firstOctet = teamNumber / 100;
             int secondOctet = teamNumber % 100;
             m_fmsAddress = QHostAddress(QString("10.%1.%2.5").arg(firstOctet).arg(secondOctet));
         }
-        
-        Logger::instance().log(Logger::Info, QString("Team number set to %1, FMS address: %2")
-                              .arg(teamNumber).arg(m_fmsAddress.toString()));
+
+        YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                      QString("Team number set to %1, FMS address: %2")
+                      .arg(teamNumber).arg(m_fmsAddress.toString()));
     }
 }
 
@@ -94,130 +128,93 @@ void FMSHandler::sendHeartbeat()
     sendStatusPacket();
 }
 
-void FMSHandler::processPendingDatagrams()
+bool FMSHandler::decodeControlPacket(const uchar *data, qint64 size, FmsState::Snapshot &snapshot)
 {
-    while (m_socket->hasPendingDatagrams()) {
-        QNetworkDatagram datagram = m_socket->receiveDatagram();
-        processPacket(datagram.data(), datagram.senderAddress());
+    if (size < CONTROL_PACKET_SIZE) {
+        return false;
     }
-}
 
-void FMSHandler::onHeartbeatTimer()
-{
-    sendStatusPacket();
+    // Bytes 0-1 are the packet number, which nothing uses
+    snapshot.matchType = data[2];
+    snapshot.matchNumber = qFromBigEndian<quint16>(data + 3);
+    snapshot.playNumber = data[5];
+    snapshot.matchTime = qFromBigEndian<quint16>(data + 6);
+
+    const quint8 controlByte = data[8];
+    snapshot.enabled = (controlByte & 0x01) != 0;
+    snapshot.autonomous = (controlByte & 0x02) != 0;
+    snapshot.test = (controlByte & 0x04) != 0;
+    snapshot.alliance = (controlByte & 0x08) ? Blue : Red;
+    snapshot.emergencyStop = (controlByte & 0x80) != 0;
+    return true;
 }
 
-void FMSHandler::onConnectionTimeout()
+void FMSHandler::processPendingDatagrams()
 {
-    if (m_connected) {
-        updateConnectionStatus(false);
-        Logger::instance().log(Logger::Warning, "FMS connection timeout");
+    // Read straight into the fixed buffer and decode from there; only the last
+    // packet of a backlog matters, but each one restarts the timeout
+    FmsState::Snapshot snapshot = m_snapshot;
+    bool received = false;
+    while (m_socket->hasPendingDatagrams()) {
+        const qint64 size = m_socket->readDatagram(m_receiveBuffer.data(), m_receiveBuffer.size());
+        const qint64 receivedAtNs = m_state.nowNs();
+        if (decodeControlPacket(reinterpret_cast<const uchar *>(m_receiveBuffer.data()), size, snapshot)) {
+            snapshot.connected = true;
+            snapshot.receivedAtNs = receivedAtNs;
+            received = true;
+        }
     }
-}
 
-void FMSHandler::processPacket(const QByteArray &data, const QHostAddress &sender)
-{
-    if (data.size() < 8) {
-        return; // Invalid packet size
+    if (!received) {
+        return;
     }
-    
-    // Reset connection timeout
     m_connectionTimer->start();
-    
-    if (!m_connected) {
-        updateConnectionStatus(true);
+    if (!snapshot.sameState(m_snapshot)) {
+        publish(snapshot);
     }
-    
-    parseControlPacket(data);
-    emit fmsDataReceived(data);
 }
 
-void FMSHandler::updateConnectionStatus(bool connected)
+void FMSHandler::onHeartbeatTimer()
 {
-    if (m_connected != connected) {
-        m_connected = connected;
-        emit connectionChanged(connected);
-    }
+    sendStatusPacket();
 }
 
-void FMSHandler::parseControlPacket(const QByteArray &data)
+void FMSHandler::onConnectionTimeout()
 {
-    QDataStream stream(data);
-    stream.setByteOrder(QDataStream::BigEndian);
-    
-    quint16 packetNumber;
-    quint8 matchType;
-    quint16 matchNumber;
-    quint8 playNumber;
-    quint16 timeRemaining;
-    quint8 controlByte;
-    
-    stream >> packetNumber >> matchType >> matchNumber >> playNumber >> timeRemaining >> controlByte;
-    
-    // Parse control byte
-    bool enabled = (controlByte & 0x01) != 0;
-    bool autonomous = (controlByte & 0x02) != 0;
-    bool test = (controlByte & 0x04) != 0;
-    bool emergencyStop = (controlByte & 0x80) != 0;
-    AllianceColor alliance = (controlByte & 0x08) ? Blue : Red;
-    
-    // Update match state
-    MatchState newState;
-    if (emergencyStop || !enabled) {
-        newState = Disabled;
-    } else if (test) {
-        newState = Test;
-    } else if (autonomous) {
-        newState = Autonomous;
-    } else {
-        newState = Teleop;
-    }
-    
-    // Emit changes
-    if (m_matchState != newState) {
-        m_matchState = newState;
-        emit matchStateChanged(newState);
-    }
-    
-    if (m_allianceColor != alliance) {
-        m_allianceColor = alliance;
-        emit allianceColorChanged(alliance);
-    }
-    
-    if (m_matchNumber != matchNumber) {
-        m_matchNumber = matchNumber;
-        emit matchNumberChanged(matchNumber);
-    }
-    
-    if (m_matchTime != timeRemaining) {
-        m_matchTime = timeRemaining;
-        emit matchTimeChanged(timeRemaining);
-    }
-    
-    if (m_enabled != enabled) {
-        m_enabled = enabled;
-        emit enabledChanged(enabled);
-    }
-    
-    if (m_emergencyStop != emergencyStop) {
-        m_emergencyStop = emergencyStop;
-        emit emergencyStopChanged(emergencyStop);
+    if (m_snapshot.connected) {
+        // A lost FMS link disables: the robot must not keep running on the last command
+        FmsState::Snapshot snapshot;
+        snapshot.receivedAtNs = m_state.nowNs();
+        publish(snapshot);
+        YADS_LOG_WARNING(::Constants::LogCategories::FMS, "FMS connection timeout");
     }
 }
 
+void FMSHandler::publish(const FmsState::Snapshot &snapshot)
+{
+    const bool connectionChanged = snapshot.connected != m_snapshot.connected;
+    m_state.publish(snapshot);
+    m_snapshot = m_state.read();
+    if (connectionChanged) {
+        YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                      m_snapshot.connected ? "FMS connected" : "FMS disconnected");
+    }
+    emit stateChanged(m_snapshot);
+}
+
 void FMSHandler::sendStatusPacket()
 {
     QByteArray packet;
     QDataStream stream(&packet, QIODevice::WriteOnly);
     stream.setByteOrder(QDataStream::BigEndian);
-    
+
     // FMS status packet format
     stream << quint16(m_teamNumber);  // Team number
     stream << quint8(0x01);           // Packet type (status)
     stream << quint8(0x00);           // Reserved
-    stream << quint32(QDateTime::currentSecsSinceEpoch()); // Timestamp
+    stream << quint32(m_clock->currentMSecsSinceEpoch() / 1000); // Timestamp
     stream << quint8(0x00);           // Status flags
     stream << quint8(0x00);           // Reserved
-    
+
     m_socket->writeDatagram(packet, m_fmsAddress, m_fmsPort);
 }
@@ -3,11 +3,30 @@
 
 #include <QObject>
 #include <QUdpSocket>
-#include <QTimer>
 #include <QHostAddress>
-#include <QNetworkDatagram>
+#include <array>
 #include "backend/core/constants.h"
+#include "backend/core/clock.h"
+#include "fmsstate.h"
 
+/**
+ * @brief The FMS link: control packets in, status heartbeats out
+ *
+ * This class manages:
+ * - The UDP socket the FMS sends match control packets to, and the 1 Hz
+ *   status heartbeat back to it
+ * - Decoding control packets in place from a reusable receive buffer
+ * - The FmsState snapshot, published once per packet that changes anything
+ * - The connection timeout
+ *
+ * Design principles:
+ * - One consolidated stateChanged() per change instead of a signal per
+ *   field; consumers pick the fields they care about
+ * - The transmit path reads the snapshot itself and connects directly, so
+ *   an FMS enable, disable or mode change goes out in a control packet from
+ *   inside the same readyRead, not on the next send tick
+ * - Nothing on the receive path allocates
+ */
 class FMSHandler : public QObject
 {
     Q_OBJECT
@@ -32,13 +51,33 @@ public:
     };
     Q_ENUM(AllianceColor)
 
-    bool isConnected() const { return m_connected; }
-    MatchState matchState() const { return m_matchState; }
-    AllianceColor allianceColor() const { return m_allianceColor; }
-    int matchNumber() const { return m_matchNumber; }
-    int matchTime() const { return m_matchTime; }
-    bool isEnabled() const { return m_enabled; }
-    bool isEmergencyStop() const { return m_emergencyStop; }
+    // Packet number, match type, match number, play number, time remaining, control byte
+    static constexpr int CONTROL_PACKET_SIZE = 9;
+    // The FMS sends control packets to Constants::DEFAULT_FMS_PORT and takes status heartbeats here
+    static constexpr quint16 FMS_STATUS_PORT = 1160;
+    static constexpr int MAX_DATAGRAM_SIZE = 1500;
+
+    bool isConnected() const { return m_snapshot.connected; }
+    MatchState matchState() const;
+    AllianceColor allianceColor() const { return AllianceColor(m_snapshot.alliance); }
+    int matchNumber() const { return m_snapshot.matchNumber; }
+    int matchTime() const { return m_snapshot.matchTime; }
+    bool isEnabled() const { return m_snapshot.enabled; }
+    bool isEmergencyStop() const { return m_snapshot.emergencyStop; }
+
+    // The same state for other threads; stays valid for the handler's lifetime
+    const FRCDriverStation::FmsState *state() const { return &m_state; }
+    FRCDriverStation::FmsState::Snapshot snapshot() const { return m_snapshot; }
+
+    // Time source for the heartbeat, connection timeout and receive stamps; set once at startup
+    void setClock(FRCDriverStation::Clock *clock);
+
+    // Talk to a fixed address instead of 10.TE.AM.5 (e.g. yads-fms-sim on loopback)
+    void setFmsAddressOverride(const QHostAddress &address);
+    QHostAddress fmsAddressOverride() const { return m_fmsAddressOverride; }
+
+    // Decodes the fields a control packet carries; false if it is too short
+    static bool decodeControlPacket(const uchar *data, qint64 size, FRCDriverStation::FmsState::Snapshot &snapshot);
 
 public slots:
     void connectToFMS();
@@ -47,14 +86,8 @@ public slots:
     void sendHeartbeat();
 
 signals:
-    void connectionChanged(bool connected);
-    void matchStateChanged(MatchState state);
-    void allianceColorChanged(AllianceColor color);
-    void matchNumberChanged(int number);
-    void matchTimeChanged(int time);
-    void enabledChanged(bool enabled);
-    void emergencyStopChanged(bool emergencyStop);
-    void fmsDataReceived(const QByteArray &data);
+    // Emitted on the socket's thread as soon as a packet (or the timeout) changes the snapshot
+    void stateChanged(const FRCDriverStation::FmsState::Snapshot &snapshot);
 
 private slots:
     void processPendingDatagrams();
@@ -62,28 +95,24 @@ private slots:
     void onConnectionTimeout();
 
 private:
-    void processPacket(const QByteArray &data, const QHostAddress &sender);
-    void updateConnectionStatus(bool connected);
-    void parseControlPacket(const QByteArray &data);
+    void publish(const FRCDriverStation::FmsState::Snapshot &snapshot);
     void sendStatusPacket();
 
     QUdpSocket *m_socket;
-    QTimer *m_heartbeatTimer;
-    QTimer *m_connectionTimer;
-    
-    bool m_connected;
+    FRCDriverStation::Clock *m_clock;
+    FRCDriverStation::ClockTimer *m_heartbeatTimer;
+    FRCDriverStation::ClockTimer *m_connectionTimer;
+
     int m_teamNumber;
-    MatchState m_matchState;
-    AllianceColor m_allianceColor;
-    int m_matchNumber;
-    int m_matchTime;
-    bool m_enabled;
-    bool m_emergencyStop;
-    
+    FRCDriverStation::FmsState m_state;
+    FRCDriverStation::FmsState::Snapshot m_snapshot;   // Last published, for this thread
+    std::array<char, MAX_DATAGRAM_SIZE> m_receiveBuffer;
+
     QHostAddress m_fmsAddress;
+    QHostAddress m_fmsAddressOverride;
     quint16 m_fmsPort;
     quint16 m_localPort;
-    
+
     static const int HEARTBEAT_INTERVAL = 1000; // ms
     static const int CONNECTION_TIMEOUT = 5000; // ms
 };
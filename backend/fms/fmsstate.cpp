@@ -0,0 +1,107 @@
+#include "fmsstate.h"
+
+namespace FRCDriverStation {
+
+namespace {
+
+enum : quint32 {
+    ConnectedBit = 1u << 0,
+    EnabledBit = 1u << 1,
+    AutonomousBit = 1u << 2,
+    TestBit = 1u << 3,
+    EmergencyStopBit = 1u << 4
+};
+
+quint32 packFlags(const FmsState::Snapshot &snapshot)
+{
+    quint32 flags = 0;
+    if (snapshot.connected) flags |= ConnectedBit;
+    if (snapshot.enabled) flags |= EnabledBit;
+    if (snapshot.autonomous) flags |= AutonomousBit;
+    if (snapshot.test) flags |= TestBit;
+    if (snapshot.emergencyStop) flags |= EmergencyStopBit;
+    return flags | quint32(snapshot.alliance) << 8 | quint32(snapshot.matchType) << 16
+                 | quint32(snapshot.playNumber) << 24;
+}
+
+} // namespace
+
+bool FmsState::Snapshot::sameControl(const Snapshot &other) const
+{
+    return connected == other.connected && enabled == other.enabled && autonomous == other.autonomous
+        && test == other.test && emergencyStop == other.emergencyStop;
+}
+
+bool FmsState::Snapshot::sameState(const Snapshot &other) const
+{
+    return sameControl(other) && alliance == other.alliance && matchType == other.matchType
+        && playNumber == other.playNumber && matchNumber == other.matchNumber
+        && matchTime == other.matchTime;
+}
+
+FmsState::FmsState(const Clock *clock)
+    : m_clock(clock)
+    , m_sequence(0)
+    , m_flags(packFlags(Snapshot()))
+    , m_match(0)
+    , m_controlGeneration(0)
+    , m_receivedAtNs(0)
+{
+}
+
+void FmsState::publish(const Snapshot &snapshot)
+{
+    const quint32 flags = packFlags(snapshot);
+    const quint32 controlMask = ConnectedBit | EnabledBit | AutonomousBit | TestBit | EmergencyStopBit;
+    quint32 generation = m_controlGeneration.load(std::memory_order_relaxed);
+    if ((flags ^ m_flags.load(std::memory_order_relaxed)) & controlMask) {
+        ++generation;
+    }
+
+    beginWrite();
+    m_flags.store(flags, std::memory_order_relaxed);
+    m_match.store(quint32(snapshot.matchNumber) | quint32(snapshot.matchTime) << 16, std::memory_order_relaxed);
+    m_controlGeneration.store(generation, std::memory_order_relaxed);
+    m_receivedAtNs.store(snapshot.receivedAtNs, std::memory_order_relaxed);
+    endWrite();
+}
+
+FmsState::Snapshot FmsState::read() const
+{
+    quint32 flags, match, before;
+    Snapshot snapshot;
+    do {
+        before = m_sequence.load(std::memory_order_acquire);
+        flags = m_flags.load(std::memory_order_relaxed);
+        match = m_match.load(std::memory_order_relaxed);
+        snapshot.controlGeneration = m_controlGeneration.load(std::memory_order_relaxed);
+        snapshot.receivedAtNs = m_receivedAtNs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while ((before & 1u) || before != m_sequence.load(std::memory_order_relaxed));
+
+    snapshot.connected = flags & ConnectedBit;
+    snapshot.enabled = flags & EnabledBit;
+    snapshot.autonomous = flags & AutonomousBit;
+    snapshot.test = flags & TestBit;
+    snapshot.emergencyStop = flags & EmergencyStopBit;
+    snapshot.alliance = quint8(flags >> 8);
+    snapshot.matchType = quint8(flags >> 16);
+    snapshot.playNumber = quint8(flags >> 24);
+    snapshot.matchNumber = quint16(match);
+    snapshot.matchTime = quint16(match >> 16);
+    return snapshot;
+}
+
+void FmsState::beginWrite()
+{
+    m_sequence.fetch_add(1, std::memory_order_relaxed);
+    // The odd sequence must be visible before any of the field stores
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void FmsState::endWrite()
+{
+    m_sequence.fetch_add(1, std::memory_order_release);
+}
+
+} // namespace FRCDriverStation
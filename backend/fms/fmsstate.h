@@ -0,0 +1,75 @@
+#ifndef FMSSTATE_H
+#define FMSSTATE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include "backend/core/clock.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Latest FMS state, shared by the FMS handler and the transmit path
+ *
+ * This class manages:
+ * - One consolidated snapshot of everything the FMS last told us: link,
+ *   enable, mode, e-stop, alliance and match information
+ * - A control generation, bumped whenever a field that ends up in the
+ *   control byte (link, enable, mode, e-stop) changes
+ * - The monotonic time the packet behind the snapshot was read, so the
+ *   transmit path can measure FMS-to-robot latency
+ *
+ * Design principles:
+ * - One writer (the FMS socket's thread), any number of readers: a sequence
+ *   counter lets readers retry instead of locking, as in MatchClock
+ * - Not a QObject: FMSHandler turns changes into one signal
+ */
+class FmsState
+{
+public:
+    struct Snapshot {
+        bool connected = false;
+        bool enabled = false;
+        bool autonomous = false;
+        bool test = false;
+        bool emergencyStop = false;
+        quint8 alliance = 2;        ///< FMSHandler::AllianceColor, also YADS_SHM_ALLIANCE_*
+        quint8 matchType = 0;
+        quint8 playNumber = 0;
+        quint16 matchNumber = 0;
+        quint16 matchTime = 0;      ///< Seconds remaining, as sent by the FMS
+        quint32 controlGeneration = 0;
+        qint64 receivedAtNs = 0;    ///< Clock::nowNs() when the packet was read
+
+        // Everything but the generation and the receive time
+        bool sameState(const Snapshot &other) const;
+        bool sameControl(const Snapshot &other) const;
+    };
+
+    explicit FmsState(const Clock *clock = Clock::system());
+
+    // Before the FMS handler starts
+    void setClock(const Clock *clock) { m_clock = clock ? clock : Clock::system(); }
+    qint64 nowNs() const { return m_clock->nowNs(); }
+
+    // Writer side; bumps the control generation if the control fields changed
+    void publish(const Snapshot &snapshot);
+
+    // Any thread
+    Snapshot read() const;
+
+private:
+    void beginWrite();
+    void endWrite();
+
+    const Clock *m_clock;
+
+    std::atomic<quint32> m_sequence;            // Odd while the writer is updating
+    std::atomic<quint32> m_flags;               // Control bits, alliance, match type, play number
+    std::atomic<quint32> m_match;               // Match number, match time
+    std::atomic<quint32> m_controlGeneration;
+    std::atomic<qint64> m_receivedAtNs;
+};
+
+} // namespace FRCDriverStation
+
+#endif // FMSSTATE_H
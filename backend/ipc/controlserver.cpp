@@ -0,0 +1,548 @@
+#include "controlserver.h"
+#include "backend/robotstate.h"
+#include "backend/core/constants.h"
+#include "backend/core/logger.h"
+#include "backend/core/statepublisher.h"
+#include "controllerhidhandler.h"
+#include <QDateTime>
+#include <QHostAddress>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace FRCDriverStation {
+
+namespace {
+
+constexpr int LENGTH_SIZE = 4;
+
+// Builds one frame; the length prefix is filled in by take()
+class FrameWriter
+{
+public:
+    explicit FrameWriter(quint8 type) {
+        m_data.reserve(64);
+        m_data.resize(LENGTH_SIZE);
+        m_data.append(char(type));
+    }
+
+    FrameWriter &u8(quint8 value) { m_data.append(char(value)); return *this; }
+    FrameWriter &u16(quint16 value) { return append(qToLittleEndian(value)); }
+    FrameWriter &u32(quint32 value) { return append(qToLittleEndian(value)); }
+    FrameWriter &i64(qint64 value) { return append(qToLittleEndian(value)); }
+    FrameWriter &f32(float value) {
+        quint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return u32(bits);
+    }
+    FrameWriter &str(const QString &value) {
+        QByteArray utf8 = value.toUtf8();
+        // Two strings per frame at most, so every frame stays under the limit; long log lines are cut, not dropped
+        utf8.truncate(qMin<int>(utf8.size(), YADS_CONTROL_MAX_FRAME / 4));
+        u16(quint16(utf8.size()));
+        m_data.append(utf8);
+        return *this;
+    }
+
+    QByteArray take() {
+        qToLittleEndian(quint32(m_data.size() - LENGTH_SIZE), m_data.data());
+        return std::move(m_data);
+    }
+
+private:
+    template <typename T>
+    FrameWriter &append(T littleEndian) {
+        m_data.append(reinterpret_cast<const char *>(&littleEndian), sizeof(littleEndian));
+        return *this;
+    }
+
+    QByteArray m_data;
+};
+
+// Reads a payload in place; any read past the end clears ok and returns zero
+class PayloadReader
+{
+public:
+    PayloadReader(const char *data, int size) : m_data(data), m_size(size), m_pos(0), m_ok(true) {}
+
+    bool ok() const { return m_ok; }
+
+    quint8 u8() { return take(1) ? quint8(m_data[m_pos - 1]) : 0; }
+    quint16 u16() { return take(2) ? qFromLittleEndian<quint16>(m_data + m_pos - 2) : 0; }
+    quint32 u32() { return take(4) ? qFromLittleEndian<quint32>(m_data + m_pos - 4) : 0; }
+    QString str() {
+        const int length = u16();
+        return take(length) ? QString::fromUtf8(m_data + m_pos - length, length) : QString();
+    }
+
+private:
+    bool take(int bytes) {
+        if (!m_ok || m_size - m_pos < bytes) {
+            m_ok = false;
+            return false;
+        }
+        m_pos += bytes;
+        return true;
+    }
+
+    const char *m_data;
+    int m_size;
+    int m_pos;
+    bool m_ok;
+};
+
+} // namespace
+
+ControlServer::ControlServer(RobotState *robotState, QObject *parent)
+    : QObject(parent)
+    , m_robotState(robotState)
+    , m_droppedLogs(0)
+    , m_logFlushScheduled(false)
+    , m_quitAllowed(false)
+{
+    m_clock.start();
+    m_server.setSocketOptions(QLocalServer::UserAccessOption);
+    connect(&m_server, &QLocalServer::newConnection, this, &ControlServer::onNewConnection);
+
+    m_stateTimer.setSingleShot(true);
+    m_stateTimer.setInterval(StatePublisher::DEFAULT_INTERVAL_MS);
+    connect(&m_stateTimer, &QTimer::timeout, this, &ControlServer::publishState);
+
+    connect(m_robotState, &RobotState::robotEnabledChanged, this, &ControlServer::publishStateNow);
+    connect(m_robotState, &RobotState::emergencyStopChanged, this, &ControlServer::publishStateNow);
+    connect(m_robotState, &RobotState::robotConnectedChanged, this, &ControlServer::publishStateNow);
+    connect(m_robotState, &RobotState::fmsConnectedChanged, this, &ControlServer::publishStateNow);
+    connect(m_robotState, &RobotState::robotModeChanged, this, &ControlServer::publishStateNow);
+    connect(m_robotState, &RobotState::teamNumberChanged, this, &ControlServer::publishStateNow);
+
+    connect(m_robotState, &RobotState::robotVoltageChanged, this, &ControlServer::scheduleState);
+    connect(m_robotState, &RobotState::networkLatencyChanged, this, &ControlServer::scheduleState);
+    connect(m_robotState, &RobotState::packetLossChanged, this, &ControlServer::scheduleState);
+}
+
+ControlServer::~ControlServer()
+{
+    close();
+}
+
+void ControlServer::setControllerHandler(ControllerHIDHandler *controllerHandler)
+{
+    if (m_controllerHandler) {
+        m_controllerHandler->disconnect(this);
+    }
+    m_controllerHandler = controllerHandler;
+    if (m_controllerHandler) {
+        connect(m_controllerHandler, &ControllerHIDHandler::controllerBound, this, &ControlServer::onControllerBound);
+        connect(m_controllerHandler, &ControllerHIDHandler::controllerUnbound, this, &ControlServer::onControllerUnbound);
+    }
+}
+
+bool ControlServer::listen(const QString &name)
+{
+    if (m_server.listen(name)) {
+        return true;
+    }
+    if (m_server.serverError() != QAbstractSocket::AddressInUseError) {
+        return false;
+    }
+
+    // Only take the name over if nobody answers on it
+    QLocalSocket probe;
+    probe.connectToServer(name);
+    if (probe.waitForConnected(100)) {
+        return false;
+    }
+    QLocalServer::removeServer(name);
+    return m_server.listen(name);
+}
+
+void ControlServer::close()
+{
+    m_stateTimer.stop();
+    const QList<QLocalSocket *> sockets = m_clients.keys();
+    m_clients.clear();
+    for (QLocalSocket *socket : sockets) {
+        socket->disconnect(this);
+        socket->abort();
+        socket->deleteLater();
+    }
+    updateLogSubscription();
+    m_server.close();
+}
+
+void ControlServer::onNewConnection()
+{
+    while (QLocalSocket *socket = m_server.nextPendingConnection()) {
+        m_clients.insert(socket, Client());
+        connect(socket, &QLocalSocket::readyRead, this, &ControlServer::onReadyRead);
+        connect(socket, &QLocalSocket::disconnected, this, &ControlServer::onDisconnected);
+        sendHello(socket);
+    }
+}
+
+void ControlServer::onReadyRead()
+{
+    const qint64 receivedNs = m_clock.nsecsElapsed();
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    auto it = m_clients.find(socket);
+    if (it == m_clients.end()) {
+        return;
+    }
+    Client &client = it.value();
+    client.input.append(socket->readAll());
+
+    // Frames are handled in place; the consumed prefix is removed once at the end
+    const char *data = client.input.constData();
+    const int available = client.input.size();
+    int offset = 0;
+    while (available - offset >= LENGTH_SIZE) {
+        const quint32 length = qFromLittleEndian<quint32>(data + offset);
+        if (length < 1 || length > YADS_CONTROL_MAX_FRAME) {
+            // Framing is lost; there is no way to resynchronise
+            YADS_LOG_WARNING(::Constants::LogCategories::CONTROL_API,
+                             QString("Control client sent a %1 byte frame, disconnecting").arg(length));
+            client.input.clear();
+            socket->abort();
+            return;
+        }
+        if (quint32(available - offset - LENGTH_SIZE) < length) {
+            break;
+        }
+        const char *frame = data + offset + LENGTH_SIZE;
+        handleFrame(socket, client, quint8(frame[0]), frame + 1, int(length) - 1, receivedNs);
+        offset += LENGTH_SIZE + int(length);
+    }
+    client.input.remove(0, offset);
+}
+
+void ControlServer::onDisconnected()
+{
+    QLocalSocket *socket = qobject_cast<QLocalSocket *>(sender());
+    if (!socket || !m_clients.remove(socket)) {
+        return;
+    }
+    socket->deleteLater();
+    updateLogSubscription();
+}
+
+void ControlServer::handleFrame(QLocalSocket *socket, Client &client, quint8 type, const char *payload, int size,
+                                qint64 receivedNs)
+{
+    PayloadReader header(payload, size);
+    const quint32 requestId = header.u32();
+    const Result result = header.ok()
+        ? execute(type, payload + 4, size - 4, client)
+        : Result{YADS_CONTROL_BAD_REQUEST, QStringLiteral("missing request id")};
+
+    const qint64 handlingUs = (m_clock.nsecsElapsed() - receivedNs) / 1000;
+    socket->write(FrameWriter(YADS_CONTROL_RESULT)
+                      .u32(requestId)
+                      .u8(result.status)
+                      .u32(quint32(qMin<qint64>(handlingUs, std::numeric_limits<quint32>::max())))
+                      .str(result.message)
+                      .take());
+    if (type == YADS_CONTROL_GET_STATE && result.status == YADS_CONTROL_OK) {
+        socket->write(stateFrame());
+    }
+
+    // Results are never skipped, so a client that sends without reading can only be cut off
+    if (socket->bytesToWrite() > MAX_BACKLOG_BYTES) {
+        YADS_LOG_WARNING(::Constants::LogCategories::CONTROL_API,
+                         "Control client is not reading its replies, disconnecting");
+        QMetaObject::invokeMethod(socket, &QLocalSocket::abort, Qt::QueuedConnection);
+    }
+}
+
+ControlServer::Result ControlServer::execute(quint8 type, const char *payload, int size, Client &client)
+{
+    PayloadReader reader(payload, size);
+
+    switch (type) {
+    case YADS_CONTROL_ENABLE:
+        // enableRobot() refuses these silently; tell the client why
+        if (m_robotState->isEmergencyStop()) {
+            return {YADS_CONTROL_REFUSED, QStringLiteral("emergency stop active")};
+        }
+        if (!m_robotState->isRobotConnected()) {
+            return {YADS_CONTROL_REFUSED, QStringLiteral("robot not connected")};
+        }
+        m_robotState->enableRobot();
+        if (!m_robotState->isRobotEnabled()) {
+            return {YADS_CONTROL_REFUSED, QStringLiteral("enable refused")};
+        }
+        return {YADS_CONTROL_OK, QString()};
+
+    case YADS_CONTROL_DISABLE:
+        m_robotState->disableRobot("Control API");
+        return {YADS_CONTROL_OK, QString()};
+
+    case YADS_CONTROL_ESTOP:
+        m_robotState->emergencyStopRobot("Control API");
+        return {YADS_CONTROL_OK, QString()};
+
+    case YADS_CONTROL_CLEAR_ESTOP:
+        m_robotState->clearEmergencyStop();
+        return {YADS_CONTROL_OK, QString()};
+
+    case YADS_CONTROL_SET_MODE: {
+        const quint8 mode = reader.u8();
+        if (!reader.ok() || mode < YADS_CONTROL_MODE_AUTONOMOUS || mode > YADS_CONTROL_MODE_TEST) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("mode must be 1-3")};
+        }
+        if (!m_robotState->setRobotMode(static_cast<RobotState::RobotMode>(mode))) {
+            return {YADS_CONTROL_REFUSED, QStringLiteral("mode is controlled by the FMS")};
+        }
+        return {YADS_CONTROL_OK, QString()};
+    }
+
+    case YADS_CONTROL_SET_TEAM: {
+        const quint16 team = reader.u16();
+        if (!reader.ok() || team < 1 || team > MAX_TEAM_NUMBER) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("team must be 1-%1").arg(MAX_TEAM_NUMBER)};
+        }
+        m_robotState->setTeamNumber(team);
+        m_robotState->setConnectionMode(RobotState::TeamNumber);
+        return {YADS_CONTROL_OK, QString()};
+    }
+
+    case YADS_CONTROL_SET_ADDRESS: {
+        const QString address = reader.str();
+        if (!reader.ok()) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("expected an address")};
+        }
+        if (address.isEmpty()) {
+            m_robotState->setConnectionMode(RobotState::TeamNumber);
+            return {YADS_CONTROL_OK, QString()};
+        }
+        const QHostAddress hostAddress(address);
+        if (hostAddress.isNull()) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("invalid address %1").arg(address)};
+        }
+        m_robotState->setRobotIpAddress(hostAddress.toString());
+        m_robotState->setConnectionMode(RobotState::IpAddress);
+        return {YADS_CONTROL_OK, QString()};
+    }
+
+    case YADS_CONTROL_BIND_CONTROLLER:
+    case YADS_CONTROL_UNBIND_CONTROLLER: {
+        const quint8 slot = reader.u8();
+        const QString deviceId = type == YADS_CONTROL_BIND_CONTROLLER ? reader.str() : QString();
+        if (!reader.ok() || slot >= ControllerHIDHandler::MAX_CONTROLLER_SLOTS) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("slot must be 0-%1")
+                                                  .arg(ControllerHIDHandler::MAX_CONTROLLER_SLOTS - 1)};
+        }
+        if (!m_controllerHandler) {
+            return {YADS_CONTROL_UNSUPPORTED, QStringLiteral("no controller support in this build")};
+        }
+        if (type == YADS_CONTROL_UNBIND_CONTROLLER) {
+            m_controllerHandler->unbindControllerFromSlot(slot);
+        } else if (!m_controllerHandler->bindControllerToSlot(deviceId, slot)) {
+            return {YADS_CONTROL_REFUSED, QStringLiteral("cannot bind %1 to slot %2").arg(deviceId).arg(slot)};
+        }
+        return {YADS_CONTROL_OK, QString()};
+    }
+
+    case YADS_CONTROL_SUBSCRIBE: {
+        const quint32 mask = reader.u32();
+        const quint8 minLogLevel = reader.u8();
+        const QString prefix = reader.str();
+        if (!reader.ok()) {
+            return {YADS_CONTROL_BAD_REQUEST, QStringLiteral("expected mask, level, category prefix")};
+        }
+        client.eventMask = mask;
+        client.minLogLevel = minLogLevel;
+        client.logCategoryPrefix = prefix;
+        client.dropped = 0;
+        updateLogSubscription();
+        return {YADS_CONTROL_OK, QString()};
+    }
+
+    case YADS_CONTROL_GET_STATE:
+        return {YADS_CONTROL_OK, QString()};
+
+    case YADS_CONTROL_QUIT:
+        if (!m_quitAllowed) {
+            return {YADS_CONTROL_UNSUPPORTED, QStringLiteral("quit is only available in yads-daemon")};
+        }
+        // After the result has been queued
+        QMetaObject::invokeMethod(this, &ControlServer::quitRequested, Qt::QueuedConnection);
+        return {YADS_CONTROL_OK, QString()};
+
+    default:
+        return {YADS_CONTROL_UNSUPPORTED, QStringLiteral("unknown request type 0x%1").arg(uint(type), 2, 16, QChar('0'))};
+    }
+}
+
+void ControlServer::sendHello(QLocalSocket *socket)
+{
+    quint32 streams = YADS_CONTROL_STREAM_STATE | YADS_CONTROL_STREAM_LOG;
+    if (m_controllerHandler) {
+        streams |= YADS_CONTROL_STREAM_CONTROLLERS;
+    }
+    socket->write(FrameWriter(YADS_CONTROL_HELLO).u16(YADS_CONTROL_PROTOCOL_VERSION).u32(streams).take());
+}
+
+void ControlServer::sendEvent(QLocalSocket *socket, Client &client, const QByteArray &frame)
+{
+    if (socket->bytesToWrite() > MAX_EVENT_BACKLOG_BYTES) {
+        ++client.dropped;
+        return;
+    }
+    if (client.dropped > 0) {
+        socket->write(FrameWriter(YADS_CONTROL_EVENT_DROPPED).u32(client.dropped).take());
+        client.dropped = 0;
+    }
+    socket->write(frame);
+}
+
+void ControlServer::broadcast(quint32 stream, const QByteArray &frame)
+{
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        if (it.value().eventMask & stream) {
+            sendEvent(it.key(), it.value(), frame);
+        }
+    }
+}
+
+QByteArray ControlServer::stateFrame() const
+{
+    quint8 flags = 0;
+    if (m_robotState->isRobotConnected()) {
+        flags |= YADS_CONTROL_FLAG_CONNECTED;
+    }
+    if (m_robotState->isRobotEnabled()) {
+        flags |= YADS_CONTROL_FLAG_ENABLED;
+    }
+    if (m_robotState->isEmergencyStop()) {
+        flags |= YADS_CONTROL_FLAG_ESTOP;
+    }
+    if (m_robotState->isFMSConnected()) {
+        flags |= YADS_CONTROL_FLAG_FMS;
+    }
+    return FrameWriter(YADS_CONTROL_EVENT_STATE)
+        .i64(QDateTime::currentMSecsSinceEpoch())
+        .u8(flags)
+        .u8(quint8(m_robotState->robotModeValue()))
+        .u16(quint16(m_robotState->teamNumber()))
+        .f32(float(m_robotState->robotVoltage()))
+        .f32(float(m_robotState->networkLatency()))
+        .f32(float(m_robotState->packetLoss()))
+        .take();
+}
+
+void ControlServer::publishState()
+{
+    bool subscribed = false;
+    for (const Client &client : std::as_const(m_clients)) {
+        subscribed |= (client.eventMask & YADS_CONTROL_STREAM_STATE) != 0;
+    }
+    if (subscribed) {
+        broadcast(YADS_CONTROL_STREAM_STATE, stateFrame());
+    }
+}
+
+void ControlServer::publishStateNow()
+{
+    m_stateTimer.stop();
+    publishState();
+}
+
+void ControlServer::scheduleState()
+{
+    if (!m_clients.isEmpty() && !m_stateTimer.isActive()) {
+        m_stateTimer.start();
+    }
+}
+
+void ControlServer::updateLogSubscription()
+{
+    bool subscribed = false;
+    for (const Client &client : std::as_const(m_clients)) {
+        subscribed |= (client.eventMask & YADS_CONTROL_STREAM_LOG) != 0;
+    }
+
+    if (subscribed && !m_logConnection) {
+        // Direct: runs on the logging thread and only queues; flushLogMessages() does the rest
+        m_logConnection = connect(&::Logger::instance(), &::Logger::logMessage, this,
+            [this](qint64 timestampMs, ::Logger::LogLevel level, const QString &category, const QString &message) {
+            onLogMessage(timestampMs, static_cast<int>(level), category, message);
+        }, Qt::DirectConnection);
+    } else if (!subscribed && m_logConnection) {
+        disconnect(m_logConnection);
+        m_logConnection = QMetaObject::Connection();
+        QMutexLocker locker(&m_logMutex);
+        m_pendingLogs.clear();
+        m_droppedLogs = 0;
+    }
+}
+
+void ControlServer::onLogMessage(qint64 timestampMs, int level, const QString &category, const QString &message)
+{
+    QMutexLocker locker(&m_logMutex);
+    if (m_pendingLogs.size() >= MAX_PENDING_LOG_MESSAGES) {
+        ++m_droppedLogs;
+        return;
+    }
+    m_pendingLogs.append(LogMessage{timestampMs, level, category, message});
+    if (m_logFlushScheduled) {
+        return;
+    }
+    m_logFlushScheduled = true;
+    locker.unlock();
+
+    QMetaObject::invokeMethod(this, &ControlServer::flushLogMessages, Qt::QueuedConnection);
+}
+
+void ControlServer::flushLogMessages()
+{
+    QVector<LogMessage> messages;
+    quint32 droppedLogs = 0;
+    {
+        QMutexLocker locker(&m_logMutex);
+        messages.swap(m_pendingLogs);
+        std::swap(droppedLogs, m_droppedLogs);
+        m_logFlushScheduled = false;
+    }
+
+    for (auto it = m_clients.begin(); it != m_clients.end(); ++it) {
+        Client &client = it.value();
+        if (!(client.eventMask & YADS_CONTROL_STREAM_LOG)) {
+            continue;
+        }
+        client.dropped += droppedLogs;
+        for (const LogMessage &entry : std::as_const(messages)) {
+            if (entry.level < client.minLogLevel || !entry.category.startsWith(client.logCategoryPrefix)) {
+                continue;
+            }
+            sendEvent(it.key(), client, FrameWriter(YADS_CONTROL_EVENT_LOG)
+                                            .i64(entry.timestampMs)
+                                            .u8(quint8(entry.level))
+                                            .str(entry.category)
+                                            .str(entry.message)
+                                            .take());
+        }
+    }
+}
+
+void ControlServer::onControllerBound(ControllerHIDDevice *controller, int slot)
+{
+    broadcast(YADS_CONTROL_STREAM_CONTROLLERS, FrameWriter(YADS_CONTROL_EVENT_CONTROLLER)
+                                                   .u8(quint8(slot))
+                                                   .u8(1)
+                                                   .str(controller->deviceId())
+                                                   .str(controller->name())
+                                                   .take());
+}
+
+void ControlServer::onControllerUnbound(const QString &deviceId, int slot)
+{
+    broadcast(YADS_CONTROL_STREAM_CONTROLLERS, FrameWriter(YADS_CONTROL_EVENT_CONTROLLER)
+                                                   .u8(quint8(slot))
+                                                   .u8(0)
+                                                   .str(deviceId)
+                                                   .str(QString())
+                                                   .take());
+}
+
+} // namespace FRCDriverStation
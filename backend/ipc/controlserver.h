@@ -0,0 +1,141 @@
+#ifndef CONTROLSERVER_H
+#define CONTROLSERVER_H
+
+#include <QObject>
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QPointer>
+#include <QTimer>
+#include <QVector>
+
+#include "yads_control.h"
+
+class RobotState;
+
+namespace FRCDriverStation {
+
+class ControllerHIDHandler;
+class ControllerHIDDevice;
+
+/**
+ * @brief Binary control and subscription API over a local socket
+ *
+ * This class manages:
+ * - A QLocalServer (a Unix domain socket, or a named pipe on Windows) that
+ *   only the current user can connect to
+ * - The length-prefixed protocol from sdk/yads_control.h: enable, disable,
+ *   e-stop, mode, team number, robot address, controller slot and quit
+ *   requests, each answered by a RESULT with the time it took to apply
+ * - Per-client subscriptions to state, log and controller events, with a
+ *   minimum log level and category prefix filter
+ *
+ * Design principles:
+ * - Requests go straight to the RobotState slots the UI buttons use, on the
+ *   GUI thread, as soon as their frame is complete; nothing is queued behind
+ *   events, so the next control packet carries the change
+ * - Slow subscribers never block the core: writes are non-blocking, events
+ *   are skipped and counted while a client's backlog is over
+ *   MAX_EVENT_BACKLOG_BYTES, and a client that still grows past
+ *   MAX_BACKLOG_BYTES is disconnected
+ * - Telemetry events follow the StatePublisher tick; enable, e-stop,
+ *   connection, mode and team changes are sent immediately
+ * - Log messages are only collected while someone subscribes to them, and
+ *   are batched off the logging thread like the event log model
+ */
+class ControlServer : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qint64 MAX_EVENT_BACKLOG_BYTES = 256 * 1024;
+    static constexpr qint64 MAX_BACKLOG_BYTES = 4 * 1024 * 1024;
+    static constexpr int MAX_PENDING_LOG_MESSAGES = 1024;
+    static constexpr int MAX_TEAM_NUMBER = 25599;
+
+    explicit ControlServer(RobotState *robotState, QObject *parent = nullptr);
+    ~ControlServer();
+
+    // Optional; without it controller requests are answered UNSUPPORTED
+    void setControllerHandler(ControllerHIDHandler *controllerHandler);
+
+    // Off by default: QUIT is answered UNSUPPORTED unless the host can shut down on request
+    void setQuitAllowed(bool allowed) { m_quitAllowed = allowed; }
+
+    // Replaces a stale socket left by an instance that did not shut down cleanly
+    bool listen(const QString &name = QString::fromLatin1(YADS_CONTROL_SOCKET_NAME));
+    void close();
+
+    QString serverPath() const { return m_server.fullServerName(); }
+    QString errorString() const { return m_server.errorString(); }
+    int clientCount() const { return int(m_clients.size()); }
+
+signals:
+    void quitRequested();
+
+private slots:
+    void onNewConnection();
+    void onReadyRead();
+    void onDisconnected();
+    void publishState();
+    void flushLogMessages();
+
+private:
+    struct Client {
+        QByteArray input;
+        quint32 eventMask = 0;
+        quint8 minLogLevel = 0;
+        QString logCategoryPrefix;
+        quint32 dropped = 0;
+    };
+
+    struct LogMessage {
+        qint64 timestampMs;
+        int level;
+        QString category;
+        QString message;
+    };
+
+    struct Result {
+        quint8 status;
+        QString message;
+    };
+
+    Result execute(quint8 type, const char *payload, int size, Client &client);
+    void handleFrame(QLocalSocket *socket, Client &client, quint8 type, const char *payload, int size,
+                     qint64 receivedNs);
+
+    void sendHello(QLocalSocket *socket);
+    void sendEvent(QLocalSocket *socket, Client &client, const QByteArray &frame);
+    void broadcast(quint32 stream, const QByteArray &frame);
+    QByteArray stateFrame() const;
+
+    void publishStateNow();
+    void scheduleState();
+    void onLogMessage(qint64 timestampMs, int level, const QString &category, const QString &message);
+    void updateLogSubscription();
+    void onControllerBound(ControllerHIDDevice *controller, int slot);
+    void onControllerUnbound(const QString &deviceId, int slot);
+
+    RobotState *m_robotState;
+    QPointer<ControllerHIDHandler> m_controllerHandler;
+    QLocalServer m_server;
+    QHash<QLocalSocket *, Client> m_clients;
+    QTimer m_stateTimer;
+    QElapsedTimer m_clock;                      // Monotonic; stamps frames for RESULT timings
+
+    // Filled on the logging thread, drained on ours
+    QMetaObject::Connection m_logConnection;
+    QMutex m_logMutex;
+    QVector<LogMessage> m_pendingLogs;
+    quint32 m_droppedLogs;
+    bool m_logFlushScheduled;
+    bool m_quitAllowed;
+};
+
+} // namespace FRCDriverStation
+
+#endif // CONTROLSERVER_H
@@ -1,34 +1,34 @@
 #include "battery_manager.h"
 #include "../core/logger.h"
 #include "../core/constants.h"
-#include <QDateTime>
 #include <algorithm>
 
 using namespace FRCDriverStation;
 using namespace FRCDriverStation::Constants;
 
-BatteryManager::BatteryManager(std::shared_ptr<Logger> logger, QObject *parent)
+BatteryManager::BatteryManager(QObject *parent)
     : QObject(parent)
-    , m_logger(logger)
-    , m_checkTimer(std::make_unique<QTimer>(this))
+    , m_clock(Clock::system())
+    , m_checkTimer(std::make_unique<ClockTimer>(this))
     , m_currentVoltage(0.0)
     , m_batteryLevel(Unknown)
     , m_batteryStatus("Unknown")
+    , m_criticalSinceMs(0)
     , m_criticalThreshold(Battery::CRITICAL_VOLTAGE)
     , m_warningThreshold(Battery::WARNING_VOLTAGE)
     , m_autoDisableEnabled(true)
 {
     // Setup check timer (1Hz)
     m_checkTimer->setInterval(1000);
-    connect(m_checkTimer.get(), &QTimer::timeout, this, &BatteryManager::checkBatteryLevel);
+    connect(m_checkTimer.get(), &ClockTimer::timeout, this, &BatteryManager::checkBatteryLevel);
     m_checkTimer->start();
 
-    m_logger->info("Battery Manager", "Battery manager initialized");
+    YADS_LOG_INFO(::Constants::LogCategories::BATTERY, "Battery manager initialized");
 }
 
 BatteryManager::~BatteryManager()
 {
-    m_logger->info("Battery Manager", "Battery manager destroyed");
+    YADS_LOG_INFO(::Constants::LogCategories::BATTERY, "Battery manager destroyed");
 }
 
 void BatteryManager::setCriticalThreshold(double threshold)
@@ -38,8 +38,8 @@ void BatteryManager::setCriticalThreshold(double threshold)
         emit criticalThresholdChanged(threshold);
         updateBatteryLevel();
         
-        m_logger->info("Battery Manager", "Critical threshold changed", 
-                      QString("%1V").arg(threshold, 0, 'f', 2));
+        YADS_LOG_INFO(::Constants::LogCategories::BATTERY,
+                      QString("Critical threshold changed: %1V").arg(threshold, 0, 'f', 2));
     }
 }
 
@@ -50,8 +50,8 @@ void BatteryManager::setWarningThreshold(double threshold)
         emit warningThresholdChanged(threshold);
         updateBatteryLevel();
         
-        m_logger->info("Battery Manager", "Warning threshold changed", 
-                      QString("%1V").arg(threshold, 0, 'f', 2));
+        YADS_LOG_INFO(::Constants::LogCategories::BATTERY,
+                      QString("Warning threshold changed: %1V").arg(threshold, 0, 'f', 2));
     }
 }
 
@@ -61,15 +61,24 @@ void BatteryManager::setAutoDisableEnabled(bool enabled)
         m_autoDisableEnabled = enabled;
         emit autoDisableEnabledChanged(enabled);
         
-        m_logger->info("Battery Manager", "Auto-disable changed", 
-                      enabled ? "Enabled" : "Disabled");
+        YADS_LOG_INFO(::Constants::LogCategories::BATTERY,
+                      QString("Auto-disable changed: %1").arg(enabled ? "Enabled" : "Disabled"));
     }
 }
 
+void BatteryManager::setClock(Clock *clock)
+{
+    m_clock = clock ? clock : Clock::system();
+    m_checkTimer->setClock(m_clock);
+    // Readings from the old clock are on a different timeline
+    m_voltageHistory.clear();
+    m_criticalSinceMs = m_clock->nowMs();
+}
+
 QList<double> BatteryManager::getVoltageHistory(int seconds) const
 {
     QList<double> history;
-    qint64 cutoffTime = QDateTime::currentMSecsSinceEpoch() - (seconds * 1000);
+    qint64 cutoffTime = m_clock->nowMs() - (seconds * 1000);
     
     for (const VoltageReading &reading : m_voltageHistory) {
         if (reading.timestamp >= cutoffTime) {
@@ -122,7 +131,7 @@ void BatteryManager::loadSettings(QSettings *settings)
     emit warningThresholdChanged(m_warningThreshold);
     emit autoDisableEnabledChanged(m_autoDisableEnabled);
     
-    m_logger->debug("Battery Manager", "Settings loaded");
+    YADS_LOG_DEBUG(::Constants::LogCategories::BATTERY, "Settings loaded");
 }
 
 void BatteryManager::saveSettings(QSettings *settings)
@@ -135,7 +144,7 @@ void BatteryManager::saveSettings(QSettings *settings)
     
     settings->endGroup();
     
-    m_logger->debug("Battery Manager", "Settings saved");
+    YADS_LOG_DEBUG(::Constants::LogCategories::BATTERY, "Settings saved");
 }
 
 void BatteryManager::updateVoltage(double voltage)
@@ -146,7 +155,7 @@ void BatteryManager::updateVoltage(double voltage)
         
         // Add to history
         VoltageReading reading;
-        reading.timestamp = QDateTime::currentMSecsSinceEpoch();
+        reading.timestamp = m_clock->nowMs();
         reading.voltage = voltage;
         m_voltageHistory.append(reading);
         
@@ -163,11 +172,13 @@ void BatteryManager::checkBatteryLevel()
 {
     // This is called periodically to check for sustained low voltage
     if (m_batteryLevel == Critical && m_autoDisableEnabled) {
-        // Check if voltage has been critical for more than 2 seconds
-        double avgVoltage = getAverageVoltage(2);
-        if (avgVoltage > 0.0 && avgVoltage <= m_criticalThreshold) {
-            m_logger->critical("Battery Manager", "Sustained critical voltage detected", 
-                             QString("Average: %1V over 2 seconds").arg(avgVoltage, 0, 'f', 2));
+        // The history only records changes, so a steady critical reading leaves no samples to
+        // average; time the critical level itself instead
+        const qint64 criticalMs = m_clock->nowMs() - m_criticalSinceMs;
+        if (criticalMs >= SUSTAINED_CRITICAL_MS) {
+            YADS_LOG_CRITICAL(::Constants::LogCategories::BATTERY,
+                              QString("Sustained critical voltage detected: %1V for %2 ms")
+                              .arg(m_currentVoltage, 0, 'f', 2).arg(criticalMs));
             emit robotShouldDisable();
         }
     }
@@ -190,12 +201,15 @@ void BatteryManager::updateBatteryLevel()
     if (m_batteryLevel != newLevel) {
         BatteryLevel oldLevel = m_batteryLevel;
         m_batteryLevel = newLevel;
+        if (newLevel == Critical) {
+            m_criticalSinceMs = m_clock->nowMs();
+        }
         emit batteryLevelChanged(newLevel);
         
         // Log level changes
         QStringList levelNames = {"Critical", "Warning", "Normal", "Unknown"};
-        m_logger->info("Battery Level", "Battery level changed", 
-                      QString("From %1 to %2 (%3V)")
+        YADS_LOG_INFO(::Constants::LogCategories::BATTERY,
+                      QString("Battery level changed from %1 to %2 (%3V)")
                       .arg(levelNames[oldLevel])
                       .arg(levelNames[newLevel])
                       .arg(m_currentVoltage, 0, 'f', 2));
@@ -2,14 +2,12 @@
 #define BATTERY_MANAGER_H
 
 #include <QObject>
-#include <QTimer>
 #include <QSettings>
 #include <memory>
+#include "../core/clock.h"
 
 namespace FRCDriverStation {
 
-class Logger;
-
 /**
  * @brief Manages battery voltage monitoring and alerts
  * 
@@ -45,7 +43,7 @@ public:
     };
     Q_ENUM(BatteryLevel)
 
-    explicit BatteryManager(std::shared_ptr<Logger> logger, QObject *parent = nullptr);
+    explicit BatteryManager(QObject *parent = nullptr);
     ~BatteryManager();
 
     // Property getters
@@ -73,6 +71,12 @@ public:
     // Data update (called by RobotState)
     void updateVoltage(double voltage);
 
+    // Time source for the history and the sustained-critical check; set once at startup
+    void setClock(Clock *clock);
+
+    // How long the voltage must stay critical before auto-disable
+    static constexpr qint64 SUSTAINED_CRITICAL_MS = 2000;
+
 signals:
     void currentVoltageChanged(double voltage);
     void criticalThresholdChanged(double threshold);
@@ -90,13 +94,14 @@ private:
     void updateBatteryLevel();
     void updateBatteryStatus();
 
-    std::shared_ptr<Logger> m_logger;
-    std::unique_ptr<QTimer> m_checkTimer;
+    Clock *m_clock;
+    std::unique_ptr<ClockTimer> m_checkTimer;
 
     // Current state
     double m_currentVoltage;
     BatteryLevel m_batteryLevel;
     QString m_batteryStatus;
+    qint64 m_criticalSinceMs;   // Monotonic ms from m_clock when the level went critical
 
     // Configuration
     double m_criticalThreshold;
@@ -105,7 +110,7 @@ private:
 
     // History tracking
     struct VoltageReading {
-        qint64 timestamp;
+        qint64 timestamp;       // Monotonic ms from m_clock
         double voltage;
     };
     QList<VoltageReading> m_voltageHistory;
@@ -1,5 +1,6 @@
 #include "network_manager.h"
 #include "../core/logger.h"
+#include "../core/constants.h"
 #include <QNetworkInterface>
 #include <QNetworkRequest>
 #include <QProcess>
@@ -8,9 +9,8 @@
 
 using namespace FRCDriverStation;
 
-NetworkManager::NetworkManager(std::shared_ptr<Logger> logger, QObject *parent)
+NetworkManager::NetworkManager(QObject *parent)
     : QObject(parent)
-    , m_logger(logger)
     , m_checkTimer(std::make_unique<QTimer>(this))
     , m_networkManager(std::make_unique<QNetworkAccessManager>(this))
     , m_connectivityReply(nullptr)
@@ -25,7 +25,7 @@ NetworkManager::NetworkManager(std::shared_ptr<Logger> logger, QObject *parent)
     // Initial network info gathering
     refreshNetworkInfo();
 
-    m_logger->info("Network Manager", "Network manager initialized");
+    YADS_LOG_INFO(::Constants::LogCategories::NETWORK, "Network manager initialized");
 }
 
 NetworkManager::~NetworkManager()
@@ -34,7 +34,7 @@ NetworkManager::~NetworkManager()
         m_connectivityReply->abort();
     }
     
-    m_logger->info("Network Manager", "Network manager destroyed");
+    YADS_LOG_INFO(::Constants::LogCategories::NETWORK, "Network manager destroyed");
 }
 
 void NetworkManager::refreshNetworkInfo()
@@ -148,8 +148,8 @@ void NetworkManager::onConnectivityCheckFinished()
         m_internetConnected = connected;
         emit internetConnectedChanged(connected);
         
-        m_logger->info("Network Manager", "Internet connectivity changed", 
-                      connected ? "Connected" : "Disconnected");
+        YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                      QString("Internet connectivity changed: %1").arg(connected ? "Connected" : "Disconnected"));
     }
     
     m_connectivityReply->deleteLater();
@@ -193,8 +193,8 @@ void NetworkManager::updateNetworkInterfaces()
         
         updatePrimaryInterface();
         
-        m_logger->debug("Network Manager", "Available interfaces updated", 
-                       newInterfaces.join(", "));
+        YADS_LOG_DEBUG(::Constants::LogCategories::NETWORK,
+                       QString("Available interfaces updated: %1").arg(newInterfaces.join(", ")));
     }
 }
 
@@ -230,7 +230,8 @@ void NetworkManager::detectGateway()
         m_gatewayAddress = newGateway;
         emit gatewayAddressChanged(newGateway);
         
-        m_logger->debug("Network Manager", "Gateway address updated", newGateway);
+        YADS_LOG_DEBUG(::Constants::LogCategories::NETWORK,
+                       QString("Gateway address updated: %1").arg(newGateway));
     }
 }
 
@@ -258,6 +259,7 @@ void NetworkManager::updatePrimaryInterface()
         m_primaryInterface = newPrimary;
         emit primaryInterfaceChanged(newPrimary);
         
-        m_logger->info("Network Manager", "Primary interface changed", newPrimary);
+        YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                      QString("Primary interface changed: %1").arg(newPrimary));
     }
 }
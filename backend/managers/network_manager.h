@@ -10,8 +10,6 @@
 
 namespace FRCDriverStation {
 
-class Logger;
-
 /**
  * @brief Manages network-related functionality and diagnostics
  * 
@@ -38,7 +36,7 @@ class NetworkManager : public QObject
     Q_PROPERTY(QString gatewayAddress READ gatewayAddress NOTIFY gatewayAddressChanged)
 
 public:
-    explicit NetworkManager(std::shared_ptr<Logger> logger, QObject *parent = nullptr);
+    explicit NetworkManager(QObject *parent = nullptr);
     ~NetworkManager();
 
     // Property getters
@@ -69,7 +67,6 @@ private:
     void detectGateway();
     void updatePrimaryInterface();
 
-    std::shared_ptr<Logger> m_logger;
     std::unique_ptr<QTimer> m_checkTimer;
     std::unique_ptr<QNetworkAccessManager> m_networkManager;
     QNetworkReply *m_connectivityReply;
@@ -3,35 +3,45 @@
 #ifdef ENABLE_PRACTICE_MATCH
 
 #include "../core/logger.h"
-#include <QDateTime>
+#include "../core/constants.h"
 
 using namespace FRCDriverStation;
 
-PracticeMatchManager::PracticeMatchManager(std::shared_ptr<Logger> logger, QObject *parent)
+PracticeMatchManager::PracticeMatchManager(QObject *parent)
     : QObject(parent)
-    , m_logger(logger)
-    , m_matchTimer(std::make_unique<QTimer>(this))
+    , m_matchTimer(std::make_unique<ClockTimer>(this))
     , m_running(false)
     , m_paused(false)
     , m_currentPhase(PreMatch)
     , m_timeRemaining(0)
-    , m_phaseStartTime(0)
     , m_autonomousTime(15)
     , m_teleopTime(135)
     , m_endgameTime(30)
     , m_autoStartEnabled(false)
     , m_robotEnabled(false)
 {
-    // Setup match timer (10Hz for smooth updates)
-    m_matchTimer->setInterval(100);
-    connect(m_matchTimer.get(), &QTimer::timeout, this, &PracticeMatchManager::updateMatch);
+    // Armed for each whole second of the countdown; QML interpolates in between
+    m_matchTimer->setSingleShot(true);
+    m_matchTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_matchTimer.get(), &ClockTimer::timeout, this, &PracticeMatchManager::updateMatch);
 
-    m_logger->info("Practice Match Manager", "Practice match manager initialized");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match manager initialized");
 }
 
 PracticeMatchManager::~PracticeMatchManager()
 {
-    m_logger->info("Practice Match Manager", "Practice match manager destroyed");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match manager destroyed");
+}
+
+void PracticeMatchManager::setClock(Clock *clock)
+{
+    if (m_running) {
+        YADS_LOG_WARNING(::Constants::LogCategories::PRACTICE_MATCH,
+                         "Clock change ignored while a match is running");
+        return;
+    }
+    m_clock.setClock(clock);
+    m_matchTimer->setClock(clock);
 }
 
 void PracticeMatchManager::setAutonomousTime(int seconds)
@@ -40,7 +50,8 @@ void PracticeMatchManager::setAutonomousTime(int seconds)
         m_autonomousTime = seconds;
         emit autonomousTimeChanged(seconds);
         
-        m_logger->info("Practice Match", "Autonomous time changed", QString("%1 seconds").arg(seconds));
+        YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH,
+                      QString("Autonomous time changed: %1 seconds").arg(seconds));
     }
 }
 
@@ -50,7 +61,8 @@ void PracticeMatchManager::setTeleopTime(int seconds)
         m_teleopTime = seconds;
         emit teleopTimeChanged(seconds);
         
-        m_logger->info("Practice Match", "Teleop time changed", QString("%1 seconds").arg(seconds));
+        YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH,
+                      QString("Teleop time changed: %1 seconds").arg(seconds));
     }
 }
 
@@ -60,7 +72,8 @@ void PracticeMatchManager::setEndgameTime(int seconds)
         m_endgameTime = seconds;
         emit endgameTimeChanged(seconds);
         
-        m_logger->info("Practice Match", "Endgame time changed", QString("%1 seconds").arg(seconds));
+        YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH,
+                      QString("Endgame time changed: %1 seconds").arg(seconds));
     }
 }
 
@@ -70,7 +83,8 @@ void PracticeMatchManager::setAutoStartEnabled(bool enabled)
         m_autoStartEnabled = enabled;
         emit autoStartEnabledChanged(enabled);
         
-        m_logger->info("Practice Match", "Auto-start changed", enabled ? "Enabled" : "Disabled");
+        YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH,
+                      QString("Auto-start changed: %1").arg(enabled ? "Enabled" : "Disabled"));
     }
 }
 
@@ -82,13 +96,14 @@ void PracticeMatchManager::startMatch()
     
     m_running = true;
     m_paused = false;
+    m_clock.start(m_autonomousTime, m_teleopTime, m_endgameTime);
     transitionToPhase(Autonomous);
-    m_matchTimer->start();
+    updateMatch();
     
     emit runningChanged(true);
     emit matchStarted();
     
-    m_logger->info("Practice Match", "Practice match started");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match started");
 }
 
 void PracticeMatchManager::stopMatch()
@@ -100,13 +115,15 @@ void PracticeMatchManager::stopMatch()
     m_running = false;
     m_paused = false;
     m_matchTimer->stop();
+    // Disable is requested before the clock stops overriding the control packets
     transitionToPhase(PostMatch);
+    m_clock.stop();
     
     emit runningChanged(false);
     emit matchStopped();
     emit robotDisableRequested();
     
-    m_logger->info("Practice Match", "Practice match stopped");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match stopped");
 }
 
 void PracticeMatchManager::pauseMatch()
@@ -116,12 +133,14 @@ void PracticeMatchManager::pauseMatch()
     }
     
     m_paused = true;
+    m_clock.pause();
     m_matchTimer->stop();
     
+    emit phaseScheduleChanged();
     emit matchPaused();
     emit robotDisableRequested();
     
-    m_logger->info("Practice Match", "Practice match paused");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match paused");
 }
 
 void PracticeMatchManager::resumeMatch()
@@ -131,12 +150,13 @@ void PracticeMatchManager::resumeMatch()
     }
     
     m_paused = false;
-    m_phaseStartTime = QDateTime::currentMSecsSinceEpoch() - ((getTotalPhaseTime() - m_timeRemaining) * 1000);
-    m_matchTimer->start();
+    m_clock.resume();
+    scheduleUpdate(m_clock.read());
     
+    emit phaseScheduleChanged();
     emit matchResumed();
     
-    m_logger->info("Practice Match", "Practice match resumed");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match resumed");
 }
 
 void PracticeMatchManager::resetMatch()
@@ -147,6 +167,7 @@ void PracticeMatchManager::resetMatch()
     m_paused = false;
     m_matchTimer->stop();
     transitionToPhase(PreMatch);
+    m_clock.stop();
     
     if (wasRunning) {
         emit runningChanged(false);
@@ -154,7 +175,7 @@ void PracticeMatchManager::resetMatch()
         emit robotDisableRequested();
     }
     
-    m_logger->info("Practice Match", "Practice match reset");
+    YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH, "Practice match reset");
 }
 
 void PracticeMatchManager::loadSettings(QSettings *settings)
@@ -174,7 +195,7 @@ void PracticeMatchManager::loadSettings(QSettings *settings)
     emit endgameTimeChanged(m_endgameTime);
     emit autoStartEnabledChanged(m_autoStartEnabled);
     
-    m_logger->debug("Practice Match Manager", "Settings loaded");
+    YADS_LOG_DEBUG(::Constants::LogCategories::PRACTICE_MATCH, "Settings loaded");
 }
 
 void PracticeMatchManager::saveSettings(QSettings *settings)
@@ -188,7 +209,7 @@ void PracticeMatchManager::saveSettings(QSettings *settings)
     
     settings->endGroup();
     
-    m_logger->debug("Practice Match Manager", "Settings saved");
+    YADS_LOG_DEBUG(::Constants::LogCategories::PRACTICE_MATCH, "Settings saved");
 }
 
 void PracticeMatchManager::setEnabled(bool enabled)
@@ -201,34 +222,31 @@ void PracticeMatchManager::setEnabled(bool enabled)
     }
 }
 
+double PracticeMatchManager::phaseTimeRemaining() const
+{
+    const MatchClock::Reading reading = m_clock.read();
+    return reading.running ? double(reading.remainingNs) / MatchClock::NS_PER_SECOND : 0.0;
+}
+
 void PracticeMatchManager::updateMatch()
 {
     if (!m_running || m_paused) {
         return;
     }
     
-    updateTimeRemaining();
-    
-    // Check for phase transitions
-    if (m_timeRemaining <= 0) {
-        switch (m_currentPhase) {
-            case Autonomous:
-                transitionToPhase(Teleop);
-                break;
-            case Teleop:
-                if (m_endgameTime > 0) {
-                    transitionToPhase(Endgame);
-                } else {
-                    stopMatch();
-                }
-                break;
-            case Endgame:
-                stopMatch();
-                break;
-            default:
-                break;
-        }
+    // The transmit path has already switched modes on the packet at the deadline;
+    // this only catches the UI and RobotState up, skipping phases a late timer missed
+    const MatchClock::Reading reading = m_clock.read();
+    if (reading.phase == MatchClock::PostMatch) {
+        stopMatch();
+        return;
+    }
+    if (static_cast<int>(reading.phase) != static_cast<int>(m_currentPhase)) {
+        transitionToPhase(static_cast<MatchPhase>(reading.phase));
     }
+    
+    updateTimeRemaining(reading);
+    scheduleUpdate(reading);
 }
 
 void PracticeMatchManager::transitionToPhase(MatchPhase phase)
@@ -236,15 +254,15 @@ void PracticeMatchManager::transitionToPhase(MatchPhase phase)
     if (m_currentPhase != phase) {
         MatchPhase oldPhase = m_currentPhase;
         m_currentPhase = phase;
-        m_phaseStartTime = QDateTime::currentMSecsSinceEpoch();
         
-        updateTimeRemaining();
+        updateTimeRemaining(m_clock.read());
         
         emit currentPhaseChanged(phase);
         emit phaseChanged(phase);
+        emit phaseScheduleChanged();
         
-        m_logger->info("Practice Match", "Phase transition", 
-                      QString("From %1 to %2").arg(phaseToString(oldPhase)).arg(phaseToString(phase)));
+        YADS_LOG_INFO(::Constants::LogCategories::PRACTICE_MATCH,
+                      QString("Phase transition from %1 to %2").arg(phaseToString(oldPhase)).arg(phaseToString(phase)));
         
         // Request robot mode changes
         switch (phase) {
@@ -263,35 +281,29 @@ void PracticeMatchManager::transitionToPhase(MatchPhase phase)
     }
 }
 
-void PracticeMatchManager::updateTimeRemaining()
+void PracticeMatchManager::updateTimeRemaining(const MatchClock::Reading &reading)
 {
-    int totalPhaseTime = getTotalPhaseTime();
-    
-    if (totalPhaseTime <= 0) {
-        m_timeRemaining = 0;
-    } else {
-        qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
-        qint64 elapsedMs = currentTime - m_phaseStartTime;
-        int elapsedSeconds = static_cast<int>(elapsedMs / 1000);
-        
-        m_timeRemaining = qMax(0, totalPhaseTime - elapsedSeconds);
+    int seconds = 0;
+    if (reading.running && static_cast<int>(reading.phase) == static_cast<int>(m_currentPhase)) {
+        // Rounded up: a phase shows its full length at the start and 0 only at its deadline
+        seconds = static_cast<int>((reading.remainingNs + MatchClock::NS_PER_SECOND - 1) / MatchClock::NS_PER_SECOND);
     }
     
-    emit timeRemainingChanged(m_timeRemaining);
+    if (seconds != m_timeRemaining) {
+        m_timeRemaining = seconds;
+        emit timeRemainingChanged(seconds);
+    }
 }
 
-int PracticeMatchManager::getTotalPhaseTime() const
+void PracticeMatchManager::scheduleUpdate(const MatchClock::Reading &reading)
 {
-    switch (m_currentPhase) {
-        case Autonomous:
-            return m_autonomousTime;
-        case Teleop:
-            return m_teleopTime;
-        case Endgame:
-            return m_endgameTime;
-        default:
-            return 0;
+    // Next whole second of the countdown; phase lengths are whole seconds, so deadlines fall on one too
+    qint64 untilNs = reading.remainingNs % MatchClock::NS_PER_SECOND;
+    if (untilNs == 0) {
+        untilNs = MatchClock::NS_PER_SECOND;
     }
+    // Rounded up, so the timer never fires just before the boundary it is for
+    m_matchTimer->start(static_cast<int>((untilNs + 999999) / 1000000));
 }
 
 QString PracticeMatchManager::phaseToString(MatchPhase phase) const
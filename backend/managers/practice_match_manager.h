@@ -6,14 +6,13 @@
 #ifdef ENABLE_PRACTICE_MATCH
 
 #include <QObject>
-#include <QTimer>
 #include <QSettings>
 #include <memory>
+#include "../core/clock.h"
+#include "../core/matchclock.h"
 
 namespace FRCDriverStation {
 
-class Logger;
-
 /**
  * @brief Manages practice match timing and control
  * 
@@ -23,6 +22,11 @@ class Logger;
  * - Match state management and control
  * - Integration with robot control system
  * 
+ * Phase deadlines live in a MatchClock on the monotonic clock. The transmit
+ * path reads it for every control packet, so mode changes go out on the
+ * packet at the deadline; this class follows with signals on a timer armed
+ * for the next whole second or deadline, not on a fixed poll.
+ * 
  * Design principles:
  * - Predictable: Match timing should be consistent and reliable
  * - Configurable: Teams should be able to adjust timing
@@ -36,6 +40,10 @@ class PracticeMatchManager : public QObject
     Q_PROPERTY(bool running READ running NOTIFY runningChanged)
     Q_PROPERTY(MatchPhase currentPhase READ currentPhase NOTIFY currentPhaseChanged)
     Q_PROPERTY(int timeRemaining READ timeRemaining NOTIFY timeRemainingChanged)
+    // Exact seconds left in the phase when read; notified only when the schedule changes
+    // (start, phase, pause, resume), so QML animates it down instead of polling
+    Q_PROPERTY(double phaseTimeRemaining READ phaseTimeRemaining NOTIFY phaseScheduleChanged)
+    Q_PROPERTY(bool paused READ paused NOTIFY phaseScheduleChanged)
     Q_PROPERTY(int autonomousTime READ autonomousTime WRITE setAutonomousTime NOTIFY autonomousTimeChanged)
     Q_PROPERTY(int teleopTime READ teleopTime WRITE setTeleopTime NOTIFY teleopTimeChanged)
     Q_PROPERTY(int endgameTime READ endgameTime WRITE setEndgameTime NOTIFY endgameTimeChanged)
@@ -51,13 +59,15 @@ public:
     };
     Q_ENUM(MatchPhase)
 
-    explicit PracticeMatchManager(std::shared_ptr<Logger> logger, QObject *parent = nullptr);
+    explicit PracticeMatchManager(QObject *parent = nullptr);
     ~PracticeMatchManager();
 
     // Property getters
     bool running() const { return m_running; }
     MatchPhase currentPhase() const { return m_currentPhase; }
     int timeRemaining() const { return m_timeRemaining; }
+    double phaseTimeRemaining() const;
+    bool paused() const { return m_paused; }
     int autonomousTime() const { return m_autonomousTime; }
     int teleopTime() const { return m_teleopTime; }
     int endgameTime() const { return m_endgameTime; }
@@ -83,10 +93,16 @@ public:
     // External control (called by RobotState)
     void setEnabled(bool enabled);
 
+    // Read by the transmit path for every control packet
+    const MatchClock *matchClock() const { return &m_clock; }
+    // Time source for the schedule and its timer; set before the first match
+    void setClock(Clock *clock);
+
 signals:
     void runningChanged(bool running);
     void currentPhaseChanged(MatchPhase phase);
     void timeRemainingChanged(int seconds);
+    void phaseScheduleChanged();
     void autonomousTimeChanged(int seconds);
     void teleopTimeChanged(int seconds);
     void endgameTimeChanged(int seconds);
@@ -104,18 +120,18 @@ private slots:
 
 private:
     void transitionToPhase(MatchPhase phase);
-    void updateTimeRemaining();
+    void updateTimeRemaining(const MatchClock::Reading &reading);
+    void scheduleUpdate(const MatchClock::Reading &reading);
     QString phaseToString(MatchPhase phase) const;
 
-    std::shared_ptr<Logger> m_logger;
-    std::unique_ptr<QTimer> m_matchTimer;
+    std::unique_ptr<ClockTimer> m_matchTimer;   // Single shot, armed for the next second or deadline
+    MatchClock m_clock;
 
     // Match state
     bool m_running;
     bool m_paused;
     MatchPhase m_currentPhase;
     int m_timeRemaining;
-    qint64 m_phaseStartTime;
 
     // Configuration
     int m_autonomousTime;
@@ -132,7 +148,8 @@ private:
 // Stub implementation when practice match is disabled
 namespace FRCDriverStation {
 
-class Logger;
+class Clock;
+class MatchClock;
 
 class PracticeMatchManager : public QObject
 {
@@ -144,12 +161,14 @@ public:
     enum MatchPhase { PreMatch = 0 };
     Q_ENUM(MatchPhase)
 
-    explicit PracticeMatchManager(std::shared_ptr<Logger>, QObject *parent = nullptr) : QObject(parent) {}
+    explicit PracticeMatchManager(QObject *parent = nullptr) : QObject(parent) {}
     ~PracticeMatchManager() = default;
 
     bool running() const { return false; }
     MatchPhase currentPhase() const { return PreMatch; }
     int timeRemaining() const { return 0; }
+    double phaseTimeRemaining() const { return 0.0; }
+    bool paused() const { return false; }
     int autonomousTime() const { return 15; }
     int teleopTime() const { return 135; }
     int endgameTime() const { return 30; }
@@ -169,11 +188,14 @@ public:
     void loadSettings(QSettings *) {}
     void saveSettings(QSettings *) {}
     void setEnabled(bool) {}
+    const MatchClock *matchClock() const { return nullptr; }
+    void setClock(Clock *) {}
 
 signals:
     void runningChanged(bool);
     void currentPhaseChanged(MatchPhase);
     void timeRemainingChanged(int);
+    void phaseScheduleChanged();
     void autonomousTimeChanged(int);
     void teleopTimeChanged(int);
     void endgameTimeChanged(int);
@@ -3,39 +3,72 @@
 #include "../../controllers/controllerhidhandler.h"
 #include "../../core/logger.h"
 #include "../../core/constants.h"
+#include "../../core/tracing.h"
+#include "../../core/flightrecorder.h"
+#include "../../core/sharedstate.h"
+#include "../../core/matchclock.h"
+#include "../../fms/fmshandler.h"
 #include <QDataStream>
 #include <QNetworkDatagram>
 #include <QDebug>
 #include <QElapsedTimer>
 #include <QDir>
 #include <QRegularExpression>
+#include <QSettings>
+#include <algorithm>
+#include <cstring>
+#include <iterator>
 
 using namespace FRCDriverStation;
 using namespace FRCDriverStation::Constants;
 using namespace FRCDriverStation::Protocol;
 
-CommunicationHandler::CommunicationHandler(RobotState *robotState, 
+namespace {
+// The roboRIO's fixed address on its USB device port
+const QHostAddress USB_ROBOT_ADDRESS(QStringLiteral("172.22.11.2"));
+// A loss burst this long is a stutter the driver feels; shorter ones are only logged
+constexpr int LOSS_BURST_SNAPSHOT_MS = 250;
+}
+
+CommunicationHandler::CommunicationHandler(::RobotState *robotState, 
                                           ControllerHIDHandler *controllerHandler,
-                                          std::shared_ptr<Logger> logger,
                                           QObject *parent)
     : QObject(parent)
     , m_udpSendSocket(std::make_unique<QUdpSocket>(this))
     , m_udpReceiveSocket(std::make_unique<QUdpSocket>(this))
     , m_tcpConsoleSocket(std::make_unique<QTcpSocket>(this))
     , m_networkTablesSocket(std::make_unique<QTcpSocket>(this))
-    , m_sendTimer(std::make_unique<QTimer>(this))
+    , m_clock(Clock::system())
+    , m_sendTimer(std::make_unique<ClockTimer>(this))
     , m_consoleReconnectTimer(std::make_unique<QTimer>(this))
-    , m_watchdogTimer(std::make_unique<QTimer>(this))
-    , m_pingTimer(std::make_unique<QTimer>(this))
+    , m_watchdogTimer(std::make_unique<ClockTimer>(this))
+    , m_pingTimer(std::make_unique<ClockTimer>(this))
     , m_networkStatsTimer(std::make_unique<QTimer>(this))
     , m_networkTablesTimer(std::make_unique<QTimer>(this))
+    , m_logDrainTimer(std::make_unique<QTimer>(this))
+    , m_consoleDrainTimer(std::make_unique<QTimer>(this))
+    , m_trafficManager(std::make_unique<TrafficManager>(this))
+    , m_sessionRecorder(std::make_unique<SessionRecorder>(this))
+    , m_recordingFmsAttached(false)
+    , m_flightRecorder(nullptr)
+    , m_recordingMatchTime(0)
+    , m_sharedState(nullptr)
+    , m_sharedControllers{}
+    , m_matchClock(nullptr)
+    , m_fmsState(nullptr)
+    , m_fmsAppliedGeneration(0)
+    , m_fmsLastLatencyUs(-1)
     , m_robotState(robotState)
     , m_controllerHandler(controllerHandler)
-    , m_logger(logger)
     , m_packetCounter(0)
+    , m_lastControlFlags(0)
+    , m_emergencyStopChannel(std::make_unique<EmergencyStopChannel>(&m_packetCounter, this))
+    , m_discovery(std::make_unique<RobotDiscovery>(m_udpSendSocket.get(), Network::DS_TO_ROBOT_PORT, this))
+    , m_mdnsResolver(std::make_unique<MdnsResolver>(this))
     , m_lastPacketTime(0)
     , m_robotConnected(false)
     , m_consoleConnected(false)
+    , m_replayActive(false)
     , m_networkManager(std::make_unique<QNetworkAccessManager>(this))
     , m_logDownloadReply(nullptr)
     , m_currentFileIndex(0)
@@ -45,7 +78,15 @@ CommunicationHandler::CommunicationHandler(RobotState *robotState,
     m_udpReceiveSocket->bind(Network::ROBOT_TO_DS_PORT, QUdpSocket::ShareAddress);
     connect(m_udpReceiveSocket.get(), &QUdpSocket::readyRead, this, &CommunicationHandler::readRobotPacket);
 
-    // Setup TCP console socket
+    // Bind the send socket up front so it can be marked as real-time traffic
+    m_udpSendSocket->bind(QHostAddress::AnyIPv4, 0);
+    if (!TrafficManager::applyRealtimePriority(m_udpSendSocket.get())) {
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                         "Could not mark control socket as high priority");
+    }
+
+    // Setup TCP console socket; a bounded read buffer lets the console limit push back on the robot
+    m_tcpConsoleSocket->setReadBufferSize(TrafficManager::CONSOLE_READ_BUFFER);
     connect(m_tcpConsoleSocket.get(), &QTcpSocket::readyRead, this, &CommunicationHandler::readConsoleData);
     connect(m_tcpConsoleSocket.get(), &QTcpSocket::connected, this, &CommunicationHandler::onConsoleConnected);
     connect(m_tcpConsoleSocket.get(), &QTcpSocket::disconnected, this, &CommunicationHandler::onConsoleDisconnected);
@@ -54,7 +95,7 @@ CommunicationHandler::CommunicationHandler(RobotState *robotState,
 
     // Setup control packet timer (50Hz)
     m_sendTimer->setInterval(Network::HEARTBEAT_INTERVAL_MS);
-    connect(m_sendTimer.get(), &QTimer::timeout, this, &CommunicationHandler::sendControlPacket);
+    connect(m_sendTimer.get(), &ClockTimer::timeout, this, &CommunicationHandler::sendControlPacket);
     m_sendTimer->start();
 
     // Setup console reconnection timer
@@ -63,12 +104,12 @@ CommunicationHandler::CommunicationHandler(RobotState *robotState,
 
     // Setup watchdog timer
     m_watchdogTimer->setInterval(1000);
-    connect(m_watchdogTimer.get(), &QTimer::timeout, this, &CommunicationHandler::updateConnectionStatus);
+    connect(m_watchdogTimer.get(), &ClockTimer::timeout, this, &CommunicationHandler::updateConnectionStatus);
     m_watchdogTimer->start();
 
     // Setup network diagnostics timers
     m_pingTimer->setInterval(1000);
-    connect(m_pingTimer.get(), &QTimer::timeout, this, &CommunicationHandler::sendPing);
+    connect(m_pingTimer.get(), &ClockTimer::timeout, this, &CommunicationHandler::sendPing);
     m_pingTimer->start();
 
     m_networkStatsTimer->setInterval(5000);
@@ -78,27 +119,90 @@ CommunicationHandler::CommunicationHandler(RobotState *robotState,
     // Setup NetworkTables monitoring
     m_networkTablesTimer->setInterval(2000);
     connect(m_networkTablesTimer.get(), &QTimer::timeout, this, &CommunicationHandler::checkNetworkTablesConnection);
+    connect(m_networkTablesSocket.get(), &QTcpSocket::connected, this, &CommunicationHandler::onNetworkTablesConnected);
+    connect(m_networkTablesSocket.get(), &QAbstractSocket::errorOccurred, this, &CommunicationHandler::onNetworkTablesError);
     m_networkTablesTimer->start();
 
-    // Connect to robot state changes
-    connect(m_robotState, &RobotState::teamNumberChanged, this, &CommunicationHandler::updateTeamNumber);
-    connect(m_robotState, &RobotState::controlDataChanged, this, &CommunicationHandler::sendControlPacket);
-    connect(m_robotState, &RobotState::robotRebootRequested, this, &CommunicationHandler::sendRebootCommand);
-    connect(m_robotState, &RobotState::robotCodeRestartRequested, this, &CommunicationHandler::sendRestartCodeCommand);
-    connect(m_robotState, &RobotState::logDownloadRequested, this, &CommunicationHandler::downloadLogs);
+    // Probes go out on the control socket; answers arrive through readRobotPacket
+    connect(m_discovery.get(), &RobotDiscovery::robotFound, this, &CommunicationHandler::onRobotFound);
+    connect(m_discovery.get(), &RobotDiscovery::discoveryFailed, this, &CommunicationHandler::onDiscoveryFailed);
+    connect(m_mdnsResolver.get(), &MdnsResolver::resolved, this,
+            [this](const QString &hostName, const QList<QHostAddress> &addresses) {
+        const QString expected = robotMdnsName(m_robotState->teamNumber());
+        if (m_discovery->isRunning() && hostName.compare(expected, Qt::CaseInsensitive) == 0) {
+            for (const QHostAddress &address : addresses) {
+                m_discovery->addCandidate(address, "mDNS");
+            }
+        }
+    });
+
+    // Log downloads and the console are read at the shaped rate; these timers resume reading once tokens refill
+    m_logDrainTimer->setSingleShot(true);
+    connect(m_logDrainTimer.get(), &QTimer::timeout, this, &CommunicationHandler::drainLogDownload);
+    m_consoleDrainTimer->setSingleShot(true);
+    connect(m_consoleDrainTimer.get(), &QTimer::timeout, this, &CommunicationHandler::readConsoleData);
+    
+    // Bulk stream limits from the settings; per-stream rates go to RobotState once a second
+    QSettings settings;
+    m_trafficManager->loadSettings(&settings);
+    connect(m_trafficManager.get(), &TrafficManager::ratesUpdated, this, &CommunicationHandler::publishTrafficRates);
+
+    // Long loss bursts get a flight recorder snapshot of the packets around them
+    connect(this, &CommunicationHandler::lossBurstDetected, this, [this](quint32 packets, int durationMs) {
+        Q_UNUSED(packets)
+        if (m_flightRecorder && durationMs >= LOSS_BURST_SNAPSHOT_MS) {
+            m_flightRecorder->trigger("loss-burst");
+        }
+    });
+
+    // Record every datagram to disk; segments roll per match (see updateRecordingSegment)
+    connect(m_sessionRecorder.get(), &SessionRecorder::segmentStarted, this, [this](const QString &path) {
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Recording segment started: %1").arg(path));
+    });
+    connect(m_sessionRecorder.get(), &SessionRecorder::segmentClosed,
+            this, [this](const QString &path, quint64 records, quint64 bytes) {
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Recording segment closed: %1: %2 records, %3 KB, %4 dropped, record() cost %5")
+                      .arg(path).arg(records).arg(bytes / 1024)
+                      .arg(m_sessionRecorder->droppedRecords())
+                      .arg(m_sessionRecorder->costHistogram().summary("ns")));
+    });
+    connect(m_sessionRecorder.get(), &SessionRecorder::recordingError, this, [this](const QString &error) {
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                         QString("Session recording problem: %1").arg(error));
+    });
+    m_sessionRecorder->setTeamNumber(m_robotState->teamNumber());
+    m_sessionRecorder->start();
+    m_emergencyStopChannel->setRecorder(m_sessionRecorder.get());
+
+    // E-stop is handled on the caller's thread so the burst does not wait behind queued events
+    connect(m_emergencyStopChannel.get(), &EmergencyStopChannel::burstSent,
+            this, &CommunicationHandler::onEmergencyStopBurstSent);
+    connect(m_emergencyStopChannel.get(), &EmergencyStopChannel::burstFailed,
+            this, &CommunicationHandler::onEmergencyStopBurstFailed);
+    connect(m_robotState, &::RobotState::emergencyStopTriggered,
+            this, &CommunicationHandler::triggerEmergencyStop, Qt::DirectConnection);
+    connect(m_robotState, &::RobotState::disableTriggered,
+            this, &CommunicationHandler::triggerDisable, Qt::DirectConnection);
+    connect(m_robotState, &::RobotState::emergencyStopChanged,
+            this, &CommunicationHandler::onEmergencyStopChanged);
+
+    // Enable and mode changes go out at once instead of on the next timer tick
+    connect(m_robotState, &::RobotState::teamNumberChanged, this, &CommunicationHandler::updateTeamNumber);
+    connect(m_robotState, &::RobotState::robotEnabledChanged, this, &CommunicationHandler::sendControlPacket);
+    connect(m_robotState, &::RobotState::robotModeChanged, this, &CommunicationHandler::sendControlPacket);
 
     // Initialize network diagnostics
     m_packetsSent = 0;
     m_packetsReceived = 0;
     m_totalLatency = 0.0;
     m_latencyCount = 0;
-    m_lastBandwidthTime = QDateTime::currentMSecsSinceEpoch();
-    m_lastBandwidthBytes = 0;
 
     // Initial setup
     updateTeamNumber();
 
-    m_logger->info("Communication Handler", "Communication handler initialized");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Communication handler initialized");
 }
 
 CommunicationHandler::~CommunicationHandler() {
@@ -110,7 +214,7 @@ CommunicationHandler::~CommunicationHandler() {
         m_logDownloadReply->abort();
     }
     
-    m_logger->info("Communication Handler", "Communication handler destroyed");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Communication handler destroyed");
 }
 
 QHostAddress CommunicationHandler::calculateRobotAddress(int teamNumber) {
@@ -125,9 +229,22 @@ QHostAddress CommunicationHandler::calculateRobotAddress(int teamNumber) {
     return QHostAddress(QString("10.%1.%2.2").arg(ipPart1).arg(ipPart2));
 }
 
+void CommunicationHandler::setRobotAddressOverride(const QHostAddress &address) {
+    if (m_robotAddressOverride == address) {
+        return;
+    }
+    m_robotAddressOverride = address;
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("Robot address override %1")
+                  .arg(address.isNull() ? QString("cleared") : address.toString()));
+    updateTeamNumber();
+}
+
 void CommunicationHandler::updateTeamNumber() {
     int teamNumber = m_robotState->teamNumber();
-    m_robotAddress = calculateRobotAddress(teamNumber);
+    m_robotAddress = m_robotAddressOverride.isNull() ? calculateRobotAddress(teamNumber)
+                                                     : m_robotAddressOverride;
+    m_emergencyStopChannel->setTarget(m_robotAddress, Network::DS_TO_ROBOT_PORT);
     
     if (m_robotAddress.isNull()) {
         m_robotState->updateCommsStatus("Invalid Team #");
@@ -142,6 +259,14 @@ void CommunicationHandler::updateTeamNumber() {
     m_packetsReceived = 0;
     m_totalLatency = 0.0;
     m_latencyCount = 0;
+    m_statusSequence.reset();
+    m_lastSequenceStats = SequenceTracker::Statistics();
+    
+    // A different robot gets its own recording
+    if (m_sessionRecorder->teamNumber() != teamNumber) {
+        m_sessionRecorder->setTeamNumber(teamNumber);
+        m_sessionRecorder->rollSegment("session");
+    }
     
     // Reconnect console
     if (m_tcpConsoleSocket->state() != QAbstractSocket::UnconnectedState) {
@@ -149,8 +274,102 @@ void CommunicationHandler::updateTeamNumber() {
     }
     connectToConsole();
     
-    m_logger->info("Communication", "Team number updated", 
-                  QString("Team %1, Robot IP: %2").arg(teamNumber).arg(m_robotAddress.toString()));
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("Team number updated: Team %1, Robot IP: %2")
+                  .arg(teamNumber).arg(m_robotAddress.toString()));
+    
+    // Control packets keep going to 10.TE.AM.2 until another path answers first
+    startDiscovery();
+}
+
+void CommunicationHandler::startDiscovery() {
+    if (!m_robotAddressOverride.isNull() || m_replayActive) {
+        m_discovery->stop();
+        return;
+    }
+    const int teamNumber = m_robotState->teamNumber();
+    const QHostAddress teamAddress = calculateRobotAddress(teamNumber);
+    if (teamAddress.isNull()) {
+        m_discovery->stop();
+        return;
+    }
+    
+    // A disabled control packet: a roboRIO answers it like any other, and it enables nothing
+    DSToRobotHeader header;
+    header.packetIndex = 0;
+    header.control = 0;
+    header.request = RequestType::NORMAL;
+    header.station = static_cast<quint8>(m_robotState->station());
+    QList<JoystickData> joysticks;
+    for (int slot = 0; slot < Controllers::MAX_CONTROLLER_SLOTS; ++slot) {
+        joysticks.append(JoystickData::neutral());
+    }
+    m_discovery->start(teamNumber, {teamAddress, USB_ROBOT_ADDRESS},
+                       PacketBuilder::buildDSPacket(header, joysticks));
+    
+    // A cached mDNS answer is probed at once; otherwise it arrives through resolved()
+    const QString mdnsName = robotMdnsName(teamNumber);
+    if (m_mdnsResolver->resolve(mdnsName)) {
+        for (const QHostAddress &address : m_mdnsResolver->cachedAddresses(mdnsName)) {
+            m_discovery->addCandidate(address, "mDNS");
+        }
+    }
+}
+
+QString CommunicationHandler::robotMdnsName(int teamNumber) {
+    return QString("roboRIO-%1-FRC.local").arg(teamNumber);
+}
+
+void CommunicationHandler::onRobotFound(const QHostAddress &address, const QString &interfaceName,
+                                        qint64 elapsedMs) {
+    YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                  QString("Robot found at %1 on %2 after %3 ms")
+                  .arg(address.toString())
+                  .arg(interfaceName.isEmpty() ? QString("the default route") : interfaceName)
+                  .arg(elapsedMs));
+    if (address.isEqual(m_robotAddress, QHostAddress::TolerantConversion)) {
+        return;
+    }
+    
+    m_robotAddress = address;
+    m_emergencyStopChannel->setTarget(m_robotAddress, Network::DS_TO_ROBOT_PORT);
+    if (m_tcpConsoleSocket->state() != QAbstractSocket::UnconnectedState) {
+        m_tcpConsoleSocket->disconnectFromHost();
+    }
+    connectToConsole();
+}
+
+void CommunicationHandler::onDiscoveryFailed() {
+    // Control packets still go to the last address, so a robot that boots later is picked up
+    YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                  QString("Still sending to %1").arg(m_robotAddress.toString()));
+}
+
+void CommunicationHandler::connectToRobot() {
+    if (m_replayActive) {
+        return;
+    }
+    m_sendTimer->start();
+    m_pingTimer->start();
+    m_watchdogTimer->start();
+    m_networkTablesTimer->start();
+    updateTeamNumber();
+}
+
+void CommunicationHandler::disconnectFromRobot() {
+    m_discovery->stop();
+    m_sendTimer->stop();
+    m_pingTimer->stop();
+    m_networkTablesTimer->stop();
+    m_consoleReconnectTimer->stop();
+    if (m_tcpConsoleSocket->state() != QAbstractSocket::UnconnectedState) {
+        m_tcpConsoleSocket->disconnectFromHost();
+    }
+    if (m_robotConnected) {
+        markConnectionLost();
+    }
+    m_robotState->updateCommsStatus("No Comms");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Robot traffic stopped");
 }
 
 void CommunicationHandler::connectToConsole() {
@@ -161,44 +380,73 @@ void CommunicationHandler::connectToConsole() {
 
 void CommunicationHandler::onConsoleConnected() {
     m_consoleConnected = true;
-    m_logger->info("Console", "Console connected", m_robotAddress.toString());
+    TrafficManager::applyBulkPriority(m_tcpConsoleSocket.get());
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("Console connected: %1").arg(m_robotAddress.toString()));
 }
 
 void CommunicationHandler::onConsoleDisconnected() {
     m_consoleConnected = false;
     m_consoleReconnectTimer->start(3000);
-    m_logger->debug("Console", "Console disconnected, will retry in 3 seconds");
+    YADS_LOG_DEBUG(::Constants::LogCategories::ROBOT_COMM, "Console disconnected, will retry in 3 seconds");
 }
 
 void CommunicationHandler::onConsoleError() {
     m_consoleConnected = false;
-    m_logger->debug("Console", "Console connection error", m_tcpConsoleSocket->errorString());
+    YADS_LOG_DEBUG(::Constants::LogCategories::ROBOT_COMM,
+                   QString("Console connection error: %1").arg(m_tcpConsoleSocket->errorString()));
 }
 
 void CommunicationHandler::readConsoleData() {
-    QByteArray data = m_tcpConsoleSocket->readAll();
-    m_robotState->appendConsoleMessage(QString::fromLatin1(data));
+    qint64 pending = m_tcpConsoleSocket->bytesAvailable();
+    qint64 allowed = qMin(pending, m_trafficManager->availableBytes(TrafficManager::Console));
+    
+    if (allowed > 0) {
+        QByteArray data = m_tcpConsoleSocket->read(allowed);
+        m_trafficManager->consume(TrafficManager::Console, data.size());
+        m_trafficManager->account(TrafficManager::Console, TrafficManager::Receive, data.size());
+        m_robotState->appendConsoleMessage(QString::fromLatin1(data));
+        pending = m_tcpConsoleSocket->bytesAvailable();
+    }
+    
+    if (pending > 0 && !m_consoleDrainTimer->isActive()) {
+        int waitMs = m_trafficManager->msUntilAvailable(TrafficManager::Console, pending);
+        m_consoleDrainTimer->start(qMax(1, waitMs));
+    }
+}
+
+void CommunicationHandler::setClock(Clock *clock) {
+    m_clock = clock ? clock : Clock::system();
+    m_sendTimer->setClock(m_clock);
+    m_watchdogTimer->setClock(m_clock);
+    m_pingTimer->setClock(m_clock);
+    // Times from the old clock mean nothing on the new one
+    m_lastPacketTime = m_clock->nowMs();
+    m_pingTimestamps.clear();
 }
 
 void CommunicationHandler::sendPing() {
-    if (m_robotAddress.isNull() || !m_robotConnected) return;
+    if (m_robotAddress.isNull() || !m_robotConnected || m_replayActive) return;
     
     // Create a simple ping packet with timestamp
     QByteArray pingPacket;
     QDataStream stream(&pingPacket, QIODevice::WriteOnly);
     stream.setByteOrder(QDataStream::BigEndian);
     
-    qint64 timestamp = QDateTime::currentMSecsSinceEpoch();
+    qint64 timestamp = m_clock->currentMSecsSinceEpoch();
     stream << static_cast<quint32>(0xDEADBEEF); // Ping marker
     stream << timestamp;
     
     m_udpSendSocket->writeDatagram(pingPacket, m_robotAddress, Network::DS_TO_ROBOT_PORT + 1);
-    m_pingTimestamps[timestamp] = QDateTime::currentMSecsSinceEpoch();
+    m_trafficManager->account(TrafficManager::Ping, TrafficManager::Transmit, pingPacket.size());
+    m_sessionRecorder->record(TrafficManager::Ping, TrafficManager::Transmit, pingPacket);
+    const qint64 now = m_clock->nowMs();
+    m_pingTimestamps[timestamp] = now;
     
     // Clean up old ping timestamps (older than 5 seconds)
     auto it = m_pingTimestamps.begin();
     while (it != m_pingTimestamps.end()) {
-        if (QDateTime::currentMSecsSinceEpoch() - it.value() > 5000) {
+        if (now - it.value() > 5000) {
             it = m_pingTimestamps.erase(it);
         } else {
             ++it;
@@ -217,7 +465,7 @@ void CommunicationHandler::processPingResponse(const QByteArray &data) {
     stream >> marker >> timestamp;
     
     if (marker == 0xDEADBEEF && m_pingTimestamps.contains(timestamp)) {
-        qint64 now = QDateTime::currentMSecsSinceEpoch();
+        qint64 now = m_clock->nowMs();
         double latency = now - m_pingTimestamps[timestamp];
         
         m_totalLatency += latency;
@@ -226,6 +474,10 @@ void CommunicationHandler::processPingResponse(const QByteArray &data) {
         // Update average latency
         double avgLatency = m_totalLatency / m_latencyCount;
         m_robotState->updateNetworkLatency(avgLatency);
+        if (m_sharedState) {
+            SharedState::Update update(m_sharedState);
+            update->latency_ms = float(avgLatency);
+        }
         
         m_pingTimestamps.remove(timestamp);
     }
@@ -234,29 +486,22 @@ void CommunicationHandler::processPingResponse(const QByteArray &data) {
 void CommunicationHandler::updateNetworkStats() {
     if (!m_robotConnected) {
         m_robotState->updatePacketLoss(100.0);
-        m_robotState->updateBandwidth(0.0);
         return;
     }
     
-    // Calculate packet loss
-    if (m_packetsSent > 0) {
-        double lossRate = 100.0 * (1.0 - (double)m_packetsReceived / (double)m_packetsSent);
-        m_robotState->updatePacketLoss(qMax(0.0, lossRate));
-    }
-    
-    // Calculate bandwidth (rough estimate based on packet size and frequency)
-    qint64 now = QDateTime::currentMSecsSinceEpoch();
-    qint64 timeDiff = now - m_lastBandwidthTime;
-    
-    if (timeDiff > 0) {
-        // Estimate bytes per second (control packets are ~100 bytes each at 50Hz)
-        qint64 estimatedBytes = m_packetsReceived * 100; // Rough packet size
-        double bandwidth = (estimatedBytes * 1000.0) / timeDiff; // bytes per second
-        m_robotState->updateBandwidth(bandwidth / 1024.0); // Convert to KB/s
-        
-        m_lastBandwidthTime = now;
-        m_lastBandwidthBytes = estimatedBytes;
+    // Calculate packet loss over this interval from the status packet indices
+    const SequenceTracker::Statistics &stats = m_statusSequence.statistics();
+    qint64 received = qint64(stats.received - m_lastSequenceStats.received);
+    qint64 lost = qint64(stats.lost) - qint64(m_lastSequenceStats.lost);
+    if (received + lost > 0) {
+        double lossRate = 100.0 * qMax<qint64>(0, lost) / double(received + qMax<qint64>(0, lost));
+        m_robotState->updatePacketLoss(lossRate);
+        if (m_sharedState) {
+            SharedState::Update update(m_sharedState);
+            update->packet_loss = float(lossRate);
+        }
     }
+    m_lastSequenceStats = stats;
     
     // Reset counters periodically to prevent overflow
     if (m_packetsSent > 10000) {
@@ -265,33 +510,73 @@ void CommunicationHandler::updateNetworkStats() {
     }
 }
 
+void CommunicationHandler::publishTrafficRates() {
+    QVariantList streams;
+    for (int stream = 0; stream < TrafficManager::StreamCount; ++stream) {
+        const auto id = static_cast<TrafficManager::Stream>(stream);
+        const TrafficManager::StreamRates sent = m_trafficManager->rates(id, TrafficManager::Transmit);
+        const TrafficManager::StreamRates received = m_trafficManager->rates(id, TrafficManager::Receive);
+        streams.append(QVariantMap{
+            {"name", TrafficManager::streamName(id)},
+            {"sentBytesPerSecond", sent.bytesPerSecond},
+            {"receivedBytesPerSecond", received.bytesPerSecond},
+            {"limitBytesPerSecond", m_trafficManager->streamLimit(id)},
+        });
+    }
+    m_robotState->updateStreamRates(streams);
+    
+    // Bandwidth across every stream, measured by the traffic manager
+    m_robotState->updateBandwidth(m_trafficManager->totalBytesPerSecond() / 1024.0); // KB/s
+}
+
 void CommunicationHandler::checkNetworkTablesConnection() {
     if (m_robotAddress.isNull() || !m_robotConnected) {
         m_robotState->updateNetworkTablesStatus(false, "No Robot Connection");
         return;
     }
     
-    // NetworkTables typically runs on port 1735
-    if (m_networkTablesSocket->state() == QAbstractSocket::UnconnectedState) {
+    // NetworkTables typically runs on port 1735. The probe is asynchronous so a
+    // slow handshake never stalls the control packet timer. It is a bare connect
+    // and close with no payload, so it is counted as a packet of zero bytes.
+    const QAbstractSocket::SocketState state = m_networkTablesSocket->state();
+    if (state == QAbstractSocket::UnconnectedState) {
+        m_trafficManager->account(TrafficManager::NetworkTables, TrafficManager::Transmit, 0);
         m_networkTablesSocket->connectToHost(m_robotAddress, Network::NETWORKTABLES_PORT);
-        
-        if (m_networkTablesSocket->waitForConnected(1000)) {
-            m_robotState->updateNetworkTablesStatus(true, "Connected");
-            m_networkTablesSocket->disconnectFromHost();
-        } else {
-            m_robotState->updateNetworkTablesStatus(false, "Not Available");
-        }
+    } else if (state == QAbstractSocket::ClosingState) {
+        // The last probe connected and is still closing; not a failure
+        return;
+    } else if (state != QAbstractSocket::ConnectedState) {
+        // Previous probe never completed
+        m_networkTablesSocket->abort();
+        m_robotState->updateNetworkTablesStatus(false, "Not Available");
     }
 }
 
+void CommunicationHandler::onNetworkTablesConnected() {
+    TrafficManager::applyBulkPriority(m_networkTablesSocket.get());
+    m_robotState->updateNetworkTablesStatus(true, "Connected");
+    m_networkTablesSocket->disconnectFromHost();
+}
+
+void CommunicationHandler::onNetworkTablesError(QAbstractSocket::SocketError error) {
+    // The server closing a probe that already connected is the normal teardown
+    if (error == QAbstractSocket::RemoteHostClosedError) {
+        return;
+    }
+    m_robotState->updateNetworkTablesStatus(false, "Not Available");
+    m_networkTablesSocket->abort();
+}
+
 void CommunicationHandler::sendRebootCommand() {
     if (m_robotAddress.isNull()) return;
     
     QByteArray packet;
     buildControlPacket(packet, RequestType::REBOOT);
     m_udpSendSocket->writeDatagram(packet, m_robotAddress, Network::DS_TO_ROBOT_PORT);
+    m_trafficManager->account(TrafficManager::Control, TrafficManager::Transmit, packet.size());
+    m_sessionRecorder->record(TrafficManager::Control, TrafficManager::Transmit, packet);
     
-    m_logger->info("Robot Command", "Robot reboot command sent");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Robot reboot command sent");
 }
 
 void CommunicationHandler::sendRestartCodeCommand() {
@@ -300,30 +585,130 @@ void CommunicationHandler::sendRestartCodeCommand() {
     QByteArray packet;
     buildControlPacket(packet, RequestType::RESTART_CODE);
     m_udpSendSocket->writeDatagram(packet, m_robotAddress, Network::DS_TO_ROBOT_PORT);
+    m_trafficManager->account(TrafficManager::Control, TrafficManager::Transmit, packet.size());
+    m_sessionRecorder->record(TrafficManager::Control, TrafficManager::Transmit, packet);
     
-    m_logger->info("Robot Command", "Robot code restart command sent");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Robot code restart command sent");
 }
 
 void CommunicationHandler::sendControlPacket() {
-    if (m_robotAddress.isNull()) return;
+    TRACE_SCOPE("CommunicationHandler::sendControlPacket");
+    if (m_robotAddress.isNull() || m_replayActive) return;
     
     QByteArray packet;
     buildControlPacket(packet);
     m_udpSendSocket->writeDatagram(packet, m_robotAddress, Network::DS_TO_ROBOT_PORT);
+    m_trafficManager->account(TrafficManager::Control, TrafficManager::Transmit, packet.size());
+    m_sessionRecorder->record(TrafficManager::Control, TrafficManager::Transmit, packet);
+    if (m_flightRecorder) {
+        m_flightRecorder->recordPacket("control>", packet);
+    }
     
     m_packetsSent++;
+    if (m_sharedState) {
+        publishControlState();
+    }
+    YADS_LOG_DEBUG(::Constants::LogCategories::ROBOT_COMM,
+                   QString("Control packet %1 sent, %2 bytes").arg(m_packetsSent).arg(packet.size()));
+}
+
+void CommunicationHandler::setFmsHandler(::FMSHandler *fmsHandler) {
+    m_fmsState = fmsHandler ? fmsHandler->state() : nullptr;
+    if (fmsHandler) {
+        m_fmsAppliedGeneration = m_fmsState->read().controlGeneration;
+        connect(fmsHandler, &::FMSHandler::stateChanged,
+                this, &CommunicationHandler::onFmsStateChanged, Qt::DirectConnection);
+    }
+}
+
+void CommunicationHandler::onFmsStateChanged() {
+    // Runs inside the FMS handler's readyRead: a change to the control byte goes out
+    // now instead of waiting up to a full period for the send timer
+    const FmsState::Snapshot fms = m_fmsState->read();
+    if (fms.controlGeneration == m_fmsAppliedGeneration) {
+        return;
+    }
+    if (fms.emergencyStop) {
+        triggerEmergencyStop("FMS");
+    } else if (!fms.enabled && (m_lastControlFlags & ControlFlags::ENABLED)) {
+        triggerDisable("FMS");
+    }
+    sendControlPacket();
+    
+    // Nothing was built if there is no robot address yet; the next packet records the latency
+    if (m_fmsAppliedGeneration != fms.controlGeneration) {
+        return;
+    }
+    const QString details = QString("%1 us after the FMS packet was read; history %2")
+                            .arg(m_fmsLastLatencyUs).arg(m_fmsLatency.summary("us"));
+    if (m_fmsLastLatencyUs > Network::HEARTBEAT_INTERVAL_MS * 1000) {
+        YADS_LOG_WARNING(::Constants::LogCategories::FMS,
+                         QString("Control change sent late: %1").arg(details));
+    } else {
+        YADS_LOG_INFO(::Constants::LogCategories::FMS, QString("Control change sent: %1").arg(details));
+    }
+}
+
+void CommunicationHandler::triggerEmergencyStop(const QString &source) {
+    // May run on any thread; only latches and wakes the e-stop transmit thread
+    m_emergencyStopChannel->trigger(source);
+}
+
+void CommunicationHandler::triggerDisable(const QString &source) {
+    // Same fast path as e-stop, but the latch only lasts until RobotState reports disabled
+    m_emergencyStopChannel->trigger(EmergencyStopChannel::Disable, source);
+}
+
+void CommunicationHandler::clearEmergencyStop() {
+    m_emergencyStopChannel->clear();
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "E-stop latch cleared");
+}
+
+void CommunicationHandler::onEmergencyStopChanged(bool emergencyStop) {
+    if (!emergencyStop && m_emergencyStopChannel->isLatched()) {
+        clearEmergencyStop();
+    }
+}
+
+void CommunicationHandler::onEmergencyStopBurstSent(EmergencyStopChannel::Action action, const QString &source,
+                                                    int packets, qint64 bytes, qint64 latencyUs) {
+    m_trafficManager->account(TrafficManager::Control, TrafficManager::Transmit,
+                              bytes, packets);
+    m_packetsSent += packets;
+    
+    QString what = action == EmergencyStopChannel::EmergencyStop ? "E-stop" : "Disable";
+    YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                     QString("%1 burst sent (%2): %3 packets, first on the wire %4 us after trigger; history %5")
+                     .arg(what)
+                     .arg(source)
+                     .arg(packets)
+                     .arg(latencyUs)
+                     .arg(m_emergencyStopChannel->latencyHistogram(action).summary("us")));
+    
+    if (m_flightRecorder && action == EmergencyStopChannel::EmergencyStop) {
+        m_flightRecorder->trigger(QString("e-stop-%1").arg(source));
+    }
+}
+
+void CommunicationHandler::onEmergencyStopBurstFailed(EmergencyStopChannel::Action action, const QString &source,
+                                                      const QString &error) {
+    // The latch still holds, so the next periodic packet carries the stop
+    QString what = action == EmergencyStopChannel::EmergencyStop ? "E-stop" : "Disable";
+    YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                     QString("%1 burst could not be sent (%2): %3").arg(what).arg(source).arg(error));
 }
 
 void CommunicationHandler::buildControlPacket(QByteArray &packet, quint8 requestType) {
+    TRACE_SCOPE("CommunicationHandler::buildControlPacket");
     // Create header
     DSToRobotHeader header;
-    header.packetIndex = m_packetCounter++;
+    header.packetIndex = static_cast<quint16>(m_packetCounter.fetchAndAddRelaxed(1));
     
     // Set control flags
     header.control = 0;
-    if (m_robotState->robotMode() == RobotState::Test) 
+    if (m_robotState->robotModeValue() == ::RobotState::Test) 
         header.control |= ControlFlags::TEST_MODE;
-    if (m_robotState->robotMode() == RobotState::Autonomous) 
+    if (m_robotState->robotModeValue() == ::RobotState::Autonomous) 
         header.control |= ControlFlags::AUTONOMOUS;
     
     // CRITICAL: Only set enabled flag when robot should be enabled
@@ -331,11 +716,62 @@ void CommunicationHandler::buildControlPacket(QByteArray &packet, quint8 request
         header.control |= ControlFlags::ENABLED;
     
     // Set FMS flag if FMS is attached
-    if (m_robotState->fmsConnected()) 
+    if (m_robotState->isFMSConnected()) 
         header.control |= ControlFlags::FMS_ATTACHED;
     
+    // An attached FMS owns enable and mode. The snapshot is read here rather than
+    // through RobotState, so the first packet after an FMS packet already carries it
+    if (m_fmsState) {
+        const FmsState::Snapshot fms = m_fmsState->read();
+        if (fms.connected) {
+            header.control &= ~(ControlFlags::ENABLED | ControlFlags::AUTONOMOUS | ControlFlags::TEST_MODE);
+            header.control |= ControlFlags::FMS_ATTACHED;
+            if (fms.enabled && !fms.emergencyStop)
+                header.control |= ControlFlags::ENABLED;
+            if (fms.autonomous)
+                header.control |= ControlFlags::AUTONOMOUS;
+            if (fms.test)
+                header.control |= ControlFlags::TEST_MODE;
+        }
+        if (fms.controlGeneration != m_fmsAppliedGeneration) {
+            m_fmsAppliedGeneration = fms.controlGeneration;
+            m_fmsLastLatencyUs = qMax<qint64>(0, m_fmsState->nowNs() - fms.receivedAtNs) / 1000;
+            m_fmsLatency.record(quint64(m_fmsLastLatencyUs));
+        }
+    }
+    
+    // A practice match owns the mode: this packet carries the phase of its own send time,
+    // so auto -> teleop flips exactly at the deadline while RobotState catches up on its timer
+    if (m_matchClock && !(header.control & ControlFlags::FMS_ATTACHED)) {
+        const MatchClock::Reading match = m_matchClock->read();
+        if (match.running) {
+            header.control &= ~(ControlFlags::AUTONOMOUS | ControlFlags::TEST_MODE);
+            if (match.phase == MatchClock::Autonomous)
+                header.control |= ControlFlags::AUTONOMOUS;
+            if (match.paused || match.phase == MatchClock::PostMatch)
+                header.control &= ~ControlFlags::ENABLED;
+        }
+    }
+    
+    // A fast-path disable holds ENABLED off until RobotState itself reports disabled
+    if (m_emergencyStopChannel->isDisableLatched()) {
+        if (m_robotState->enabled()) {
+            header.control &= ~ControlFlags::ENABLED;
+        } else {
+            m_emergencyStopChannel->clearDisable();
+        }
+    }
+    
+    // A latched e-stop overrides everything until it is explicitly cleared
+    if (m_emergencyStopChannel->isLatched()) {
+        header.control |= ControlFlags::EMERGENCY_STOP;
+        header.control &= ~ControlFlags::ENABLED;
+    }
+    m_lastControlFlags = header.control;
+    
     header.request = requestType != 0 ? requestType : RequestType::NORMAL;
     header.station = static_cast<quint8>(m_robotState->station());
+    m_emergencyStopChannel->setStation(header.station);
 
     // Collect controller data from SLOTS
     QList<JoystickData> joysticks;
@@ -413,8 +849,15 @@ void CommunicationHandler::buildControlPacket(QByteArray &packet, quint8 request
 }
 
 void CommunicationHandler::readRobotPacket() {
+    TRACE_SCOPE("CommunicationHandler::readRobotPacket");
     while (m_udpReceiveSocket->hasPendingDatagrams()) {
         QNetworkDatagram datagram = m_udpReceiveSocket->receiveDatagram();
+        const QByteArray data = datagram.data();
+        
+        // A live robot must not interleave with replayed status packets
+        if (m_replayActive) {
+            continue;
+        }
         
         // Check if this is a ping response
         if (datagram.data().size() >= 12) {
@@ -424,61 +867,251 @@ void CommunicationHandler::readRobotPacket() {
             stream >> marker;
             
             if (marker == 0xDEADBEEF) {
+                m_trafficManager->account(TrafficManager::Ping, TrafficManager::Receive, datagram.data().size());
+                m_sessionRecorder->record(TrafficManager::Ping, TrafficManager::Receive, data);
                 processPingResponse(datagram.data());
                 continue; // Don't process as regular robot packet
             }
         }
         
+        // While discovering, the first path to answer becomes the robot address
+        if (m_discovery->isRunning()) {
+            m_discovery->handleResponse(datagram.senderAddress());
+        }
+        
+        m_trafficManager->account(TrafficManager::Status, TrafficManager::Receive, datagram.data().size());
+        m_sessionRecorder->record(TrafficManager::Status, TrafficManager::Receive, data);
+        if (m_flightRecorder) {
+            m_flightRecorder->recordPacket("status<", data);
+        }
         parseStatusPacket(datagram.data());
-        m_lastPacketTime = QDateTime::currentMSecsSinceEpoch();
+        markStatusReceived();
+    }
+}
+
+void CommunicationHandler::markStatusReceived() {
+    m_lastPacketTime = m_clock->nowMs();
+    m_packetsReceived++;
+    if (!m_robotConnected) {
         m_robotConnected = true;
-        m_packetsReceived++;
+        emit robotConnected();
+    }
+}
+
+void CommunicationHandler::markConnectionLost() {
+    m_robotConnected = false;
+    const SequenceTracker::BurstHistogram &bursts = m_statusSequence.burstHistogram();
+    if (bursts.totalCount() > 0) {
+        YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                      QString("Status packet loss bursts so far: %1")
+                      .arg(bursts.summary("packets")));
+    }
+    m_robotState->updateCommsStatus("No Comms");
+    m_robotState->updateRobotCodeStatus("No Code");
+    m_robotState->updateNetworkLatency(0.0);
+    m_robotState->updatePacketLoss(100.0);
+    m_robotState->updateBandwidth(0.0);
+    if (m_sharedState) {
+        SharedState::Update update(m_sharedState);
+        update->robot_connected = 0;
+        update->robot_code = 0;
+        update->latency_ms = 0.0f;
+        update->packet_loss = 100.0f;
     }
+    emit robotDisconnected();
 }
 
 void CommunicationHandler::parseStatusPacket(const QByteArray &data) {
-    RobotToDSHeader header;
-    RobotDiagnostics diagnostics;
-    MatchTiming timing;
-    
-    if (PacketBuilder::parseRobotPacket(data, header, diagnostics, timing)) {
-        // Update robot state with received data
-        m_robotState->updateRobotVoltage(header.getVoltage());
-        m_robotState->updateCpuUsage(diagnostics.cpuUsage);
-        m_robotState->updateRamUsage(diagnostics.ramUsage);
-        m_robotState->updateDiskUsage(diagnostics.diskUsage);
-        m_robotState->updateCanUtil(diagnostics.getCanUtilPercent());
-        m_robotState->updateCanBusOff(diagnostics.canBusOffCount);
-        m_robotState->updateRobotCodeStatus(diagnostics.robotCodeStatus ? "Robot Code" : "No Code");
-        m_robotState->updateMatchTime(timing.matchTimeRemaining);
+    TRACE_SCOPE("CommunicationHandler::parseStatusPacket");
+    // Split into stages so ReplayEngine can time each one separately
+    StatusFrame frame;
+    if (decodeStatusPacket(data, frame)) {
+        YADS_LOG_DEBUG(::Constants::LogCategories::ROBOT_COMM,
+                       QString("Status packet %1: status 0x%2, code %3")
+                       .arg(frame.header.packetIndex)
+                       .arg(frame.header.status, 2, 16, QChar('0'))
+                       .arg(frame.diagnostics.robotCodeStatus));
+        trackStatusSequence(frame.header.packetIndex);
+        applyStatusPacket(frame);
+    } else {
+        YADS_LOG_DEBUG(::Constants::LogCategories::ROBOT_COMM,
+                       QString("Undecodable status packet, %1 bytes").arg(data.size()));
+    }
+}
+
+bool CommunicationHandler::decodeStatusPacket(const QByteArray &data, StatusFrame &frame) {
+    return PacketBuilder::parseRobotPacket(data, frame.header, frame.diagnostics, frame.timing);
+}
+
+void CommunicationHandler::applyStatusPacket(const StatusFrame &frame) {
+    TRACE_SCOPE("CommunicationHandler::applyStatusPacket");
+    const RobotDiagnostics &diagnostics = frame.diagnostics;
+    const MatchTiming &timing = frame.timing;
+    
+    // Update robot state with received data
+    m_robotState->updateRobotVoltage(frame.header.getVoltage());
+    m_robotState->updateCpuUsage(diagnostics.cpuUsage);
+    m_robotState->updateRamUsage(diagnostics.ramUsage);
+    m_robotState->updateDiskUsage(diagnostics.diskUsage);
+    m_robotState->updateCanUtil(diagnostics.getCanUtilPercent());
+    m_robotState->updateCanBusOff(diagnostics.canBusOffCount);
+    m_robotState->updateRobotCodeStatus(diagnostics.robotCodeStatus ? "Robot Code" : "No Code");
+    m_robotState->updateMatchTime(timing.matchTimeRemaining);
+    updateRecordingSegment(timing.matchTimeRemaining);
+    
+    m_robotState->updateCommsStatus("Robot Connected");
+    
+    if (m_sharedState) {
+        SharedState::Update update(m_sharedState);
+        update->robot_connected = 1;
+        update->robot_code = diagnostics.robotCodeStatus ? 1 : 0;
+        update->robot_status = frame.header.status;
+        update->status_packets++;
+        update->battery_voltage = float(frame.header.getVoltage());
+        update->cpu_usage = float(diagnostics.cpuUsage);
+        update->can_utilization = float(diagnostics.getCanUtilPercent());
+        update->can_bus_off = diagnostics.canBusOffCount;
+        if (m_robotState->isFMSConnected()) {
+            update->match_phase = timing.matchPhase;
+            update->match_source = YADS_SHM_MATCH_FMS;
+            update->match_time_remaining = float(timing.matchTimeRemaining);
+        }
+    }
+}
+
+void CommunicationHandler::publishControlState() {
+    SharedState::Update update(m_sharedState);
+    update->team_number = quint16(m_robotState->teamNumber());
+    update->enabled = (m_lastControlFlags & ControlFlags::ENABLED) ? 1 : 0;
+    update->emergency_stop = (m_lastControlFlags & ControlFlags::EMERGENCY_STOP) ? 1 : 0;
+    update->mode = (m_lastControlFlags & ControlFlags::TEST_MODE) ? YADS_SHM_MODE_TEST
+                 : (m_lastControlFlags & ControlFlags::AUTONOMOUS) ? YADS_SHM_MODE_AUTONOMOUS
+                 : YADS_SHM_MODE_TELEOP;
+    update->control_packets++;
+    
+    // The same controller values the packet just carried
+    for (int slot = 0; slot < Controllers::MAX_CONTROLLER_SLOTS && slot < YADS_SHM_MAX_CONTROLLERS; ++slot) {
+        ControllerHIDDevice *device = m_controllerHandler->getControllerInSlot(slot);
+        yads_shm_controller &controller = update->controllers[slot];
+        if (!device || !device->isConnected()) {
+            if (controller.present) {
+                std::memset(&controller, 0, sizeof(controller));
+                std::fill(std::begin(controller.povs), std::end(controller.povs), qint16(-1));
+            }
+            m_sharedControllers[size_t(slot)] = nullptr;
+            continue;
+        }
         
-        // Update match phase based on timing and FMS status
-        if (m_robotState->fmsAttached()) {
-            RobotState::MatchPhase phase = static_cast<RobotState::MatchPhase>(timing.matchPhase);
-            m_robotState->updateMatchPhase(phase);
+        controller.present = 1;
+        controller.axis_count = quint8(qMin(device->getAxisCount(), YADS_SHM_MAX_AXES));
+        controller.button_count = quint8(qMin(device->getButtonCount(), 32));
+        controller.pov_count = quint8(qMin(device->getPOVCount(), YADS_SHM_MAX_POVS));
+        for (int axis = 0; axis < controller.axis_count; ++axis) {
+            controller.axes[axis] = device->getAxisValue(axis);
+        }
+        quint32 buttons = 0;
+        for (int button = 0; button < controller.button_count; ++button) {
+            buttons |= device->getButtonValue(button) ? (quint32(1) << button) : 0;
+        }
+        controller.buttons = buttons;
+        for (int pov = 0; pov < controller.pov_count; ++pov) {
+            controller.povs[pov] = device->getPOVValue(pov);
         }
         
-        m_robotState->updateCommsStatus("Robot Connected");
+        // Names only change with the device; converting one every packet would allocate
+        if (m_sharedControllers[size_t(slot)] != device) {
+            m_sharedControllers[size_t(slot)] = device;
+            const QByteArray name = device->name().toUtf8().left(YADS_SHM_NAME_SIZE - 1);
+            std::memset(controller.name, 0, sizeof(controller.name));
+            std::memcpy(controller.name, name.constData(), size_t(name.size()));
+        }
+    }
+}
+
+void CommunicationHandler::setReplayActive(bool active) {
+    if (m_replayActive == active) {
+        return;
+    }
+    m_replayActive = active;
+    
+    // Replayed packets carry their own sequence numbers
+    m_statusSequence.reset();
+    m_lastSequenceStats = SequenceTracker::Statistics();
+    
+    if (active) {
+        // Nothing goes on the wire, and a replay is not recorded over itself
+        m_discovery->stop();
+        m_sendTimer->stop();
+        m_pingTimer->stop();
+        m_networkTablesTimer->stop();
+        m_sessionRecorder->stop();
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      "Live robot traffic suspended for session replay");
+    } else {
+        m_robotConnected = false;
+        m_sessionRecorder->start();
+        m_sendTimer->start();
+        m_pingTimer->start();
+        m_networkTablesTimer->start();
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Live robot traffic resumed");
+    }
+}
+
+void CommunicationHandler::trackStatusSequence(quint16 packetIndex) {
+    const quint64 burstsBefore = m_statusSequence.statistics().bursts;
+    SequenceTracker::Result result = m_statusSequence.record(packetIndex);
+    const SequenceTracker::Statistics &stats = m_statusSequence.statistics();
+    
+    if (result == SequenceTracker::Result::Resynced) {
+        YADS_LOG_INFO(::Constants::LogCategories::NETWORK,
+                      QString("Status packet index resynchronised at %1").arg(packetIndex));
+    }
+    
+    if (stats.bursts != burstsBefore) {
+        // Status packets arrive at the control rate, so a burst maps directly to an outage length
+        int durationMs = static_cast<int>(stats.lastBurst) * Network::HEARTBEAT_INTERVAL_MS;
+        YADS_LOG_WARNING(::Constants::LogCategories::NETWORK,
+                         QString("Status packet loss burst: %1 packets (~%2 ms), longest %3")
+                         .arg(stats.lastBurst).arg(durationMs).arg(stats.longestBurst));
+        emit lossBurstDetected(stats.lastBurst, durationMs);
+    }
+}
+
+void CommunicationHandler::updateRecordingSegment(int matchTimeRemaining) {
+    // A match starts when the DS attaches to the FMS or the match clock starts
+    // counting down from idle; each match gets its own segment
+    const bool fmsAttached = m_robotState->isFMSConnected();
+    const bool attachedNow = fmsAttached && !m_recordingFmsAttached;
+    const bool clockStarted = matchTimeRemaining > 0 && m_recordingMatchTime <= 0;
+    m_recordingFmsAttached = fmsAttached;
+    m_recordingMatchTime = matchTimeRemaining;
+    
+    if (attachedNow) {
+        m_sessionRecorder->rollSegment("fms-match");
+    } else if (clockStarted && !fmsAttached) {
+        // On the field the attach already started this match's segment
+        m_sessionRecorder->rollSegment("match");
     }
 }
 
 void CommunicationHandler::updateConnectionStatus() {
-    qint64 currentTime = QDateTime::currentMSecsSinceEpoch();
+    qint64 currentTime = m_clock->nowMs();
     
     // Check if we haven't received a packet in over 2 seconds
     if (m_robotConnected && (currentTime - m_lastPacketTime) > Network::PACKET_TIMEOUT_MS) {
-        m_robotConnected = false;
-        m_robotState->updateCommsStatus("No Comms");
-        m_robotState->updateRobotCodeStatus("No Code");
-        m_robotState->updateNetworkLatency(0.0);
-        m_robotState->updatePacketLoss(100.0);
-        m_robotState->updateBandwidth(0.0);
+        if (m_flightRecorder) {
+            m_flightRecorder->trigger("connection-lost");
+        }
+        markConnectionLost();
+        
+        // A tether swap moves the robot to another path; probe them all again
+        startDiscovery();
     }
 }
 
 void CommunicationHandler::downloadLogs(const QString &destinationPath) {
     if (m_logDownloadReply) {
-        m_logger->warning("Log Download", "Log download already in progress");
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Log download already in progress");
         return;
     }
     
@@ -516,7 +1149,10 @@ void CommunicationHandler::requestAvailableLogFiles() {
     
     connect(m_logDownloadReply, &QNetworkReply::finished, this, [this]() {
         if (m_logDownloadReply->error() == QNetworkReply::NoError) {
-            parseLogFileList(m_logDownloadReply->readAll());
+            QByteArray listing = m_logDownloadReply->readAll();
+            m_trafficManager->account(TrafficManager::LogDownload, TrafficManager::Receive, listing.size());
+            m_trafficManager->consume(TrafficManager::LogDownload, listing.size());
+            parseLogFileList(listing);
         } else {
             m_robotState->updateLogDownloadStatus("Error: Cannot connect to robot log server");
             m_robotState->onLogDownloadCompleted(m_currentDownloadPath, false);
@@ -598,11 +1234,12 @@ void CommunicationHandler::downloadNextLogFile() {
     
     m_logDownloadReply = m_networkManager->get(request);
     
-    connect(m_logDownloadReply, &QNetworkReply::readyRead, this, [this]() {
-        if (m_downloadFile) {
-            m_downloadFile->write(m_logDownloadReply->readAll());
-        }
-    });
+    // A bounded read buffer makes QNetworkAccessManager stop reading the socket while
+    // we hold data back, so the robot's TCP window closes instead of flooding the link
+    m_logDownloadReply->setReadBufferSize(TrafficManager::LOG_DOWNLOAD_READ_BUFFER);
+    
+    connect(m_logDownloadReply, &QNetworkReply::readyRead, 
+            this, &CommunicationHandler::drainLogDownload);
     
     connect(m_logDownloadReply, &QNetworkReply::downloadProgress, 
             this, &CommunicationHandler::onLogDownloadProgress);
@@ -623,7 +1260,39 @@ void CommunicationHandler::onLogDownloadProgress(qint64 bytesReceived, qint64 by
     }
 }
 
+void CommunicationHandler::drainLogDownload() {
+    if (!m_logDownloadReply || !m_downloadFile) {
+        return;
+    }
+    
+    qint64 pending = m_logDownloadReply->bytesAvailable();
+    qint64 allowed = qMin(pending, m_trafficManager->availableBytes(TrafficManager::LogDownload));
+    
+    if (allowed > 0) {
+        QByteArray data = m_logDownloadReply->read(allowed);
+        m_trafficManager->consume(TrafficManager::LogDownload, data.size());
+        m_trafficManager->account(TrafficManager::LogDownload, TrafficManager::Receive, data.size());
+        m_downloadFile->write(data);
+        pending = m_logDownloadReply->bytesAvailable();
+    }
+    
+    if (pending > 0 && !m_logDrainTimer->isActive()) {
+        int waitMs = m_trafficManager->msUntilAvailable(TrafficManager::LogDownload, pending);
+        m_logDrainTimer->start(qMax(1, waitMs));
+    }
+}
+
 void CommunicationHandler::onLogDownloadFinished() {
+    m_logDrainTimer->stop();
+    
+    // Whatever is still buffered is bounded by the read buffer size
+    if (m_downloadFile && m_logDownloadReply && m_logDownloadReply->error() == QNetworkReply::NoError) {
+        QByteArray remaining = m_logDownloadReply->readAll();
+        m_trafficManager->consume(TrafficManager::LogDownload, remaining.size());
+        m_trafficManager->account(TrafficManager::LogDownload, TrafficManager::Receive, remaining.size());
+        m_downloadFile->write(remaining);
+    }
+    
     if (m_downloadFile) {
         m_downloadFile->close();
         m_downloadFile.reset();
@@ -643,6 +1312,7 @@ void CommunicationHandler::onLogDownloadFinished() {
 }
 
 void CommunicationHandler::onLogDownloadError() {
+    m_logDrainTimer->stop();
     QString error = m_logDownloadReply ? m_logDownloadReply->errorString() : "Unknown error";
     m_robotState->updateLogDownloadStatus(QString("Download error: %1").arg(error));
     
@@ -660,6 +1330,8 @@ void CommunicationHandler::onLogDownloadError() {
 }
 
 void CommunicationHandler::cancelLogDownload() {
+    m_logDrainTimer->stop();
+    
     if (m_logDownloadReply) {
         m_logDownloadReply->abort();
         m_logDownloadReply->deleteLater();
@@ -11,24 +11,52 @@
 #include <QNetworkReply>
 #include <QFile>
 #include <QStringList>
+#include <QAtomicInteger>
+#include <array>
 #include <memory>
 #include "packets.h"
+#include "sequencetracker.h"
+#include "trafficmanager.h"
+#include "emergencystopchannel.h"
+#include "sessionrecorder.h"
+#include "../../comms/robotdiscovery.h"
+#include "../../comms/mdnsresolver.h"
+#include "../../core/clock.h"
+#include "../../core/histogram.h"
+
+class FMSHandler;
+class RobotState;
 
 namespace FRCDriverStation {
 
-class RobotState;
 class ControllerHIDHandler;
-class Logger;
+class ReplayEngine;
+class FlightRecorder;
+class SharedState;
+class MatchClock;
+class FmsState;
+class ControllerHIDDevice;
 
 /**
  * @brief Handles all communication with the roboRIO
  * 
  * This class manages:
  * - UDP control packet transmission (DS -> Robot)
+ * - Emergency stop and disable fast path (immediate burst, latched into later packets)
  * - UDP status packet reception (Robot -> DS)  
  * - TCP console log streaming (Robot -> DS)
- * - Network connection management
+ * - Network connection management, with every robot path (10.TE.AM.2, USB,
+ *   roboRIO-TEAM-FRC.local over mDNS) probed in parallel and the first to answer taken
  * - Network diagnostics (ping, packet loss, bandwidth)
+ * - Status stream sequence tracking (loss, reordering, duplicates, loss bursts)
+ * - Per-stream bandwidth accounting and shaping of bulk streams
+ * - Session recording of every DS <-> robot datagram, one segment per match
+ * - Flight recorder packet summaries, and snapshots on e-stop and connection loss
+ * - The shared-memory state segment, updated on every control and status packet
+ * - Practice match mode changes, applied on the first packet at each phase deadline
+ * - FMS enable, mode and e-stop, sent the moment the FMS packet is read, with
+ *   FMS-to-wire latency kept in a histogram
+ * - Replay of recorded status traffic through the live decode/state pipeline
  * - Robot command transmission (reboot, restart code)
  * - Log file downloading from the robot
  * - NetworkTables monitoring
@@ -44,14 +72,53 @@ class CommunicationHandler : public QObject
     Q_OBJECT
     
 public:
-    explicit CommunicationHandler(RobotState *robotState, 
+    // Microseconds from reading an FMS packet to the control packet that carries it
+    using FmsLatencyHistogram = Log2Histogram<24>;
+    
+    explicit CommunicationHandler(::RobotState *robotState, 
                                  ControllerHIDHandler *controllerHandler,
-                                 std::shared_ptr<Logger> logger,
                                  QObject *parent = nullptr);
     ~CommunicationHandler();
     
+    const SequenceTracker &statusSequence() const { return m_statusSequence; }
+    TrafficManager *trafficManager() const { return m_trafficManager.get(); }
+    EmergencyStopChannel *emergencyStopChannel() const { return m_emergencyStopChannel.get(); }
+    SessionRecorder *sessionRecorder() const { return m_sessionRecorder.get(); }
+    
+    // Packet summaries and e-stop/connection-loss snapshots; set once at startup
+    void setFlightRecorder(FlightRecorder *recorder) { m_flightRecorder = recorder; }
+    
+    // Link, network and controller state for external tools; set once at startup
+    void setSharedState(SharedState *sharedState) { m_sharedState = sharedState; }
+    
+    // Practice match schedule, read for every control packet; set once at startup
+    void setMatchClock(const MatchClock *matchClock) { m_matchClock = matchClock; }
+    
+    // FMS snapshot, read for every control packet; control changes are sent at once. Set once at startup
+    void setFmsHandler(::FMSHandler *fmsHandler);
+    const FmsLatencyHistogram &fmsLatencyHistogram() const { return m_fmsLatency; }
+    
+    // Time source for the control, ping and watchdog timers and the packet timeout; set once at startup
+    void setClock(Clock *clock);
+    
+    // Talk to a fixed address instead of 10.TE.AM.2 (e.g. yads-robot-sim on loopback)
+    void setRobotAddressOverride(const QHostAddress &address);
+    QHostAddress robotAddressOverride() const { return m_robotAddressOverride; }
+    
+signals:
+    // First status packet after silence, and the PACKET_TIMEOUT_MS watchdog expiring
+    void robotConnected();
+    void robotDisconnected();
+    void lossBurstDetected(quint32 packets, int durationMs);
+    
 public slots:
+    // Control, ping and console traffic run from construction; these stop and restart them
+    void connectToRobot();
+    void disconnectFromRobot();
     void sendControlPacket();
+    void triggerEmergencyStop(const QString &source);
+    void triggerDisable(const QString &source);
+    void clearEmergencyStop();
     void sendRebootCommand();
     void sendRestartCodeCommand();
     void downloadLogs(const QString &destinationPath);
@@ -69,17 +136,48 @@ private slots:
     void onLogDownloadFinished();
     void onLogDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
     void onLogDownloadError();
+    void drainLogDownload();
+    void onNetworkTablesConnected();
+    void onNetworkTablesError(QAbstractSocket::SocketError error);
     void sendPing();
     void updateNetworkStats();
+    void publishTrafficRates();
     void requestAvailableLogFiles();
     void processPingResponse(const QByteArray &data);
     void updateConnectionStatus();
+    void onRobotFound(const QHostAddress &address, const QString &interfaceName, qint64 elapsedMs);
+    void onDiscoveryFailed();
+    void onEmergencyStopChanged(bool emergencyStop);
+    void onFmsStateChanged();
+    void onEmergencyStopBurstSent(EmergencyStopChannel::Action action, const QString &source,
+                                  int packets, qint64 bytes, qint64 latencyUs);
+    void onEmergencyStopBurstFailed(EmergencyStopChannel::Action action, const QString &source,
+                                    const QString &error);
 
 private:
+    friend class ReplayEngine;
+    
+    // A decoded status packet, between the decode and apply stages
+    struct StatusFrame {
+        Protocol::RobotToDSHeader header;
+        Protocol::RobotDiagnostics diagnostics;
+        Protocol::MatchTiming timing;
+    };
+    
     // Network utilities
     QHostAddress calculateRobotAddress(int teamNumber);
+    void startDiscovery();
+    static QString robotMdnsName(int teamNumber);
     void buildControlPacket(QByteArray &packet, quint8 requestType = 0);
     void parseStatusPacket(const QByteArray &data);
+    static bool decodeStatusPacket(const QByteArray &data, StatusFrame &frame);
+    void applyStatusPacket(const StatusFrame &frame);
+    void markStatusReceived();
+    void markConnectionLost();
+    void setReplayActive(bool active);
+    void trackStatusSequence(quint16 packetIndex);
+    void updateRecordingSegment(int matchTimeRemaining);
+    void publishControlState();
     void parseLogFileList(const QByteArray &data);
     void downloadNextLogFile();
     
@@ -89,34 +187,63 @@ private:
     std::unique_ptr<QTcpSocket> m_tcpConsoleSocket;
     std::unique_ptr<QTcpSocket> m_networkTablesSocket;
     
-    // Timers
-    std::unique_ptr<QTimer> m_sendTimer;
+    // Timers; the ones the connection logic depends on run on m_clock
+    Clock *m_clock;
+    std::unique_ptr<ClockTimer> m_sendTimer;
     std::unique_ptr<QTimer> m_consoleReconnectTimer;
-    std::unique_ptr<QTimer> m_watchdogTimer;
-    std::unique_ptr<QTimer> m_pingTimer;
+    std::unique_ptr<ClockTimer> m_watchdogTimer;
+    std::unique_ptr<ClockTimer> m_pingTimer;
     std::unique_ptr<QTimer> m_networkStatsTimer;
     std::unique_ptr<QTimer> m_networkTablesTimer;
+    std::unique_ptr<QTimer> m_logDrainTimer;
+    std::unique_ptr<QTimer> m_consoleDrainTimer;
+    
+    // Bandwidth accounting and shaping
+    std::unique_ptr<TrafficManager> m_trafficManager;
+    
+    // Datagram capture
+    std::unique_ptr<SessionRecorder> m_sessionRecorder;
+    bool m_recordingFmsAttached;
+    FlightRecorder *m_flightRecorder;
+    int m_recordingMatchTime;
+    
+    // Shared-memory state; the devices remember which slot names are already published
+    SharedState *m_sharedState;
+    std::array<ControllerHIDDevice *, Controllers::MAX_CONTROLLER_SLOTS> m_sharedControllers;
+    
+    const MatchClock *m_matchClock;
+    
+    // FMS control; the generation is the last one carried by a built packet
+    const FmsState *m_fmsState;
+    quint32 m_fmsAppliedGeneration;
+    qint64 m_fmsLastLatencyUs;
+    FmsLatencyHistogram m_fmsLatency;
     
     // State references
-    RobotState *m_robotState;
+    ::RobotState *m_robotState;
     ControllerHIDHandler *m_controllerHandler;
-    std::shared_ptr<Logger> m_logger;
     
     // Network state
     QHostAddress m_robotAddress;
-    quint16 m_packetCounter;
-    qint64 m_lastPacketTime;
+    QHostAddress m_robotAddressOverride;
+    QAtomicInteger<quint16> m_packetCounter;   // Shared with the e-stop transmit thread
+    quint8 m_lastControlFlags;                 // Control byte of the last built packet
+    std::unique_ptr<EmergencyStopChannel> m_emergencyStopChannel;
+    std::unique_ptr<RobotDiscovery> m_discovery;   // Team-number mode only; idle with an override
+    std::unique_ptr<MdnsResolver> m_mdnsResolver;  // Adds roboRIO-TEAM-FRC.local to discovery
+    qint64 m_lastPacketTime;                   // Monotonic ms from m_clock
     bool m_robotConnected;
     bool m_consoleConnected;
+    bool m_replayActive;   // Live status is ignored and nothing is sent while replaying
     
     // Network diagnostics state
-    QMap<qint64, qint64> m_pingTimestamps;
+    QMap<qint64, qint64> m_pingTimestamps;     // Wire timestamp -> monotonic send time
     quint32 m_packetsSent;
     quint32 m_packetsReceived;
     double m_totalLatency;
     quint32 m_latencyCount;
-    qint64 m_lastBandwidthTime;
-    qint64 m_lastBandwidthBytes;
+    SequenceTracker m_statusSequence;
+    SequenceTracker::Statistics m_lastSequenceStats;
     
     // Log download state
     std::unique_ptr<QNetworkAccessManager> m_networkManager;
@@ -0,0 +1,222 @@
+#include "emergencystopchannel.h"
+#include "packets.h"
+#include "trafficmanager.h"
+#include "sessionrecorder.h"
+#include "../../core/constants.h"
+#include "../../core/tracing.h"
+#include <QUdpSocket>
+
+using namespace FRCDriverStation;
+using namespace FRCDriverStation::Constants;
+using namespace FRCDriverStation::Protocol;
+
+EmergencyStopChannel::EmergencyStopChannel(QAtomicInteger<quint16> *packetCounter, QObject *parent)
+    : QObject(parent)
+    , m_packetCounter(packetCounter)
+    , m_recorder(nullptr)
+    , m_running(true)
+    , m_latched(false)
+    , m_disableLatched(false)
+    , m_pendingActions(0)
+    , m_station(0)
+    , m_port(Network::DS_TO_ROBOT_PORT)
+    , m_templateVersion(0)
+{
+    for (auto &timestamp : m_triggeredAtNs) {
+        timestamp.store(0, std::memory_order_relaxed);
+    }
+
+    m_clock.start();
+    rebuildTemplates();
+
+    m_thread.reset(QThread::create([this]() { run(); }));
+    m_thread->setObjectName("EmergencyStop");
+    m_thread->start(QThread::TimeCriticalPriority);
+}
+
+EmergencyStopChannel::~EmergencyStopChannel() {
+    m_running.store(false, std::memory_order_release);
+    m_wake.release();
+    m_thread->wait();
+}
+
+void EmergencyStopChannel::setTarget(const QHostAddress &address, quint16 port) {
+    QMutexLocker locker(&m_mutex);
+    m_address = address;
+    m_port = port;
+}
+
+void EmergencyStopChannel::setStation(quint8 station) {
+    // Only the control path writes the station, so the unlocked check cannot miss a change
+    if (station == m_station.load(std::memory_order_acquire)) {
+        return;
+    }
+    QMutexLocker locker(&m_mutex);
+    m_station.store(station, std::memory_order_release);
+    rebuildTemplates();
+}
+
+void EmergencyStopChannel::trigger(Action action, const QString &source) {
+    // Stamp first so the measured latency covers everything after the caller decided to stop
+    m_triggeredAtNs[action].store(m_clock.nsecsElapsed(), std::memory_order_relaxed);
+    if (action == EmergencyStop) {
+        m_latched.store(true, std::memory_order_release);
+    } else {
+        m_disableLatched.store(true, std::memory_order_release);
+    }
+
+    {
+        QMutexLocker locker(&m_mutex);
+        m_sources[action] = source;
+    }
+
+    m_pendingActions.fetch_or(1 << action, std::memory_order_acq_rel);
+    m_wake.release();
+}
+
+void EmergencyStopChannel::clear() {
+    m_latched.store(false, std::memory_order_release);
+}
+
+void EmergencyStopChannel::clearDisable() {
+    m_disableLatched.store(false, std::memory_order_release);
+}
+
+void EmergencyStopChannel::rebuildTemplates() {
+    // Caller holds m_mutex (or is the constructor)
+    QList<JoystickData> joysticks;
+    for (int slot = 0; slot < Controllers::MAX_CONTROLLER_SLOTS; ++slot) {
+        joysticks.append(JoystickData::neutral());
+    }
+
+    for (int action = 0; action < ActionCount; ++action) {
+        DSToRobotHeader header;
+        header.packetIndex = 0;
+        header.control = action == EmergencyStop ? ControlFlags::EMERGENCY_STOP : 0;
+        header.request = RequestType::NORMAL;
+        header.station = m_station.load(std::memory_order_relaxed);
+
+        QByteArray &packet = m_templates[action];
+        packet = PacketBuilder::buildDSPacket(header, joysticks);
+
+        // The checksum is a 16-bit byte sum, so only the index bytes need adding at send time
+        quint32 sum = 0;
+        for (int i = 2; i < packet.size() - 2; ++i) {
+            sum += static_cast<quint8>(packet[i]);
+        }
+        m_templateSums[action] = sum;
+    }
+    m_templateVersion++;
+}
+
+void EmergencyStopChannel::run() {
+    QUdpSocket socket;
+    socket.bind(QHostAddress::AnyIPv4, 0);
+    TrafficManager::applyRealtimePriority(&socket);
+
+    // Private copies of the templates, patched in place for every packet of a burst
+    std::array<QByteArray, ActionCount> packets;
+    std::array<quint32, ActionCount> packetSums = {};
+    quint32 packetVersion = 0;
+
+    while (true) {
+        m_wake.acquire();
+
+        // Several triggers while a burst was going out collapse into one more burst
+        m_wake.tryAcquire(m_wake.available());
+
+        // A burst triggered just before shutdown (the final disable) still goes out
+        const bool stopping = !m_running.load(std::memory_order_acquire);
+        int pending = m_pendingActions.exchange(0, std::memory_order_acq_rel);
+        if (pending == 0) {
+            if (stopping) {
+                break;
+            }
+            continue;
+        }
+
+        QHostAddress address;
+        quint16 port;
+        std::array<QString, ActionCount> sources;
+        {
+            QMutexLocker locker(&m_mutex);
+            address = m_address;
+            port = m_port;
+            sources = m_sources;
+            if (packetVersion != m_templateVersion) {
+                for (int action = 0; action < ActionCount; ++action) {
+                    packets[action] = m_templates[action];
+                    packets[action].detach();
+                    packetSums[action] = m_templateSums[action];
+                }
+                packetVersion = m_templateVersion;
+            }
+        }
+
+        for (int action = 0; action < ActionCount; ++action) {
+            if (!(pending & (1 << action))) {
+                continue;
+            }
+
+            // A disable packet carries no e-stop bit, so never send one once e-stopped
+            if (action == Disable && isLatched()) {
+                continue;
+            }
+
+            sendBurst(socket, Action(action), packets[action], packetSums[action],
+                      address, port, sources[action]);
+        }
+
+        if (stopping) {
+            break;
+        }
+    }
+}
+
+void EmergencyStopChannel::sendBurst(QUdpSocket &socket, Action action, QByteArray &packet, quint32 packetSum,
+                                     const QHostAddress &address, quint16 port, const QString &source) {
+    TRACE_SCOPE("EmergencyStopChannel::sendBurst");
+    if (address.isNull() || packet.size() < 4) {
+        emit burstFailed(action, source, "No robot address");
+        return;
+    }
+
+    char *data = packet.data();
+    const int size = packet.size();
+    qint64 latencyUs = -1;
+    int sent = 0;
+
+    for (int i = 0; i < BURST_PACKET_COUNT; ++i) {
+        // The first packet goes out at once; the rest are spread over the control period
+        if (i > 0) {
+            QThread::usleep(BURST_SPACING_US);
+        }
+
+        quint16 index = static_cast<quint16>(m_packetCounter->fetchAndAddRelaxed(1));
+        quint8 indexHigh = static_cast<quint8>(index >> 8);
+        quint8 indexLow = static_cast<quint8>(index & 0xFF);
+        quint16 checksum = static_cast<quint16>((packetSum + indexHigh + indexLow) & 0xFFFF);
+
+        data[0] = static_cast<char>(indexHigh);
+        data[1] = static_cast<char>(indexLow);
+        data[size - 2] = static_cast<char>(checksum >> 8);
+        data[size - 1] = static_cast<char>(checksum & 0xFF);
+
+        if (socket.writeDatagram(data, size, address, port) == size) {
+            sent++;
+            if (latencyUs < 0) {
+                latencyUs = (m_clock.nsecsElapsed() - m_triggeredAtNs[action].load(std::memory_order_relaxed)) / 1000;
+                m_latency[action].record(static_cast<quint64>(qMax<qint64>(latencyUs, 0)));
+            }
+            if (m_recorder) {
+                m_recorder->record(TrafficManager::Control, TrafficManager::Transmit, data, size);
+            }
+        }
+    }
+
+    if (sent == 0) {
+        emit burstFailed(action, source, socket.errorString());
+    } else {
+        emit burstSent(action, source, sent, qint64(sent) * size, latencyUs);
+    }
+}
@@ -0,0 +1,119 @@
+#ifndef EMERGENCYSTOPCHANNEL_H
+#define EMERGENCYSTOPCHANNEL_H
+
+#include <QObject>
+#include <QThread>
+#include <QSemaphore>
+#include <QMutex>
+#include <QHostAddress>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <array>
+#include <atomic>
+#include <memory>
+#include "../../core/histogram.h"
+
+class QUdpSocket;
+
+namespace FRCDriverStation {
+
+class SessionRecorder;
+
+/**
+ * @brief Dedicated transmit path for emergency stop
+ *
+ * This class manages:
+ * - Precomputed e-stop and disable control datagrams, rebuilt only when the station changes
+ * - A transmit thread with its own real-time socket that sends a burst of the matching
+ *   datagram the moment a safety action is triggered, without waiting for the 50Hz send timer.
+ *   Burst packets are spaced a few ms apart so one short outage cannot take them all
+ * - The e-stop latch, which the periodic control path folds into every later packet
+ * - A disable latch that keeps ENABLED out of control packets until RobotState catches up
+ * - Trigger-to-wire latency per action, kept in histograms for post-event audits
+ *
+ * Design principles:
+ * - Triggering is safe from any thread and never blocks: it latches, stamps and wakes
+ * - Nothing on the send path allocates, logs or touches the GUI event loop
+ * - Packet indices come from the same counter as the control stream so the robot
+ *   sees one monotonic sequence
+ */
+class EmergencyStopChannel : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Microseconds; 24 buckets reach ~8 s, far beyond anything acceptable
+    using LatencyHistogram = Log2Histogram<24>;
+
+    enum Action {
+        EmergencyStop = 0,
+        Disable,
+        ActionCount
+    };
+    Q_ENUM(Action)
+
+    static constexpr int BURST_PACKET_COUNT = 5;
+    static constexpr int BURST_SPACING_US = 3000;   // Whole burst stays within one control period
+
+    explicit EmergencyStopChannel(QAtomicInteger<quint16> *packetCounter, QObject *parent = nullptr);
+    ~EmergencyStopChannel();
+
+    void setTarget(const QHostAddress &address, quint16 port);
+    // Called for every control packet; locks only when the station actually changes
+    void setStation(quint8 station);
+
+    // Bursts are captured too; set once before the first trigger
+    void setRecorder(SessionRecorder *recorder) { m_recorder = recorder; }
+
+    // Latch e-stop and send a burst immediately; callable from any thread
+    void trigger(const QString &source) { trigger(EmergencyStop, source); }
+    void trigger(Action action, const QString &source);
+    void clear();
+    bool isLatched() const { return m_latched.load(std::memory_order_acquire); }
+
+    // Disable is latched only until the periodic path reports the robot disabled
+    void clearDisable();
+    bool isDisableLatched() const { return m_disableLatched.load(std::memory_order_acquire); }
+
+    const LatencyHistogram &latencyHistogram(Action action = EmergencyStop) const { return m_latency[action]; }
+
+signals:
+    // Emitted from the transmit thread once a burst is on the wire
+    void burstSent(EmergencyStopChannel::Action action, const QString &source,
+                   int packets, qint64 bytes, qint64 latencyUs);
+    void burstFailed(EmergencyStopChannel::Action action, const QString &source, const QString &error);
+
+private:
+    void run();
+    void rebuildTemplates();
+    void sendBurst(QUdpSocket &socket, Action action, QByteArray &packet, quint32 packetSum,
+                   const QHostAddress &address, quint16 port, const QString &source);
+
+    QAtomicInteger<quint16> *m_packetCounter;
+    SessionRecorder *m_recorder;
+    std::unique_ptr<QThread> m_thread;
+    QSemaphore m_wake;
+    std::atomic<bool> m_running;
+    std::atomic<bool> m_latched;
+    std::atomic<bool> m_disableLatched;
+    std::atomic<int> m_pendingActions;   // Bit per Action
+
+    // Trigger timestamps are nanoseconds on m_clock, shared by both threads
+    QElapsedTimer m_clock;
+    std::array<std::atomic<qint64>, ActionCount> m_triggeredAtNs;
+    std::array<LatencyHistogram, ActionCount> m_latency;
+    std::atomic<quint8> m_station;   // Written by the control path, under m_mutex when it changes
+
+    // Guarded by m_mutex; the transmit thread copies it into its own buffer
+    mutable QMutex m_mutex;
+    QHostAddress m_address;
+    quint16 m_port;
+    std::array<QByteArray, ActionCount> m_templates;
+    std::array<quint32, ActionCount> m_templateSums;   // Byte sums excluding index and checksum
+    quint32 m_templateVersion;
+    std::array<QString, ActionCount> m_sources;
+};
+
+} // namespace FRCDriverStation
+
+#endif // EMERGENCYSTOPCHANNEL_H
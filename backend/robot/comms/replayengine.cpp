@@ -0,0 +1,235 @@
+#include "replayengine.h"
+#include "communicationhandler.h"
+#include "sessionrecorder.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QMetaEnum>
+#include <limits>
+
+using namespace FRCDriverStation;
+
+ReplayEngine::ReplayEngine(CommunicationHandler *handler, QObject *parent)
+    : QObject(parent)
+    , m_handler(handler)
+    , m_stepTimer(std::make_unique<QTimer>(this))
+    , m_mode(RealTime)
+    , m_running(false)
+    , m_pending()
+    , m_hasPending(false)
+    , m_firstTimestampNs(0)
+    , m_lastTimestampNs(0)
+    , m_statusPackets(0)
+    , m_decodeFailures(0)
+    , m_skippedRecords(0)
+    , m_wallNs(0)
+{
+    m_stepTimer->setSingleShot(true);
+    m_stepTimer->setTimerType(Qt::PreciseTimer);
+    connect(m_stepTimer.get(), &QTimer::timeout, this, &ReplayEngine::step);
+}
+
+ReplayEngine::~ReplayEngine() {
+    stop();
+}
+
+bool ReplayEngine::start(const QString &path, Mode mode) {
+    stop();
+
+    if (!m_reader.open(path)) {
+        return false;
+    }
+
+    m_path = path;
+    m_mode = mode;
+    m_statusPackets = 0;
+    m_decodeFailures = 0;
+    m_skippedRecords = 0;
+    m_wallNs = 0;
+    m_allocations = AllocationCounter::Snapshot();
+    for (StageHistogram &histogram : m_stages) {
+        histogram.reset();
+    }
+
+    m_hasPending = m_reader.next(m_pending);
+    m_firstTimestampNs = m_hasPending ? m_pending.timestampNs : 0;
+    m_lastTimestampNs = m_firstTimestampNs;
+
+    m_handler->setReplayActive(true);
+    m_running = true;
+    m_wallClock.start();
+
+    emit started(path, m_reader.label());
+    m_stepTimer->start(0);
+    return true;
+}
+
+void ReplayEngine::stop() {
+    if (m_running) {
+        finish();
+    }
+}
+
+void ReplayEngine::step() {
+    if (!m_running) {
+        return;
+    }
+
+    if (m_mode == AsFastAsPossible) {
+        // Yield to the event loop between batches so queued work still runs
+        for (int processed = 0; m_hasPending && processed < FAST_BATCH_PACKETS; ++processed) {
+            feed(m_pending);
+            m_hasPending = m_reader.next(m_pending);
+        }
+    } else {
+        const qint64 elapsedNs = m_wallClock.nsecsElapsed();
+        while (m_hasPending && m_pending.timestampNs - m_firstTimestampNs <= elapsedNs) {
+            feed(m_pending);
+            m_hasPending = m_reader.next(m_pending);
+        }
+    }
+
+    emit progress(m_statusPackets);
+
+    if (!m_hasPending) {
+        finish();
+        return;
+    }
+    scheduleNext();
+}
+
+void ReplayEngine::scheduleNext() {
+    if (m_mode == AsFastAsPossible) {
+        m_stepTimer->start(0);
+        return;
+    }
+
+    const qint64 dueNs = m_pending.timestampNs - m_firstTimestampNs;
+    const qint64 waitMs = qMax<qint64>(0, (dueNs - m_wallClock.nsecsElapsed()) / 1000000);
+    m_stepTimer->start(int(qMin<qint64>(waitMs, std::numeric_limits<int>::max())));
+}
+
+void ReplayEngine::feed(const SessionReader::Record &record) {
+    m_lastTimestampNs = record.timestampNs;
+
+    // Control, ping and e-stop records are our own transmissions and pings are
+    // handled off the status path; only robot status goes through the pipeline
+    if (record.stream != TrafficManager::Status || record.direction != TrafficManager::Receive) {
+        m_skippedRecords++;
+        return;
+    }
+
+    const QByteArray data = record.toByteArray();
+    const AllocationCounter::Snapshot allocationsBefore = AllocationCounter::thread();
+
+    CommunicationHandler::StatusFrame frame;
+    const qint64 decodeStart = SessionRecorder::monotonicNs();
+    const bool decoded = CommunicationHandler::decodeStatusPacket(data, frame);
+    const qint64 decodeEnd = SessionRecorder::monotonicNs();
+    m_stages[Decode].record(quint64(decodeEnd - decodeStart));
+
+    if (!decoded) {
+        m_decodeFailures++;
+        return;
+    }
+
+    m_handler->trackStatusSequence(frame.header.packetIndex);
+    const qint64 sequenceEnd = SessionRecorder::monotonicNs();
+    m_handler->applyStatusPacket(frame);
+    m_handler->markStatusReceived();
+    const qint64 applyEnd = SessionRecorder::monotonicNs();
+
+    const AllocationCounter::Snapshot allocationsAfter = AllocationCounter::thread();
+    m_allocations.allocations += allocationsAfter.allocations - allocationsBefore.allocations;
+    m_allocations.bytes += allocationsAfter.bytes - allocationsBefore.bytes;
+
+    m_stages[Sequence].record(quint64(sequenceEnd - decodeEnd));
+    m_stages[Apply].record(quint64(applyEnd - sequenceEnd));
+    m_stages[Total].record(quint64(applyEnd - decodeStart));
+    m_statusPackets++;
+}
+
+void ReplayEngine::finish() {
+    m_stepTimer->stop();
+    m_wallNs = m_wallClock.nsecsElapsed();
+    m_running = false;
+    m_hasPending = false;
+    m_reader.close();
+    m_handler->setReplayActive(false);
+    emit finished();
+}
+
+double ReplayEngine::packetsPerSecond() const {
+    return m_wallNs > 0 ? double(m_statusPackets) * 1e9 / double(m_wallNs) : 0.0;
+}
+
+QString ReplayEngine::reportText() const {
+    const QMetaEnum stages = QMetaEnum::fromType<Stage>();
+    const double packets = double(qMax<quint64>(m_statusPackets, 1));
+
+    QString text = QString("Replay of %1 (%2)\n").arg(m_path)
+        .arg(m_mode == RealTime ? "real time" : "as fast as possible");
+    text += QString("  %1 status packets, %2 decode failures, %3 other records skipped\n")
+        .arg(m_statusPackets).arg(m_decodeFailures).arg(m_skippedRecords);
+    text += QString("  %1 s wall for %2 s recorded, %3 packets/s\n")
+        .arg(double(m_wallNs) / 1e9, 0, 'f', 3)
+        .arg(double(m_lastTimestampNs - m_firstTimestampNs) / 1e9, 0, 'f', 3)
+        .arg(packetsPerSecond(), 0, 'f', 0);
+    for (int stage = 0; stage < StageCount; ++stage) {
+        text += QString("  %1: %2\n").arg(stages.valueToKey(stage), -8)
+            .arg(m_stages[stage].summary("ns"));
+    }
+    if (AllocationCounter::isEnabled()) {
+        text += QString("  %1 allocations (%2 bytes) per packet\n")
+            .arg(double(m_allocations.allocations) / packets, 0, 'f', 2)
+            .arg(double(m_allocations.bytes) / packets, 0, 'f', 1);
+    } else {
+        text += "  Allocation counting not built in (ENABLE_ALLOCATION_COUNTING)\n";
+    }
+    return text;
+}
+
+QJsonObject ReplayEngine::report() const {
+    const QMetaEnum stages = QMetaEnum::fromType<Stage>();
+
+    QJsonObject stageObject;
+    for (int stage = 0; stage < StageCount; ++stage) {
+        const StageHistogram &histogram = m_stages[stage];
+        QJsonArray buckets;
+        for (int bucket = 0; bucket < StageHistogram::Buckets; ++bucket) {
+            buckets.append(double(histogram.count(bucket)));
+        }
+
+        QJsonObject entry;
+        entry["count"] = double(histogram.totalCount());
+        entry["p50Ns"] = double(histogram.percentile(0.50));
+        entry["p99Ns"] = double(histogram.percentile(0.99));
+        entry["maxNs"] = double(histogram.maxValue());
+        entry["log2Buckets"] = buckets;
+        stageObject[QString::fromLatin1(stages.valueToKey(stage)).toLower()] = entry;
+    }
+
+    QJsonObject object;
+    object["file"] = m_path;
+    object["mode"] = m_mode == RealTime ? "realtime" : "fast";
+    object["statusPackets"] = double(m_statusPackets);
+    object["decodeFailures"] = double(m_decodeFailures);
+    object["skippedRecords"] = double(m_skippedRecords);
+    object["wallSeconds"] = double(m_wallNs) / 1e9;
+    object["recordedSeconds"] = double(m_lastTimestampNs - m_firstTimestampNs) / 1e9;
+    object["packetsPerSecond"] = packetsPerSecond();
+    object["stages"] = stageObject;
+    if (AllocationCounter::isEnabled()) {
+        object["allocations"] = double(m_allocations.allocations);
+        object["allocatedBytes"] = double(m_allocations.bytes);
+    }
+    return object;
+}
+
+bool ReplayEngine::writeReport(const QString &path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(QJsonDocument(report()).toJson()) >= 0;
+}
@@ -0,0 +1,152 @@
+#include "sequencetracker.h"
+
+using namespace FRCDriverStation;
+
+SequenceTracker::SequenceTracker(int reorderHorizon)
+    : m_reorderHorizon(qBound(1, reorderHorizon, WINDOW_SIZE - 1))
+    , m_synchronized(false)
+    , m_head(0)
+    , m_span(0)
+    , m_consecutiveRejects(0)
+    , m_rejectedAsDuplicate(0)
+{
+}
+
+void SequenceTracker::reset() {
+    m_bits.fill(0);
+    m_synchronized = false;
+    m_head = 0;
+    m_span = 0;
+    m_consecutiveRejects = 0;
+    m_rejectedAsDuplicate = 0;
+    m_stats = Statistics();
+    m_burstHistogram.reset();
+}
+
+SequenceTracker::Result SequenceTracker::record(quint16 sequence) {
+    if (!m_synchronized) {
+        synchronize(sequence);
+        m_stats.received++;
+        return Result::InOrder;
+    }
+
+    // Signed distance from the head, correct across the 65535 -> 0 wrap
+    const int delta = static_cast<qint16>(static_cast<quint16>(sequence - m_head));
+
+    if (delta > 0) {
+        m_consecutiveRejects = 0;
+        m_rejectedAsDuplicate = 0;
+
+        if (delta >= WINDOW_SIZE) {
+            // Jumped past the whole window: everything in between is gone
+            closeBurst();
+            m_stats.lost += m_stats.pending + quint64(delta - 1);
+            m_stats.currentBurst = m_stats.pending + quint32(delta - 1);
+            closeBurst();
+            m_stats.resyncs++;
+            synchronize(sequence);
+            m_stats.received++;
+            return Result::Resynced;
+        }
+
+        advanceTo(sequence);
+        setBit(sequence);
+        m_stats.received++;
+        return delta == 1 ? Result::InOrder : Result::Gap;
+    }
+
+    const int age = -delta;
+    if (age < WINDOW_SIZE) {
+        if (age < m_span && !testBit(sequence)) {
+            m_consecutiveRejects = 0;
+            m_rejectedAsDuplicate = 0;
+            setBit(sequence);
+            m_stats.received++;
+            m_stats.reordered++;
+
+            if (age < m_reorderHorizon) {
+                m_stats.pending--;
+                return Result::Reordered;
+            }
+
+            // Already confirmed lost; correct the count but leave the burst history alone
+            m_stats.lost--;
+            m_stats.late++;
+            return Result::Late;
+        }
+
+        if (++m_consecutiveRejects < RESYNC_REJECT_THRESHOLD) {
+            if (age < m_span) {
+                m_stats.duplicates++;
+                m_rejectedAsDuplicate++;
+                return Result::Duplicate;
+            }
+            return Result::Stale;
+        }
+
+        // A run of rejects means the sender restarted inside our window
+        m_stats.duplicates -= m_rejectedAsDuplicate;
+    }
+
+    // Older than anything we track: the sender restarted its counter
+    closeBurst();
+    m_stats.lost += m_stats.pending;
+    m_stats.currentBurst = m_stats.pending;
+    closeBurst();
+    m_stats.resyncs++;
+    synchronize(sequence);
+    m_stats.received++;
+    return Result::Resynced;
+}
+
+void SequenceTracker::synchronize(quint16 sequence) {
+    m_bits.fill(0);
+    m_synchronized = true;
+    m_head = sequence;
+    m_span = 1;
+    m_consecutiveRejects = 0;
+    m_rejectedAsDuplicate = 0;
+    m_stats.pending = 0;
+    setBit(sequence);
+}
+
+void SequenceTracker::advanceTo(quint16 sequence) {
+    while (m_head != sequence) {
+        ++m_head;
+        clearBit(m_head);
+        m_stats.pending++;
+
+        if (m_span < WINDOW_SIZE) {
+            m_span++;
+        }
+        if (m_span > m_reorderHorizon) {
+            confirmSlot(static_cast<quint16>(m_head - m_reorderHorizon));
+        }
+    }
+
+    // The head itself is about to be marked received
+    m_stats.pending--;
+}
+
+void SequenceTracker::confirmSlot(quint16 sequence) {
+    if (testBit(sequence)) {
+        closeBurst();
+        return;
+    }
+
+    m_stats.pending--;
+    m_stats.lost++;
+    m_stats.currentBurst++;
+}
+
+void SequenceTracker::closeBurst() {
+    if (m_stats.currentBurst == 0) {
+        return;
+    }
+
+    m_burstHistogram.record(m_stats.currentBurst);
+    m_stats.bursts++;
+    m_stats.lastBurst = m_stats.currentBurst;
+    m_stats.longestBurst = qMax(m_stats.longestBurst, m_stats.currentBurst);
+    m_stats.currentBurst = 0;
+}
@@ -0,0 +1,105 @@
+#ifndef SEQUENCETRACKER_H
+#define SEQUENCETRACKER_H
+
+#include <QtGlobal>
+#include <array>
+#include "../../core/histogram.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Sliding-window tracker for a 16-bit packet sequence stream
+ *
+ * This class manages:
+ * - A 1024-bit receive bitmap keyed on the packet index (with wraparound)
+ * - Exact loss, reorder, duplicate and late-arrival counts
+ * - Loss burst detection with a histogram of burst lengths
+ * - Resynchronisation when the sender restarts its counter
+ *
+ * A gap is only confirmed as lost once the head of the stream has moved
+ * reorderHorizon packets past it, so a packet that is merely late is
+ * counted as reordered instead of lost. Everything is fixed-size and
+ * allocation free; one record() call per received packet is O(1) apart
+ * from the gap it skips over.
+ */
+class SequenceTracker
+{
+public:
+    static constexpr int WINDOW_SIZE = 1024;
+    static constexpr int DEFAULT_REORDER_HORIZON = 32;
+    static constexpr int RESYNC_REJECT_THRESHOLD = 8;
+
+    enum class Result {
+        InOrder,    ///< Next expected packet
+        Gap,        ///< Ahead of the expected packet, skipped ones are pending
+        Reordered,  ///< Filled a pending gap inside the reorder horizon
+        Late,       ///< Filled a gap that had already been counted as lost
+        Duplicate,  ///< Already received
+        Stale,      ///< Older than the first packet since the last resync
+        Resynced    ///< Sender restarted or jumped further than the window
+    };
+
+    struct Statistics {
+        quint64 received = 0;     ///< Unique packets accepted
+        quint64 lost = 0;         ///< Packets confirmed lost
+        quint64 reordered = 0;    ///< Packets that arrived after a later one
+        quint64 late = 0;         ///< Reordered packets that arrived past the horizon
+        quint64 duplicates = 0;   ///< Copies of packets already received
+        quint64 resyncs = 0;      ///< Counter restarts / window overruns
+        quint64 bursts = 0;       ///< Completed loss bursts
+        quint32 pending = 0;      ///< Gaps not yet confirmed lost
+        quint32 currentBurst = 0; ///< Length of the burst still in progress
+        quint32 longestBurst = 0;
+        quint32 lastBurst = 0;    ///< Length of the most recently completed burst
+
+        double lossPercent() const {
+            const quint64 expected = received + lost;
+            return expected > 0 ? (100.0 * lost) / expected : 0.0;
+        }
+    };
+
+    using BurstHistogram = Log2Histogram<12>;
+
+    explicit SequenceTracker(int reorderHorizon = DEFAULT_REORDER_HORIZON);
+
+    Result record(quint16 sequence);
+    void reset();
+
+    const Statistics &statistics() const { return m_stats; }
+    const BurstHistogram &burstHistogram() const { return m_burstHistogram; }
+    bool isSynchronized() const { return m_synchronized; }
+    quint16 highestSequence() const { return m_head; }
+
+private:
+    void synchronize(quint16 sequence);
+    void advanceTo(quint16 sequence);
+    void confirmSlot(quint16 sequence);
+    void closeBurst();
+
+    bool testBit(quint16 sequence) const {
+        const int slot = sequence % WINDOW_SIZE;
+        return (m_bits[slot / 64] >> (slot % 64)) & 1u;
+    }
+    void setBit(quint16 sequence) {
+        const int slot = sequence % WINDOW_SIZE;
+        m_bits[slot / 64] |= quint64(1) << (slot % 64);
+    }
+    void clearBit(quint16 sequence) {
+        const int slot = sequence % WINDOW_SIZE;
+        m_bits[slot / 64] &= ~(quint64(1) << (slot % 64));
+    }
+
+    std::array<quint64, WINDOW_SIZE / 64> m_bits{};
+    int m_reorderHorizon;
+    bool m_synchronized;
+    quint16 m_head;
+    int m_span;                 ///< Sequences covered since sync, saturates at WINDOW_SIZE
+    int m_consecutiveRejects;   ///< Rejected packets in a row, used to detect a silent restart
+    quint64 m_rejectedAsDuplicate;
+    Statistics m_stats;
+    BurstHistogram m_burstHistogram;
+};
+
+} // namespace FRCDriverStation
+
+#endif // SEQUENCETRACKER_H
@@ -0,0 +1,80 @@
+#ifndef SESSIONFORMAT_H
+#define SESSIONFORMAT_H
+
+#include <QtGlobal>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief On-disk layout of session recording segments (.yrec)
+ *
+ * A segment is a file header followed by 8-byte aligned records. All fields
+ * are in host byte order; recordings are read back on the machine type that
+ * wrote them. A record is committed when its size field becomes non-zero,
+ * so a reader stops at the first zero size (the unused, zero-filled tail of
+ * a preallocated segment, or the point where the process died).
+ *
+ * Timestamps are monotonic nanoseconds (std::chrono::steady_clock). The
+ * header pairs one monotonic timestamp with wall-clock time so a reader can
+ * convert. Index records are written every INDEX_INTERVAL datagrams and
+ * chain backwards from FileHeader::lastIndexOffset, which lets a reader
+ * seek by time without scanning the whole segment.
+ */
+namespace SessionFormat {
+
+static constexpr char MAGIC[8] = {'Y', 'A', 'D', 'S', 'R', 'E', 'C', '1'};
+static constexpr quint32 VERSION = 1;
+static constexpr quint32 RECORD_ALIGNMENT = 8;
+static constexpr quint32 INDEX_INTERVAL = 256;
+
+enum RecordType : quint8 {
+    Datagram = 1,
+    Index = 2
+};
+
+// Direction lives in the top bit of RecordHeader::channel, the stream in the rest
+static constexpr quint8 CHANNEL_RECEIVE = 0x80;
+static constexpr quint8 CHANNEL_STREAM_MASK = 0x7F;
+
+struct FileHeader {
+    char magic[8];
+    quint32 version;
+    quint32 headerSize;
+    quint64 capacity;              // Preallocated file size in bytes
+    quint64 usedBytes;             // Written on close; 0 if the segment was not closed cleanly
+    quint64 lastIndexOffset;       // Most recent index record, 0 if none
+    qint64 createdMsSinceEpoch;
+    qint64 createdMonotonicNs;
+    qint32 teamNumber;
+    quint32 reserved;
+    char label[48];                // NUL-terminated, e.g. "practice-match"
+};
+
+struct RecordHeader {
+    quint32 size;                  // Whole record including padding; written last
+    quint16 payloadLength;
+    quint8 type;                   // RecordType
+    quint8 channel;                // Stream | CHANNEL_RECEIVE
+    qint64 timestampNs;
+};
+
+struct IndexPayload {
+    quint64 recordOffset;          // Datagram record this index entry points at
+    quint64 previousIndexOffset;   // 0 for the first index record
+    quint64 recordNumber;          // Datagrams written to the segment before this one
+};
+
+static_assert(sizeof(FileHeader) % RECORD_ALIGNMENT == 0, "FileHeader must keep records aligned");
+static_assert(sizeof(RecordHeader) == 16, "RecordHeader layout changed");
+static_assert(sizeof(IndexPayload) == 24, "IndexPayload layout changed");
+
+inline quint32 alignedRecordSize(quint32 payloadLength) {
+    const quint32 size = quint32(sizeof(RecordHeader)) + payloadLength;
+    return (size + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+} // namespace SessionFormat
+
+} // namespace FRCDriverStation
+
+#endif // SESSIONFORMAT_H
@@ -0,0 +1,103 @@
+#include "sessionreader.h"
+#include <cstring>
+
+using namespace FRCDriverStation;
+using namespace FRCDriverStation::SessionFormat;
+
+SessionReader::SessionReader()
+    : m_base(nullptr)
+    , m_end(0)
+    , m_cursor(0)
+{
+}
+
+SessionReader::~SessionReader() {
+    close();
+}
+
+bool SessionReader::open(const QString &path) {
+    close();
+
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly)) {
+        m_error = m_file.errorString();
+        return false;
+    }
+
+    const qint64 fileSize = m_file.size();
+    if (fileSize < qint64(sizeof(FileHeader))) {
+        m_error = "File too small for a session header";
+        m_file.close();
+        return false;
+    }
+
+    m_base = m_file.map(0, fileSize);
+    if (!m_base) {
+        m_error = m_file.errorString();
+        m_file.close();
+        return false;
+    }
+
+    const FileHeader &fileHeader = header();
+    if (std::memcmp(fileHeader.magic, MAGIC, sizeof(MAGIC)) != 0 || fileHeader.version != VERSION) {
+        m_error = "Not a session recording, or an unsupported version";
+        close();
+        return false;
+    }
+
+    // usedBytes is only written on a clean close; otherwise scan to the first empty record
+    m_end = fileHeader.usedBytes != 0 ? qMin<quint64>(fileHeader.usedBytes, quint64(fileSize))
+                                      : quint64(fileSize);
+    rewind();
+    return true;
+}
+
+void SessionReader::close() {
+    if (m_base) {
+        m_file.unmap(const_cast<uchar *>(m_base));
+        m_base = nullptr;
+    }
+    if (m_file.isOpen()) {
+        m_file.close();
+    }
+    m_end = 0;
+    m_cursor = 0;
+}
+
+QString SessionReader::label() const {
+    const FileHeader &fileHeader = header();
+    return QString::fromUtf8(fileHeader.label, int(qstrnlen(fileHeader.label, sizeof(fileHeader.label))));
+}
+
+void SessionReader::rewind() {
+    m_cursor = header().headerSize;
+}
+
+bool SessionReader::next(Record &record) {
+    while (m_cursor + sizeof(RecordHeader) <= m_end) {
+        const RecordHeader *recordHeader = reinterpret_cast<const RecordHeader *>(m_base + m_cursor);
+        if (recordHeader->size == 0 || m_cursor + recordHeader->size > m_end
+            || sizeof(RecordHeader) + recordHeader->payloadLength > recordHeader->size) {
+            // Uncommitted or torn record: this is where the writer stopped
+            m_cursor = m_end;
+            return false;
+        }
+
+        const quint64 recordOffset = m_cursor;
+        m_cursor += recordHeader->size;
+
+        if (recordHeader->type != Datagram) {
+            continue;
+        }
+
+        record.stream = TrafficManager::Stream(recordHeader->channel & CHANNEL_STREAM_MASK);
+        record.direction = (recordHeader->channel & CHANNEL_RECEIVE) ? TrafficManager::Receive
+                                                                       : TrafficManager::Transmit;
+        record.timestampNs = recordHeader->timestampNs;
+        record.data = reinterpret_cast<const char *>(m_base + recordOffset + sizeof(RecordHeader));
+        record.size = recordHeader->payloadLength;
+        return true;
+    }
+
+    return false;
+}
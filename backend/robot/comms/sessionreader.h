@@ -0,0 +1,59 @@
+#ifndef SESSIONREADER_H
+#define SESSIONREADER_H
+
+#include <QFile>
+#include <QString>
+#include "sessionformat.h"
+#include "trafficmanager.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Sequential reader for session recording segments
+ *
+ * Maps a .yrec segment read-only and walks its datagram records in the
+ * order they were committed. Works on cleanly closed segments and on
+ * segments left behind by a crash (reading stops at the first
+ * uncommitted record). Payload pointers stay valid until close().
+ */
+class SessionReader
+{
+public:
+    struct Record {
+        TrafficManager::Stream stream;
+        TrafficManager::Direction direction;
+        qint64 timestampNs;
+        const char *data;
+        int size;
+
+        QByteArray toByteArray() const { return QByteArray::fromRawData(data, size); }
+    };
+
+    SessionReader();
+    ~SessionReader();
+
+    bool open(const QString &path);
+    void close();
+    bool isOpen() const { return m_base != nullptr; }
+    QString errorString() const { return m_error; }
+
+    const SessionFormat::FileHeader &header() const {
+        return *reinterpret_cast<const SessionFormat::FileHeader *>(m_base);
+    }
+    QString label() const;
+
+    // Skips index records; returns false at the end of the segment
+    bool next(Record &record);
+    void rewind();
+
+private:
+    QFile m_file;
+    const uchar *m_base;
+    quint64 m_end;
+    quint64 m_cursor;
+    QString m_error;
+};
+
+} // namespace FRCDriverStation
+
+#endif // SESSIONREADER_H
@@ -0,0 +1,386 @@
+#include "sessionrecorder.h"
+#include <QDir>
+#include <QDateTime>
+#include <QFileInfo>
+#include <QRegularExpression>
+#include <QStandardPaths>
+#include <QThread>
+#include <chrono>
+#include <cstring>
+
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
+using namespace FRCDriverStation;
+using namespace FRCDriverStation::SessionFormat;
+
+namespace {
+
+// Commit helpers for fields that readers poll while we write
+void storeRelease(quint32 *field, quint32 value) {
+    reinterpret_cast<std::atomic<quint32> *>(field)->store(value, std::memory_order_release);
+}
+
+void storeRelease(quint64 *field, quint64 value) {
+    reinterpret_cast<std::atomic<quint64> *>(field)->store(value, std::memory_order_release);
+}
+
+// Reserves real blocks for the whole segment. With a sparse file a full disk only
+// shows up when a store into the mapping faults, and that is a SIGBUS, not an error.
+bool preallocate(QFile &file, qint64 size, QString *errorString) {
+#ifdef Q_OS_LINUX
+    const int result = posix_fallocate(file.handle(), 0, size);
+    if (result != 0) {
+        *errorString = QString::fromLocal8Bit(strerror(result));
+        return false;
+    }
+    return true;
+#else
+    // No posix_fallocate on macOS; Windows allocates the blocks when the file is extended
+    if (!file.resize(size)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+#endif
+}
+
+} // namespace
+
+SessionRecorder::SessionRecorder(QObject *parent)
+    : QObject(parent)
+    , m_segment(nullptr)
+    , m_writers(0)
+    , m_segmentBytes(DEFAULT_SEGMENT_BYTES)
+    , m_teamNumber(0)
+    , m_workerRunning(false)
+    , m_droppedRecords(0)
+{
+}
+
+SessionRecorder::~SessionRecorder() {
+    stop();
+}
+
+QString SessionRecorder::defaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation) + "/recordings";
+}
+
+qint64 SessionRecorder::monotonicNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool SessionRecorder::start(const QString &directory, quint64 segmentBytes) {
+    QMutexLocker locker(&m_rollMutex);
+    if (m_segment.load(std::memory_order_acquire)) {
+        return true;
+    }
+
+    m_directory = directory.isEmpty() ? defaultDirectory() : directory;
+    m_segmentBytes = qMax<quint64>(segmentBytes, 1024 * 1024);
+
+    if (!QDir().mkpath(m_directory)) {
+        emit recordingError(QString("Cannot create %1").arg(m_directory));
+        return false;
+    }
+
+    Segment *segment = openSegment("session");
+    if (!segment) {
+        return false;
+    }
+
+    m_segment.store(segment, std::memory_order_seq_cst);
+    locker.unlock();
+
+    // Rolls and pruning happen on the worker from here on
+    {
+        QMutexLocker workLocker(&m_workMutex);
+        m_workerRunning = true;
+    }
+    m_worker.reset(QThread::create([this]() { runWorker(); }));
+    m_worker->setObjectName("SessionRecorder");
+    m_worker->start(QThread::LowPriority);
+    return true;
+}
+
+void SessionRecorder::stop() {
+    // Pending rolls are dropped; the segment they would have closed is closed here
+    stopWorker();
+
+    QMutexLocker locker(&m_rollMutex);
+    Segment *segment = m_segment.exchange(nullptr, std::memory_order_seq_cst);
+    if (segment) {
+        closeSegment(segment);
+    }
+}
+
+QString SessionRecorder::currentSegmentPath() const {
+    QMutexLocker locker(&m_rollMutex);
+    return m_currentPath;
+}
+
+SessionRecorder::Segment *SessionRecorder::acquireSegment() {
+    // Announce ourselves before looking at the segment. Pairs with the swap before
+    // closeSegment(): either closeSegment() sees this writer and waits, or this load
+    // sees the new segment. The count lives here rather than in the segment, so no
+    // writer ever touches a segment that may already be gone. seq_cst on both sides,
+    // as with acquire/release the increment and the load may reorder.
+    m_writers.fetch_add(1, std::memory_order_seq_cst);
+    Segment *segment = m_segment.load(std::memory_order_seq_cst);
+    if (!segment) {
+        releaseSegment();
+    }
+    return segment;
+}
+
+void SessionRecorder::releaseSegment() {
+    m_writers.fetch_sub(1, std::memory_order_release);
+}
+
+bool SessionRecorder::record(TrafficManager::Stream stream, TrafficManager::Direction direction,
+                             const char *data, int size) {
+    const qint64 timestampNs = monotonicNs();
+
+    if (size < 0 || size > 0xFFFF) {
+        return false;
+    }
+
+    Segment *segment = acquireSegment();
+    if (!segment) {
+        return false;
+    }
+
+    const quint32 recordSize = alignedRecordSize(quint32(size));
+    const quint64 offset = segment->writeOffset.fetch_add(recordSize, std::memory_order_relaxed);
+
+    if (offset + recordSize > segment->capacity) {
+        m_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+        if (!segment->full.exchange(true)) {
+            QMetaObject::invokeMethod(this, "onSegmentFull", Qt::QueuedConnection);
+        }
+        releaseSegment();
+        return false;
+    }
+
+    uchar *at = segment->base + offset;
+    RecordHeader *header = reinterpret_cast<RecordHeader *>(at);
+    header->payloadLength = quint16(size);
+    header->type = Datagram;
+    header->channel = quint8(stream & CHANNEL_STREAM_MASK)
+                    | (direction == TrafficManager::Receive ? CHANNEL_RECEIVE : 0);
+    header->timestampNs = timestampNs;
+    std::memcpy(at + sizeof(RecordHeader), data, size_t(size));
+    storeRelease(&header->size, recordSize);
+
+    const quint64 recordNumber = segment->recordCount.fetch_add(1, std::memory_order_relaxed);
+    if (recordNumber % INDEX_INTERVAL == 0) {
+        writeIndex(segment, offset, recordNumber, timestampNs);
+    }
+
+    releaseSegment();
+
+    m_cost.record(quint64(qMax<qint64>(monotonicNs() - timestampNs, 0)));
+    return true;
+}
+
+void SessionRecorder::writeIndex(Segment *segment, quint64 recordOffset, quint64 recordNumber, qint64 timestampNs) {
+    const quint32 recordSize = alignedRecordSize(sizeof(IndexPayload));
+    const quint64 offset = segment->writeOffset.fetch_add(recordSize, std::memory_order_relaxed);
+    if (offset + recordSize > segment->capacity) {
+        return;
+    }
+
+    FileHeader *fileHeader = reinterpret_cast<FileHeader *>(segment->base);
+    quint64 *lastIndex = &fileHeader->lastIndexOffset;
+
+    uchar *at = segment->base + offset;
+    RecordHeader *header = reinterpret_cast<RecordHeader *>(at);
+    IndexPayload *payload = reinterpret_cast<IndexPayload *>(at + sizeof(RecordHeader));
+    payload->recordOffset = recordOffset;
+    payload->previousIndexOffset = reinterpret_cast<std::atomic<quint64> *>(lastIndex)->load(std::memory_order_acquire);
+    payload->recordNumber = recordNumber;
+    header->payloadLength = sizeof(IndexPayload);
+    header->type = Index;
+    header->channel = 0;
+    header->timestampNs = timestampNs;
+    storeRelease(&header->size, recordSize);
+
+    storeRelease(lastIndex, offset);
+}
+
+SessionRecorder::Segment *SessionRecorder::openSegment(const QString &label) {
+    // Caller holds m_rollMutex
+    QString safeLabel = label;
+    safeLabel.replace(QRegularExpression("[^A-Za-z0-9_-]"), "_");
+
+    const QDateTime now = QDateTime::currentDateTime();
+    const QString path = QString("%1/%2_team%3_%4.yrec")
+        .arg(m_directory)
+        .arg(now.toString("yyyyMMdd-HHmmss-zzz"))
+        .arg(teamNumber())
+        .arg(safeLabel);
+
+    std::unique_ptr<Segment> segment = std::make_unique<Segment>();
+    segment->file.setFileName(path);
+    segment->capacity = m_segmentBytes;
+    segment->label = label;
+
+    // Sized once up front so the mapping never grows
+    if (!segment->file.open(QIODevice::ReadWrite)) {
+        emit recordingError(QString("Cannot create %1: %2").arg(path).arg(segment->file.errorString()));
+        return nullptr;
+    }
+    QString error;
+    if (!preallocate(segment->file, qint64(segment->capacity), &error)) {
+        emit recordingError(QString("Cannot allocate %1: %2").arg(path).arg(error));
+        segment->file.close();
+        segment->file.remove();
+        return nullptr;
+    }
+
+    segment->base = segment->file.map(0, qint64(segment->capacity));
+    if (!segment->base) {
+        emit recordingError(QString("Cannot map %1: %2").arg(path).arg(segment->file.errorString()));
+        segment->file.close();
+        segment->file.remove();
+        return nullptr;
+    }
+
+    FileHeader *header = reinterpret_cast<FileHeader *>(segment->base);
+    std::memset(header, 0, sizeof(FileHeader));
+    std::memcpy(header->magic, MAGIC, sizeof(header->magic));
+    header->version = VERSION;
+    header->headerSize = sizeof(FileHeader);
+    header->capacity = segment->capacity;
+    header->createdMsSinceEpoch = now.toMSecsSinceEpoch();
+    header->createdMonotonicNs = monotonicNs();
+    header->teamNumber = teamNumber();
+    const QByteArray labelBytes = label.toUtf8().left(sizeof(header->label) - 1);
+    std::memcpy(header->label, labelBytes.constData(), size_t(labelBytes.size()));
+
+    segment->writeOffset.store(sizeof(FileHeader));
+    m_currentPath = path;
+
+    emit segmentStarted(path);
+    return segment.release();
+}
+
+void SessionRecorder::closeSegment(Segment *segment) {
+    // Caller holds m_rollMutex and has already swapped the segment out (seq_cst).
+    // Writers of the new segment are counted too; each holds it for one memcpy.
+    while (m_writers.load(std::memory_order_seq_cst) != 0) {
+        QThread::yieldCurrentThread();
+    }
+
+    const quint64 usedBytes = qMin(segment->writeOffset.load(), segment->capacity);
+    FileHeader *header = reinterpret_cast<FileHeader *>(segment->base);
+    storeRelease(&header->usedBytes, usedBytes);
+
+    const QString path = segment->file.fileName();
+    const quint64 records = segment->recordCount.load();
+
+    segment->file.unmap(segment->base);
+    segment->file.resize(qint64(usedBytes));
+    segment->file.close();
+    delete segment;
+
+    emit segmentClosed(path, records, usedBytes);
+}
+
+void SessionRecorder::rollSegment(const QString &label) {
+    queueRoll(label, false);
+}
+
+void SessionRecorder::onSegmentFull() {
+    // Only if no roll has replaced the full segment by the time the worker gets to it
+    queueRoll(QString(), true);
+}
+
+void SessionRecorder::queueRoll(const QString &label, bool onlyIfFull) {
+    QMutexLocker locker(&m_workMutex);
+    if (!m_workerRunning) {
+        return;
+    }
+    m_pendingRolls.enqueue({label, onlyIfFull});
+    m_wake.wakeOne();
+}
+
+void SessionRecorder::stopWorker() {
+    {
+        QMutexLocker locker(&m_workMutex);
+        if (!m_workerRunning) {
+            return;
+        }
+        m_workerRunning = false;
+        m_pendingRolls.clear();
+        m_wake.wakeAll();
+    }
+
+    m_worker->wait();
+    m_worker.reset();
+}
+
+void SessionRecorder::runWorker() {
+    // Whatever piled up while recording was stopped
+    pruneDirectory();
+
+    QMutexLocker locker(&m_workMutex);
+    while (true) {
+        while (m_workerRunning && m_pendingRolls.isEmpty()) {
+            m_wake.wait(&m_workMutex);
+        }
+        if (!m_workerRunning) {
+            break;
+        }
+
+        const PendingRoll roll = m_pendingRolls.dequeue();
+        locker.unlock();
+        performRoll(roll);
+        locker.relock();
+    }
+}
+
+void SessionRecorder::performRoll(const PendingRoll &roll) {
+    QMutexLocker locker(&m_rollMutex);
+    Segment *current = m_segment.load(std::memory_order_acquire);
+    if (!current || (roll.onlyIfFull && !current->full.load())) {
+        return;
+    }
+
+    Segment *next = openSegment(roll.label.isEmpty() ? current->label : roll.label);
+    if (!next) {
+        // Keep recording into the old segment rather than losing everything
+        return;
+    }
+
+    Segment *previous = m_segment.exchange(next, std::memory_order_seq_cst);
+    closeSegment(previous);
+    locker.unlock();
+
+    pruneDirectory();
+}
+
+void SessionRecorder::pruneDirectory() {
+    QDir dir(m_directory);
+    QFileInfoList segments = dir.entryInfoList(QStringList() << "*.yrec", QDir::Files, QDir::Time | QDir::Reversed);
+
+    quint64 total = 0;
+    for (const QFileInfo &info : segments) {
+        total += quint64(info.size());
+    }
+
+    const QString current = currentSegmentPath();
+    for (const QFileInfo &info : segments) {
+        if (total <= MAX_RECORDING_DIRECTORY_BYTES) {
+            break;
+        }
+        if (info.absoluteFilePath() == QFileInfo(current).absoluteFilePath()) {
+            continue;
+        }
+        if (QFile::remove(info.absoluteFilePath())) {
+            total -= quint64(info.size());
+        }
+    }
+}
@@ -0,0 +1,140 @@
+#ifndef SESSIONRECORDER_H
+#define SESSIONRECORDER_H
+
+#include <QObject>
+#include <QFile>
+#include <QMutex>
+#include <QQueue>
+#include <QString>
+#include <QThread>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include "sessionformat.h"
+#include "trafficmanager.h"
+#include "../../core/histogram.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Always-on capture of every datagram exchanged with the robot
+ *
+ * This class manages:
+ * - Preallocated, memory-mapped segment files in the SessionFormat layout
+ * - Lock-free appends from any thread (control timer, status reader, e-stop thread)
+ * - Periodic index records so a segment can be searched by time
+ * - Rolling to a new segment per match, or when a segment fills up, on a worker thread
+ * - Pruning the oldest segments once the recordings directory exceeds its budget
+ *
+ * Design principles:
+ * - record() is a timestamp, one atomic add and a memcpy into the mapping; no
+ *   system calls, locks or allocations on the hot path
+ * - Records are committed by writing their size last, so a crash leaves a
+ *   readable segment that simply ends at the last complete record
+ * - Recording never blocks or fails the comms path; when a segment is full,
+ *   records are counted as dropped until the roll has happened
+ * - rollSegment() only queues the roll; creating, mapping, truncating and pruning
+ *   files happens on the worker, never on the status packet path
+ */
+class SessionRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Nanoseconds spent inside record(), kept to check the per-packet overhead budget
+    using CostHistogram = Log2Histogram<16>;
+
+    static constexpr quint64 DEFAULT_SEGMENT_BYTES = 64ULL * 1024 * 1024;
+    static constexpr quint64 MAX_RECORDING_DIRECTORY_BYTES = 2ULL * 1024 * 1024 * 1024;
+
+    explicit SessionRecorder(QObject *parent = nullptr);
+    ~SessionRecorder();
+
+    bool start(const QString &directory = QString(), quint64 segmentBytes = DEFAULT_SEGMENT_BYTES);
+    void stop();
+    bool isRecording() const { return m_segment.load(std::memory_order_acquire) != nullptr; }
+
+    // Used for segments opened from now on
+    void setTeamNumber(int teamNumber) { m_teamNumber.store(teamNumber, std::memory_order_relaxed); }
+    int teamNumber() const { return m_teamNumber.load(std::memory_order_relaxed); }
+
+    // Hot path; callable from any thread
+    bool record(TrafficManager::Stream stream, TrafficManager::Direction direction,
+                const char *data, int size);
+    bool record(TrafficManager::Stream stream, TrafficManager::Direction direction,
+                const QByteArray &data) {
+        return record(stream, direction, data.constData(), data.size());
+    }
+
+    QString directory() const { return m_directory; }
+    QString currentSegmentPath() const;
+    quint64 droppedRecords() const { return m_droppedRecords.load(std::memory_order_relaxed); }
+    const CostHistogram &costHistogram() const { return m_cost; }
+
+    static QString defaultDirectory();
+    static qint64 monotonicNs();
+
+public slots:
+    // Queues closing the current segment and starting a new one labelled e.g. "match-42";
+    // an empty label keeps the current one. Returns at once; the worker does the file I/O.
+    void rollSegment(const QString &label = QString());
+
+signals:
+    // Emitted from the worker thread for rolls, and from the caller's for start() and stop()
+    void segmentStarted(const QString &path);
+    void segmentClosed(const QString &path, quint64 records, quint64 bytes);
+    void recordingError(const QString &error);
+
+private slots:
+    void onSegmentFull();
+
+private:
+    struct Segment {
+        QFile file;
+        uchar *base = nullptr;
+        quint64 capacity = 0;
+        QString label;
+        std::atomic<quint64> writeOffset{0};
+        std::atomic<quint64> recordCount{0};
+        std::atomic<bool> full{false};
+    };
+
+    struct PendingRoll {
+        QString label;
+        bool onlyIfFull;
+    };
+
+    Segment *acquireSegment();
+    void releaseSegment();
+    Segment *openSegment(const QString &label);
+    void closeSegment(Segment *segment);
+    void writeIndex(Segment *segment, quint64 recordOffset, quint64 recordNumber, qint64 timestampNs);
+    void pruneDirectory();
+
+    void queueRoll(const QString &label, bool onlyIfFull);
+    void runWorker();
+    void performRoll(const PendingRoll &roll);
+    void stopWorker();
+
+    std::atomic<Segment *> m_segment;
+    std::atomic<int> m_writers;   // record() calls between acquireSegment() and releaseSegment()
+    mutable QMutex m_rollMutex;   // Serialises start/stop/roll; never taken by record()
+    QString m_directory;
+    QString m_currentPath;
+    quint64 m_segmentBytes;
+    std::atomic<int> m_teamNumber;
+
+    // Roll worker
+    QMutex m_workMutex;
+    QWaitCondition m_wake;
+    QQueue<PendingRoll> m_pendingRolls;     // Guarded by m_workMutex
+    bool m_workerRunning;                   // Guarded by m_workMutex
+    std::unique_ptr<QThread> m_worker;
+
+    std::atomic<quint64> m_droppedRecords;
+    CostHistogram m_cost;
+};
+
+} // namespace FRCDriverStation
+
+#endif // SESSIONRECORDER_H
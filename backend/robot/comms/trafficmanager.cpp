@@ -0,0 +1,214 @@
+#include "trafficmanager.h"
+#include <QAbstractSocket>
+#include <QSettings>
+#include <QVariant>
+#include <cmath>
+#include <limits>
+
+#ifdef Q_OS_LINUX
+#include <sys/socket.h>
+#endif
+
+using namespace FRCDriverStation;
+
+TokenBucket::TokenBucket()
+    : m_rate(0)
+    , m_burst(0)
+    , m_tokens(0.0)
+{
+    m_clock.start();
+}
+
+void TokenBucket::configure(qint64 bytesPerSecond, qint64 burstBytes) {
+    m_rate = qMax<qint64>(0, bytesPerSecond);
+    // Default burst is a quarter second of traffic
+    m_burst = burstBytes > 0 ? burstBytes : qMax<qint64>(1, m_rate / 4);
+    m_tokens = static_cast<double>(m_burst);
+    m_clock.restart();
+}
+
+void TokenBucket::refill() {
+    qint64 elapsedNs = m_clock.nsecsElapsed();
+    m_clock.restart();
+    m_tokens = qMin(static_cast<double>(m_burst), m_tokens + (m_rate * elapsedNs) / 1e9);
+}
+
+qint64 TokenBucket::available() {
+    if (!isLimited()) {
+        return std::numeric_limits<qint64>::max();
+    }
+    refill();
+    return static_cast<qint64>(m_tokens);
+}
+
+bool TokenBucket::tryConsume(qint64 bytes) {
+    if (!isLimited()) {
+        return true;
+    }
+    refill();
+    if (m_tokens < bytes) {
+        return false;
+    }
+    m_tokens -= bytes;
+    return true;
+}
+
+void TokenBucket::consume(qint64 bytes) {
+    if (!isLimited()) {
+        return;
+    }
+    refill();
+    m_tokens -= bytes;
+}
+
+int TokenBucket::msUntilAvailable(qint64 bytes) {
+    if (!isLimited()) {
+        return 0;
+    }
+    refill();
+    double missing = qMin<double>(bytes, m_burst) - m_tokens;
+    if (missing <= 0.0) {
+        return 0;
+    }
+    return static_cast<int>(std::ceil(missing * 1000.0 / m_rate));
+}
+
+TrafficManager::TrafficManager(QObject *parent)
+    : QObject(parent)
+    , m_rateTimer(std::make_unique<QTimer>(this))
+{
+    setStreamLimit(LogDownload, DEFAULT_LOG_DOWNLOAD_LIMIT_BYTES_PER_SEC, LOG_DOWNLOAD_READ_BUFFER);
+    setStreamLimit(Console, DEFAULT_CONSOLE_LIMIT_BYTES_PER_SEC, CONSOLE_READ_BUFFER);
+
+    m_rateTimer->setInterval(1000);
+    connect(m_rateTimer.get(), &QTimer::timeout, this, &TrafficManager::updateRates);
+    m_rateTimer->start();
+    m_rateClock.start();
+}
+
+void TrafficManager::updateRates() {
+    qint64 elapsedMs = m_rateClock.restart();
+    if (elapsedMs <= 0) {
+        return;
+    }
+
+    for (auto &stream : m_counters) {
+        for (Counter &counter : stream) {
+            counter.bytesPerSecond = (counter.bytes - counter.lastBytes) * 1000.0 / elapsedMs;
+            counter.packetsPerSecond = (counter.packets - counter.lastPackets) * 1000.0 / elapsedMs;
+            counter.lastBytes = counter.bytes;
+            counter.lastPackets = counter.packets;
+        }
+    }
+
+    emit ratesUpdated();
+}
+
+TrafficManager::StreamRates TrafficManager::rates(Stream stream, Direction direction) const {
+    const Counter &counter = m_counters[stream][direction];
+
+    StreamRates rates;
+    rates.bytesPerSecond = counter.bytesPerSecond;
+    rates.packetsPerSecond = counter.packetsPerSecond;
+    rates.totalBytes = counter.bytes;
+    rates.totalPackets = counter.packets;
+    return rates;
+}
+
+double TrafficManager::totalBytesPerSecond() const {
+    double total = 0.0;
+    for (const auto &stream : m_counters) {
+        for (const Counter &counter : stream) {
+            total += counter.bytesPerSecond;
+        }
+    }
+    return total;
+}
+
+void TrafficManager::setStreamLimit(Stream stream, qint64 bytesPerSecond, qint64 burstBytes) {
+    // The control and status streams are real-time and never shaped
+    if (stream == Control || stream == Status) {
+        return;
+    }
+    m_buckets[stream].configure(bytesPerSecond, burstBytes);
+}
+
+qint64 TrafficManager::streamLimit(Stream stream) const {
+    return m_buckets[stream].rate();
+}
+
+qint64 TrafficManager::availableBytes(Stream stream) {
+    return m_buckets[stream].available();
+}
+
+bool TrafficManager::tryConsume(Stream stream, qint64 bytes) {
+    return m_buckets[stream].tryConsume(bytes);
+}
+
+void TrafficManager::consume(Stream stream, qint64 bytes) {
+    m_buckets[stream].consume(bytes);
+}
+
+int TrafficManager::msUntilAvailable(Stream stream, qint64 bytes) {
+    return m_buckets[stream].msUntilAvailable(bytes);
+}
+
+bool TrafficManager::applyRealtimePriority(QAbstractSocket *socket) {
+    // Highest non-privileged SO_PRIORITY maps to the voice queue on most qdiscs
+    return applyPriority(socket, DSCP_EXPEDITED_FORWARDING, 6);
+}
+
+bool TrafficManager::applyBulkPriority(QAbstractSocket *socket) {
+    return applyPriority(socket, DSCP_LOW_PRIORITY, 1);
+}
+
+bool TrafficManager::applyPriority(QAbstractSocket *socket, int typeOfService, int linuxPriority) {
+    if (!socket || socket->socketDescriptor() == -1) {
+        return false;
+    }
+
+    // IP_TOS; Windows ignores this unless a QoS policy allows it
+    socket->setSocketOption(QAbstractSocket::TypeOfServiceOption, typeOfService);
+    bool ok = socket->socketOption(QAbstractSocket::TypeOfServiceOption).toInt() == typeOfService;
+
+#ifdef Q_OS_LINUX
+    int priority = linuxPriority;
+    ok = ::setsockopt(static_cast<int>(socket->socketDescriptor()), SOL_SOCKET, SO_PRIORITY,
+                      &priority, sizeof(priority)) == 0 && ok;
+#else
+    Q_UNUSED(linuxPriority);
+#endif
+
+    return ok;
+}
+
+QString TrafficManager::streamName(Stream stream) {
+    switch (stream) {
+    case Control: return "Control";
+    case Status: return "Status";
+    case Console: return "Console";
+    case NetworkTables: return "NetworkTables";
+    case LogDownload: return "Log Download";
+    case Ping: return "Ping";
+    default: return "Unknown";
+    }
+}
+
+void TrafficManager::loadSettings(QSettings *settings) {
+    settings->beginGroup("TrafficManager");
+    // A burst of one read buffer: the bucket never holds more than the socket can hand over at once
+    setStreamLimit(LogDownload,
+                   settings->value("logDownloadLimit", DEFAULT_LOG_DOWNLOAD_LIMIT_BYTES_PER_SEC).toLongLong(),
+                   LOG_DOWNLOAD_READ_BUFFER);
+    setStreamLimit(Console,
+                   settings->value("consoleLimit", DEFAULT_CONSOLE_LIMIT_BYTES_PER_SEC).toLongLong(),
+                   CONSOLE_READ_BUFFER);
+    settings->endGroup();
+}
+
+void TrafficManager::saveSettings(QSettings *settings) {
+    settings->beginGroup("TrafficManager");
+    settings->setValue("logDownloadLimit", streamLimit(LogDownload));
+    settings->setValue("consoleLimit", streamLimit(Console));
+    settings->endGroup();
+}
@@ -0,0 +1,157 @@
+#ifndef TRAFFICMANAGER_H
+#define TRAFFICMANAGER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <array>
+#include <memory>
+
+class QAbstractSocket;
+class QSettings;
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Token bucket used to shape bulk streams
+ *
+ * Tokens are bytes. The bucket refills continuously at rate bytes per
+ * second up to burst bytes; a rate of zero means unlimited.
+ */
+class TokenBucket
+{
+public:
+    TokenBucket();
+
+    void configure(qint64 bytesPerSecond, qint64 burstBytes);
+    bool isLimited() const { return m_rate > 0; }
+    qint64 rate() const { return m_rate; }
+
+    qint64 available();
+    bool tryConsume(qint64 bytes);
+    void consume(qint64 bytes);
+    int msUntilAvailable(qint64 bytes);
+
+private:
+    void refill();
+
+    qint64 m_rate;
+    qint64 m_burst;
+    double m_tokens;
+    QElapsedTimer m_clock;
+};
+
+/**
+ * @brief Accounts for and prioritises all traffic between the DS and the robot
+ *
+ * This class manages:
+ * - Per-stream byte and packet counters (control, status, console, NT, log download, ping)
+ * - Per-second byte/packet rates for every stream and direction
+ * - Token-bucket limits on bulk streams (log download, console) so they stay
+ *   inside the field budget, loaded from the settings
+ * - Socket priority marking (DSCP / SO_PRIORITY) for real-time vs. bulk sockets
+ *
+ * Design principles:
+ * - Accounting is a couple of integer adds, cheap enough for the 50Hz control path
+ * - The control stream is never shaped; only bulk streams wait for tokens
+ * - Bulk streams are back-pressured (read slower), never dropped
+ */
+class TrafficManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum Stream {
+        Control = 0,
+        Status,
+        Console,
+        NetworkTables,
+        LogDownload,
+        Ping,
+        StreamCount
+    };
+    Q_ENUM(Stream)
+
+    enum Direction {
+        Transmit = 0,
+        Receive,
+        DirectionCount
+    };
+    Q_ENUM(Direction)
+
+    struct StreamRates {
+        double bytesPerSecond = 0.0;
+        double packetsPerSecond = 0.0;
+        quint64 totalBytes = 0;
+        quint64 totalPackets = 0;
+    };
+
+    // FRC field radios cap each robot at 4 Mbit/s; bulk streams get a share of it
+    static constexpr qint64 FIELD_BANDWIDTH_LIMIT_BYTES_PER_SEC = 4 * 1000 * 1000 / 8;
+    static constexpr qint64 DEFAULT_LOG_DOWNLOAD_LIMIT_BYTES_PER_SEC = FIELD_BANDWIDTH_LIMIT_BYTES_PER_SEC / 2;
+    static constexpr qint64 DEFAULT_CONSOLE_LIMIT_BYTES_PER_SEC = 0;   // Unlimited
+    // Socket read buffers of the shaped streams, so an empty bucket pushes back on the sender
+    static constexpr qint64 LOG_DOWNLOAD_READ_BUFFER = 64 * 1024;
+    static constexpr qint64 CONSOLE_READ_BUFFER = 16 * 1024;
+
+    // DSCP values shifted into the IPv4 TOS byte
+    static constexpr int DSCP_EXPEDITED_FORWARDING = 46 << 2;
+    static constexpr int DSCP_LOW_PRIORITY = 8 << 2;
+
+    explicit TrafficManager(QObject *parent = nullptr);
+
+    void account(Stream stream, Direction direction, qint64 bytes, int packets = 1) {
+        Counter &counter = m_counters[stream][direction];
+        counter.bytes += bytes;
+        counter.packets += packets;
+    }
+
+    StreamRates rates(Stream stream, Direction direction) const;
+    double totalBytesPerSecond() const;
+
+    // Shaping; a limit of zero means unlimited
+    void setStreamLimit(Stream stream, qint64 bytesPerSecond, qint64 burstBytes = 0);
+    qint64 streamLimit(Stream stream) const;
+    qint64 availableBytes(Stream stream);
+    bool tryConsume(Stream stream, qint64 bytes);
+    void consume(Stream stream, qint64 bytes);
+    int msUntilAvailable(Stream stream, qint64 bytes);
+
+    // Socket prioritisation
+    static bool applyRealtimePriority(QAbstractSocket *socket);
+    static bool applyBulkPriority(QAbstractSocket *socket);
+
+    static QString streamName(Stream stream);
+
+    // Settings management; limits are bytes per second
+    void loadSettings(QSettings *settings);
+    void saveSettings(QSettings *settings);
+
+signals:
+    // Once a second, after rates() and totalBytesPerSecond() have moved on
+    void ratesUpdated();
+
+private slots:
+    void updateRates();
+
+private:
+    struct Counter {
+        quint64 bytes = 0;
+        quint64 packets = 0;
+        quint64 lastBytes = 0;
+        quint64 lastPackets = 0;
+        double bytesPerSecond = 0.0;
+        double packetsPerSecond = 0.0;
+    };
+
+    static bool applyPriority(QAbstractSocket *socket, int typeOfService, int linuxPriority);
+
+    std::array<std::array<Counter, DirectionCount>, StreamCount> m_counters;
+    std::array<TokenBucket, StreamCount> m_buckets;
+    std::unique_ptr<QTimer> m_rateTimer;
+    QElapsedTimer m_rateClock;
+};
+
+} // namespace FRCDriverStation
+
+#endif // TRAFFICMANAGER_H
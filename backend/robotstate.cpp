@@ -1,5 +1,5 @@
 #include "robotstate.h"
-#include "comms/communicationhandler.h"
+#include "robot/comms/communicationhandler.h"
 #include "controllers/controllerhidhandler.h"
 #include "managers/battery_manager.h"
 #include "managers/practice_match_manager.h"
@@ -9,7 +9,11 @@
 #include "fms/fmshandler.h"
 #endif
 
-#include <QApplication>
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+#include "controllers/evdevkeylistener.h"
+#endif
+
+#include <QCoreApplication>
 #include <QSettings>
 #include <QStandardPaths>
 #include <QDir>
@@ -19,6 +23,11 @@
 #include <QHostAddress>
 #include <QProcess>
 
+namespace {
+// Console lines kept for the UI; older output is dropped from the front
+constexpr int MAX_CONSOLE_CHARS = 64 * 1024;
+}
+
 RobotState::RobotState(QObject *parent)
     : QObject(parent)
     , m_robotEnabled(false)
@@ -29,16 +38,17 @@ RobotState::RobotState(QObject *parent)
     , m_connectionMode(TeamNumber)
     , m_robotMode(Disabled)
     , m_connectionState(Disconnected)
-    , m_batteryVoltage(0.0)
-    , m_pingLatency(-1)
     , m_globalShortcutsEnabled(true)
-    , m_commsStatus("Disconnected")
-    , m_robotCodeStatus("No Robot Code")
+    , m_station(0)
+    , m_matchTime(0)
+    , m_commsStatus("No Comms")
+    , m_robotCodeStatus("No Code")
     , m_joystickStatus("No Controllers")
-    , m_robotVoltage(0.0)
-    , m_networkLatency(0.0)
-    , m_packetLoss(0.0)
     , m_consoleOutput("")
+    , m_networkTablesStatus("No Robot Connection")
+    , m_networkTablesConnected(false)
+    , m_logDownloadProgress(0)
+    , m_logDownloadInProgress(false)
     , m_communicationHandler(nullptr)
     , m_controllerHandler(nullptr)
     , m_batteryManager(nullptr)
@@ -47,6 +57,9 @@ RobotState::RobotState(QObject *parent)
 #ifdef ENABLE_FMS_SUPPORT
     , m_fmsHandler(nullptr)
 #endif
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+    , m_evdevKeyListener(nullptr)
+#endif
 #if defined(ENABLE_GLOBAL_SHORTCUTS) && defined(QHOTKEY_AVAILABLE)
     , m_emergencyStopHotkey(nullptr)
     , m_disableRobotHotkey(nullptr)
@@ -55,11 +68,14 @@ RobotState::RobotState(QObject *parent)
     , m_statusUpdateTimer(nullptr)
     , m_connectionTimeoutTimer(nullptr)
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Initializing robot state manager");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Initializing robot state manager");
     
     // Load settings first
     loadSettings();
     
+    // Telemetry slots exist before any component can publish into them
+    setupTelemetry();
+    
     // Initialize components
     initializeComponents();
     
@@ -76,17 +92,17 @@ RobotState::RobotState(QObject *parent)
     }
 #endif
     
-    Logger::instance().log(Logger::Info, "RobotState", 
-                          QString("Robot state manager initialized (Team: %1, IP: %2, Mode: %3, Global shortcuts: %4)")
-                          .arg(m_teamNumber)
-                          .arg(m_robotIpAddress)
-                          .arg(m_connectionMode == TeamNumber ? "Team Number" : "IP Address")
-                          .arg(m_globalShortcutsEnabled ? "enabled" : "disabled"));
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("Robot state manager initialized (Team: %1, IP: %2, Mode: %3, Global shortcuts: %4)")
+                  .arg(m_teamNumber)
+                  .arg(m_robotIpAddress)
+                  .arg(m_connectionMode == TeamNumber ? "Team Number" : "IP Address")
+                  .arg(m_globalShortcutsEnabled ? "enabled" : "disabled"));
 }
 
 RobotState::~RobotState()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Shutting down robot state manager");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Shutting down robot state manager");
     
     // Save current settings
     saveSettings();
@@ -105,71 +121,110 @@ RobotState::~RobotState()
     }
     
     // Cleanup components (they will be deleted by Qt's parent-child system)
-    Logger::instance().log(Logger::Info, "RobotState", "Robot state manager shutdown complete");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Robot state manager shutdown complete");
 }
 
 void RobotState::initializeComponents()
 {
-    // Initialize communication handler
-    m_communicationHandler = new CommunicationHandler(this);
-    
     // Initialize controller handler
-    m_controllerHandler = new ControllerHIDHandler(this);
+    m_controllerHandler = new FRCDriverStation::ControllerHIDHandler(this);
     
     // Initialize battery manager
-    m_batteryManager = new BatteryManager(this);
+    m_batteryManager = new FRCDriverStation::BatteryManager(this);
     
     // Initialize practice match manager
-    m_practiceMatchManager = new PracticeMatchManager(this);
+    m_practiceMatchManager = new FRCDriverStation::PracticeMatchManager(this);
     
     // Initialize network manager
-    m_networkManager = new NetworkManager(this);
+    m_networkManager = new FRCDriverStation::NetworkManager(this);
+    
+    // Initialize communication handler; it reads this object and the controller
+    // slots for every control packet, so it comes after both
+    m_communicationHandler = new FRCDriverStation::CommunicationHandler(this, m_controllerHandler, this);
+    applyRobotAddress();
     
 #ifdef ENABLE_FMS_SUPPORT
     // Initialize FMS handler if enabled
     m_fmsHandler = new FMSHandler(this);
 #endif
     
-    Logger::instance().log(Logger::Info, "RobotState", "All components initialized");
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+    // Initialize evdev safety key listener (started once connections are made)
+    m_evdevKeyListener = new FRCDriverStation::EvdevKeyListener(this);
+#endif
+    
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "All components initialized");
 }
 
 void RobotState::setupConnections()
 {
-    // Communication handler connections
+    // Communication handler connections; telemetry arrives through the update*() methods
     if (m_communicationHandler) {
-        connect(m_communicationHandler, &CommunicationHandler::robotConnected,
+        connect(m_communicationHandler, &FRCDriverStation::CommunicationHandler::robotConnected,
                 this, &RobotState::onRobotConnected);
-        connect(m_communicationHandler, &CommunicationHandler::robotDisconnected,
+        connect(m_communicationHandler, &FRCDriverStation::CommunicationHandler::robotDisconnected,
                 this, &RobotState::onRobotDisconnected);
-        connect(m_communicationHandler, &CommunicationHandler::robotEnabled,
-                this, &RobotState::onRobotEnabled);
-        connect(m_communicationHandler, &CommunicationHandler::robotDisabled,
-                this, &RobotState::onRobotDisabled);
-        connect(m_communicationHandler, &CommunicationHandler::communicationError,
-                this, &RobotState::onCommunicationError);
-        connect(m_communicationHandler, &CommunicationHandler::pingLatencyChanged,
-                this, &RobotState::onPingLatencyChanged);
     }
     
-    // Battery manager connections
+    // Sustained critical voltage disables, as the disable button does
     if (m_batteryManager) {
-        connect(m_batteryManager, &BatteryManager::batteryVoltageChanged,
-                this, &RobotState::onBatteryVoltageChanged);
+        connect(m_batteryManager, &FRCDriverStation::BatteryManager::robotShouldDisable, this, [this]() {
+            if (m_robotEnabled) {
+                disableRobot("Battery critical");
+            }
+        });
     }
     
 #ifdef ENABLE_FMS_SUPPORT
     // FMS handler connections
     if (m_fmsHandler) {
-        connect(m_fmsHandler, &FMSHandler::fmsConnected,
-                this, &RobotState::onFMSConnected);
-        connect(m_fmsHandler, &FMSHandler::fmsDisconnected,
-                this, &RobotState::onFMSDisconnected);
-        connect(m_fmsHandler, &FMSHandler::fmsModeChanged,
-                this, &RobotState::onFMSModeChanged);
+        connect(m_fmsHandler, &FMSHandler::stateChanged,
+                this, &RobotState::onFMSStateChanged);
+        // The transmit path reads the FMS snapshot itself and sends control changes at once
+        if (m_communicationHandler) {
+            m_communicationHandler->setFmsHandler(m_fmsHandler);
+        }
+    }
+#endif
+    
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+    // Key presses arrive on the input thread. The fast-path signal is emitted right
+    // there so the transmit thread is woken without a trip through the event loop;
+    // the state change itself is queued to this thread.
+    if (m_evdevKeyListener) {
+        connect(m_evdevKeyListener, &FRCDriverStation::EvdevKeyListener::emergencyStopPressed,
+                this, [this](const QString& device, qint64 latencyUs) {
+            const QString source = QString("Keyboard (%1)").arg(device);
+            emit emergencyStopTriggered(source);
+            QMetaObject::invokeMethod(this, [this, source, latencyUs]() {
+                YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                                 QString("Emergency stop key pressed, %1 us from kernel to dispatch")
+                                 .arg(latencyUs));
+                applyEmergencyStop(source);
+            }, Qt::QueuedConnection);
+        }, Qt::DirectConnection);
+        connect(m_evdevKeyListener, &FRCDriverStation::EvdevKeyListener::disablePressed,
+                this, [this](const QString& device, qint64 latencyUs) {
+            const QString source = QString("Keyboard (%1)").arg(device);
+            emit disableTriggered(source);
+            QMetaObject::invokeMethod(this, [this, source, latencyUs]() {
+                YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                              QString("Disable key pressed, %1 us from kernel to dispatch")
+                              .arg(latencyUs));
+                applyDisable(source);
+            }, Qt::QueuedConnection);
+        }, Qt::DirectConnection);
+        connect(m_evdevKeyListener, &FRCDriverStation::EvdevKeyListener::keyboardAdded,
+                this, &RobotState::onEvdevKeyboardAdded);
+        connect(m_evdevKeyListener, &FRCDriverStation::EvdevKeyListener::keyboardRemoved,
+                this, &RobotState::onEvdevKeyboardRemoved);
+        connect(m_evdevKeyListener, &FRCDriverStation::EvdevKeyListener::errorOccurred,
+                this, &RobotState::onEvdevError);
+        m_evdevKeyListener->start();
     }
 #endif
     
-    Logger::instance().log(Logger::Info, "RobotState", "Component connections established");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Component connections established");
 }
 
 void RobotState::setupTimers()
@@ -178,7 +233,6 @@ void RobotState::setupTimers()
     m_statusUpdateTimer = new QTimer(this);
     m_statusUpdateTimer->setInterval(100);
     connect(m_statusUpdateTimer, &QTimer::timeout, this, &RobotState::robotStatusChanged);
-    connect(m_statusUpdateTimer, &QTimer::timeout, this, &RobotState::updateStatusStrings);
     m_statusUpdateTimer->start();
     
     // Connection timeout timer (5 second timeout)
@@ -186,13 +240,62 @@ void RobotState::setupTimers()
     m_connectionTimeoutTimer->setInterval(5000);
     m_connectionTimeoutTimer->setSingleShot(true);
     
-    Logger::instance().log(Logger::Info, "RobotState", "Timers configured");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Timers configured");
+}
+
+void RobotState::setupTelemetry()
+{
+    // Registration order must match TelemetrySlot
+    int slot = m_telemetry.addSlot(0.0, [this](double value) { emit batteryVoltageChanged(value); });
+    Q_ASSERT(slot == BatteryVoltageSlot);
+    slot = m_telemetry.addSlot(-1.0, [this](double value) { emit pingLatencyChanged(static_cast<int>(value)); });
+    Q_ASSERT(slot == PingLatencySlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit robotVoltageChanged(value); });
+    Q_ASSERT(slot == RobotVoltageSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit networkLatencyChanged(value); });
+    Q_ASSERT(slot == NetworkLatencySlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit packetLossChanged(value); });
+    Q_ASSERT(slot == PacketLossSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit bandwidthChanged(value); });
+    Q_ASSERT(slot == BandwidthSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit cpuUsageChanged(value); });
+    Q_ASSERT(slot == CpuUsageSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit ramUsageChanged(value); });
+    Q_ASSERT(slot == RamUsageSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit diskUsageChanged(value); });
+    Q_ASSERT(slot == DiskUsageSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit canUtilChanged(value); });
+    Q_ASSERT(slot == CanUtilSlot);
+    slot = m_telemetry.addSlot(0.0, [this](double value) { emit canBusOffChanged(static_cast<int>(value)); });
+    Q_ASSERT(slot == CanBusOffSlot);
+    Q_UNUSED(slot);
+    
+    m_telemetry.start();
+}
+
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+void RobotState::onEvdevKeyboardAdded(const QString& path, const QString& name)
+{
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Safety keys active on %1 (%2)").arg(name).arg(path));
+}
+
+void RobotState::onEvdevKeyboardRemoved(const QString& path, const QString& name)
+{
+    YADS_LOG_INFO(::Constants::LogCategories::CONTROLLERS,
+                  QString("Keyboard removed: %1 (%2)").arg(name).arg(path));
+}
+
+void RobotState::onEvdevError(const QString& error)
+{
+    YADS_LOG_WARNING(::Constants::LogCategories::CONTROLLERS, QString("Evdev safety keys: %1").arg(error));
 }
+#endif
 
 #if defined(ENABLE_GLOBAL_SHORTCUTS) && defined(QHOTKEY_AVAILABLE)
 void RobotState::setupGlobalShortcuts()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Setting up global shortcuts");
+    YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Setting up global shortcuts");
     
     try {
         // Emergency stop shortcut (Space)
@@ -207,16 +310,16 @@ void RobotState::setupGlobalShortcuts()
         registerGlobalShortcut(m_enableRobotHotkey, QKeySequence(Qt::CTRL | Qt::Key_E),
                               SLOT(onEnableRobotShortcut()), "Enable Robot");
         
-        Logger::instance().log(Logger::Info, "RobotState", "Global shortcuts registered successfully");
+        YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Global shortcuts registered successfully");
     } catch (const std::exception& e) {
-        Logger::instance().log(Logger::Error, "RobotState", 
-                              QString("Failed to setup global shortcuts: %1").arg(e.what()));
+        YADS_LOG_CRITICAL(::Constants::LogCategories::GLOBAL_SHORTCUTS,
+                          QString("Failed to setup global shortcuts: %1").arg(e.what()));
     }
 }
 
 void RobotState::cleanupGlobalShortcuts()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Cleaning up global shortcuts");
+    YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Cleaning up global shortcuts");
     
     if (m_emergencyStopHotkey) {
         m_emergencyStopHotkey->setRegistered(false);
@@ -236,7 +339,7 @@ void RobotState::cleanupGlobalShortcuts()
         m_enableRobotHotkey = nullptr;
     }
     
-    Logger::instance().log(Logger::Info, "RobotState", "Global shortcuts cleanup complete");
+    YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Global shortcuts cleanup complete");
 }
 
 void RobotState::registerGlobalShortcut(QHotkey*& hotkey, const QKeySequence& sequence, 
@@ -246,15 +349,15 @@ void RobotState::registerGlobalShortcut(QHotkey*& hotkey, const QKeySequence& se
     
     if (hotkey->isRegistered()) {
         connect(hotkey, SIGNAL(activated()), this, slot);
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Global shortcut registered: %1 (%2)")
-                              .arg(description)
-                              .arg(sequence.toString()));
+        YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS,
+                      QString("Global shortcut registered: %1 (%2)")
+                      .arg(description)
+                      .arg(sequence.toString()));
     } else {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              QString("Failed to register global shortcut: %1 (%2)")
-                              .arg(description)
-                              .arg(sequence.toString()));
+        YADS_LOG_WARNING(::Constants::LogCategories::GLOBAL_SHORTCUTS,
+                         QString("Failed to register global shortcut: %1 (%2)")
+                         .arg(description)
+                         .arg(sequence.toString()));
         hotkey->deleteLater();
         hotkey = nullptr;
     }
@@ -262,27 +365,27 @@ void RobotState::registerGlobalShortcut(QHotkey*& hotkey, const QKeySequence& se
 
 void RobotState::onEmergencyStopShortcut()
 {
-    Logger::instance().log(Logger::Warning, "RobotState", "Emergency stop triggered via global shortcut");
+    emergencyStopRobot("Global Shortcut");
+    YADS_LOG_WARNING(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Emergency stop triggered via global shortcut");
     emit globalShortcutTriggered("Emergency Stop");
-    emergencyStopRobot();
 }
 
 void RobotState::onDisableRobotShortcut()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Robot disable triggered via global shortcut");
+    YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Robot disable triggered via global shortcut");
     emit globalShortcutTriggered("Disable Robot");
-    disableRobot();
+    disableRobot("Global Shortcut");
 }
 
 void RobotState::onEnableRobotShortcut()
 {
     if (!m_emergencyStop) {
-        Logger::instance().log(Logger::Info, "RobotState", "Robot enable triggered via global shortcut");
+        YADS_LOG_INFO(::Constants::LogCategories::GLOBAL_SHORTCUTS, "Robot enable triggered via global shortcut");
         emit globalShortcutTriggered("Enable Robot");
         enableRobot();
     } else {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              "Robot enable shortcut ignored - emergency stop active");
+        YADS_LOG_WARNING(::Constants::LogCategories::GLOBAL_SHORTCUTS,
+                         "Robot enable shortcut ignored - emergency stop active");
     }
 }
 #endif
@@ -298,6 +401,35 @@ QString RobotState::robotMode() const
     }
 }
 
+bool RobotState::setRobotMode(RobotMode mode)
+{
+    if (mode != Autonomous && mode != Teleop && mode != Test) {
+        return false;
+    }
+    if (m_fmsConnected) {
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM,
+                         "Cannot change robot mode - controlled by the FMS");
+        return false;
+    }
+    if (mode == m_robotMode) {
+        return true;
+    }
+    
+    // Never carry an enable over into another mode's code
+    if (m_robotEnabled) {
+        disableRobot("Mode change");
+    }
+    
+    QMutexLocker locker(&m_stateMutex);
+    m_robotMode = mode;
+    locker.unlock();
+    
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("Robot mode changed to: %1").arg(robotMode()));
+    emit robotModeChanged(robotMode());
+    return true;
+}
+
 void RobotState::setTeamNumber(int teamNumber)
 {
     if (m_teamNumber != teamNumber) {
@@ -305,14 +437,10 @@ void RobotState::setTeamNumber(int teamNumber)
         m_teamNumber = teamNumber;
         locker.unlock();
         
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Team number changed to: %1").arg(teamNumber));
-        
-        // Update communication handler with new team number
-        if (m_communicationHandler) {
-            m_communicationHandler->setTeamNumber(teamNumber);
-        }
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Team number changed to: %1").arg(teamNumber));
         
+        // The communication handler follows teamNumberChanged
         emit teamNumberChanged(teamNumber);
         saveSettings();
     }
@@ -325,13 +453,10 @@ void RobotState::setRobotIpAddress(const QString& ipAddress)
         m_robotIpAddress = ipAddress;
         locker.unlock();
         
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Robot IP address changed to: %1").arg(ipAddress));
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Robot IP address changed to: %1").arg(ipAddress));
         
-        // Update communication handler with new IP address
-        if (m_communicationHandler) {
-            m_communicationHandler->setRobotIpAddress(ipAddress);
-        }
+        applyRobotAddress();
         
         emit robotIpAddressChanged(ipAddress);
         saveSettings();
@@ -346,15 +471,11 @@ void RobotState::setConnectionMode(int mode)
         m_connectionMode = newMode;
         locker.unlock();
         
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Connection mode changed to: %1")
-                              .arg(newMode == TeamNumber ? "Team Number" : "IP Address"));
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Connection mode changed to: %1")
+                      .arg(newMode == TeamNumber ? "Team Number" : "IP Address"));
         
-        // Update communication handler with new connection mode
-        if (m_communicationHandler) {
-            m_communicationHandler->setConnectionMode(newMode == TeamNumber ? 
-                CommunicationHandler::TeamNumber : CommunicationHandler::IpAddress);
-        }
+        applyRobotAddress();
         
         emit connectionModeChanged(mode);
         saveSettings();
@@ -366,8 +487,8 @@ void RobotState::setGlobalShortcutsEnabled(bool enabled)
     if (m_globalShortcutsEnabled != enabled) {
         m_globalShortcutsEnabled = enabled;
         
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Global shortcuts %1").arg(enabled ? "enabled" : "disabled"));
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Global shortcuts %1").arg(enabled ? "enabled" : "disabled"));
         
 #if defined(ENABLE_GLOBAL_SHORTCUTS) && defined(QHOTKEY_AVAILABLE)
         if (enabled) {
@@ -385,52 +506,61 @@ void RobotState::setGlobalShortcutsEnabled(bool enabled)
 void RobotState::enableRobot()
 {
     if (m_emergencyStop) {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              "Cannot enable robot - emergency stop active");
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Cannot enable robot - emergency stop active");
         return;
     }
     
     if (!isRobotConnected()) {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              "Cannot enable robot - not connected");
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Cannot enable robot - not connected");
         return;
     }
     
-    Logger::instance().log(Logger::Info, "RobotState", "Enabling robot");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Enabling robot");
     
-    if (m_communicationHandler) {
-        m_communicationHandler->enableRobot();
-    }
+    // The next control packet carries the enable; the handler sends one on the change
+    setEnabledState(true);
     
     logStateChange("Robot enabled");
 }
 
-void RobotState::disableRobot()
+void RobotState::disableRobot(const QString &source)
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Disabling robot");
+    // Transmit-path listeners send the disable burst directly from this signal
+    emit disableTriggered(source);
+    applyDisable(source);
+}
+
+void RobotState::applyDisable(const QString &source)
+{
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, QString("Disabling robot (%1)").arg(source));
     
-    if (m_communicationHandler) {
-        m_communicationHandler->disableRobot();
-    }
+    setEnabledState(false);
     
     logStateChange("Robot disabled");
 }
 
-void RobotState::emergencyStopRobot()
+void RobotState::emergencyStopRobot(const QString &source)
+{
+    // Listeners on the transmit path send the e-stop burst directly from this
+    // signal, so it goes out before any locking, logging or UI work
+    emit emergencyStopTriggered(source);
+    applyEmergencyStop(source);
+}
+
+void RobotState::applyEmergencyStop(const QString &source)
 {
     QMutexLocker locker(&m_stateMutex);
     m_emergencyStop = true;
     m_lastEmergencyStopTime = QDateTime::currentDateTime();
     locker.unlock();
     
-    Logger::instance().log(Logger::Error, "RobotState", "EMERGENCY STOP ACTIVATED");
+    YADS_LOG_CRITICAL(::Constants::LogCategories::ROBOT_COMM,
+                      QString("EMERGENCY STOP ACTIVATED (%1)").arg(source));
     
-    if (m_communicationHandler) {
-        m_communicationHandler->emergencyStop();
-    }
+    // The handler latched the stop from emergencyStopTriggered; this only drops the enable
+    setEnabledState(false);
     
     emit emergencyStopChanged(true);
-    emit emergencyStopTriggered("Manual");
     logStateChange("Emergency stop activated");
 }
 
@@ -441,7 +571,7 @@ void RobotState::clearEmergencyStop()
         m_emergencyStop = false;
         locker.unlock();
         
-        Logger::instance().log(Logger::Info, "RobotState", "Emergency stop cleared");
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Emergency stop cleared");
         
         emit emergencyStopChanged(false);
         logStateChange("Emergency stop cleared");
@@ -451,22 +581,19 @@ void RobotState::clearEmergencyStop()
 void RobotState::connectToRobot()
 {
     if (m_connectionMode == TeamNumber && m_teamNumber == 0) {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              "Cannot connect - team number not set");
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Cannot connect - team number not set");
         return;
     }
     
     if (m_connectionMode == IpAddress && m_robotIpAddress.isEmpty()) {
-        Logger::instance().log(Logger::Warning, "RobotState", 
-                              "Cannot connect - IP address not set");
+        YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Cannot connect - IP address not set");
         return;
     }
     
     QString target = (m_connectionMode == TeamNumber) ? 
         QString("Team %1").arg(m_teamNumber) : m_robotIpAddress;
     
-    Logger::instance().log(Logger::Info, "RobotState", 
-                          QString("Connecting to robot (%1)").arg(target));
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, QString("Connecting to robot (%1)").arg(target));
     
     updateConnectionState(Connecting);
     
@@ -482,18 +609,19 @@ void RobotState::connectToRobot()
 
 void RobotState::disconnectFromRobot()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Disconnecting from robot");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Disconnecting from robot");
     
     if (m_communicationHandler) {
         m_communicationHandler->disconnectFromRobot();
     }
     
     updateConnectionState(Disconnected);
+    emit robotConnectedChanged(false);
 }
 
 void RobotState::restartCommunication()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Restarting communication");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Restarting communication");
     
     disconnectFromRobot();
     
@@ -501,58 +629,6 @@ void RobotState::restartCommunication()
     QTimer::singleShot(1000, this, &RobotState::connectToRobot);
 }
 
-void RobotState::updateStatusStrings()
-{
-    // Update communications status
-    QString newCommsStatus;
-    if (isRobotConnected()) {
-        newCommsStatus = "Connected";
-    } else if (m_connectionState == Connecting) {
-        newCommsStatus = "Connecting...";
-    } else {
-        newCommsStatus = "Disconnected";
-    }
-    
-    if (m_commsStatus != newCommsStatus) {
-        m_commsStatus = newCommsStatus;
-        emit commsStatusChanged(m_commsStatus);
-    }
-    
-    // Update robot code status
-    QString newRobotCodeStatus = isRobotConnected() ? "Robot Code" : "No Robot Code";
-    if (m_robotCodeStatus != newRobotCodeStatus) {
-        m_robotCodeStatus = newRobotCodeStatus;
-        emit robotCodeStatusChanged(m_robotCodeStatus);
-    }
-    
-    // Update joystick status
-    QString newJoystickStatus = "No Controllers"; // This would be updated by controller handler
-    if (m_joystickStatus != newJoystickStatus) {
-        m_joystickStatus = newJoystickStatus;
-        emit joystickStatusChanged(m_joystickStatus);
-    }
-    
-    // Update voltage (same as battery voltage for now)
-    if (m_robotVoltage != m_batteryVoltage) {
-        m_robotVoltage = m_batteryVoltage;
-        emit robotVoltageChanged(m_robotVoltage);
-    }
-    
-    // Update network latency
-    double newLatency = static_cast<double>(m_pingLatency);
-    if (m_networkLatency != newLatency) {
-        m_networkLatency = newLatency;
-        emit networkLatencyChanged(m_networkLatency);
-    }
-    
-    // Update packet loss (would be calculated from communication handler)
-    double newPacketLoss = 0.0; // Placeholder
-    if (m_packetLoss != newPacketLoss) {
-        m_packetLoss = newPacketLoss;
-        emit packetLossChanged(m_packetLoss);
-    }
-}
-
 void RobotState::onRobotConnected()
 {
     QMutexLocker locker(&m_stateMutex);
@@ -561,7 +637,7 @@ void RobotState::onRobotConnected()
     
     updateConnectionState(Connected);
     
-    Logger::instance().log(Logger::Info, "RobotState", "Robot connected successfully");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Robot connected successfully");
     
     // Stop connection timeout timer
     if (m_connectionTimeoutTimer) {
@@ -575,7 +651,7 @@ void RobotState::onRobotDisconnected()
 {
     updateConnectionState(Disconnected);
     
-    Logger::instance().log(Logger::Warning, "RobotState", "Robot disconnected");
+    YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Robot disconnected");
     
     // Clear robot enabled state
     if (m_robotEnabled) {
@@ -589,89 +665,284 @@ void RobotState::onRobotDisconnected()
     emit robotConnectedChanged(false);
 }
 
-void RobotState::onRobotEnabled()
+void RobotState::setEnabledState(bool enabled)
 {
+    if (m_robotEnabled == enabled) {
+        return;
+    }
     QMutexLocker locker(&m_stateMutex);
-    m_robotEnabled = true;
+    m_robotEnabled = enabled;
     locker.unlock();
     
-    Logger::instance().log(Logger::Info, "RobotState", "Robot enabled");
-    emit robotEnabledChanged(true);
-    emit enabledChanged(true);
+    emit robotEnabledChanged(enabled);
+    emit enabledChanged(enabled);
 }
 
-void RobotState::onRobotDisabled()
+void RobotState::setStation(int station)
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_robotEnabled = false;
-    locker.unlock();
-    
-    Logger::instance().log(Logger::Info, "RobotState", "Robot disabled");
-    emit robotEnabledChanged(false);
-    emit enabledChanged(false);
+    if (station < 0 || station > 5 || station == m_station) {
+        return;
+    }
+    m_station = station;
+    emit stationChanged(station);
 }
 
-void RobotState::onBatteryVoltageChanged(double voltage)
+void RobotState::applyRobotAddress()
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_batteryVoltage = voltage;
-    locker.unlock();
-    
-    emit batteryVoltageChanged(voltage);
+    if (!m_communicationHandler) {
+        return;
+    }
+    // An empty override sends to 10.TE.AM.2 again
+    const QHostAddress address = m_connectionMode == IpAddress ? QHostAddress(m_robotIpAddress)
+                                                               : QHostAddress();
+    m_communicationHandler->setRobotAddressOverride(address);
 }
 
-void RobotState::onPingLatencyChanged(int latency)
+void RobotState::updateRobotVoltage(double voltage)
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_pingLatency = latency;
-    locker.unlock();
-    
-    emit pingLatencyChanged(latency);
+    // Runs for every status packet; the signals follow on the next UI tick
+    m_telemetry.publish(RobotVoltageSlot, voltage);
+    m_telemetry.publish(BatteryVoltageSlot, voltage);
+    if (m_batteryManager) {
+        m_batteryManager->updateVoltage(voltage);
+    }
 }
 
-void RobotState::onCommunicationError(const QString& error)
+void RobotState::updateNetworkLatency(double latency)
 {
-    Logger::instance().log(Logger::Error, "RobotState", 
-                          QString("Communication error: %1").arg(error));
-    
-    emit communicationError(error);
+    m_telemetry.publish(PingLatencySlot, latency);
+    m_telemetry.publish(NetworkLatencySlot, latency);
+}
+
+void RobotState::updatePacketLoss(double loss)
+{
+    m_telemetry.publish(PacketLossSlot, loss);
+}
+
+void RobotState::updateBandwidth(double kilobytesPerSecond)
+{
+    m_telemetry.publish(BandwidthSlot, kilobytesPerSecond);
+}
+
+QVariantList RobotState::lossBurstBuckets() const
+{
+    using BurstHistogram = FRCDriverStation::SequenceTracker::BurstHistogram;
+    const BurstHistogram &histogram = m_communicationHandler->statusSequence().burstHistogram();
     
-    // If we were connected, update state to connection lost
-    if (m_connectionState == Connected) {
-        updateConnectionState(ConnectionLost);
+    QVariantList buckets;
+    for (int bucket = 1; bucket < BurstHistogram::Buckets; ++bucket) {
+        const quint64 count = histogram.count(bucket);
+        if (count == 0) {
+            continue;
+        }
+        
+        const quint64 lower = BurstHistogram::bucketLowerBound(bucket);
+        const quint64 upper = BurstHistogram::bucketUpperBound(bucket);
+        QString label;
+        if (bucket == BurstHistogram::Buckets - 1) {
+            label = QString(">= %1").arg(lower);
+        } else {
+            label = lower == upper ? QString::number(lower) : QString("%1-%2").arg(lower).arg(upper);
+        }
+        
+        QVariantMap entry;
+        entry["label"] = label;
+        entry["count"] = count;
+        buckets.append(entry);
     }
+    return buckets;
 }
 
-#ifdef ENABLE_FMS_SUPPORT
-void RobotState::onFMSConnected()
+void RobotState::updateStreamRates(const QVariantList &rates)
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_fmsConnected = true;
-    locker.unlock();
-    
-    Logger::instance().log(Logger::Info, "RobotState", "FMS connected");
-    emit fmsConnectedChanged(true);
+    // Refreshed once a second by the traffic manager, so no change check
+    m_streamRates = rates;
+    emit streamRatesChanged();
 }
 
-void RobotState::onFMSDisconnected()
+void RobotState::updateCpuUsage(double percent)
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_fmsConnected = false;
-    locker.unlock();
-    
-    Logger::instance().log(Logger::Info, "RobotState", "FMS disconnected");
-    emit fmsConnectedChanged(false);
+    m_telemetry.publish(CpuUsageSlot, percent);
 }
 
-void RobotState::onFMSModeChanged(int mode)
+void RobotState::updateRamUsage(double percent)
 {
-    QMutexLocker locker(&m_stateMutex);
-    m_robotMode = static_cast<RobotMode>(mode);
-    locker.unlock();
+    m_telemetry.publish(RamUsageSlot, percent);
+}
+
+void RobotState::updateDiskUsage(double percent)
+{
+    m_telemetry.publish(DiskUsageSlot, percent);
+}
+
+void RobotState::updateCanUtil(double percent)
+{
+    m_telemetry.publish(CanUtilSlot, percent);
+}
+
+void RobotState::updateCanBusOff(int count)
+{
+    m_telemetry.publish(CanBusOffSlot, count);
+}
+
+void RobotState::updateMatchTime(int seconds)
+{
+    if (m_matchTime != seconds) {
+        m_matchTime = seconds;
+        emit matchTimeChanged(seconds);
+    }
+}
+
+void RobotState::updateCommsStatus(const QString& status)
+{
+    if (m_commsStatus != status) {
+        m_commsStatus = status;
+        emit commsStatusChanged(status);
+    }
+}
+
+void RobotState::updateRobotCodeStatus(const QString& status)
+{
+    if (m_robotCodeStatus != status) {
+        m_robotCodeStatus = status;
+        emit robotCodeStatusChanged(status);
+    }
+}
+
+void RobotState::updateJoystickStatus(const QString& status)
+{
+    if (m_joystickStatus != status) {
+        m_joystickStatus = status;
+        emit joystickStatusChanged(status);
+    }
+}
+
+void RobotState::updateNetworkTablesStatus(bool connected, const QString& status)
+{
+    if (m_networkTablesConnected != connected || m_networkTablesStatus != status) {
+        m_networkTablesConnected = connected;
+        m_networkTablesStatus = status;
+        emit networkTablesStatusChanged();
+    }
+}
+
+void RobotState::appendConsoleMessage(const QString& message)
+{
+    m_consoleOutput.append(message);
+    if (m_consoleOutput.size() > MAX_CONSOLE_CHARS) {
+        m_consoleOutput.remove(0, m_consoleOutput.size() - MAX_CONSOLE_CHARS);
+    }
+    emit consoleOutputChanged(m_consoleOutput);
+}
+
+void RobotState::updateLogDownloadStatus(const QString& status)
+{
+    m_logDownloadStatus = status;
+    emit logDownloadStatusChanged(status);
+}
+
+void RobotState::updateLogDownloadProgress(int percent)
+{
+    if (m_logDownloadProgress != percent) {
+        m_logDownloadProgress = percent;
+        emit logDownloadProgressChanged(percent);
+    }
+}
+
+void RobotState::updateAvailableLogFiles(const QStringList& files)
+{
+    m_availableLogFiles = files;
+    emit availableLogFilesChanged(files);
+}
+
+void RobotState::onLogDownloadCompleted(const QString& path, bool success)
+{
+    m_logDownloadInProgress = false;
+    emit logDownloadInProgressChanged(false);
+    emit logDownloadCompleted(path, success);
+}
+
+void RobotState::rebootRobot()
+{
+    YADS_LOG_WARNING(::Constants::LogCategories::ROBOT_COMM, "Rebooting the roboRIO");
+    if (m_communicationHandler) {
+        m_communicationHandler->sendRebootCommand();
+    }
+}
+
+void RobotState::restartRobotCode()
+{
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Restarting robot code");
+    if (m_communicationHandler) {
+        m_communicationHandler->sendRestartCodeCommand();
+    }
+}
+
+void RobotState::downloadLogs(const QString& destinationPath)
+{
+    if (!m_communicationHandler || m_logDownloadInProgress) {
+        return;
+    }
+    m_logDownloadInProgress = true;
+    m_logDownloadProgress = 0;
+    emit logDownloadInProgressChanged(true);
+    emit logDownloadProgressChanged(0);
+    m_communicationHandler->downloadLogs(destinationPath);
+}
+
+void RobotState::cancelLogDownload()
+{
+    if (m_communicationHandler && m_logDownloadInProgress) {
+        m_communicationHandler->cancelLogDownload();
+    }
+    // Aborting the reply may already have completed the download with an error
+    if (m_logDownloadInProgress) {
+        onLogDownloadCompleted(QString(), false);
+    }
+}
+
+#ifdef ENABLE_FMS_SUPPORT
+void RobotState::onFMSStateChanged(const FRCDriverStation::FmsState::Snapshot &snapshot)
+{
+    // The control packet carrying this change is already on its way (see
+    // CommunicationHandler::onFmsStateChanged), so nothing here re-triggers a burst
+    if (snapshot.connected != m_fmsConnected) {
+        QMutexLocker locker(&m_stateMutex);
+        m_fmsConnected = snapshot.connected;
+        locker.unlock();
+        
+        YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                      snapshot.connected ? "FMS connected" : "FMS disconnected");
+        emit fmsConnectedChanged(snapshot.connected);
+    }
     
-    Logger::instance().log(Logger::Info, "RobotState", 
-                          QString("Robot mode changed to: %1").arg(robotMode()));
-    emit robotModeChanged(robotMode());
+    // Only the FMS asserting e-stop is acted on; clearing stays a local decision
+    if (snapshot.emergencyStop && !m_emergencyStop) {
+        applyEmergencyStop("FMS");
+    }
+    
+    // An FMS disable, or losing the FMS link, disables locally as well
+    if (!snapshot.enabled && m_robotEnabled) {
+        applyDisable("FMS");
+    }
+    
+    if (!snapshot.connected) {
+        return;
+    }
+    
+    // The FMS assigns the alliance; the position within it stays as configured
+    setStation(m_station % 3 + (snapshot.alliance == FMSHandler::Blue ? 3 : 0));
+    
+    const RobotMode mode = snapshot.test ? Test : snapshot.autonomous ? Autonomous : Teleop;
+    if (mode != m_robotMode) {
+        QMutexLocker locker(&m_stateMutex);
+        m_robotMode = mode;
+        locker.unlock();
+        
+        YADS_LOG_INFO(::Constants::LogCategories::FMS,
+                      QString("Robot mode changed to: %1").arg(robotMode()));
+        emit robotModeChanged(robotMode());
+    }
 }
 #endif
 
@@ -683,10 +954,10 @@ void RobotState::updateConnectionState(ConnectionState newState)
         m_connectionState = newState;
         locker.unlock();
         
-        Logger::instance().log(Logger::Info, "RobotState", 
-                              QString("Connection state changed: %1 -> %2")
-                              .arg(static_cast<int>(oldState))
-                              .arg(static_cast<int>(newState)));
+        YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                      QString("Connection state changed: %1 -> %2")
+                      .arg(static_cast<int>(oldState))
+                      .arg(static_cast<int>(newState)));
         
         emit connectionStateChanged(newState);
     }
@@ -697,13 +968,13 @@ void RobotState::logStateChange(const QString& change)
     QString target = (m_connectionMode == TeamNumber) ? 
         QString("Team: %1").arg(m_teamNumber) : QString("IP: %1").arg(m_robotIpAddress);
     
-    Logger::instance().log(Logger::Info, "RobotState", 
-                          QString("State change: %1 (%2, Connected: %3, Enabled: %4, E-Stop: %5)")
-                          .arg(change)
-                          .arg(target)
-                          .arg(isRobotConnected() ? "Yes" : "No")
-                          .arg(m_robotEnabled ? "Yes" : "No")
-                          .arg(m_emergencyStop ? "Yes" : "No"));
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM,
+                  QString("State change: %1 (%2, Connected: %3, Enabled: %4, E-Stop: %5)")
+                  .arg(change)
+                  .arg(target)
+                  .arg(isRobotConnected() ? "Yes" : "No")
+                  .arg(m_robotEnabled ? "Yes" : "No")
+                  .arg(m_emergencyStop ? "Yes" : "No"));
 }
 
 void RobotState::saveSettings()
@@ -730,23 +1001,23 @@ void RobotState::loadSettings()
 
 void RobotState::restartApplication()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Restarting application");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Restarting application");
     
     // Save current state
     saveSettings();
     
     // Restart the application
-    QApplication::quit();
-    QProcess::startDetached(QApplication::applicationFilePath(), QApplication::arguments());
+    QCoreApplication::quit();
+    QProcess::startDetached(QCoreApplication::applicationFilePath(), QCoreApplication::arguments());
 }
 
 void RobotState::shutdownApplication()
 {
-    Logger::instance().log(Logger::Info, "RobotState", "Shutting down application");
+    YADS_LOG_INFO(::Constants::LogCategories::ROBOT_COMM, "Shutting down application");
     
     // Save current state
     saveSettings();
     
     // Quit the application
-    QApplication::quit();
+    QCoreApplication::quit();
 }
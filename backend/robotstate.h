@@ -7,6 +7,8 @@
 #include <QMutex>
 #include <QNetworkInterface>
 #include <QHostAddress>
+#include <QStringList>
+#include <QVariantList>
 
 #ifdef ENABLE_GLOBAL_SHORTCUTS
 #ifdef QHOTKEY_AVAILABLE
@@ -17,14 +19,21 @@
 
 #include "core/logger.h"
 #include "core/constants.h"
+#include "core/statepublisher.h"
 
+namespace FRCDriverStation {
 class CommunicationHandler;
 class ControllerHIDHandler;
 class BatteryManager;
 class PracticeMatchManager;
 class NetworkManager;
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+class EvdevKeyListener;
+#endif
+}
 
 #ifdef ENABLE_FMS_SUPPORT
+#include "fms/fmsstate.h"
 class FMSHandler;
 #endif
 
@@ -33,6 +42,15 @@ class FMSHandler;
  * 
  * This class manages the overall state of the robot connection,
  * handles global shortcuts, and coordinates between different subsystems.
+ *
+ * Telemetry that changes at packet rate (voltages, latency, packet loss,
+ * roboRIO load) is published through a StatePublisher: producers write it
+ * lock-free from their own thread, and the NOTIFY signals fire at most once
+ * per UI tick. Enable, e-stop and connection state still notify immediately.
+ *
+ * The CommunicationHandler owned here reads enable, mode, team and station
+ * from this object for every control packet, and reports what the robot sends
+ * back through the update*() methods.
  */
 class RobotState : public QObject
 {
@@ -54,6 +72,21 @@ class RobotState : public QObject
     Q_PROPERTY(double robotVoltage READ robotVoltage NOTIFY robotVoltageChanged)
     Q_PROPERTY(double networkLatency READ networkLatency NOTIFY networkLatencyChanged)
     Q_PROPERTY(double packetLoss READ packetLoss NOTIFY packetLossChanged)
+    Q_PROPERTY(double bandwidth READ bandwidth NOTIFY bandwidthChanged)
+    Q_PROPERTY(QVariantList streamRates READ streamRates NOTIFY streamRatesChanged)
+    Q_PROPERTY(double cpuUsage READ cpuUsage NOTIFY cpuUsageChanged)
+    Q_PROPERTY(double ramUsage READ ramUsage NOTIFY ramUsageChanged)
+    Q_PROPERTY(double diskUsage READ diskUsage NOTIFY diskUsageChanged)
+    Q_PROPERTY(double canUtil READ canUtil NOTIFY canUtilChanged)
+    Q_PROPERTY(int canBusOff READ canBusOff NOTIFY canBusOffChanged)
+    Q_PROPERTY(int matchTime READ matchTime NOTIFY matchTimeChanged)
+    Q_PROPERTY(int station READ station WRITE setStation NOTIFY stationChanged)
+    Q_PROPERTY(bool networkTablesConnected READ networkTablesConnected NOTIFY networkTablesStatusChanged)
+    Q_PROPERTY(QString networkTablesStatus READ networkTablesStatus NOTIFY networkTablesStatusChanged)
+    Q_PROPERTY(QString logDownloadStatus READ logDownloadStatus NOTIFY logDownloadStatusChanged)
+    Q_PROPERTY(int logDownloadProgress READ logDownloadProgress NOTIFY logDownloadProgressChanged)
+    Q_PROPERTY(bool logDownloadInProgress READ logDownloadInProgress NOTIFY logDownloadInProgressChanged)
+    Q_PROPERTY(QStringList availableLogFiles READ availableLogFiles NOTIFY availableLogFilesChanged)
     Q_PROPERTY(QString consoleOutput READ consoleOutput NOTIFY consoleOutputChanged)
     Q_PROPERTY(bool enabled READ enabled NOTIFY enabledChanged)
 
@@ -92,16 +125,36 @@ public:
     QString robotIpAddress() const { return m_robotIpAddress; }
     int connectionMode() const { return static_cast<int>(m_connectionMode); }
     QString robotMode() const;
-    double batteryVoltage() const { return m_batteryVoltage; }
-    int pingLatency() const { return m_pingLatency; }
+    RobotMode robotModeValue() const { return m_robotMode; }
+    double batteryVoltage() const { return m_telemetry.published(BatteryVoltageSlot); }
+    int pingLatency() const { return static_cast<int>(m_telemetry.published(PingLatencySlot)); }
     ConnectionState connectionState() const { return m_connectionState; }
     bool globalShortcutsEnabled() const { return m_globalShortcutsEnabled; }
     QString commsStatus() const { return m_commsStatus; }
     QString robotCodeStatus() const { return m_robotCodeStatus; }
     QString joystickStatus() const { return m_joystickStatus; }
-    double robotVoltage() const { return m_robotVoltage; }
-    double networkLatency() const { return m_networkLatency; }
-    double packetLoss() const { return m_packetLoss; }
+    double robotVoltage() const { return m_telemetry.published(RobotVoltageSlot); }
+    double networkLatency() const { return m_telemetry.published(NetworkLatencySlot); }
+    double packetLoss() const { return m_telemetry.published(PacketLossSlot); }
+    double bandwidth() const { return m_telemetry.published(BandwidthSlot); }
+    // One map per traffic stream: name, sent/received bytes per second and limit
+    QVariantList streamRates() const { return m_streamRates; }
+    // Status packet loss bursts by length, one {label, count} per non-empty bucket
+    Q_INVOKABLE QVariantList lossBurstBuckets() const;
+    double cpuUsage() const { return m_telemetry.published(CpuUsageSlot); }
+    double ramUsage() const { return m_telemetry.published(RamUsageSlot); }
+    double diskUsage() const { return m_telemetry.published(DiskUsageSlot); }
+    double canUtil() const { return m_telemetry.published(CanUtilSlot); }
+    int canBusOff() const { return static_cast<int>(m_telemetry.published(CanBusOffSlot)); }
+    int matchTime() const { return m_matchTime; }
+    // Driver station position, 0-2 red 1-3 and 3-5 blue 1-3, as sent to the robot
+    int station() const { return m_station; }
+    bool networkTablesConnected() const { return m_networkTablesConnected; }
+    QString networkTablesStatus() const { return m_networkTablesStatus; }
+    QString logDownloadStatus() const { return m_logDownloadStatus; }
+    int logDownloadProgress() const { return m_logDownloadProgress; }
+    bool logDownloadInProgress() const { return m_logDownloadInProgress; }
+    QStringList availableLogFiles() const { return m_availableLogFiles; }
     QString consoleOutput() const { return m_consoleOutput; }
     bool enabled() const { return m_robotEnabled; }
 
@@ -110,13 +163,39 @@ public:
     void setRobotIpAddress(const QString& ipAddress);
     void setConnectionMode(int mode);
     void setGlobalShortcutsEnabled(bool enabled);
+    void setStation(int station);
+    // Autonomous, Teleop or Test; disables first if enabled. Refused while the FMS owns the mode.
+    Q_INVOKABLE bool setRobotMode(RobotMode mode);
 
     // Component getters
-    CommunicationHandler* communicationHandler() const { return m_communicationHandler; }
-    ControllerHIDHandler* controllerHandler() const { return m_controllerHandler; }
-    BatteryManager* batteryManager() const { return m_batteryManager; }
-    PracticeMatchManager* practiceMatchManager() const { return m_practiceMatchManager; }
-    NetworkManager* networkManager() const { return m_networkManager; }
+    FRCDriverStation::CommunicationHandler* communicationHandler() const { return m_communicationHandler; }
+    FRCDriverStation::ControllerHIDHandler* controllerHandler() const { return m_controllerHandler; }
+    FRCDriverStation::BatteryManager* batteryManager() const { return m_batteryManager; }
+    FRCDriverStation::PracticeMatchManager* practiceMatchManager() const { return m_practiceMatchManager; }
+    FRCDriverStation::NetworkManager* networkManager() const { return m_networkManager; }
+    
+    // Data updates from the communication handler, up to once per status packet.
+    // Telemetry goes through the publisher; the rest notifies only on a change.
+    void updateRobotVoltage(double voltage);
+    void updateNetworkLatency(double latency);
+    void updatePacketLoss(double loss);
+    void updateBandwidth(double kilobytesPerSecond);
+    void updateStreamRates(const QVariantList &rates);
+    void updateCpuUsage(double percent);
+    void updateRamUsage(double percent);
+    void updateDiskUsage(double percent);
+    void updateCanUtil(double percent);
+    void updateCanBusOff(int count);
+    void updateMatchTime(int seconds);
+    void updateCommsStatus(const QString& status);
+    void updateRobotCodeStatus(const QString& status);
+    void updateJoystickStatus(const QString& status);
+    void updateNetworkTablesStatus(bool connected, const QString& status);
+    void appendConsoleMessage(const QString& message);
+    void updateLogDownloadStatus(const QString& status);
+    void updateLogDownloadProgress(int percent);
+    void updateAvailableLogFiles(const QStringList& files);
+    void onLogDownloadCompleted(const QString& path, bool success);
 
 #ifdef ENABLE_FMS_SUPPORT
     FMSHandler* fmsHandler() const { return m_fmsHandler; }
@@ -125,14 +204,20 @@ public:
 public slots:
     // Robot control
     void enableRobot();
-    void disableRobot();
-    void emergencyStopRobot();
+    void disableRobot(const QString &source = "Manual");
+    void emergencyStopRobot(const QString &source = "Manual");
     void clearEmergencyStop();
     
     // Connection management
     void connectToRobot();
     void disconnectFromRobot();
     void restartCommunication();
+    
+    // Robot commands
+    void rebootRobot();
+    void restartRobotCode();
+    void downloadLogs(const QString& destinationPath);
+    void cancelLogDownload();
 
     // System control
     void restartApplication();
@@ -158,6 +243,21 @@ signals:
     void robotVoltageChanged(double voltage);
     void networkLatencyChanged(double latency);
     void packetLossChanged(double loss);
+    void bandwidthChanged(double bandwidth);
+    void streamRatesChanged();
+    void cpuUsageChanged(double usage);
+    void ramUsageChanged(double usage);
+    void diskUsageChanged(double usage);
+    void canUtilChanged(double utilization);
+    void canBusOffChanged(int count);
+    void matchTimeChanged(int seconds);
+    void stationChanged(int station);
+    void networkTablesStatusChanged();
+    void logDownloadStatusChanged(const QString& status);
+    void logDownloadProgressChanged(int progress);
+    void logDownloadInProgressChanged(bool inProgress);
+    void availableLogFilesChanged(const QStringList& files);
+    void logDownloadCompleted(const QString& path, bool success);
     void consoleOutputChanged(const QString& output);
     void enabledChanged(bool enabled);
 
@@ -165,23 +265,22 @@ signals:
     void robotStatusChanged();
     void communicationError(const QString& error);
     void emergencyStopTriggered(const QString& source);
+    void disableTriggered(const QString& source);
     void globalShortcutTriggered(const QString& shortcut);
 
 private slots:
     // Internal state management
     void onRobotConnected();
     void onRobotDisconnected();
-    void onRobotEnabled();
-    void onRobotDisabled();
-    void onBatteryVoltageChanged(double voltage);
-    void onPingLatencyChanged(int latency);
-    void onCommunicationError(const QString& error);
-    void updateStatusStrings();
 
 #ifdef ENABLE_FMS_SUPPORT
-    void onFMSConnected();
-    void onFMSDisconnected();
-    void onFMSModeChanged(int mode);
+    void onFMSStateChanged(const FRCDriverStation::FmsState::Snapshot &snapshot);
+#endif
+
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+    void onEvdevKeyboardAdded(const QString& path, const QString& name);
+    void onEvdevKeyboardRemoved(const QString& path, const QString& name);
+    void onEvdevError(const QString& error);
 #endif
 
 #if defined(ENABLE_GLOBAL_SHORTCUTS) && defined(QHOTKEY_AVAILABLE)
@@ -192,6 +291,21 @@ private slots:
 #endif
 
 private:
+    // Slots in m_telemetry, registered in this order by setupTelemetry()
+    enum TelemetrySlot {
+        BatteryVoltageSlot = 0,
+        PingLatencySlot,
+        RobotVoltageSlot,
+        NetworkLatencySlot,
+        PacketLossSlot,
+        BandwidthSlot,
+        CpuUsageSlot,
+        RamUsageSlot,
+        DiskUsageSlot,
+        CanUtilSlot,
+        CanBusOffSlot
+    };
+    
     // Core state
     bool m_robotEnabled;
     bool m_emergencyStop;
@@ -201,18 +315,27 @@ private:
     ConnectionMode m_connectionMode;
     RobotMode m_robotMode;
     ConnectionState m_connectionState;
-    double m_batteryVoltage;
-    int m_pingLatency;
     bool m_globalShortcutsEnabled;
+    int m_station;
+    int m_matchTime;
     
     // Status strings
     QString m_commsStatus;
     QString m_robotCodeStatus;
     QString m_joystickStatus;
-    double m_robotVoltage;
-    double m_networkLatency;
-    double m_packetLoss;
     QString m_consoleOutput;
+    QString m_networkTablesStatus;
+    bool m_networkTablesConnected;
+    QVariantList m_streamRates;
+    
+    // Log download
+    QString m_logDownloadStatus;
+    int m_logDownloadProgress;
+    bool m_logDownloadInProgress;
+    QStringList m_availableLogFiles;
+    
+    // Packet-rate telemetry, coalesced to UI rate
+    FRCDriverStation::StatePublisher m_telemetry;
 
     // Timestamps
     QDateTime m_lastPacketTime;
@@ -223,16 +346,21 @@ private:
     mutable QMutex m_stateMutex;
 
     // Components
-    CommunicationHandler* m_communicationHandler;
-    ControllerHIDHandler* m_controllerHandler;
-    BatteryManager* m_batteryManager;
-    PracticeMatchManager* m_practiceMatchManager;
-    NetworkManager* m_networkManager;
+    FRCDriverStation::CommunicationHandler* m_communicationHandler;
+    FRCDriverStation::ControllerHIDHandler* m_controllerHandler;
+    FRCDriverStation::BatteryManager* m_batteryManager;
+    FRCDriverStation::PracticeMatchManager* m_practiceMatchManager;
+    FRCDriverStation::NetworkManager* m_networkManager;
 
 #ifdef ENABLE_FMS_SUPPORT
     FMSHandler* m_fmsHandler;
 #endif
 
+#ifdef ENABLE_EVDEV_SAFETY_KEYS
+    // Safety keys read straight from evdev, independent of the display server
+    FRCDriverStation::EvdevKeyListener* m_evdevKeyListener;
+#endif
+
 #if defined(ENABLE_GLOBAL_SHORTCUTS) && defined(QHOTKEY_AVAILABLE)
     // Global shortcuts
     QPointer<QHotkey> m_emergencyStopHotkey;
@@ -248,8 +376,13 @@ private:
     void initializeComponents();
     void setupConnections();
     void setupTimers();
+    void setupTelemetry();
     void updateConnectionState(ConnectionState newState);
+    void applyRobotAddress();
+    void setEnabledState(bool enabled);
     void logStateChange(const QString& change);
+    void applyEmergencyStop(const QString& source);
+    void applyDisable(const QString& source);
     void saveSettings();
     void loadSettings();
 
@@ -0,0 +1,42 @@
+#include "benchmarkutils.h"
+#include "backend/managers/battery_manager.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+// Alternates far enough apart that every call passes the change threshold and
+// lands in the history, which is the expensive path
+constexpr double VOLTAGE_LOW = 11.8;
+constexpr double VOLTAGE_HIGH = 12.6;
+constexpr int FULL_HISTORY = 3600;
+
+} // namespace
+
+static void BM_BatteryUpdateVoltage(benchmark::State &state) {
+    BatteryManager battery;
+    bool high = false;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        high = !high;
+        battery.updateVoltage(high ? VOLTAGE_HIGH : VOLTAGE_LOW);
+    }
+    allocations.report();
+}
+BENCHMARK(BM_BatteryUpdateVoltage);
+
+static void BM_BatteryGetAverageVoltage(benchmark::State &state) {
+    BatteryManager battery;
+    // A full history; every reading is recent so the whole list is scanned
+    for (int i = 0; i < FULL_HISTORY; ++i) {
+        battery.updateVoltage(i % 2 ? VOLTAGE_HIGH : VOLTAGE_LOW);
+    }
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(battery.getAverageVoltage(10));
+    }
+    allocations.report();
+}
+BENCHMARK(BM_BatteryGetAverageVoltage);
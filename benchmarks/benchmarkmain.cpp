@@ -0,0 +1,23 @@
+#include <QCoreApplication>
+#include <QStandardPaths>
+#include "benchmarkutils.h"
+
+// Custom main: the code under test creates QObjects and timers, which need an application object
+int main(int argc, char *argv[])
+{
+    // Keep benchmark log files out of the real application data directory
+    QStandardPaths::setTestModeEnabled(true);
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("yads_bench");
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+
+    benchmark::AddCustomContext("allocation_counting",
+                                FRCDriverStation::AllocationCounter::isEnabled() ? "on" : "off");
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
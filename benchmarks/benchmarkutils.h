@@ -0,0 +1,39 @@
+#ifndef BENCHMARKUTILS_H
+#define BENCHMARKUTILS_H
+
+#include <benchmark/benchmark.h>
+#include "backend/core/allocationcounter.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Reports heap allocations per iteration for one benchmark run
+ *
+ * Construct just before the timed loop; report() adds "allocs/op" and
+ * "bytes/op" counters to the benchmark output (and its JSON export).
+ */
+class AllocationScope
+{
+public:
+    explicit AllocationScope(benchmark::State &state)
+        : m_state(state)
+        , m_start(AllocationCounter::thread())
+    {
+    }
+
+    void report() {
+        const AllocationCounter::Snapshot end = AllocationCounter::thread();
+        m_state.counters["allocs/op"] = benchmark::Counter(
+            double(end.allocations - m_start.allocations), benchmark::Counter::kAvgIterations);
+        m_state.counters["bytes/op"] = benchmark::Counter(
+            double(end.bytes - m_start.bytes), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    benchmark::State &m_state;
+    AllocationCounter::Snapshot m_start;
+};
+
+} // namespace FRCDriverStation
+
+#endif // BENCHMARKUTILS_H
@@ -0,0 +1,100 @@
+#include "benchmarkutils.h"
+#include "backend/comms/packets.h"
+#include "backend/controllers/controllerhiddevice.h"
+
+#ifdef Q_OS_LINUX
+#include "tests/uinputdevice.h"
+#include <cstring>
+#include <iterator>
+#endif
+
+using namespace FRCDriverStation;
+
+static void BM_JoystickDataSerialize(benchmark::State &state) {
+    FRC::JoystickData joystick;
+    for (int axis = 0; axis < FRC::JoystickData::MAX_AXES; ++axis) {
+        joystick.axes[axis] = (axis % 5 - 2) / 2.0f;
+    }
+    joystick.buttons = 0xA5A5A5A5;
+    joystick.povs[0] = 90;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        QByteArray data = joystick.serialize();
+        benchmark::DoNotOptimize(data.constData());
+    }
+    allocations.report();
+}
+BENCHMARK(BM_JoystickDataSerialize);
+
+#ifdef Q_OS_LINUX
+
+namespace {
+
+const int GAMEPAD_AXES[] = {ABS_X, ABS_Y, ABS_Z, ABS_RX, ABS_RY, ABS_RZ};
+const int GAMEPAD_BUTTONS[] = {BTN_SOUTH, BTN_EAST, BTN_NORTH, BTN_WEST,
+                               BTN_TL, BTN_TR, BTN_SELECT, BTN_START};
+constexpr char GAMEPAD_NAME[] = "YADS benchmark gamepad";
+
+// One frame of stick and button movement, terminated by SYN_REPORT
+void emitFrame(UinputDevice &gamepad, int frame) {
+    input_event events[std::size(GAMEPAD_AXES) + std::size(GAMEPAD_BUTTONS) + 1];
+    std::memset(events, 0, sizeof(events));
+    int count = 0;
+    for (int axis : GAMEPAD_AXES) {
+        events[count].type = EV_ABS;
+        events[count].code = axis;
+        events[count].value = ((frame * 977 + axis * 131) % 65536) - 32768;
+        ++count;
+    }
+    for (int button : GAMEPAD_BUTTONS) {
+        events[count].type = EV_KEY;
+        events[count].code = button;
+        events[count].value = (frame + button) & 1;
+        ++count;
+    }
+    events[count].type = EV_SYN;
+    events[count].code = SYN_REPORT;
+    ++count;
+    gamepad.emitEvents(events, count);
+}
+
+} // namespace
+
+static void BM_ControllerUpdateData(benchmark::State &state) {
+    // A real evdev node, so updateData() is measured including its read() syscall
+    QVector<UinputDevice::Axis> axes;
+    for (int axis : GAMEPAD_AXES) {
+        axes.append({axis, -32768, 32767});
+    }
+    UinputDevice gamepad(GAMEPAD_NAME, QVector<int>(std::begin(GAMEPAD_BUTTONS), std::end(GAMEPAD_BUTTONS)), axes);
+    if (!gamepad.isValid()) {
+        state.SkipWithError("Cannot create a uinput device (no write access to /dev/uinput?)");
+        return;
+    }
+    const QString path = gamepad.eventPath();
+    std::unique_ptr<ControllerHIDDevice> device(
+        path.isEmpty() ? nullptr : ControllerHIDDevice::createFromPath(path));
+    if (!device) {
+        state.SkipWithError("Cannot open the virtual gamepad event node");
+        return;
+    }
+
+    // Drain anything queued while the device was being set up
+    while (device->updateData()) {
+    }
+
+    int frame = 0;
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        state.PauseTiming();
+        emitFrame(gamepad, frame++);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(device->updateData());
+    }
+    allocations.report();
+}
+// Pause/ResumeTiming is costly; keep the iteration count moderate
+BENCHMARK(BM_ControllerUpdateData)->Iterations(20000);
+
+#endif // Q_OS_LINUX
@@ -0,0 +1,107 @@
+#include "benchmarkutils.h"
+#include "backend/core/logger.h"
+#include <QString>
+#include <cstdio>
+#include <iostream>
+
+#ifdef Q_OS_UNIX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace FRCDriverStation;
+
+namespace {
+
+Logger &initializedLogger() {
+    static bool initialized = false;
+    if (!initialized) {
+        Logger::instance().initialize();
+        initialized = true;
+    }
+    return Logger::instance();
+}
+
+// Points stdout at /dev/null for the lifetime of the object so console logging
+// is measured without flooding the benchmark report
+class StdoutSilencer
+{
+public:
+    StdoutSilencer() : m_saved(-1) {
+#ifdef Q_OS_UNIX
+        std::cout.flush();
+        std::fflush(stdout);
+        m_saved = dup(STDOUT_FILENO);
+        const int devNull = open("/dev/null", O_WRONLY);
+        if (devNull >= 0) {
+            dup2(devNull, STDOUT_FILENO);
+            close(devNull);
+        }
+#endif
+    }
+
+    ~StdoutSilencer() {
+#ifdef Q_OS_UNIX
+        std::cout.flush();
+        std::fflush(stdout);
+        if (m_saved >= 0) {
+            dup2(m_saved, STDOUT_FILENO);
+            close(m_saved);
+        }
+#endif
+    }
+
+private:
+    int m_saved;
+};
+
+} // namespace
+
+static void BM_LoggerInfoFile(benchmark::State &state) {
+    Logger &logger = initializedLogger();
+    logger.setConsoleLoggingEnabled(false);
+    logger.setFileLoggingEnabled(true);
+    const QString message = QStringLiteral("Robot voltage 12.34V, CAN 23%, packet 4711");
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        logger.info(message, "Benchmark");
+    }
+    allocations.report();
+}
+BENCHMARK(BM_LoggerInfoFile);
+
+static void BM_LoggerInfoConsole(benchmark::State &state) {
+    Logger &logger = initializedLogger();
+    logger.setFileLoggingEnabled(false);
+    const QString message = QStringLiteral("Robot voltage 12.34V, CAN 23%, packet 4711");
+
+    StdoutSilencer silencer;
+    logger.setConsoleLoggingEnabled(true);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        logger.info(message, "Benchmark");
+    }
+    allocations.report();
+
+    logger.setConsoleLoggingEnabled(false);
+    logger.setFileLoggingEnabled(true);
+}
+BENCHMARK(BM_LoggerInfoConsole);
+
+static void BM_LoggerInfoFiltered(benchmark::State &state) {
+    // Below the log level: the cost every disabled debug() call site pays
+    Logger &logger = initializedLogger();
+    logger.setLogLevel(Logger::LogLevel::Warning);
+    const QString message = QStringLiteral("Robot voltage 12.34V, CAN 23%, packet 4711");
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        logger.info(message, "Benchmark");
+    }
+    allocations.report();
+
+    logger.setLogLevel(Logger::LogLevel::Info);
+}
+BENCHMARK(BM_LoggerInfoFiltered);
@@ -0,0 +1,62 @@
+#include "benchmarkutils.h"
+#include "backend/core/clock.h"
+#include "backend/core/matchclock.h"
+#include "backend/managers/practice_match_manager.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+constexpr qint64 AUTONOMOUS_END_MS = 15 * 1000;
+constexpr int PACKET_INTERVAL_MS = 20;
+
+} // namespace
+
+// A full 15 + 135 + 30 s practice match in virtual time, with a 50 Hz packet
+// timer reading the schedule the way the transmit path does
+static void BM_PracticeMatchVirtualTime(benchmark::State &state) {
+    qint64 packets = 0;
+    for (auto _ : state) {
+        VirtualClock clock;
+        PracticeMatchManager match;
+        match.setClock(&clock);
+
+        ClockTimer packetTimer;
+        packetTimer.setClock(&clock);
+        packetTimer.setInterval(PACKET_INTERVAL_MS);
+        qint64 firstTeleopPacketMs = -1;
+        QObject::connect(&packetTimer, &ClockTimer::timeout, [&]() {
+            ++packets;
+            const MatchClock::Reading reading = match.matchClock()->read();
+            if (firstTeleopPacketMs < 0 && reading.phase == MatchClock::Teleop) {
+                firstTeleopPacketMs = clock.nowMs();
+            }
+        });
+        packetTimer.start();
+
+        match.startMatch();
+        while (match.running() && clock.advanceToNextTimer()) {
+        }
+
+        // Packet-synchronous: the first teleop packet is the one sent at the deadline
+        if (firstTeleopPacketMs != AUTONOMOUS_END_MS) {
+            state.SkipWithError("teleop did not start on the packet at the autonomous deadline");
+            break;
+        }
+    }
+    state.counters["packets/op"] = benchmark::Counter(double(packets), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_PracticeMatchVirtualTime)->Unit(benchmark::kMillisecond);
+
+// Cost of one schedule read, paid by every control packet during a match
+static void BM_MatchClockRead(benchmark::State &state) {
+    MatchClock clock;
+    clock.start(15, 135, 30);
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(clock.read());
+    }
+    allocations.report();
+}
+BENCHMARK(BM_MatchClockRead);
@@ -0,0 +1,138 @@
+#include "benchmarkutils.h"
+#include "backend/robot/comms/packets.h"
+#include "backend/core/constants.h"
+#include "backend/fms/fmshandler.h"
+#include <QDataStream>
+#include <QList>
+
+using namespace FRCDriverStation;
+using namespace FRCDriverStation::Constants;
+using namespace FRCDriverStation::Protocol;
+
+namespace {
+
+// Bound controllers with every input in use; all slots is the worst case for the control path
+QList<JoystickData> busyJoysticks(int count) {
+    QList<JoystickData> joysticks;
+    for (int slot = 0; slot < count; ++slot) {
+        JoystickData joystick;
+        for (int axis = 0; axis < Controllers::MAX_AXES_PER_CONTROLLER; ++axis) {
+            joystick.axes.setAxis(axis, ((axis + slot) % 7 - 3) / 3.0);
+        }
+        for (int button = 0; button < Controllers::MAX_BUTTONS_PER_CONTROLLER; ++button) {
+            joystick.buttons.setButton(button, (button + slot) % 3 == 0);
+        }
+        for (int pov = 0; pov < Controllers::MAX_POVS_PER_CONTROLLER; ++pov) {
+            joystick.povs.setPOV(pov, pov == 0 ? 90 : -1);
+        }
+        joysticks.append(joystick);
+    }
+    return joysticks;
+}
+
+// A status packet in the layout PacketBuilder::parseRobotPacket() reads
+QByteArray robotStatusPacket() {
+    QByteArray packet;
+    QDataStream stream(&packet, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    RobotToDSHeader header;
+    header.packetIndex = 1234;
+    header.control = 0;
+    header.status = 0;
+    header.voltage = 0;
+    RobotDiagnostics diagnostics;
+    diagnostics.cpuUsage = 25;
+    diagnostics.ramUsage = 40;
+    diagnostics.diskUsage = 30;
+    diagnostics.canUtilization = 20;
+    diagnostics.canBusOffCount = 0;
+    diagnostics.robotCodeStatus = 1;
+    MatchTiming timing;
+    timing.matchPhase = 0;
+    timing.matchTimeRemaining = 0;
+
+    stream << header.packetIndex << header.control << header.status << header.voltage;
+    stream << diagnostics.cpuUsage << diagnostics.ramUsage << diagnostics.diskUsage
+           << diagnostics.canUtilization << diagnostics.canBusOffCount << diagnostics.robotCodeStatus;
+    stream << timing.matchPhase << timing.matchTimeRemaining;
+    stream << PacketBuilder::calculateChecksum(packet);
+    return packet;
+}
+
+} // namespace
+
+static void BM_BuildDSPacket(benchmark::State &state) {
+    const QList<JoystickData> joysticks = busyJoysticks(int(state.range(0)));
+    DSToRobotHeader header;
+    header.control = ControlFlags::ENABLED;
+    header.request = RequestType::NORMAL;
+    header.station = 1;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        header.packetIndex++;
+        QByteArray packet = PacketBuilder::buildDSPacket(header, joysticks);
+        benchmark::DoNotOptimize(packet.constData());
+    }
+    allocations.report();
+}
+BENCHMARK(BM_BuildDSPacket)->ArgName("controllers")->Arg(0)->Arg(Controllers::MAX_CONTROLLER_SLOTS);
+
+static void BM_ParseRobotPacket(benchmark::State &state) {
+    const QByteArray packet = robotStatusPacket();
+    RobotToDSHeader header;
+    RobotDiagnostics diagnostics;
+    MatchTiming timing;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        const bool parsed = PacketBuilder::parseRobotPacket(packet, header, diagnostics, timing);
+        benchmark::DoNotOptimize(parsed);
+        benchmark::DoNotOptimize(header);
+    }
+    allocations.report();
+    if (!PacketBuilder::parseRobotPacket(packet, header, diagnostics, timing)) {
+        state.SkipWithError("Synthetic status packet did not parse");
+    }
+}
+BENCHMARK(BM_ParseRobotPacket);
+
+static void BM_RobotPacketsCalculateCRC(benchmark::State &state) {
+    RobotPackets packets;
+    QByteArray data(int(state.range(0)), Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] = char(i * 31);
+    }
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(packets.calculateCRC(data));
+    }
+    allocations.report();
+    state.SetBytesProcessed(qint64(state.iterations()) * data.size());
+}
+BENCHMARK(BM_RobotPacketsCalculateCRC)->ArgName("bytes")->Arg(64)->Arg(1024);
+
+// The FMS receive path per packet: decode in place, publish the snapshot, read it back
+// the way the transmit path does
+static void BM_FmsControlPacket(benchmark::State &state) {
+    // Qualification 12, play 1, 135 s left, enabled teleop, blue alliance
+    const uchar packet[FMSHandler::CONTROL_PACKET_SIZE] = {0x00, 0x2A, 0x02, 0x00, 0x0C, 0x01, 0x00, 0x87, 0x09};
+    FmsState fms;
+    FmsState::Snapshot snapshot;
+    snapshot.connected = true;
+
+    AllocationScope allocations(state);
+    for (auto _ : state) {
+        if (!FMSHandler::decodeControlPacket(packet, sizeof(packet), snapshot)) {
+            state.SkipWithError("Synthetic FMS packet did not decode");
+            break;
+        }
+        snapshot.receivedAtNs = fms.nowNs();
+        fms.publish(snapshot);
+        benchmark::DoNotOptimize(fms.read());
+    }
+    allocations.report();
+}
+BENCHMARK(BM_FmsControlPacket);
@@ -0,0 +1,231 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QLoggingCategory>
+#include <QTimer>
+#include <atomic>
+#include <csignal>
+
+#include "backend/core/logger.h"
+#include "backend/core/constants.h"
+#include "backend/core/eventloopmonitor.h"
+#include "backend/core/flightrecorder.h"
+#include "backend/core/tracing.h"
+#include "backend/core/sharedstate.h"
+#include "backend/ipc/controlserver.h"
+#include "backend/managers/battery_manager.h"
+#include "backend/managers/practice_match_manager.h"
+#include "backend/robotstate.h"
+#include "backend/robot/comms/communicationhandler.h"
+
+#ifdef ENABLE_FMS_SUPPORT
+#include "backend/fms/fmshandler.h"
+#endif
+
+Q_LOGGING_CATEGORY(daemonMain, "daemon")
+
+namespace {
+
+std::atomic<bool> s_stopRequested{false};
+
+void requestStop(int) {
+    s_stopRequested.store(true);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+
+    QCoreApplication app(argc, argv);
+
+    // Same names as the GUI, so both share settings, logs and recordings
+    app.setApplicationName(Constants::APPLICATION_NAME);
+    app.setApplicationVersion(Constants::APPLICATION_VERSION);
+    app.setOrganizationName(Constants::ORGANIZATION_NAME);
+    app.setOrganizationDomain(Constants::ORGANIZATION_DOMAIN);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Headless FRC Driver Station.\n"
+        "Controlled over a local socket with the protocol in sdk/yads_control.h.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption controlSocketOption("control-socket",
+        "Local socket name or path for the control API (see sdk/yads_control.h).", "name",
+        QString::fromLatin1(YADS_CONTROL_SOCKET_NAME));
+    QCommandLineOption teamOption("team",
+        "Team number to connect to (saved, as in the GUI).", "number");
+    QCommandLineOption robotAddressOption("robot-address",
+        "Talk to the robot at this address instead of 10.TE.AM.2 (e.g. 127.0.0.1 for yads-robot-sim).", "address");
+    QCommandLineOption fmsAddressOption("fms-address",
+        "Listen for an FMS and send its heartbeats to this address instead of 10.TE.AM.5 (e.g. 127.0.0.1 for yads-fms-sim).", "address");
+    QCommandLineOption logLevelOption("log-level",
+        "Log levels: a global level and/or category=level pairs, e.g. \"info,robot.communication=debug\".", "spec");
+    QCommandLineOption sharedStateOption("shared-state",
+        "Publish live state for external tools at this path instead of the default (see sdk/yads_shm.h).", "file");
+    QCommandLineOption traceOption("trace",
+        "Record hot-path trace spans and write them as Chrome trace JSON on exit (needs ENABLE_TRACING).", "file");
+    parser.addOption(controlSocketOption);
+    parser.addOption(teamOption);
+    parser.addOption(robotAddressOption);
+    parser.addOption(fmsAddressOption);
+    parser.addOption(logLevelOption);
+    parser.addOption(traceOption);
+    parser.addOption(sharedStateOption);
+    parser.process(app);
+
+    Logger::instance().initialize();
+    Logger::instance().startFlightRecorder();
+    if (parser.isSet(logLevelOption)) {
+        QString logLevelError;
+        if (!Logger::instance().applyLogLevelSpec(parser.value(logLevelOption), &logLevelError)) {
+            qCCritical(daemonMain) << "Invalid --log-level:" << logLevelError;
+            return 1;
+        }
+    }
+    qCInfo(daemonMain) << "Starting yads-daemon version" << Constants::APPLICATION_VERSION;
+
+    if (parser.isSet(traceOption)) {
+        if (FRCDriverStation::TRACING_COMPILED_IN) {
+            FRCDriverStation::Tracing::setEnabled(true);
+        } else {
+            qCWarning(daemonMain) << "--trace ignored: built without ENABLE_TRACING";
+        }
+    }
+
+    FRCDriverStation::EventLoopMonitor eventLoopMonitor;
+    eventLoopMonitor.start();
+
+    RobotState robotState;
+
+    if (parser.isSet(teamOption)) {
+        bool ok = false;
+        const int team = parser.value(teamOption).toInt(&ok);
+        if (!ok || team < 1 || team > 25599) {
+            qCCritical(daemonMain) << "Invalid --team" << parser.value(teamOption);
+            return 1;
+        }
+        robotState.setTeamNumber(team);
+        robotState.setConnectionMode(RobotState::TeamNumber);
+    }
+
+    if (parser.isSet(robotAddressOption)) {
+        const QHostAddress robotAddress(parser.value(robotAddressOption));
+        if (robotAddress.isNull()) {
+            qCCritical(daemonMain) << "Invalid --robot-address" << parser.value(robotAddressOption);
+            return 1;
+        }
+        robotState.setRobotIpAddress(robotAddress.toString());
+        robotState.setConnectionMode(RobotState::IpAddress);
+    }
+
+    if (parser.isSet(fmsAddressOption)) {
+#ifdef ENABLE_FMS_SUPPORT
+        const QHostAddress fmsAddress(parser.value(fmsAddressOption));
+        if (fmsAddress.isNull()) {
+            qCCritical(daemonMain) << "Invalid --fms-address" << parser.value(fmsAddressOption);
+            return 1;
+        }
+        FMSHandler *fmsHandler = robotState.fmsHandler();
+        fmsHandler->setFmsAddressOverride(fmsAddress);
+        fmsHandler->setTeamNumber(robotState.teamNumber());
+        QObject::connect(&robotState, &RobotState::teamNumberChanged, fmsHandler, &FMSHandler::setTeamNumber);
+        fmsHandler->connectToFMS();
+#else
+        qCWarning(daemonMain) << "--fms-address ignored: built without ENABLE_FMS_SUPPORT";
+#endif
+    }
+
+    // Flight recorder snapshots: packet summaries and e-stop/connection loss come from comms, as in the GUI
+    robotState.communicationHandler()->setFlightRecorder(Logger::instance().flightRecorder());
+    QObject::connect(robotState.batteryManager(), &FRCDriverStation::BatteryManager::voltageAlert,
+                     Logger::instance().flightRecorder(),
+                     [](FRCDriverStation::BatteryManager::BatteryLevel level, double voltage) {
+        if (level == FRCDriverStation::BatteryManager::Critical) {
+            Logger::instance().flightRecorder()->trigger(QString("brownout-%1V").arg(voltage, 0, 'f', 1));
+        }
+    });
+
+    // Updated from the packet path: every control and status packet, as in the GUI
+    FRCDriverStation::SharedState sharedState;
+    if (!sharedState.start(parser.value(sharedStateOption))) {
+        qCWarning(daemonMain) << "Cannot publish shared state at" << sharedState.path() << ":" << sharedState.errorString();
+    }
+    robotState.communicationHandler()->setSharedState(&sharedState);
+    
+    // Practice matches flip mode on the packet at each phase deadline, as in the GUI
+    FRCDriverStation::PracticeMatchManager *practiceMatch = robotState.practiceMatchManager();
+    robotState.communicationHandler()->setMatchClock(practiceMatch->matchClock());
+    auto publishPracticeMatch = [&sharedState, practiceMatch]() {
+        sharedState.setMatch(quint8(practiceMatch->currentPhase()),
+                             practiceMatch->running() ? YADS_SHM_MATCH_PRACTICE : YADS_SHM_MATCH_NONE,
+                             float(practiceMatch->phaseTimeRemaining()));
+    };
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::runningChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::currentPhaseChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::timeRemainingChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::phaseScheduleChanged, &sharedState, publishPracticeMatch);
+#ifdef ENABLE_FMS_SUPPORT
+    FMSHandler *fms = robotState.fmsHandler();
+    auto publishFms = [&sharedState, fms]() {
+        sharedState.setFms(fms->isConnected(), fms->isEnabled(), fms->isEmergencyStop(),
+                           quint8(fms->allianceColor()), quint16(fms->matchNumber()));
+    };
+    QObject::connect(fms, &FMSHandler::stateChanged, &sharedState, publishFms);
+    publishFms();
+#endif
+
+    // No controller handling in the daemon: bind requests are answered UNSUPPORTED
+    FRCDriverStation::ControlServer controlServer(&robotState);
+    controlServer.setQuitAllowed(true);
+    if (!controlServer.listen(parser.value(controlSocketOption))) {
+        qCCritical(daemonMain) << "Cannot listen on" << parser.value(controlSocketOption) << ":" << controlServer.errorString();
+        return 1;
+    }
+    QObject::connect(&controlServer, &FRCDriverStation::ControlServer::quitRequested,
+                     &app, &QCoreApplication::quit);
+
+    // SIGTERM from systemd and Ctrl+C both go through the normal shutdown
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    QTimer stopPoll;
+    QObject::connect(&stopPoll, &QTimer::timeout, &app, []() {
+        if (s_stopRequested.load()) {
+            QCoreApplication::quit();
+        }
+    });
+    stopPoll.start(100);
+
+    // Safe state first, while comms are still up: nothing may stay enabled once the daemon
+    // is gone. The disable burst is flushed when the e-stop channel is destroyed, and one
+    // disabled control packet goes out here in case the robot was already disabled
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, &robotState, [&robotState]() {
+        robotState.disableRobot("Daemon shutdown");
+        robotState.communicationHandler()->sendControlPacket();
+    });
+
+    qCInfo(daemonMain) << "Control API on" << controlServer.serverPath()
+                       << "- ready in" << startupTimer.elapsed() << "ms";
+
+    int result = app.exec();
+
+    qCInfo(daemonMain) << "yads-daemon shutting down with exit code:" << result;
+    controlServer.close();
+    Logger::instance().stopFlightRecorder();
+    robotState.communicationHandler()->setSharedState(nullptr);
+    sharedState.stop();
+
+    if (FRCDriverStation::Tracing::isEnabled()) {
+        QString traceError;
+        if (!FRCDriverStation::Tracing::writeChromeTrace(parser.value(traceOption), &traceError)) {
+            qCWarning(daemonMain) << "Could not write trace to" << parser.value(traceOption) << ":" << traceError;
+        }
+    }
+
+    Logger::instance().shutdown();
+    return result;
+}
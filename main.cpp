@@ -5,11 +5,31 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QLoggingCategory>
+#include <QCommandLineParser>
+#include <QHostAddress>
 
 #include "backend/core/logger.h"
 #include "backend/core/constants.h"
+#include "backend/core/eventloopmonitor.h"
+#include "backend/core/tracing.h"
+#include "backend/core/flightrecorder.h"
+#include "backend/core/eventlogmodel.h"
+#include "backend/core/eventlogfiltermodel.h"
+#include "backend/core/seriesfeeder.h"
+#include "backend/core/sharedstate.h"
+#include "backend/ipc/controlserver.h"
+#include "backend/controllers/controllerhidhandler.h"
+#include "backend/managers/battery_manager.h"
+#include "backend/managers/network_manager.h"
+#include "backend/managers/practice_match_manager.h"
 #include "backend/managers/application_manager.h"
 #include "backend/robotstate.h"
+#include "backend/robot/comms/communicationhandler.h"
+#include "backend/robot/comms/replayengine.h"
+
+#ifdef ENABLE_FMS_SUPPORT
+#include "backend/fms/fmshandler.h"
+#endif
 
 #ifdef ENABLE_GLOBAL_SHORTCUTS
 #include <QHotkey>
@@ -30,23 +50,144 @@ int main(int argc, char *argv[])
     // Set application icon
     app.setWindowIcon(QIcon(":/icons/app-icon.png"));
     
+    // Command line options
+    QCommandLineParser parser;
+    parser.setApplicationDescription("FRC Driver Station");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption replayOption("replay",
+        "Replay a recorded session (.yrec) through the status pipeline.", "file");
+    QCommandLineOption replaySpeedOption("replay-speed",
+        "Replay pacing: realtime or fast.", "speed", "realtime");
+    QCommandLineOption replayReportOption("replay-report",
+        "Write the replay benchmark report as JSON.", "file");
+    QCommandLineOption replayExitOption("replay-exit",
+        "Quit when the replay has finished.");
+    QCommandLineOption robotAddressOption("robot-address",
+        "Talk to the robot at this address instead of 10.TE.AM.2 (e.g. 127.0.0.1 for yads-robot-sim).", "address");
+    QCommandLineOption fmsAddressOption("fms-address",
+        "Listen for an FMS and send its heartbeats to this address instead of 10.TE.AM.5 (e.g. 127.0.0.1 for yads-fms-sim).", "address");
+    QCommandLineOption logLevelOption("log-level",
+        "Log levels: a global level and/or category=level pairs, e.g. \"info,robot.communication=debug\".", "spec");
+    QCommandLineOption sharedStateOption("shared-state",
+        "Publish live state for external tools at this path instead of the default (see sdk/yads_shm.h).", "file");
+    QCommandLineOption controlSocketOption("control-socket",
+        "Local socket name or path for the control API (see sdk/yads_control.h).", "name",
+        QString::fromLatin1(YADS_CONTROL_SOCKET_NAME));
+    QCommandLineOption traceOption("trace",
+        "Record hot-path trace spans and write them as Chrome trace JSON on exit (needs ENABLE_TRACING).", "file");
+    parser.addOption(robotAddressOption);
+    parser.addOption(fmsAddressOption);
+    parser.addOption(traceOption);
+    parser.addOption(sharedStateOption);
+    parser.addOption(controlSocketOption);
+    parser.addOption(logLevelOption);
+    parser.addOption(replayOption);
+    parser.addOption(replaySpeedOption);
+    parser.addOption(replayReportOption);
+    parser.addOption(replayExitOption);
+    parser.process(app);
+    
+    // Attached before the logger starts so the event log has the startup messages too
+    FRCDriverStation::EventLogModel eventLog;
+    eventLog.attach(&Logger::instance());
+    
     // Initialize logging system
     Logger::instance().initialize();
+    Logger::instance().startFlightRecorder();
+    if (parser.isSet(logLevelOption)) {
+        QString logLevelError;
+        if (!Logger::instance().applyLogLevelSpec(parser.value(logLevelOption), &logLevelError)) {
+            qCCritical(main) << "Invalid --log-level:" << logLevelError;
+            return 1;
+        }
+    }
     qCInfo(main) << "Starting" << Constants::APPLICATION_NAME << "version" << Constants::APPLICATION_VERSION;
     
+    if (parser.isSet(traceOption)) {
+        if (FRCDriverStation::TRACING_COMPILED_IN) {
+            FRCDriverStation::Tracing::setEnabled(true);
+            qCInfo(main) << "Tracing enabled, writing" << parser.value(traceOption) << "on exit";
+        } else {
+            qCWarning(main) << "--trace ignored: built without ENABLE_TRACING";
+        }
+    }
+    
+    // Watch the GUI thread from the start so slow startup work shows up too
+    FRCDriverStation::EventLoopMonitor eventLoopMonitor;
+    eventLoopMonitor.start();
+    
     // Create application manager
     ApplicationManager appManager;
     
+    // RobotState owns the robot link and the managers; everything below reaches them through it
+    RobotState *robotState = appManager.robotState();
+    
     // Create QML engine
     QQmlApplicationEngine engine;
     
     // Register QML types
     qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "ApplicationManager", &appManager);
-    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "RobotState", appManager.robotState());
-    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "NetworkManager", appManager.networkManager());
-    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "BatteryManager", appManager.batteryManager());
-    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "ControllerManager", appManager.controllerManager());
-    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "PracticeMatchManager", appManager.practiceMatchManager());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "RobotState", robotState);
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "NetworkManager", robotState->networkManager());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "BatteryManager", robotState->batteryManager());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "ControllerManager", robotState->controllerHandler());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "PracticeMatchManager", robotState->practiceMatchManager());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "EventLoopMonitor", &eventLoopMonitor);
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "Logger", &Logger::instance());
+    qmlRegisterSingletonInstance("YetAnotherDriverStation", 1, 0, "EventLog", &eventLog);
+    qmlRegisterType<FRCDriverStation::EventLogFilterModel>("YetAnotherDriverStation", 1, 0, "EventLogFilterModel");
+    qmlRegisterType<FRCDriverStation::SeriesFeeder>("YetAnotherDriverStation", 1, 0, "SeriesFeeder");
+    
+    // Flight recorder snapshots: packet summaries and e-stop/connection loss come from comms
+    robotState->communicationHandler()->setFlightRecorder(Logger::instance().flightRecorder());
+    QObject::connect(robotState->batteryManager(), &FRCDriverStation::BatteryManager::voltageAlert,
+                     Logger::instance().flightRecorder(),
+                     [](FRCDriverStation::BatteryManager::BatteryLevel level, double voltage) {
+        if (level == FRCDriverStation::BatteryManager::Critical) {
+            Logger::instance().flightRecorder()->trigger(QString("brownout-%1V").arg(voltage, 0, 'f', 1));
+        }
+    });
+    
+    // Live state for dashboards, pit displays and scripts
+    FRCDriverStation::SharedState sharedState;
+    if (sharedState.start(parser.value(sharedStateOption))) {
+        qCInfo(main) << "Publishing shared state at" << sharedState.path();
+    } else {
+        qCWarning(main) << "Cannot publish shared state at" << sharedState.path() << ":" << sharedState.errorString();
+    }
+    robotState->communicationHandler()->setSharedState(&sharedState);
+    
+    FRCDriverStation::PracticeMatchManager *practiceMatch = robotState->practiceMatchManager();
+    robotState->communicationHandler()->setMatchClock(practiceMatch->matchClock());
+    auto publishPracticeMatch = [&sharedState, practiceMatch]() {
+        sharedState.setMatch(quint8(practiceMatch->currentPhase()),
+                             practiceMatch->running() ? YADS_SHM_MATCH_PRACTICE : YADS_SHM_MATCH_NONE,
+                             float(practiceMatch->phaseTimeRemaining()));
+    };
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::runningChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::currentPhaseChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::timeRemainingChanged, &sharedState, publishPracticeMatch);
+    QObject::connect(practiceMatch, &FRCDriverStation::PracticeMatchManager::phaseScheduleChanged, &sharedState, publishPracticeMatch);
+    
+#ifdef ENABLE_FMS_SUPPORT
+    FMSHandler *fms = robotState->fmsHandler();
+    auto publishFms = [&sharedState, fms]() {
+        sharedState.setFms(fms->isConnected(), fms->isEnabled(), fms->isEmergencyStop(),
+                           quint8(fms->allianceColor()), quint16(fms->matchNumber()));
+    };
+    QObject::connect(fms, &FMSHandler::stateChanged, &sharedState, publishFms);
+    publishFms();
+#endif
+    
+    // Commands and event streams for scripts and pit-side bridges
+    FRCDriverStation::ControlServer controlServer(robotState);
+    controlServer.setControllerHandler(robotState->controllerHandler());
+    if (controlServer.listen(parser.value(controlSocketOption))) {
+        qCInfo(main) << "Control API on" << controlServer.serverPath();
+    } else {
+        qCWarning(main) << "Cannot listen on" << parser.value(controlSocketOption) << ":" << controlServer.errorString();
+    }
     
     // Set up global shortcuts
 #ifdef ENABLE_GLOBAL_SHORTCUTS
@@ -87,8 +228,93 @@ int main(int argc, char *argv[])
     
     qCInfo(main) << "Application started successfully";
     
+    if (parser.isSet(robotAddressOption)) {
+        const QHostAddress robotAddress(parser.value(robotAddressOption));
+        if (robotAddress.isNull()) {
+            qCCritical(main) << "Invalid --robot-address" << parser.value(robotAddressOption);
+            return 1;
+        }
+        robotState->communicationHandler()->setRobotAddressOverride(robotAddress);
+    }
+    
+    if (parser.isSet(fmsAddressOption)) {
+#ifdef ENABLE_FMS_SUPPORT
+        const QHostAddress fmsAddress(parser.value(fmsAddressOption));
+        if (fmsAddress.isNull()) {
+            qCCritical(main) << "Invalid --fms-address" << parser.value(fmsAddressOption);
+            return 1;
+        }
+        FMSHandler *fmsHandler = robotState->fmsHandler();
+        fmsHandler->setFmsAddressOverride(fmsAddress);
+        fmsHandler->setTeamNumber(robotState->teamNumber());
+        QObject::connect(robotState, &RobotState::teamNumberChanged, fmsHandler, &FMSHandler::setTeamNumber);
+        fmsHandler->connectToFMS();
+#else
+        qCWarning(main) << "--fms-address ignored: built without ENABLE_FMS_SUPPORT";
+#endif
+    }
+    
+    // Session replay, started once the UI is up so bindings see every update
+    if (parser.isSet(replayOption)) {
+        const QString speed = parser.value(replaySpeedOption);
+        if (speed != "realtime" && speed != "fast") {
+            qCCritical(main) << "Unknown --replay-speed" << speed << "(expected realtime or fast)";
+            return 1;
+        }
+        
+        FRCDriverStation::ReplayEngine *replay =
+            new FRCDriverStation::ReplayEngine(robotState->communicationHandler(), &app);
+        const QString reportPath = parser.value(replayReportOption);
+        const bool exitWhenDone = parser.isSet(replayExitOption);
+        
+        QObject::connect(replay, &FRCDriverStation::ReplayEngine::finished, &app, [replay, reportPath, exitWhenDone]() {
+            const QString report = replay->reportText();
+            for (const QString &line : report.split('\n', Qt::SkipEmptyParts)) {
+                qCInfo(main).noquote() << line;
+            }
+            
+            bool reportWritten = true;
+            if (!reportPath.isEmpty()) {
+                reportWritten = replay->writeReport(reportPath);
+                if (!reportWritten) {
+                    qCWarning(main) << "Could not write replay report to" << reportPath;
+                }
+            }
+            
+            if (exitWhenDone) {
+                QCoreApplication::exit(reportWritten && replay->decodeFailures() == 0 ? 0 : 2);
+            }
+        });
+        
+        const FRCDriverStation::ReplayEngine::Mode mode = speed == "fast"
+            ? FRCDriverStation::ReplayEngine::AsFastAsPossible
+            : FRCDriverStation::ReplayEngine::RealTime;
+        if (!replay->start(parser.value(replayOption), mode)) {
+            qCCritical(main) << "Cannot replay" << parser.value(replayOption) << ":" << replay->errorString();
+            return 1;
+        }
+        qCInfo(main) << "Replaying" << parser.value(replayOption) << "(" << speed << ")";
+    }
+    
     int result = app.exec();
     
     qCInfo(main) << "Application shutting down with exit code:" << result;
+    // Marks the ring as cleanly closed so the next start does not treat it as a crash
+    Logger::instance().stopFlightRecorder();
+    controlServer.close();
+    robotState->communicationHandler()->setSharedState(nullptr);
+    sharedState.stop();
+    
+    if (FRCDriverStation::Tracing::isEnabled()) {
+        QString traceError;
+        if (FRCDriverStation::Tracing::writeChromeTrace(parser.value(traceOption), &traceError)) {
+            qCInfo(main) << "Trace written to" << parser.value(traceOption);
+        } else {
+            qCWarning(main) << "Could not write trace to" << parser.value(traceOption) << ":" << traceError;
+        }
+    }
+    
+    // Lets a compression in progress finish; the current log is compressed next start
+    Logger::instance().shutdown();
     return result;
 }
@@ -1,6 +1,7 @@
 import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
+import YetAnotherDriverStation 1.0
 
 Item {
     ScrollView {
@@ -94,6 +95,82 @@ Item {
                 }
             }
             
+            // Event loop diagnostics
+            GroupBox {
+                title: "Event Loop"
+                Layout.fillWidth: true
+                
+                ColumnLayout {
+                    anchors.fill: parent
+                    
+                    GridLayout {
+                        Layout.fillWidth: true
+                        columns: 2
+                        
+                        Label { text: "Dispatch Latency:" }
+                        Label { 
+                            text: `p50 ${EventLoopMonitor.p50LatencyMs.toFixed(1)} ms, p99 ${EventLoopMonitor.p99LatencyMs.toFixed(1)} ms, max ${EventLoopMonitor.maxLatencyMs.toFixed(1)} ms`
+                            color: EventLoopMonitor.p99LatencyMs > 20 ? "orange" : "green"
+                        }
+                        
+                        Label { text: "Stalls:" }
+                        Label { 
+                            text: EventLoopMonitor.stallCount > 0
+                                  ? `${EventLoopMonitor.stallCount} (last ${EventLoopMonitor.lastStallMs.toFixed(0)} ms)`
+                                  : "None"
+                            color: EventLoopMonitor.stallCount > 0 ? "red" : "green"
+                        }
+                        
+                        Label { text: "Stall Threshold:" }
+                        SpinBox {
+                            from: 40
+                            to: 5000
+                            stepSize: 50
+                            value: EventLoopMonitor.stallThresholdMs
+                            onValueModified: EventLoopMonitor.stallThresholdMs = value
+                            textFromValue: function(value) { return value + " ms" }
+                        }
+                    }
+                    
+                    // Latency histogram, one bar per non-empty power-of-two bucket
+                    Repeater {
+                        id: latencyBuckets
+                        property int maxCount: {
+                            let largest = 1
+                            for (let i = 0; i < model.length; ++i) {
+                                largest = Math.max(largest, model[i].count)
+                            }
+                            return largest
+                        }
+                        model: {
+                            EventLoopMonitor.p99LatencyMs // Re-read on every statistics update
+                            return EventLoopMonitor.latencyBuckets()
+                        }
+                        
+                        RowLayout {
+                            Layout.fillWidth: true
+                            
+                            Label {
+                                text: modelData.label
+                                Layout.preferredWidth: 90
+                                horizontalAlignment: Text.AlignRight
+                            }
+                            Rectangle {
+                                Layout.preferredHeight: 12
+                                Layout.preferredWidth: Math.max(2, 300 * modelData.count / latencyBuckets.maxCount)
+                                color: "#2196F3"
+                            }
+                            Label { text: modelData.count }
+                        }
+                    }
+                    
+                    Button {
+                        text: "Reset"
+                        onClicked: EventLoopMonitor.resetStatistics()
+                    }
+                }
+            }
+            
             // Battery diagnostics
             GroupBox {
                 title: "Battery Diagnostics"
@@ -3,73 +3,42 @@ import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtQuick.Dialogs 1.3
 import FRC.Backend 1.0
+import YetAnotherDriverStation 1.0 as YADS
 
 Frame {
+    id: root
     background: Rectangle { color: "transparent" }
 
-    property var logEntries: []
     property string filterText: ""
     property string selectedCategory: "All"
     property bool robotConnected: robotState.commsStatus.toLowerCase().includes("connected")
 
-    // Connect to logging signals
-    Connections {
-        target: robotState
-        
-        function onEventLogged(event, details, timestamp) {
-            var entry = {
-                timestamp: timestamp,
-                time: new Date(timestamp).toLocaleTimeString(),
-                event: event,
-                details: details,
-                category: getCategoryFromEvent(event)
-            }
-            
-            logEntries.unshift(entry) // Add to beginning
-            
-            // Limit entries to prevent memory issues
-            if (logEntries.length > 1000) {
-                logEntries = logEntries.slice(0, 1000)
-            }
-            
-            logListModel.clear()
-            updateFilteredEntries()
+    readonly property var levelNames: ["Debug", "Info", "Warning", "Critical", "Fatal"]
+
+    function levelColor(level) {
+        switch (level) {
+            case 0: return "#666666"
+            case 1: return "#2196f3"
+            case 2: return "#ff9800"
+            case 3: return "#f44336"
+            default: return "#b71c1c"
         }
     }
 
-    // Functions from EventLogView
-    function getCategoryFromEvent(event) {
-        if (event.includes("Emergency")) return "Emergency"
-        if (event.includes("Robot") || event.includes("Control")) return "Robot"
-        if (event.includes("Battery")) return "Battery"
-        if (event.includes("Network") || event.includes("Communication")) return "Network"
-        if (event.includes("Practice")) return "Practice"
-        if (event.includes("Dashboard")) return "Dashboard"
-        if (event.includes("Configuration")) return "Config"
-        if (event.includes("FMS")) return "FMS"
-        return "System"
+    // Incremental C++ filter over YADS.EventLog; newest entries first
+    YADS.EventLogFilterModel {
+        id: filteredLog
+        sourceModel: YADS.EventLog
+        filterText: root.filterText
+        category: selectedCategory === "All" ? "" : selectedCategory
+        minimumLevel: levelComboBox.currentIndex
     }
 
-    function updateFilteredEntries() {
-        logListModel.clear()
-
-        for (var i = 0; i < logEntries.length; i++) {
-            var entry = logEntries[i]
-
-            // Apply category filter
-            if (selectedCategory !== "All" && entry.category !== selectedCategory) {
-                continue
-            }
-
-            // Apply text filter
-            if (filterText !== "" &&
-                !entry.event.toLowerCase().includes(filterText.toLowerCase()) &&
-                !entry.details.toLowerCase().includes(filterText.toLowerCase())) {
-                continue
-            }
-
-            logListModel.append(entry)
-        }
+    // Typing only refilters once the user pauses
+    Timer {
+        id: filterDebounce
+        interval: 150
+        onTriggered: filterText = filterTextField.text
     }
 
     function exportLog() {
@@ -77,9 +46,7 @@ Frame {
     }
 
     function clearLog() {
-        logEntries = []
-        logListModel.clear()
-        robotState.clearEventLog()
+        YADS.EventLog.clear()
     }
 
     ColumnLayout {
@@ -94,7 +61,7 @@ Frame {
             Layout.fillWidth: true
 
             TabButton { text: "Event Log" }
-            TabButton { text: "Console Output" }
+            TabButton { text: "Log Files" }
         }
 
         StackLayout {
@@ -117,15 +84,34 @@ Frame {
 
                     Item { Layout.fillWidth: true }
 
-                    // Category Filter
+                    // Minimum level
                     ComboBox {
-                        id: categoryComboBox
-                        model: ["All", "Emergency", "Robot", "Battery", "Network", "Practice", "Dashboard", "Config", "FMS", "System"]
-                        currentText: selectedCategory
-                        onCurrentTextChanged: {
-                            selectedCategory = currentText
-                            updateFilteredEntries()
+                        id: levelComboBox
+                        model: levelNames
+                        currentIndex: 1
+
+                        background: Rectangle {
+                            color: "#404040"
+                            border.color: "#666666"
+                            radius: 4
+                        }
+
+                        contentItem: Text {
+                            text: levelComboBox.displayText
+                            font: levelComboBox.font
+                            color: "white"
+                            verticalAlignment: Text.AlignVCenter
+                            leftPadding: 10
                         }
+                    }
+
+                    // Category Filter; categories are the logger's, as they are seen
+                    ComboBox {
+                        id: categoryComboBox
+                        model: ["All"].concat(YADS.EventLog.categories)
+                        onActivated: selectedCategory = currentText
+                        // New categories rebuild the list; keep the selection
+                        onModelChanged: currentIndex = Math.max(0, find(selectedCategory))
 
                         background: Rectangle {
                             color: "#404040"
@@ -146,11 +132,7 @@ Frame {
                     TextField {
                         id: filterTextField
                         placeholderText: "Filter events..."
-                        text: filterText
-                        onTextChanged: {
-                            filterText = text
-                            updateFilteredEntries()
-                        }
+                        onTextChanged: filterDebounce.restart()
 
                         background: Rectangle {
                             color: "#404040"
@@ -219,7 +201,7 @@ Frame {
                                 font.pixelSize: 11
                             }
                             Label {
-                                text: logEntries.length.toString()
+                                text: YADS.EventLog.count.toString()
                                 color: "white"
                                 font.pixelSize: 16
                                 font.bold: true
@@ -234,7 +216,7 @@ Frame {
                                 font.pixelSize: 11
                             }
                             Label {
-                                text: logListModel.count.toString()
+                                text: filteredLog.count.toString()
                                 color: "white"
                                 font.pixelSize: 16
                                 font.bold: true
@@ -286,7 +268,7 @@ Frame {
                         id: logListView
                         anchors.fill: parent
                         anchors.margins: 5
-                        model: ListModel { id: logListModel }
+                        model: filteredLog
                         clip: true
 
                         ScrollBar.vertical: ScrollBar {
@@ -308,19 +290,7 @@ Frame {
                             width: logListView.width - 10
                             height: 60
                             color: index % 2 === 0 ? "#2d2d2d" : "#252525"
-                            border.color: {
-                                switch(model.category) {
-                                    case "Emergency": return "#f44336"
-                                    case "Robot": return "#2196f3"
-                                    case "Battery": return "#ff9800"
-                                    case "Network": return "#9c27b0"
-                                    case "Practice": return "#4caf50"
-                                    case "Dashboard": return "#00bcd4"
-                                    case "Config": return "#795548"
-                                    case "FMS": return "#ff5722"
-                                    default: return "#666666"
-                                }
-                            }
+                            border.color: levelColor(model.level)
                             border.width: 1
                             radius: 4
 
@@ -329,7 +299,7 @@ Frame {
                                 anchors.margins: 10
                                 spacing: 15
 
-                                // Category Indicator
+                                // Level Indicator
                                 Rectangle {
                                     width: 8
                                     height: 40
@@ -350,7 +320,7 @@ Frame {
                                     }
 
                                     Label {
-                                        text: model.category
+                                        text: model.levelName
                                         color: parent.parent.parent.border.color
                                         font.pixelSize: 10
                                     }
@@ -362,7 +332,7 @@ Frame {
                                     spacing: 2
 
                                     Label {
-                                        text: model.event
+                                        text: model.category
                                         color: "white"
                                         font.pixelSize: 13
                                         font.bold: true
@@ -371,7 +341,7 @@ Frame {
                                     }
 
                                     Label {
-                                        text: model.details
+                                        text: model.message
                                         color: "lightgray"
                                         font.pixelSize: 11
                                         Layout.fillWidth: true
@@ -386,7 +356,7 @@ Frame {
                                 anchors.fill: parent
                                 onClicked: {
                                     // Could show detailed view or copy to clipboard
-                                    console.log("Event clicked:", model.event, model.details)
+                                    console.log("Event clicked:", model.category, model.message)
                                 }
                             }
                         }
@@ -394,25 +364,87 @@ Frame {
                         // Empty state
                         Label {
                             anchors.centerIn: parent
-                            text: logEntries.length === 0 ? "No events logged yet" : "No events match current filter"
+                            text: YADS.EventLog.count === 0 ? "No events logged yet" : "No events match current filter"
                             color: "gray"
                             font.pixelSize: 14
-                            visible: logListModel.count === 0
+                            visible: filteredLog.count === 0
                         }
                     }
                 }
             }
 
-            // Console Output View
-            Item {
-                // Placeholder for Console Output View
+            // Log Files View: current and rotated logs, .log.gz decompressed on read
+            ColumnLayout {
+                id: logFilesView
+
+                // Tail only; archives are streamed so this bounds memory, not file size
+                property int maxLines: 2000
+
+                function refreshFiles() {
+                    var selected = logFileComboBox.currentText
+                    logFileComboBox.model = YADS.Logger.getLogFiles()
+                    var index = logFileComboBox.find(selected)
+                    logFileComboBox.currentIndex = index >= 0 ? index : 0
+                    loadSelectedFile()
+                }
+
+                function loadSelectedFile() {
+                    logFileText.text = logFileComboBox.currentText === ""
+                        ? "No log files yet"
+                        : YADS.Logger.getLogContent(logFileComboBox.currentText, maxLines)
+                }
+
+                RowLayout {
+                    Layout.fillWidth: true
+
+                    Label {
+                        text: "Log Files"
+                        font.pixelSize: 18
+                        font.bold: true
+                        color: "white"
+                    }
+
+                    Item { Layout.fillWidth: true }
+
+                    ComboBox {
+                        id: logFileComboBox
+                        Layout.preferredWidth: 300
+                        onActivated: logFilesView.loadSelectedFile()
+                    }
+
+                    Button {
+                        text: "Refresh"
+                        onClicked: logFilesView.refreshFiles()
+                    }
+                }
+
                 Label {
-                    anchors.centerIn: parent
-                    text: "Console Output View\n(Implementation placeholder)"
-                    horizontalAlignment: Text.AlignHCenter
-                    font.pixelSize: 18
-                    color: "#888888"
+                    text: "Showing the last " + logFilesView.maxLines + " lines. Rotated logs are compressed; older ones are removed to stay within the disk budget. Folder: " + YADS.Logger.getLogDirectory()
+                    color: "gray"
+                    font.pixelSize: 11
+                    Layout.fillWidth: true
+                    wrapMode: Text.Wrap
+                }
+
+                ScrollView {
+                    Layout.fillWidth: true
+                    Layout.fillHeight: true
+
+                    TextArea {
+                        id: logFileText
+                        readOnly: true
+                        wrapMode: TextEdit.NoWrap
+                        font.family: "monospace"
+                        font.pixelSize: 11
+                        color: "lightgray"
+                        background: Rectangle {
+                            color: "#1e1e1e"
+                            radius: 4
+                        }
+                    }
                 }
+
+                onVisibleChanged: if (visible) refreshFiles()
             }
         }
     }
@@ -427,26 +459,7 @@ Frame {
 
         onAccepted: {
             var filePath = fileDialog.fileUrl.toString().replace("file://", "")
-            robotState.exportEventLog(filePath)
-        }
-    }
-
-    // Initialize with recent log entries
-    Component.onCompleted: {
-        var recentEntries = robotState.getRecentLogEntries(100)
-        for (var i = 0; i < recentEntries.length; i++) {
-            var parts = recentEntries[i].match(/\[([^\]]+)\] ([^:]+): (.+)/)
-            if (parts && parts.length >= 4) {
-                var entry = {
-                    timestamp: Date.now() - (recentEntries.length - i) * 1000,
-                    time: parts[1],
-                    event: parts[2],
-                    details: parts[3],
-                    category: getCategoryFromEvent(parts[2])
-                }
-                logEntries.push(entry)
-            }
+            YADS.EventLog.exportToFile(filePath)
         }
-        updateFilteredEntries()
     }
 }
@@ -2,83 +2,61 @@ import QtQuick 2.15
 import QtQuick.Controls 2.15
 import QtQuick.Layouts 1.15
 import QtCharts 2.15
+import YetAnotherDriverStation 1.0 as YADS
 
 Frame {
     background: Rectangle { color: "transparent" }
     
     property bool robotConnected: robotState.commsStatus.toLowerCase().includes("connected")
     property bool isPaused: false
-    property int maxDataPoints: 300
     property real timeRange: 60000 // 60 seconds
     
-    // Data storage for network charts
-    property var latencyData: []
-    property var packetLossData: []
-    property var bandwidthData: []
+    // One ring buffer per chart; each pushes to its series once per frame
+    YADS.SeriesFeeder {
+        id: latencyFeeder
+        series: latencySeries
+        timeRangeMs: timeRange
+    }
+    
+    YADS.SeriesFeeder {
+        id: packetLossFeeder
+        series: packetLossSeries
+        timeRangeMs: timeRange
+    }
+    
+    YADS.SeriesFeeder {
+        id: bandwidthFeeder
+        series: bandwidthSeries
+        timeRangeMs: timeRange
+    }
     
     // Connect to network diagnostic signals
     Connections {
         target: robotState
         
-        function onNetworkLatencyChanged(latency, timestamp) {
+        function onNetworkLatencyChanged(latency) {
             if (!isPaused && robotConnected) {
-                addDataPoint(latencyData, latencySeries, timestamp, latency)
-                updateChart(latencyChart, latencyData)
+                latencyFeeder.append(latency)
             }
         }
         
-        function onPacketLossChanged(loss, timestamp) {
+        function onPacketLossChanged(loss) {
             if (!isPaused && robotConnected) {
-                addDataPoint(packetLossData, packetLossSeries, timestamp, loss)
-                updateChart(packetLossChart, packetLossData)
+                packetLossFeeder.append(loss)
             }
         }
         
-        function onBandwidthChanged(bandwidth, timestamp) {
+        function onBandwidthChanged(bandwidth) {
             if (!isPaused && robotConnected) {
-                addDataPoint(bandwidthData, bandwidthSeries, timestamp, bandwidth)
-                updateChart(bandwidthChart, bandwidthData)
+                bandwidthFeeder.append(bandwidth)
             }
         }
     }
     
-    function addDataPoint(dataArray, series, timestamp, value) {
-        dataArray.push({x: timestamp, y: value})
-        
-        const cutoffTime = timestamp - timeRange
-        while (dataArray.length > 0 && dataArray[0].x < cutoffTime) {
-            dataArray.shift()
-        }
-        
-        if (dataArray.length > maxDataPoints) {
-            dataArray.shift()
-        }
-        
-        series.clear()
-        for (let i = 0; i < dataArray.length; i++) {
-            series.append(dataArray[i].x, dataArray[i].y)
-        }
-    }
-    
-    function updateChart(chart, dataArray) {
-        if (dataArray.length === 0) return
-        
-        const now = Date.now()
-        const minTime = now - timeRange
-        const maxTime = now
-        
-        chart.axisX().min = minTime
-        chart.axisX().max = maxTime
-    }
-    
     function clearAllData() {
-        latencyData = []
-        packetLossData = []
-        bandwidthData = []
-        
-        latencySeries.clear()
-        packetLossSeries.clear()
-        bandwidthSeries.clear()
+        latencyFeeder.clear()
+        packetLossFeeder.clear()
+        bandwidthFeeder.clear()
     }
 
     ColumnLayout {
@@ -222,6 +200,100 @@ Frame {
             }
         }
         
+        // Traffic by Stream
+        GroupBox {
+            title: "Traffic by Stream"
+            Layout.fillWidth: true
+            
+            ColumnLayout {
+                anchors.fill: parent
+                
+                Repeater {
+                    model: robotState.streamRates
+                    
+                    RowLayout {
+                        Layout.fillWidth: true
+                        spacing: 20
+                        
+                        Label {
+                            text: modelData.name
+                            font.bold: true
+                            color: "white"
+                            Layout.preferredWidth: 110
+                        }
+                        Label {
+                            text: "Sent " + (modelData.sentBytesPerSecond / 1024).toFixed(1) + " KB/s"
+                            color: "lightgray"
+                            Layout.preferredWidth: 130
+                        }
+                        Label {
+                            text: "Received " + (modelData.receivedBytesPerSecond / 1024).toFixed(1) + " KB/s"
+                            color: "lightgray"
+                            Layout.preferredWidth: 150
+                        }
+                        Label {
+                            text: modelData.limitBytesPerSecond > 0
+                                  ? "Limit " + (modelData.limitBytesPerSecond / 1024).toFixed(0) + " KB/s"
+                                  : "Unlimited"
+                            color: modelData.limitBytesPerSecond > 0 ? "orange" : "gray"
+                        }
+                    }
+                }
+            }
+        }
+        
+        // Loss Bursts
+        GroupBox {
+            title: "Status Packet Loss Bursts (packets)"
+            Layout.fillWidth: true
+            
+            ColumnLayout {
+                anchors.fill: parent
+                
+                Label {
+                    visible: lossBursts.count === 0
+                    text: "No loss bursts"
+                    color: "gray"
+                }
+                
+                Repeater {
+                    id: lossBursts
+                    
+                    property int maxCount: {
+                        let largest = 1
+                        for (let i = 0; i < model.length; ++i) {
+                            largest = Math.max(largest, model[i].count)
+                        }
+                        return largest
+                    }
+                    model: {
+                        robotState.packetLoss // Re-read on every network statistics update
+                        return robotState.lossBurstBuckets()
+                    }
+                    
+                    RowLayout {
+                        Layout.fillWidth: true
+                        
+                        Label {
+                            text: modelData.label
+                            Layout.preferredWidth: 90
+                            horizontalAlignment: Text.AlignRight
+                            color: "white"
+                        }
+                        Rectangle {
+                            Layout.preferredHeight: 12
+                            Layout.preferredWidth: Math.max(2, 300 * modelData.count / lossBursts.maxCount)
+                            color: "#ff5722"
+                        }
+                        Label {
+                            text: modelData.count
+                            color: "lightgray"
+                        }
+                    }
+                }
+            }
+        }
+        
         // Network Charts
         ScrollView {
             Layout.fillWidth: true
@@ -245,6 +317,8 @@ Frame {
                     DateTimeAxis {
                         id: latencyTimeAxis
                         format: "hh:mm:ss"
+                        min: latencyFeeder.windowStart
+                        max: latencyFeeder.windowEnd
                         color: "white"
                         labelsColor: "white"
                     }
@@ -252,13 +326,14 @@ Frame {
                     ValueAxis {
                         id: latencyValueAxis
                         min: 0
-                        max: 100
+                        max: Math.max(100, Math.ceil(latencyFeeder.maximum * 1.2))
                         color: "white"
                         labelsColor: "white"
                     }
                     
                     LineSeries {
                         id: latencySeries
+                        useOpenGL: true
                         axisX: latencyTimeAxis
                         axisY: latencyValueAxis
                         color: "#2196f3"
@@ -280,6 +355,8 @@ Frame {
                     DateTimeAxis {
                         id: packetLossTimeAxis
                         format: "hh:mm:ss"
+                        min: packetLossFeeder.windowStart
+                        max: packetLossFeeder.windowEnd
                         color: "white"
                         labelsColor: "white"
                     }
@@ -287,13 +364,14 @@ Frame {
                     ValueAxis {
                         id: packetLossValueAxis
                         min: 0
-                        max: 20
+                        max: Math.max(20, Math.ceil(packetLossFeeder.maximum * 1.2))
                         color: "white"
                         labelsColor: "white"
                     }
                     
                     LineSeries {
                         id: packetLossSeries
+                        useOpenGL: true
                         axisX: packetLossTimeAxis
                         axisY: packetLossValueAxis
                         color: "#ff5722"
@@ -315,6 +393,8 @@ Frame {
                     DateTimeAxis {
                         id: bandwidthTimeAxis
                         format: "hh:mm:ss"
+                        min: bandwidthFeeder.windowStart
+                        max: bandwidthFeeder.windowEnd
                         color: "white"
                         labelsColor: "white"
                     }
@@ -322,13 +402,14 @@ Frame {
                     ValueAxis {
                         id: bandwidthValueAxis
                         min: 0
-                        max: 50
+                        max: Math.max(50, Math.ceil(bandwidthFeeder.maximum * 1.2))
                         color: "white"
                         labelsColor: "white"
                     }
                     
                     LineSeries {
                         id: bandwidthSeries
+                        useOpenGL: true
                         axisX: bandwidthTimeAxis
                         axisY: bandwidthValueAxis
                         color: "#4caf50"
@@ -58,9 +58,48 @@ Item {
                     Item { Layout.fillWidth: true }
                     
                     Label {
-                        text: `${Math.floor(practiceMatchManager.timeRemaining / 60)}:${(practiceMatchManager.timeRemaining % 60).toString().padStart(2, '0')}`
+                        id: matchTimeLabel
+                        
+                        // Exact at each schedule change, animated down in between; no per-tick signals
+                        property real secondsLeft: 0
+                        
+                        function resync() {
+                            countdown.stop()
+                            secondsLeft = practiceMatchManager.phaseTimeRemaining
+                            if (practiceMatchManager.running && !practiceMatchManager.paused && secondsLeft > 0) {
+                                countdown.from = secondsLeft
+                                countdown.duration = secondsLeft * 1000
+                                countdown.start()
+                            }
+                        }
+                        
+                        text: {
+                            const seconds = Math.ceil(secondsLeft)
+                            return `${Math.floor(seconds / 60)}:${(seconds % 60).toString().padStart(2, '0')}`
+                        }
                         font.pixelSize: 24
                         font.bold: true
+                        
+                        NumberAnimation {
+                            id: countdown
+                            target: matchTimeLabel
+                            property: "secondsLeft"
+                            to: 0
+                        }
+                        
+                        Connections {
+                            target: practiceMatchManager
+                            
+                            function onPhaseScheduleChanged() {
+                                matchTimeLabel.resync()
+                            }
+                            
+                            function onRunningChanged() {
+                                matchTimeLabel.resync()
+                            }
+                        }
+                        
+                        Component.onCompleted: resync()
                     }
                 }
                 
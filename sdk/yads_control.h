@@ -0,0 +1,134 @@
+/*
+ * yads_control.h - YADS local control and subscription protocol
+ *
+ * YADS (and yads-daemon) listen on a local socket: a Unix domain socket on
+ * Linux and macOS, a named pipe on Windows. The default name is
+ * YADS_CONTROL_SOCKET_NAME, which Qt places in the temp directory
+ * (/tmp/yads-control); --control-socket takes a name or an absolute path.
+ * Only the same user can connect. yads-daemon serves only this protocol; its
+ * --control-socket option works the same way.
+ *
+ * Framing: every message in both directions is
+ *
+ *     uint32 length      little-endian, bytes that follow (type + payload),
+ *                        1 .. YADS_CONTROL_MAX_FRAME
+ *     uint8  type        enum yads_control_type
+ *     ...    payload     little-endian integers, IEEE floats, strings as
+ *                        uint16 byte length + UTF-8 bytes (no terminator)
+ *
+ * Requests carry a uint32 request id chosen by the client, echoed in the
+ * RESULT that answers it. Requests are handled in order, on the thread that
+ * owns the robot state, as soon as a frame is complete.
+ *
+ * Events are only sent for the streams a client subscribed to. A client that
+ * does not keep up loses events instead of slowing YADS down: once its
+ * unread backlog passes the server's limit, events are skipped and counted,
+ * and the next event it receives is preceded by YADS_CONTROL_EVENT_DROPPED.
+ * Results are never skipped; a client whose backlog keeps growing anyway is
+ * disconnected.
+ */
+
+#ifndef YADS_CONTROL_H
+#define YADS_CONTROL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YADS_CONTROL_PROTOCOL_VERSION 1
+#define YADS_CONTROL_SOCKET_NAME "yads-control"
+#define YADS_CONTROL_MAX_FRAME 4096
+
+enum yads_control_type {
+    /*
+     * Server -> client, first frame on every connection:
+     * uint16 protocol version, uint32 events the server can send (mask)
+     */
+    YADS_CONTROL_HELLO = 0x00,
+
+    /* Requests, client -> server; every payload starts with uint32 request id */
+    YADS_CONTROL_ENABLE = 0x01,             /* - */
+    YADS_CONTROL_DISABLE = 0x02,            /* - */
+    YADS_CONTROL_ESTOP = 0x03,              /* - */
+    YADS_CONTROL_CLEAR_ESTOP = 0x04,        /* - */
+    YADS_CONTROL_SET_MODE = 0x05,           /* uint8 enum yads_control_mode */
+    YADS_CONTROL_SET_TEAM = 0x06,           /* uint16 team number */
+    YADS_CONTROL_BIND_CONTROLLER = 0x07,    /* uint8 slot, string device id */
+    YADS_CONTROL_UNBIND_CONTROLLER = 0x08,  /* uint8 slot */
+    YADS_CONTROL_SUBSCRIBE = 0x09,          /* uint32 event mask, uint8 minimum log level,
+                                               string log category prefix (may be empty) */
+    YADS_CONTROL_GET_STATE = 0x0A,          /* - ; answered by a RESULT, then one STATE event */
+    YADS_CONTROL_SET_ADDRESS = 0x0B,        /* string robot address; empty goes back to the
+                                               team number address (10.TE.AM.2) */
+    YADS_CONTROL_QUIT = 0x0C,               /* - ; yads-daemon only: the robot is disabled,
+                                               then the daemon exits */
+
+    /*
+     * Server -> client answer to a request:
+     * uint32 request id, uint8 enum yads_control_status, uint32 handling time in
+     * microseconds (frame complete to command applied), string message
+     */
+    YADS_CONTROL_RESULT = 0x80,
+
+    /* Events, server -> client */
+    YADS_CONTROL_EVENT_STATE = 0xC0,        /* see yads_control_state below */
+    YADS_CONTROL_EVENT_LOG = 0xC1,          /* int64 timestamp ms, uint8 level, string category,
+                                               string message */
+    YADS_CONTROL_EVENT_CONTROLLER = 0xC2,   /* uint8 slot, uint8 bound, string device id,
+                                               string name */
+    YADS_CONTROL_EVENT_DROPPED = 0xCF       /* uint32 events skipped since the last one received */
+};
+
+enum yads_control_status {
+    YADS_CONTROL_OK = 0,
+    YADS_CONTROL_REFUSED = 1,       /* valid, but not allowed now (e.g. enable while e-stopped) */
+    YADS_CONTROL_BAD_REQUEST = 2,   /* malformed payload or out-of-range value */
+    YADS_CONTROL_UNSUPPORTED = 3    /* unknown type, or not available in this build */
+};
+
+/*
+ * yads-daemon has no controller handling: BIND_CONTROLLER and
+ * UNBIND_CONTROLLER always return UNSUPPORTED there, and its HELLO leaves
+ * YADS_CONTROL_STREAM_CONTROLLERS out of the event mask. The GUI answers
+ * QUIT with UNSUPPORTED.
+ */
+
+enum yads_control_mode {
+    YADS_CONTROL_MODE_AUTONOMOUS = 1,
+    YADS_CONTROL_MODE_TELEOP = 2,
+    YADS_CONTROL_MODE_TEST = 3
+};
+
+/* Event mask bits for SUBSCRIBE and HELLO */
+#define YADS_CONTROL_STREAM_STATE (1u << 0)
+#define YADS_CONTROL_STREAM_LOG (1u << 1)
+#define YADS_CONTROL_STREAM_CONTROLLERS (1u << 2)
+
+/* EVENT_STATE flags */
+#define YADS_CONTROL_FLAG_CONNECTED (1u << 0)
+#define YADS_CONTROL_FLAG_ENABLED (1u << 1)
+#define YADS_CONTROL_FLAG_ESTOP (1u << 2)
+#define YADS_CONTROL_FLAG_FMS (1u << 3)
+
+/*
+ * EVENT_STATE payload, packed, little-endian; sent on every enable, e-stop,
+ * connection, mode or team change immediately, and for telemetry at most
+ * once per UI tick (about 30 Hz):
+ *
+ *     int64  timestamp ms since the Unix epoch
+ *     uint8  flags (YADS_CONTROL_FLAG_*)
+ *     uint8  mode (0 disabled, else enum yads_control_mode)
+ *     uint16 team number
+ *     float  battery voltage
+ *     float  latency ms
+ *     float  packet loss percent
+ */
+#define YADS_CONTROL_STATE_PAYLOAD_SIZE 24
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YADS_CONTROL_H */
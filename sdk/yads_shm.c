@@ -0,0 +1,217 @@
+/*
+ * yads_shm.c - client side of the YADS shared-memory state segment
+ */
+
+/* O_CLOEXEC, nanosleep and friends are POSIX, hidden by strict C99 (C_STANDARD 99) */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "yads_shm.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define YADS_SHM_READ_ATTEMPTS 1000
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+static uint32_t load_sequence(const volatile uint32_t *sequence)
+{
+    /* x86/x64: aligned loads are atomic, volatile is not reordered by MSVC */
+    uint32_t value = *sequence;
+    _ReadBarrier();
+    return value;
+}
+static void read_fence(void)
+{
+    _ReadBarrier();
+}
+static void cpu_relax(void)
+{
+    YieldProcessor();
+}
+#else
+static uint32_t load_sequence(const volatile uint32_t *sequence)
+{
+    return __atomic_load_n(sequence, __ATOMIC_ACQUIRE);
+}
+static void read_fence(void)
+{
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+static void cpu_relax(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+#endif
+
+int yads_shm_default_path(char *buffer, size_t size)
+{
+    int written;
+#ifdef _WIN32
+    char directory[MAX_PATH + 1];
+    DWORD length = GetTempPathA(sizeof(directory), directory);
+    if (length == 0 || length > MAX_PATH) {
+        return YADS_SHM_ERROR;
+    }
+    written = snprintf(buffer, size, "%s%s", directory, YADS_SHM_FILE_NAME);
+#else
+    /* Must match SharedState::defaultPath() in YADS */
+    const char *directory = "/dev/shm";
+    struct stat info;
+    if (stat(directory, &info) != 0 || !S_ISDIR(info.st_mode)) {
+        directory = getenv("TMPDIR");
+        if (!directory || !*directory) {
+            directory = "/tmp";
+        }
+    }
+    written = snprintf(buffer, size, "%s%s%s", directory,
+                       directory[strlen(directory) - 1] == '/' ? "" : "/", YADS_SHM_FILE_NAME);
+#endif
+    return written > 0 && (size_t)written < size ? YADS_SHM_OK : YADS_SHM_ERROR;
+}
+
+int yads_shm_open(yads_shm_reader *reader, const char *path)
+{
+    char defaultPath[1024];
+    const yads_shm_header *header;
+
+    memset(reader, 0, sizeof(*reader));
+    if (!path) {
+        if (yads_shm_default_path(defaultPath, sizeof(defaultPath)) != YADS_SHM_OK) {
+            return YADS_SHM_ERROR;
+        }
+        path = defaultPath;
+    }
+
+#ifdef _WIN32
+    {
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        HANDLE mapping;
+        LARGE_INTEGER fileSize;
+        if (file == INVALID_HANDLE_VALUE) {
+            return YADS_SHM_NOT_FOUND;
+        }
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < (LONGLONG)sizeof(yads_shm_header)) {
+            CloseHandle(file);
+            return YADS_SHM_BAD_FORMAT;
+        }
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        CloseHandle(file);
+        if (!mapping) {
+            return YADS_SHM_ERROR;
+        }
+        reader->state = (const volatile yads_shm_state *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!reader->state) {
+            CloseHandle(mapping);
+            return YADS_SHM_ERROR;
+        }
+        reader->handle = mapping;
+        reader->mapped_size = (size_t)fileSize.QuadPart;
+    }
+#else
+    {
+        struct stat info;
+        void *base;
+        int fd = open(path, O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return YADS_SHM_NOT_FOUND;
+        }
+        if (fstat(fd, &info) != 0 || info.st_size < (off_t)sizeof(yads_shm_header)) {
+            close(fd);
+            return YADS_SHM_BAD_FORMAT;
+        }
+        base = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (base == MAP_FAILED) {
+            return YADS_SHM_ERROR;
+        }
+        reader->state = (const volatile yads_shm_state *)base;
+        reader->mapped_size = (size_t)info.st_size;
+    }
+#endif
+
+    header = (const yads_shm_header *)&reader->state->header;
+    if (header->magic != YADS_SHM_MAGIC) {
+        yads_shm_close(reader);
+        return YADS_SHM_BAD_FORMAT;
+    }
+    if (header->version_major != YADS_SHM_VERSION_MAJOR) {
+        yads_shm_close(reader);
+        return YADS_SHM_BAD_VERSION;
+    }
+    if (header->size > reader->mapped_size) {
+        yads_shm_close(reader);
+        return YADS_SHM_BAD_FORMAT;
+    }
+    return YADS_SHM_OK;
+}
+
+void yads_shm_close(yads_shm_reader *reader)
+{
+    if (!reader->state) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile((LPCVOID)reader->state);
+    CloseHandle((HANDLE)reader->handle);
+#else
+    munmap((void *)reader->state, reader->mapped_size);
+#endif
+    memset(reader, 0, sizeof(*reader));
+}
+
+int yads_shm_read(const yads_shm_reader *reader, yads_shm_state *out)
+{
+    /* A newer minor version may be larger; an older one leaves our extra fields zero */
+    size_t size;
+    int attempt;
+
+    if (!reader->state) {
+        return YADS_SHM_NOT_FOUND;
+    }
+    size = reader->state->header.size;
+    if (size > sizeof(*out)) {
+        size = sizeof(*out);
+    }
+    memset(out, 0, sizeof(*out));
+
+    for (attempt = 0; attempt < YADS_SHM_READ_ATTEMPTS; ++attempt) {
+        uint32_t before = load_sequence(&reader->state->header.sequence);
+        uint32_t after;
+        if (before & 1u) {
+            cpu_relax();
+            continue;
+        }
+        memcpy(out, (const void *)reader->state, size);
+        read_fence();
+        after = reader->state->header.sequence;
+        if (before == after) {
+            return YADS_SHM_OK;
+        }
+        cpu_relax();
+    }
+    return YADS_SHM_BUSY;
+}
+
+int yads_shm_writer_running(const yads_shm_reader *reader)
+{
+    return reader->state && reader->state->header.writer_pid != 0;
+}
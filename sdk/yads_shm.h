@@ -0,0 +1,173 @@
+/*
+ * yads_shm.h - read YADS driver station state from shared memory
+ *
+ * YADS keeps the latest robot, network, controller, match and FMS state in a
+ * small memory-mapped file and updates it on every robot packet. This header
+ * describes the layout; yads_shm.c maps the file and takes consistent
+ * snapshots without system calls or locks, so a consumer can poll it at any
+ * rate without slowing the driver station down.
+ *
+ * Typical use:
+ *
+ *     yads_shm_reader reader;
+ *     yads_shm_state state;
+ *     if (yads_shm_open(&reader, NULL) == YADS_SHM_OK) {
+ *         if (yads_shm_read(&reader, &state) == YADS_SHM_OK)
+ *             printf("%.2f V\n", state.battery_voltage);
+ *         yads_shm_close(&reader);
+ *     }
+ *
+ * Versioning: the major version changes when existing fields move or change
+ * meaning; readers must reject a different major. Minor versions only append
+ * fields at the end and raise header.size, so an older reader keeps working
+ * and a newer reader checks header.size before using appended fields.
+ *
+ * Consistency: the writer makes header.sequence odd, updates the fields and
+ * makes it even again. yads_shm_read() copies the whole state and retries if
+ * the sequence was odd or changed during the copy (a seqlock).
+ */
+
+#ifndef YADS_SHM_H
+#define YADS_SHM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define YADS_SHM_MAGIC 0x53444159u /* "YADS" in little-endian byte order */
+#define YADS_SHM_VERSION_MAJOR 1
+#define YADS_SHM_VERSION_MINOR 0
+#define YADS_SHM_FILE_NAME "yads-state"
+
+#define YADS_SHM_MAX_CONTROLLERS 6
+#define YADS_SHM_MAX_AXES 12
+#define YADS_SHM_MAX_POVS 4
+#define YADS_SHM_NAME_SIZE 32
+
+/* Robot modes, as sent in the control packet */
+enum yads_shm_mode {
+    YADS_SHM_MODE_TELEOP = 0,
+    YADS_SHM_MODE_TEST = 1,
+    YADS_SHM_MODE_AUTONOMOUS = 2
+};
+
+/* Match phases; also PracticeMatchManager::MatchPhase */
+enum yads_shm_match_phase {
+    YADS_SHM_PHASE_PRE_MATCH = 0,
+    YADS_SHM_PHASE_AUTONOMOUS = 1,
+    YADS_SHM_PHASE_TELEOP = 2,
+    YADS_SHM_PHASE_ENDGAME = 3,
+    YADS_SHM_PHASE_POST_MATCH = 4
+};
+
+/* Who drives the match clock */
+enum yads_shm_match_source {
+    YADS_SHM_MATCH_NONE = 0,
+    YADS_SHM_MATCH_PRACTICE = 1,
+    YADS_SHM_MATCH_FMS = 2
+};
+
+/* FMS alliance colour; also FMSHandler::AllianceColor */
+enum yads_shm_alliance {
+    YADS_SHM_ALLIANCE_RED = 0,
+    YADS_SHM_ALLIANCE_BLUE = 1,
+    YADS_SHM_ALLIANCE_UNKNOWN = 2
+};
+
+typedef struct yads_shm_header {
+    uint32_t magic;             /* YADS_SHM_MAGIC */
+    uint16_t version_major;
+    uint16_t version_minor;
+    uint32_t size;              /* sizeof(yads_shm_state) of the writer */
+    uint32_t sequence;          /* seqlock: odd while an update is in progress */
+    int64_t writer_pid;         /* 0 once the driver station has shut down cleanly */
+    int64_t updated_ms;         /* wall clock of the last update, ms since the Unix epoch */
+} yads_shm_header;
+
+typedef struct yads_shm_controller {
+    uint8_t present;            /* a controller is bound to this slot */
+    uint8_t axis_count;
+    uint8_t button_count;
+    uint8_t pov_count;
+    uint32_t buttons;           /* bit n is button n + 1 */
+    int16_t povs[YADS_SHM_MAX_POVS];       /* degrees, -1 when centred */
+    float axes[YADS_SHM_MAX_AXES];         /* -1.0 .. 1.0 */
+    char name[YADS_SHM_NAME_SIZE];         /* UTF-8, NUL-terminated */
+} yads_shm_controller;
+
+typedef struct yads_shm_state {
+    yads_shm_header header;
+
+    /* Robot link, updated on every status and control packet */
+    uint16_t team_number;
+    uint8_t robot_connected;
+    uint8_t robot_code;         /* robot code running */
+    uint8_t enabled;            /* as last sent to the robot */
+    uint8_t emergency_stop;     /* as last sent to the robot */
+    uint8_t mode;               /* enum yads_shm_mode, as last sent */
+    uint8_t robot_status;       /* status byte as last received from the robot */
+    uint32_t control_packets;   /* control packets sent since start */
+    uint32_t status_packets;    /* status packets received since start */
+    float battery_voltage;
+    float cpu_usage;            /* percent */
+    float can_utilization;      /* percent */
+    uint32_t can_bus_off;
+
+    /* Network, updated on every ping and once per statistics interval */
+    float latency_ms;
+    float packet_loss;          /* percent */
+
+    /* Match */
+    uint8_t match_phase;        /* enum yads_shm_match_phase */
+    uint8_t match_source;       /* enum yads_shm_match_source */
+    uint16_t reserved0;
+    float match_time_remaining; /* seconds */
+
+    /* FMS */
+    uint8_t fms_connected;
+    uint8_t fms_enabled;
+    uint8_t fms_emergency_stop;
+    uint8_t fms_alliance;       /* enum yads_shm_alliance */
+    uint16_t fms_match_number;
+    uint16_t reserved1;
+
+    /* Controllers, by driver station slot */
+    yads_shm_controller controllers[YADS_SHM_MAX_CONTROLLERS];
+} yads_shm_state;
+
+enum yads_shm_result {
+    YADS_SHM_OK = 0,
+    YADS_SHM_NOT_FOUND = -1,    /* no segment: YADS has never run, or another path */
+    YADS_SHM_BAD_FORMAT = -2,   /* not a YADS segment, or too small */
+    YADS_SHM_BAD_VERSION = -3,  /* incompatible major version */
+    YADS_SHM_BUSY = -4,         /* the writer kept updating during every attempt */
+    YADS_SHM_ERROR = -5         /* the file exists but could not be mapped */
+};
+
+typedef struct yads_shm_reader {
+    const volatile yads_shm_state *state;
+    size_t mapped_size;
+    void *handle;               /* platform mapping handle */
+} yads_shm_reader;
+
+/* Writes the default segment path (the one YADS uses) into buffer */
+int yads_shm_default_path(char *buffer, size_t size);
+
+/* Maps the segment read-only; path NULL means yads_shm_default_path() */
+int yads_shm_open(yads_shm_reader *reader, const char *path);
+void yads_shm_close(yads_shm_reader *reader);
+
+/* Copies a consistent snapshot into out */
+int yads_shm_read(const yads_shm_reader *reader, yads_shm_state *out);
+
+/* Non-zero while the writer has not shut down; it may still have crashed */
+int yads_shm_writer_running(const yads_shm_reader *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* YADS_SHM_H */
@@ -0,0 +1,105 @@
+/*
+ * yads-shm-dump - print the YADS shared-memory state, once or continuously
+ *
+ * Usage: yads-shm-dump [-w interval_ms] [path]
+ */
+
+/* O_CLOEXEC, nanosleep and friends are POSIX, hidden by strict C99 (C_STANDARD 99) */
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "yads_shm.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define sleep_ms(ms) Sleep(ms)
+#else
+#include <time.h>
+static void sleep_ms(int ms)
+{
+    struct timespec delay;
+    delay.tv_sec = ms / 1000;
+    delay.tv_nsec = (long)(ms % 1000) * 1000000L;
+    nanosleep(&delay, NULL);
+}
+#endif
+
+static const char *mode_name(uint8_t mode)
+{
+    switch (mode) {
+    case YADS_SHM_MODE_TEST: return "test";
+    case YADS_SHM_MODE_AUTONOMOUS: return "autonomous";
+    default: return "teleop";
+    }
+}
+
+static void print_state(const yads_shm_state *state)
+{
+    int slot;
+    printf("seq %u  team %u  robot %s  code %s  %s %s%s\n",
+           state->header.sequence, state->team_number,
+           state->robot_connected ? "connected" : "disconnected",
+           state->robot_code ? "yes" : "no",
+           state->enabled ? "enabled" : "disabled", mode_name(state->mode),
+           state->emergency_stop ? "  E-STOP" : "");
+    printf("battery %.2f V  latency %.1f ms  loss %.1f %%  cpu %.0f %%  can %.0f %%\n",
+           state->battery_voltage, state->latency_ms, state->packet_loss,
+           state->cpu_usage, state->can_utilization);
+    printf("match phase %u (source %u)  %.1f s left  fms %s match %u\n",
+           state->match_phase, state->match_source, state->match_time_remaining,
+           state->fms_connected ? "connected" : "disconnected", state->fms_match_number);
+    for (slot = 0; slot < YADS_SHM_MAX_CONTROLLERS; ++slot) {
+        const yads_shm_controller *controller = &state->controllers[slot];
+        if (controller->present) {
+            printf("  slot %d: %s  axes %u  buttons 0x%08x\n", slot, controller->name,
+                   controller->axis_count, controller->buttons);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    yads_shm_reader reader;
+    yads_shm_state state;
+    const char *path = NULL;
+    int interval = 0;
+    int i;
+    int result;
+
+    for (i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            interval = atoi(argv[++i]);
+        } else {
+            path = argv[i];
+        }
+    }
+
+    result = yads_shm_open(&reader, path);
+    if (result != YADS_SHM_OK) {
+        fprintf(stderr, "cannot open YADS state segment (error %d)\n", result);
+        return 1;
+    }
+
+    do {
+        result = yads_shm_read(&reader, &state);
+        if (result != YADS_SHM_OK) {
+            fprintf(stderr, "read failed (error %d)\n", result);
+        } else {
+            print_state(&state);
+            if (!yads_shm_writer_running(&reader)) {
+                printf("(YADS is not running; last state shown)\n");
+            }
+        }
+        if (interval > 0) {
+            sleep_ms(interval);
+        }
+    } while (interval > 0);
+
+    yads_shm_close(&reader);
+    return result == YADS_SHM_OK ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+#include <QtTest>
+
+#include "backend/core/clock.h"
+#include "backend/managers/battery_manager.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+constexpr double CRITICAL_THRESHOLD = 6.8;
+constexpr double WARNING_THRESHOLD = 7.5;
+constexpr double NORMAL_VOLTAGE = 12.5;
+constexpr double CRITICAL_VOLTAGE = 6.0;
+constexpr int CHECK_INTERVAL_MS = 1000;    // BatteryManager's check timer
+
+} // namespace
+
+class TestBatteryManager : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void sustainedCriticalDisables();
+    void briefDipDoesNotDisable();
+    void autoDisableOff();
+    void criticalAlert();
+
+private:
+    void configure(BatteryManager &battery, VirtualClock &clock);
+};
+
+void TestBatteryManager::configure(BatteryManager &battery, VirtualClock &clock)
+{
+    battery.setClock(&clock);
+    battery.setWarningThreshold(WARNING_THRESHOLD);
+    battery.setCriticalThreshold(CRITICAL_THRESHOLD);
+    battery.setAutoDisableEnabled(true);
+}
+
+// A steady critical reading (the robot reports the same voltage in every packet)
+// disables once it has lasted SUSTAINED_CRITICAL_MS, on the next check
+void TestBatteryManager::sustainedCriticalDisables()
+{
+    VirtualClock clock;
+    BatteryManager battery;
+    configure(battery, clock);
+    QSignalSpy disable(&battery, &BatteryManager::robotShouldDisable);
+
+    battery.updateVoltage(NORMAL_VOLTAGE);
+    clock.advance(500);
+    battery.updateVoltage(CRITICAL_VOLTAGE);
+    QCOMPARE(battery.batteryLevel(), BatteryManager::Critical);
+
+    // Checks at 1 s and 2 s see 0.5 s and 1.5 s of critical voltage
+    clock.advance(BatteryManager::SUSTAINED_CRITICAL_MS);
+    QCOMPARE(disable.count(), 0);
+
+    // The check at 3 s sees 2.5 s
+    clock.advance(CHECK_INTERVAL_MS);
+    QCOMPARE(disable.count(), 1);
+
+    // And keeps asking while the voltage stays down
+    for (int i = 0; i < 3; ++i) {
+        battery.updateVoltage(CRITICAL_VOLTAGE);
+        clock.advance(CHECK_INTERVAL_MS);
+    }
+    QCOMPARE(disable.count(), 4);
+}
+
+// A dip shorter than SUSTAINED_CRITICAL_MS, as when a motor stalls, leaves the robot enabled
+void TestBatteryManager::briefDipDoesNotDisable()
+{
+    VirtualClock clock;
+    BatteryManager battery;
+    configure(battery, clock);
+    QSignalSpy disable(&battery, &BatteryManager::robotShouldDisable);
+
+    battery.updateVoltage(NORMAL_VOLTAGE);
+    clock.advance(500);
+    battery.updateVoltage(CRITICAL_VOLTAGE);
+    clock.advance(BatteryManager::SUSTAINED_CRITICAL_MS - 100);
+    battery.updateVoltage(NORMAL_VOLTAGE);
+    QCOMPARE(battery.batteryLevel(), BatteryManager::Normal);
+
+    clock.advance(10 * CHECK_INTERVAL_MS);
+    QCOMPARE(disable.count(), 0);
+
+    // A second dip starts its own count instead of adding to the first
+    battery.updateVoltage(CRITICAL_VOLTAGE);
+    clock.advance(BatteryManager::SUSTAINED_CRITICAL_MS - 100);
+    QCOMPARE(disable.count(), 0);
+}
+
+void TestBatteryManager::autoDisableOff()
+{
+    VirtualClock clock;
+    BatteryManager battery;
+    configure(battery, clock);
+    battery.setAutoDisableEnabled(false);
+    QSignalSpy disable(&battery, &BatteryManager::robotShouldDisable);
+
+    battery.updateVoltage(CRITICAL_VOLTAGE);
+    clock.advance(10 * CHECK_INTERVAL_MS);
+    QCOMPARE(disable.count(), 0);
+}
+
+// The flight recorder's brownout snapshot hangs off this alert
+void TestBatteryManager::criticalAlert()
+{
+    VirtualClock clock;
+    BatteryManager battery;
+    configure(battery, clock);
+    QSignalSpy alerts(&battery, &BatteryManager::voltageAlert);
+
+    battery.updateVoltage(NORMAL_VOLTAGE);
+    battery.updateVoltage(7.2);
+    battery.updateVoltage(CRITICAL_VOLTAGE);
+
+    QCOMPARE(alerts.count(), 2);
+    QCOMPARE(alerts.at(0).at(0).value<BatteryManager::BatteryLevel>(), BatteryManager::Warning);
+    QCOMPARE(alerts.at(1).at(0).value<BatteryManager::BatteryLevel>(), BatteryManager::Critical);
+    QCOMPARE(alerts.at(1).at(1).toDouble(), CRITICAL_VOLTAGE);
+}
+
+QTEST_GUILESS_MAIN(TestBatteryManager)
+#include "tst_batterymanager.moc"
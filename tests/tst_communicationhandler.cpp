@@ -0,0 +1,85 @@
+#include <QtTest>
+#include <QStandardPaths>
+
+#include "backend/core/clock.h"
+#include "backend/core/constants.h"
+#include "backend/robotstate.h"
+#include "backend/robot/comms/communicationhandler.h"
+#include "robotsimulator.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+constexpr int CONTROL_INTERVAL_MS = 20;
+constexpr int WATCHDOG_INTERVAL_MS = 1000;  // CommunicationHandler's watchdog timer
+
+} // namespace
+
+class TestCommunicationHandler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void packetTimeoutWatchdog();
+};
+
+void TestCommunicationHandler::initTestCase()
+{
+    // RobotState loads and saves settings; keep them out of the user's
+    QStandardPaths::setTestModeEnabled(true);
+    QCoreApplication::setApplicationName(::Constants::APPLICATION_NAME);
+    QCoreApplication::setOrganizationName(::Constants::ORGANIZATION_NAME);
+}
+
+// The robot goes silent: the handler calls it lost on the first watchdog tick past
+// PACKET_TIMEOUT_MS, and not before
+void TestCommunicationHandler::packetTimeoutWatchdog()
+{
+    RobotSimulator::Settings robot;
+    robot.bindAddress = QHostAddress::LocalHost;
+    robot.console = false;
+    robot.networkTables = false;
+    robot.http = false;
+    RobotSimulator simulator(robot);
+    if (!simulator.start()) {
+        QSKIP(qPrintable(QString("Cannot start robot endpoint: %1").arg(simulator.errorString())));
+    }
+
+    VirtualClock clock;
+    RobotState robotState;
+    CommunicationHandler *handler = robotState.communicationHandler();
+    handler->setClock(&clock);
+    robotState.setRobotIpAddress(QHostAddress(QHostAddress::LocalHost).toString());
+    robotState.setConnectionMode(RobotState::IpAddress);
+
+    QSignalSpy connected(handler, &CommunicationHandler::robotConnected);
+    QSignalSpy disconnected(handler, &CommunicationHandler::robotDisconnected);
+
+    // One control packet out; the simulator answers it in real time
+    clock.advance(CONTROL_INTERVAL_MS);
+    QVERIFY(connected.wait(2000));
+    QVERIFY(robotState.isRobotConnected());
+    const qint64 lastStatusMs = clock.nowMs();
+
+    simulator.stop();
+    QTest::qWait(50);
+
+    // Nothing is read while virtual time runs, so no status packet can arrive
+    const qint64 timeoutMs = FRCDriverStation::Constants::Network::PACKET_TIMEOUT_MS;
+    while (disconnected.isEmpty() && clock.nowMs() < lastStatusMs + timeoutMs + 2 * WATCHDOG_INTERVAL_MS) {
+        clock.advance(CONTROL_INTERVAL_MS);
+    }
+
+    QCOMPARE(disconnected.count(), 1);
+    QVERIFY(!robotState.isRobotConnected());
+    const qint64 silenceMs = clock.nowMs() - lastStatusMs;
+    QVERIFY2(silenceMs > timeoutMs,
+             qPrintable(QString("lost after %1 ms of silence").arg(silenceMs)));
+    QVERIFY2(silenceMs <= timeoutMs + WATCHDOG_INTERVAL_MS + CONTROL_INTERVAL_MS,
+             qPrintable(QString("lost after %1 ms of silence").arg(silenceMs)));
+}
+
+QTEST_GUILESS_MAIN(TestCommunicationHandler)
+#include "tst_communicationhandler.moc"
@@ -0,0 +1,114 @@
+#include <QtTest>
+#include <QUdpSocket>
+#include <QtEndian>
+
+#include "backend/core/clock.h"
+#include "backend/core/constants.h"
+#include "backend/fms/fmshandler.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+constexpr int FMS_TIMEOUT_MS = 5000;        // FMSHandler::CONNECTION_TIMEOUT
+constexpr quint8 CONTROL_ENABLED = 0x01;
+
+// An FMS control packet, as FMSHandler::decodeControlPacket reads it
+QByteArray controlPacket(quint16 matchTime, quint8 control)
+{
+    QByteArray packet(FMSHandler::CONTROL_PACKET_SIZE, '\0');
+    uchar *data = reinterpret_cast<uchar *>(packet.data());
+    data[2] = 2;                                // Qualification
+    qToBigEndian<quint16>(12, data + 3);        // Match number
+    data[5] = 1;                                // Play number
+    qToBigEndian<quint16>(matchTime, data + 6);
+    data[8] = control;
+    return packet;
+}
+
+} // namespace
+
+class TestFmsHandler : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void connectionTimeout();
+    void packetsRestartTimeout();
+
+private:
+    bool sendControl(QUdpSocket &socket, quint16 matchTime, quint8 control);
+};
+
+void TestFmsHandler::init()
+{
+    // The handler listens on the real FMS port; another DS on this machine would own it
+    QUdpSocket probe;
+    if (!probe.bind(QHostAddress::Any, ::Constants::DEFAULT_FMS_PORT)) {
+        QSKIP("FMS port in use");
+    }
+}
+
+bool TestFmsHandler::sendControl(QUdpSocket &socket, quint16 matchTime, quint8 control)
+{
+    const QByteArray packet = controlPacket(matchTime, control);
+    return socket.writeDatagram(packet, QHostAddress::LocalHost, ::Constants::DEFAULT_FMS_PORT) == packet.size();
+}
+
+// A silent FMS disables after exactly FMS_TIMEOUT_MS of virtual time
+void TestFmsHandler::connectionTimeout()
+{
+    VirtualClock clock;
+    FMSHandler fms;
+    fms.setClock(&clock);
+    fms.setFmsAddressOverride(QHostAddress::LocalHost);
+    fms.connectToFMS();
+    QSignalSpy changes(&fms, &FMSHandler::stateChanged);
+
+    QUdpSocket fmsSocket;
+    QVERIFY(sendControl(fmsSocket, 135, CONTROL_ENABLED));
+    QTRY_VERIFY(fms.isConnected());
+    QVERIFY(fms.isEnabled());
+    QCOMPARE(fms.matchState(), FMSHandler::Teleop);
+    QCOMPARE(changes.count(), 1);
+
+    clock.advance(FMS_TIMEOUT_MS - 1);
+    QVERIFY(fms.isConnected());
+    QVERIFY(fms.isEnabled());
+
+    clock.advance(1);
+    QVERIFY(!fms.isConnected());
+    QVERIFY(!fms.isEnabled());
+    QCOMPARE(fms.matchState(), FMSHandler::Unknown);
+    QCOMPARE(changes.count(), 2);
+    QVERIFY(!changes.last().at(0).value<FmsState::Snapshot>().connected);
+}
+
+// Each packet restarts the timeout
+void TestFmsHandler::packetsRestartTimeout()
+{
+    VirtualClock clock;
+    FMSHandler fms;
+    fms.setClock(&clock);
+    fms.setFmsAddressOverride(QHostAddress::LocalHost);
+    fms.connectToFMS();
+    QSignalSpy changes(&fms, &FMSHandler::stateChanged);
+
+    QUdpSocket fmsSocket;
+    QVERIFY(sendControl(fmsSocket, 135, CONTROL_ENABLED));
+    QTRY_COMPARE(changes.count(), 1);
+
+    clock.advance(FMS_TIMEOUT_MS - 1000);
+    QVERIFY(sendControl(fmsSocket, 131, CONTROL_ENABLED));
+    QTRY_COMPARE(changes.count(), 2);
+
+    // Measured from the second packet, not the first
+    clock.advance(FMS_TIMEOUT_MS - 1);
+    QVERIFY(fms.isConnected());
+    clock.advance(1);
+    QVERIFY(!fms.isConnected());
+}
+
+QTEST_GUILESS_MAIN(TestFmsHandler)
+#include "tst_fmshandler.moc"
@@ -0,0 +1,149 @@
+#include <QtTest>
+#include <QList>
+#include <QPair>
+
+#include "backend/core/clock.h"
+#include "backend/core/matchclock.h"
+#include "backend/managers/practice_match_manager.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+// An FRC match: 15 s autonomous, then 135 s teleop whose last 30 s are the endgame
+constexpr int AUTONOMOUS_SECONDS = 15;
+constexpr int TELEOP_SECONDS = 105;
+constexpr int ENDGAME_SECONDS = 30;
+constexpr qint64 AUTONOMOUS_END_MS = AUTONOMOUS_SECONDS * 1000;
+constexpr qint64 TELEOP_END_MS = (AUTONOMOUS_SECONDS + TELEOP_SECONDS) * 1000;
+constexpr qint64 MATCH_MS = 150 * 1000;
+
+using PhaseChange = QPair<qint64, PracticeMatchManager::MatchPhase>;
+
+} // namespace
+
+class TestPracticeMatch : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void fullMatch();
+    void pauseAndResume();
+    void stopDisables();
+};
+
+// A whole match in virtual time: every phase flips exactly on its deadline
+void TestPracticeMatch::fullMatch()
+{
+    VirtualClock clock;
+    PracticeMatchManager match;
+    match.setClock(&clock);
+    match.setAutonomousTime(AUTONOMOUS_SECONDS);
+    match.setTeleopTime(TELEOP_SECONDS);
+    match.setEndgameTime(ENDGAME_SECONDS);
+
+    QList<PhaseChange> phases;
+    connect(&match, &PracticeMatchManager::phaseChanged, &match, [&](PracticeMatchManager::MatchPhase phase) {
+        phases.append({clock.nowMs(), phase});
+    });
+    QSignalSpy modeRequests(&match, &PracticeMatchManager::robotModeChangeRequested);
+    QSignalSpy stopped(&match, &PracticeMatchManager::matchStopped);
+
+    match.startMatch();
+    QVERIFY(match.running());
+    QCOMPARE(match.timeRemaining(), AUTONOMOUS_SECONDS);
+
+    clock.advance(AUTONOMOUS_END_MS - 1);
+    QCOMPARE(match.currentPhase(), PracticeMatchManager::Autonomous);
+    QCOMPARE(match.timeRemaining(), 1);
+
+    while (match.running() && clock.advanceToNextTimer()) {
+    }
+
+    QVERIFY(!match.running());
+    QCOMPARE(clock.nowMs(), MATCH_MS);
+    QCOMPARE(stopped.count(), 1);
+
+    const QList<PhaseChange> expected = {
+        {0, PracticeMatchManager::Autonomous},
+        {AUTONOMOUS_END_MS, PracticeMatchManager::Teleop},
+        {TELEOP_END_MS, PracticeMatchManager::Endgame},
+        {MATCH_MS, PracticeMatchManager::PostMatch},
+    };
+    QCOMPARE(phases, expected);
+
+    // Autonomous, then teleop for both teleop and endgame
+    QCOMPARE(modeRequests.count(), 3);
+    QCOMPARE(modeRequests.at(0).at(0).toInt(), 1);
+    QCOMPARE(modeRequests.at(1).at(0).toInt(), 0);
+    QCOMPARE(modeRequests.at(2).at(0).toInt(), 0);
+
+    QVERIFY(!match.matchClock()->read().running);
+}
+
+// Paused time is not match time: the schedule picks up where it stopped
+void TestPracticeMatch::pauseAndResume()
+{
+    VirtualClock clock;
+    PracticeMatchManager match;
+    match.setClock(&clock);
+    match.setAutonomousTime(AUTONOMOUS_SECONDS);
+    match.setTeleopTime(TELEOP_SECONDS);
+    match.setEndgameTime(ENDGAME_SECONDS);
+
+    match.startMatch();
+    clock.advance(5000);
+    QCOMPARE(match.timeRemaining(), AUTONOMOUS_SECONDS - 5);
+
+    QSignalSpy disableRequests(&match, &PracticeMatchManager::robotDisableRequested);
+    match.pauseMatch();
+    QVERIFY(match.paused());
+    QCOMPARE(disableRequests.count(), 1);
+
+    clock.advance(60000);
+    QCOMPARE(match.currentPhase(), PracticeMatchManager::Autonomous);
+    QCOMPARE(match.timeRemaining(), AUTONOMOUS_SECONDS - 5);
+    const MatchClock::Reading paused = match.matchClock()->read();
+    QVERIFY(paused.paused);
+    QCOMPARE(paused.phase, MatchClock::Autonomous);
+    QCOMPARE(paused.remainingNs, (AUTONOMOUS_SECONDS - 5) * MatchClock::NS_PER_SECOND);
+
+    match.resumeMatch();
+    QVERIFY(!match.paused());
+
+    clock.advance((AUTONOMOUS_SECONDS - 5) * 1000 - 1);
+    QCOMPARE(match.currentPhase(), PracticeMatchManager::Autonomous);
+    clock.advance(1);
+    QCOMPARE(match.currentPhase(), PracticeMatchManager::Teleop);
+    QCOMPARE(clock.nowMs(), 60000 + AUTONOMOUS_END_MS);
+
+    // Pausing and resuming again in teleop shifts the end of the match by the pause
+    match.pauseMatch();
+    clock.advance(30000);
+    match.resumeMatch();
+    while (match.running() && clock.advanceToNextTimer()) {
+    }
+    QCOMPARE(clock.nowMs(), 60000 + 30000 + MATCH_MS);
+}
+
+void TestPracticeMatch::stopDisables()
+{
+    VirtualClock clock;
+    PracticeMatchManager match;
+    match.setClock(&clock);
+
+    match.startMatch();
+    clock.advance(20000);
+
+    QSignalSpy disableRequests(&match, &PracticeMatchManager::robotDisableRequested);
+    match.stopMatch();
+    QVERIFY(!match.running());
+    QVERIFY(disableRequests.count() >= 1);
+    QCOMPARE(match.currentPhase(), PracticeMatchManager::PostMatch);
+
+    // No timer is left to flip a phase after the stop
+    QCOMPARE(clock.pendingTimers(), 0);
+}
+
+QTEST_GUILESS_MAIN(TestPracticeMatch)
+#include "tst_practicematch.moc"
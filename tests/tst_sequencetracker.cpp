@@ -0,0 +1,228 @@
+#include <QtTest>
+
+#include "backend/robot/comms/sequencetracker.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+using Result = SequenceTracker::Result;
+
+// Short horizon so a gap is confirmed lost a handful of packets later
+constexpr int SHORT_HORIZON = 4;
+
+// Records first..last inclusive, expecting each to arrive in order
+bool recordInOrder(SequenceTracker &tracker, int first, int last)
+{
+    for (int sequence = first; sequence <= last; ++sequence) {
+        if (tracker.record(quint16(sequence)) != Result::InOrder) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+class TestSequenceTracker : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void wrapAround();
+    void gapAcrossWrap();
+    void duplicate();
+    void reorderWithinHorizon();
+    void lateAfterHorizon();
+    void farJumpResyncs();
+    void restartInsideWindowResyncs();
+    void burstHistogram();
+};
+
+// 65535 -> 0 is the next packet, not a jump back of 65535
+void TestSequenceTracker::wrapAround()
+{
+    SequenceTracker tracker;
+    QVERIFY(!tracker.isSynchronized());
+
+    QCOMPARE(tracker.record(65534), Result::InOrder);
+    QVERIFY(tracker.isSynchronized());
+    QCOMPARE(tracker.record(65535), Result::InOrder);
+    QCOMPARE(tracker.record(0), Result::InOrder);
+    QCOMPARE(tracker.record(1), Result::InOrder);
+
+    QCOMPARE(tracker.highestSequence(), quint16(1));
+    QCOMPARE(tracker.statistics().received, quint64(4));
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+    QCOMPARE(tracker.statistics().resyncs, quint64(0));
+}
+
+// A gap that spans the wrap stays pending and is filled from either side of it
+void TestSequenceTracker::gapAcrossWrap()
+{
+    SequenceTracker tracker;
+    QCOMPARE(tracker.record(65535), Result::InOrder);
+    QCOMPARE(tracker.record(2), Result::Gap);
+    QCOMPARE(tracker.statistics().pending, quint32(2));
+
+    QCOMPARE(tracker.record(0), Result::Reordered);
+    QCOMPARE(tracker.record(1), Result::Reordered);
+    QCOMPARE(tracker.statistics().pending, quint32(0));
+    QCOMPARE(tracker.statistics().reordered, quint64(2));
+    QCOMPARE(tracker.statistics().received, quint64(4));
+}
+
+// Copies of received packets are counted but not received twice
+void TestSequenceTracker::duplicate()
+{
+    SequenceTracker tracker;
+    QVERIFY(recordInOrder(tracker, 10, 12));
+
+    QCOMPARE(tracker.record(11), Result::Duplicate);
+    QCOMPARE(tracker.record(12), Result::Duplicate);
+    QCOMPARE(tracker.statistics().duplicates, quint64(2));
+    QCOMPARE(tracker.statistics().received, quint64(3));
+
+    // The stream carries on as if nothing happened
+    QCOMPARE(tracker.record(13), Result::InOrder);
+    QCOMPARE(tracker.statistics().duplicates, quint64(2));
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+}
+
+// A packet overtaken by the next one is reordered, never lost
+void TestSequenceTracker::reorderWithinHorizon()
+{
+    SequenceTracker tracker(SHORT_HORIZON);
+    QCOMPARE(tracker.record(0), Result::InOrder);
+    QCOMPARE(tracker.record(2), Result::Gap);
+    QCOMPARE(tracker.statistics().pending, quint32(1));
+
+    QCOMPARE(tracker.record(1), Result::Reordered);
+    QVERIFY(recordInOrder(tracker, 3, 20));
+
+    QCOMPARE(tracker.statistics().reordered, quint64(1));
+    QCOMPARE(tracker.statistics().late, quint64(0));
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+    QCOMPARE(tracker.statistics().bursts, quint64(0));
+}
+
+// Once the head is a horizon past a gap it is lost; a packet that still turns up
+// afterwards takes the loss back but leaves the burst history alone
+void TestSequenceTracker::lateAfterHorizon()
+{
+    SequenceTracker tracker(SHORT_HORIZON);
+    QVERIFY(recordInOrder(tracker, 0, 2));
+    QCOMPARE(tracker.record(4), Result::Gap);
+    QVERIFY(recordInOrder(tracker, 5, 6));
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+
+    // Head 7 is a horizon past 3
+    QCOMPARE(tracker.record(7), Result::InOrder);
+    QCOMPARE(tracker.statistics().lost, quint64(1));
+    QCOMPARE(tracker.statistics().pending, quint32(0));
+    QCOMPARE(tracker.record(8), Result::InOrder);
+    QCOMPARE(tracker.statistics().bursts, quint64(1));
+
+    QCOMPARE(tracker.record(3), Result::Late);
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+    QCOMPARE(tracker.statistics().late, quint64(1));
+    QCOMPARE(tracker.statistics().reordered, quint64(1));
+    QCOMPARE(tracker.statistics().received, quint64(9));
+    QCOMPARE(tracker.statistics().bursts, quint64(1));
+
+    // A second copy is just a duplicate
+    QCOMPARE(tracker.record(3), Result::Duplicate);
+}
+
+// A jump past the whole window loses everything in between as one burst
+void TestSequenceTracker::farJumpResyncs()
+{
+    SequenceTracker tracker;
+    QVERIFY(recordInOrder(tracker, 100, 110));
+
+    const quint16 jump = quint16(110 + SequenceTracker::WINDOW_SIZE + 5);
+    QCOMPARE(tracker.record(jump), Result::Resynced);
+    QCOMPARE(tracker.highestSequence(), jump);
+    QCOMPARE(tracker.statistics().resyncs, quint64(1));
+    QCOMPARE(tracker.statistics().lost, quint64(SequenceTracker::WINDOW_SIZE + 4));
+    QCOMPARE(tracker.statistics().lastBurst, quint32(SequenceTracker::WINDOW_SIZE + 4));
+    QCOMPARE(tracker.statistics().pending, quint32(0));
+
+    QCOMPARE(tracker.record(quint16(jump + 1)), Result::InOrder);
+
+    // A counter restart from far behind resyncs on the first packet
+    QCOMPARE(tracker.record(0), Result::Resynced);
+    QCOMPARE(tracker.statistics().resyncs, quint64(2));
+    QCOMPARE(tracker.record(1), Result::InOrder);
+}
+
+// A sender restarting a little behind the head looks like duplicates at first;
+// after RESYNC_REJECT_THRESHOLD rejects in a row the tracker follows it
+void TestSequenceTracker::restartInsideWindowResyncs()
+{
+    SequenceTracker tracker;
+    QVERIFY(recordInOrder(tracker, 0, 299));
+
+    const int restart = 290;
+    for (int i = 0; i < SequenceTracker::RESYNC_REJECT_THRESHOLD - 1; ++i) {
+        QCOMPARE(tracker.record(quint16(restart + i)), Result::Duplicate);
+    }
+    QCOMPARE(tracker.statistics().duplicates, quint64(SequenceTracker::RESYNC_REJECT_THRESHOLD - 1));
+
+    const quint16 resyncAt = quint16(restart + SequenceTracker::RESYNC_REJECT_THRESHOLD - 1);
+    QCOMPARE(tracker.record(resyncAt), Result::Resynced);
+    QCOMPARE(tracker.highestSequence(), resyncAt);
+    QCOMPARE(tracker.statistics().resyncs, quint64(1));
+    // They were the new stream, not copies of the old one
+    QCOMPARE(tracker.statistics().duplicates, quint64(0));
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+
+    QCOMPARE(tracker.record(quint16(resyncAt + 1)), Result::InOrder);
+
+    // One stray old packet after the resync is stale, not another restart
+    QCOMPARE(tracker.record(250), Result::Stale);
+    QCOMPARE(tracker.statistics().resyncs, quint64(1));
+    QCOMPARE(tracker.record(quint16(resyncAt + 2)), Result::InOrder);
+}
+
+// Burst lengths go into power-of-two buckets once the burst is confirmed over
+void TestSequenceTracker::burstHistogram()
+{
+    SequenceTracker tracker(SHORT_HORIZON);
+    QCOMPARE(tracker.record(0), Result::InOrder);
+    QCOMPARE(tracker.record(4), Result::Gap);        // 1..3 lost
+    QVERIFY(recordInOrder(tracker, 5, 20));
+    QCOMPARE(tracker.record(22), Result::Gap);       // 21 lost
+    QVERIFY(recordInOrder(tracker, 23, 30));
+    QCOMPARE(tracker.record(41), Result::Gap);       // 31..40 lost
+    // 31..37 are a horizon behind the head already; the burst is still open
+    QCOMPARE(tracker.statistics().currentBurst, quint32(7));
+    QCOMPARE(tracker.statistics().bursts, quint64(2));
+    QVERIFY(recordInOrder(tracker, 42, 60));
+
+    const SequenceTracker::Statistics &stats = tracker.statistics();
+    QCOMPARE(stats.lost, quint64(14));
+    QCOMPARE(stats.received, quint64(47));
+    QVERIFY(qFuzzyCompare(stats.lossPercent(), 100.0 * 14 / 61));
+    QCOMPARE(stats.bursts, quint64(3));
+    QCOMPARE(stats.currentBurst, quint32(0));
+    QCOMPARE(stats.longestBurst, quint32(10));
+    QCOMPARE(stats.lastBurst, quint32(10));
+
+    const SequenceTracker::BurstHistogram &histogram = tracker.burstHistogram();
+    QCOMPARE(histogram.totalCount(), quint64(3));
+    QCOMPARE(histogram.maxValue(), quint64(10));
+    QCOMPARE(histogram.count(0), quint64(0));
+    QCOMPARE(histogram.count(1), quint64(1));   // 1
+    QCOMPARE(histogram.count(2), quint64(1));   // 2..3
+    QCOMPARE(histogram.count(3), quint64(0));   // 4..7
+    QCOMPARE(histogram.count(4), quint64(1));   // 8..15
+
+    tracker.reset();
+    QVERIFY(!tracker.isSynchronized());
+    QCOMPARE(tracker.statistics().lost, quint64(0));
+    QCOMPARE(tracker.burstHistogram().totalCount(), quint64(0));
+}
+
+QTEST_GUILESS_MAIN(TestSequenceTracker)
+#include "tst_sequencetracker.moc"
@@ -0,0 +1,196 @@
+#include <QtTest>
+#include <memory>
+
+#include "backend/controllers/controllerhidhandler.h"
+#include "backend/controllers/evdevkeylistener.h"
+#include "uinputdevice.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+constexpr char GAMEPAD_NAME[] = "YADS test gamepad";
+constexpr char KEYBOARD_NAME[] = "YADS test keyboard";
+constexpr int DETECT_INTERVAL_MS = 2000;    // ControllerHIDHandler's detection timer
+constexpr int HOTPLUG_TIMEOUT_MS = 2 * DETECT_INTERVAL_MS + 1000;
+
+// Sticks on a signed 16-bit range, triggers on an unsigned 8-bit one, as an Xbox pad reports them
+const QVector<UinputDevice::Axis> GAMEPAD_AXES = {
+    {ABS_X, -32768, 32767},
+    {ABS_Y, -32768, 32767},
+    {ABS_Z, 0, 255},
+    {ABS_RX, -32768, 32767},
+};
+const QVector<int> GAMEPAD_BUTTONS = {BTN_SOUTH, BTN_EAST, BTN_NORTH, BTN_WEST};
+
+ControllerHIDDevice *findController(const ControllerHIDHandler &handler, const QString &name)
+{
+    for (ControllerHIDDevice *controller : handler.getAllControllers()) {
+        if (controller->name() == name) {
+            return controller;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace
+
+class TestUinputDevices : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void init();
+    void gamepadHotplug();
+    void gamepadMapping_data();
+    void gamepadMapping();
+    void safetyKeys();
+};
+
+void TestUinputDevices::init()
+{
+    // Probe with a throwaway device so every case skips the same way
+    UinputDevice probe("YADS uinput probe", {KEY_A});
+    if (!probe.isValid()) {
+        QSKIP("Cannot create a uinput device (no write access to /dev/uinput?)");
+    }
+}
+
+// The detection timer picks up a gamepad that appears and drops it, and its slot, once it is gone
+void TestUinputDevices::gamepadHotplug()
+{
+    ControllerHIDHandler handler;
+    QSignalSpy connected(&handler, &ControllerHIDHandler::controllerConnected);
+    QSignalSpy disconnected(&handler, &ControllerHIDHandler::controllerDisconnected);
+    QSignalSpy unbound(&handler, &ControllerHIDHandler::controllerUnbound);
+    handler.startPolling();
+    QVERIFY(!findController(handler, GAMEPAD_NAME));
+
+    auto gamepad = std::make_unique<UinputDevice>(GAMEPAD_NAME, GAMEPAD_BUTTONS, GAMEPAD_AXES);
+    QVERIFY(gamepad->isValid());
+    QVERIFY(!gamepad->eventPath().isEmpty());
+
+    QTRY_VERIFY_WITH_TIMEOUT(findController(handler, GAMEPAD_NAME), HOTPLUG_TIMEOUT_MS);
+    ControllerHIDDevice *controller = findController(handler, GAMEPAD_NAME);
+    const QString deviceId = controller->deviceId();
+    QVERIFY(controller->isConnected());
+    QVERIFY(controller->isGameController());
+    QCOMPARE(controller->getAxisCount(), int(GAMEPAD_AXES.size()));
+    QCOMPARE(controller->getButtonCount(), int(GAMEPAD_BUTTONS.size()));
+    QVERIFY(connected.count() >= 1);
+    QVERIFY(handler.bindControllerToSlot(deviceId, 2));
+
+    gamepad.reset();
+
+    QTRY_VERIFY_WITH_TIMEOUT(!handler.getControllerById(deviceId), HOTPLUG_TIMEOUT_MS);
+    QVERIFY(disconnected.contains(QVariantList{deviceId}));
+    QVERIFY(unbound.contains(QVariantList{deviceId, 2}));
+    QVERIFY(!handler.getControllerInSlot(2));
+}
+
+void TestUinputDevices::gamepadMapping_data()
+{
+    QTest::addColumn<int>("code");
+    QTest::addColumn<int>("value");
+    QTest::addColumn<int>("axis");
+    QTest::addColumn<float>("expected");
+
+    // Axes are numbered in evdev code order and scaled from their own range to -1..1.
+    // Every axis starts at 0 and evdev drops unchanged values, so no row writes 0.
+    QTest::newRow("x min") << ABS_X << -32768 << 0 << -1.0f;
+    QTest::newRow("x max") << ABS_X << 32767 << 0 << 1.0f;
+    QTest::newRow("y half up") << ABS_Y << -16384 << 1 << -0.5f;
+    QTest::newRow("trigger half") << ABS_Z << 128 << 2 << 0.0f;
+    QTest::newRow("trigger pressed") << ABS_Z << 255 << 2 << 1.0f;
+    QTest::newRow("right x quarter") << ABS_RX << 16384 << 3 << 0.5f;
+}
+
+// Events written to the virtual pad come back out of the bound slot on the poll timer
+void TestUinputDevices::gamepadMapping()
+{
+    QFETCH(int, code);
+    QFETCH(int, value);
+    QFETCH(int, axis);
+    QFETCH(float, expected);
+
+    UinputDevice gamepad(GAMEPAD_NAME, GAMEPAD_BUTTONS, GAMEPAD_AXES);
+    QVERIFY(gamepad.isValid());
+    QVERIFY(!gamepad.eventPath().isEmpty());
+
+    ControllerHIDHandler handler;
+    handler.refreshControllers();
+    ControllerHIDDevice *controller = findController(handler, GAMEPAD_NAME);
+    QVERIFY(controller);
+    QVERIFY(handler.bindControllerToSlot(controller->deviceId(), 0));
+    QSignalSpy dataChanged(&handler, &ControllerHIDHandler::controllerDataChanged);
+    handler.startPolling();
+
+    QVERIFY(gamepad.emitEvent(EV_ABS, code, value));
+    QTRY_VERIFY(!dataChanged.isEmpty());
+    QCOMPARE(dataChanged.first().at(0).toInt(), 0);
+    QVERIFY2(qAbs(controller->getAxisValue(axis) - expected) < 0.01f,
+             qPrintable(QString("axis %1 is %2").arg(axis).arg(controller->getAxisValue(axis))));
+
+    // Buttons follow the same rule: BTN_NORTH is the third button the pad reports
+    QVERIFY(!controller->getButtonValue(2));
+    QVERIFY(gamepad.emitEvent(EV_KEY, BTN_NORTH, 1));
+    QTRY_VERIFY(controller->getButtonValue(2));
+    QVERIFY(!controller->getButtonValue(0));
+    QVERIFY(gamepad.emitEvent(EV_KEY, BTN_NORTH, 0));
+    QTRY_VERIFY(!controller->getButtonValue(2));
+}
+
+// The evdev safety keys: a keyboard plugged in after start() is followed, and Space and
+// Enter map to e-stop and disable
+void TestUinputDevices::safetyKeys()
+{
+    // The listener emits on its input thread; the listener's own context queues these to us
+    EvdevKeyListener listener;
+    QStringList added;
+    QStringList removed;
+    QStringList emergencyStops;
+    qint64 emergencyStopLatencyUs = -1;
+    QStringList disables;
+    connect(&listener, &EvdevKeyListener::keyboardAdded, &listener,
+            [&](const QString &path, const QString &) { added.append(path); });
+    connect(&listener, &EvdevKeyListener::keyboardRemoved, &listener,
+            [&](const QString &path, const QString &) { removed.append(path); });
+    connect(&listener, &EvdevKeyListener::emergencyStopPressed, &listener,
+            [&](const QString &device, qint64 latencyUs) {
+        emergencyStops.append(device);
+        emergencyStopLatencyUs = latencyUs;
+    });
+    connect(&listener, &EvdevKeyListener::disablePressed, &listener,
+            [&](const QString &device, qint64) { disables.append(device); });
+    QVERIFY(listener.start());
+
+    auto keyboard = std::make_unique<UinputDevice>(KEYBOARD_NAME, QVector<int>{KEY_SPACE, KEY_ENTER, KEY_A});
+    QVERIFY(keyboard->isValid());
+    const QString path = keyboard->eventPath();
+    QVERIFY(!path.isEmpty());
+    QTRY_VERIFY(added.contains(path));
+
+    // Other keys, releases and autorepeat are ignored
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_A, 1));
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_A, 0));
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_SPACE, 1));
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_SPACE, 2));
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_SPACE, 0));
+    QTRY_COMPARE(emergencyStops, QStringList{KEYBOARD_NAME});
+    // uinput devices honour EVIOCSCLOCKID, so the latency is measured
+    QVERIFY(emergencyStopLatencyUs >= 0);
+
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_ENTER, 1));
+    QVERIFY(keyboard->emitEvent(EV_KEY, KEY_ENTER, 0));
+    QTRY_COMPARE(disables, QStringList{KEYBOARD_NAME});
+    QCOMPARE(emergencyStops.size(), qsizetype(1));
+
+    keyboard.reset();
+    QTRY_VERIFY(removed.contains(path));
+
+    listener.stop();
+    QVERIFY(!listener.isRunning());
+}
+
+QTEST_GUILESS_MAIN(TestUinputDevices)
+#include "tst_uinputdevices.moc"
@@ -0,0 +1,135 @@
+#ifndef UINPUTDEVICE_H
+#define UINPUTDEVICE_H
+
+#include <QByteArray>
+#include <QDir>
+#include <QFile>
+#include <QString>
+#include <QThread>
+#include <QVector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/uinput.h>
+#include <cstring>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Virtual input device created through /dev/uinput
+ *
+ * Gives the evdev readers (ControllerHIDDevice, EvdevKeyListener) a real
+ * event node to open, so hot-plug, capability probing and event decoding
+ * run exactly as they do for a physical gamepad or keyboard. Destroying the
+ * device unplugs it. Needs write access to /dev/uinput; check isValid().
+ */
+class UinputDevice
+{
+public:
+    struct Axis {
+        int code;
+        int minimum;
+        int maximum;
+    };
+
+    UinputDevice(const char *name, const QVector<int> &keys, const QVector<Axis> &axes = {})
+        : m_fd(-1)
+        , m_name(name)
+    {
+        m_fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+        if (m_fd < 0) {
+            return;
+        }
+
+        if (!keys.isEmpty()) {
+            ioctl(m_fd, UI_SET_EVBIT, EV_KEY);
+            for (int key : keys) {
+                ioctl(m_fd, UI_SET_KEYBIT, key);
+            }
+        }
+        if (!axes.isEmpty()) {
+            ioctl(m_fd, UI_SET_EVBIT, EV_ABS);
+            for (const Axis &axis : axes) {
+                ioctl(m_fd, UI_SET_ABSBIT, axis.code);
+                uinput_abs_setup abs;
+                std::memset(&abs, 0, sizeof(abs));
+                abs.code = axis.code;
+                abs.absinfo.minimum = axis.minimum;
+                abs.absinfo.maximum = axis.maximum;
+                ioctl(m_fd, UI_ABS_SETUP, &abs);
+            }
+        }
+
+        uinput_setup setup;
+        std::memset(&setup, 0, sizeof(setup));
+        setup.id.bustype = BUS_VIRTUAL;
+        setup.id.vendor = 0x1209;
+        setup.id.product = 0x0001;
+        std::strncpy(setup.name, name, UINPUT_MAX_NAME_SIZE - 1);
+        if (ioctl(m_fd, UI_DEV_SETUP, &setup) < 0 || ioctl(m_fd, UI_DEV_CREATE) < 0) {
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    ~UinputDevice() {
+        destroy();
+    }
+
+    UinputDevice(const UinputDevice &) = delete;
+    UinputDevice &operator=(const UinputDevice &) = delete;
+
+    bool isValid() const { return m_fd >= 0; }
+
+    // Unplugs the device; its event node goes away
+    void destroy() {
+        if (m_fd >= 0) {
+            ioctl(m_fd, UI_DEV_DESTROY);
+            close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+    // The event node the kernel creates for us; it can take a moment to appear
+    QString eventPath() const {
+        for (int attempt = 0; attempt < 50; ++attempt) {
+            const QDir input("/sys/class/input");
+            for (const QString &entry : input.entryList({"event*"}, QDir::Dirs | QDir::System)) {
+                QFile nameFile(input.filePath(entry + "/device/name"));
+                if (nameFile.open(QIODevice::ReadOnly)
+                    && nameFile.readAll().trimmed() == m_name
+                    && QFile::exists("/dev/input/" + entry)) {
+                    return "/dev/input/" + entry;
+                }
+            }
+            QThread::msleep(20);
+        }
+        return QString();
+    }
+
+    // Events are delivered to readers once a SYN_REPORT follows them
+    bool emitEvents(const input_event *events, int count) {
+        const ssize_t size = ssize_t(sizeof(input_event)) * count;
+        return write(m_fd, events, size) == size;
+    }
+
+    bool emitEvent(int type, int code, int value) {
+        input_event events[2];
+        std::memset(events, 0, sizeof(events));
+        events[0].type = type;
+        events[0].code = code;
+        events[0].value = value;
+        events[1].type = EV_SYN;
+        events[1].code = SYN_REPORT;
+        return emitEvents(events, 2);
+    }
+
+private:
+    int m_fd;
+    QByteArray m_name;
+};
+
+} // namespace FRCDriverStation
+
+#endif // UINPUTDEVICE_H
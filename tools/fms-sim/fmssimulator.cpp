@@ -0,0 +1,358 @@
+#include "fmssimulator.h"
+#include <QJsonArray>
+#include <QtEndian>
+
+using namespace FRCDriverStation;
+
+namespace {
+
+// Header of the DS status heartbeat (see FMSHandler::sendStatusPacket()): team (2), type (1)
+constexpr int HEARTBEAT_MIN_SIZE = 3;
+constexpr quint8 HEARTBEAT_TYPE_STATUS = 0x01;
+
+} // namespace
+
+QList<FmsSimulator::Step> FmsSimulator::matchScript(int preMatchSeconds, int autonomousSeconds, int teleopSeconds,
+                                                    bool emergencyStop, int deadlineMs, int abortDeadlineMs) {
+    const quint8 mode = DsEnabled | DsAutonomous | DsTest | DsFmsAttached;
+    QList<Step> script;
+
+    Step preMatch;
+    preMatch.name = "pre-match";
+    preMatch.control = FmsAutonomous;
+    preMatch.durationMs = preMatchSeconds * 1000;
+    preMatch.expectMask = mode;
+    preMatch.expectValue = DsAutonomous | DsFmsAttached;
+    preMatch.deadlineMs = deadlineMs;
+    script.append(preMatch);
+
+    Step autonomous;
+    autonomous.name = "autonomous";
+    autonomous.control = FmsEnabled | FmsAutonomous;
+    autonomous.durationMs = autonomousSeconds * 1000;
+    autonomous.matchTime = true;
+    autonomous.expectMask = mode;
+    autonomous.expectValue = DsEnabled | DsAutonomous | DsFmsAttached;
+    autonomous.deadlineMs = deadlineMs;
+    script.append(autonomous);
+
+    // The field disables every robot between the two periods
+    Step transition;
+    transition.name = "transition";
+    transition.control = 0;
+    transition.durationMs = 1000;
+    transition.expectMask = mode;
+    transition.expectValue = DsFmsAttached;
+    transition.deadlineMs = deadlineMs;
+    script.append(transition);
+
+    Step teleop;
+    teleop.name = "teleop";
+    teleop.control = FmsEnabled;
+    teleop.durationMs = teleopSeconds * 1000;
+    teleop.matchTime = true;
+    teleop.expectMask = mode;
+    teleop.expectValue = DsEnabled | DsFmsAttached;
+    teleop.deadlineMs = deadlineMs;
+    script.append(teleop);
+
+    if (emergencyStop) {
+        Step stop;
+        stop.name = "e-stop";
+        stop.control = FmsEnabled | FmsEmergencyStop;
+        stop.durationMs = 2000;
+        stop.expectMask = DsEnabled | DsEmergencyStop;
+        stop.expectValue = DsEmergencyStop;
+        stop.deadlineMs = deadlineMs;
+        script.append(stop);
+    }
+
+    // Match abort: the FMS stops talking, and the DS must detach and stay disabled
+    Step abort;
+    abort.name = "abort";
+    abort.silent = true;
+    abort.durationMs = abortDeadlineMs + 1000;
+    abort.expectMask = DsEnabled | DsFmsAttached;
+    abort.expectValue = 0;
+    abort.deadlineMs = abortDeadlineMs;
+    script.append(abort);
+
+    return script;
+}
+
+FmsSimulator::FmsSimulator(const Settings &settings, QObject *parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_controlSocket(std::make_unique<QUdpSocket>(this))
+    , m_statusSocket(std::make_unique<QUdpSocket>(this))
+    , m_packetTimer(std::make_unique<QTimer>(this))
+    , m_stepTimer(std::make_unique<QTimer>(this))
+    , m_dsTimer(std::make_unique<QTimer>(this))
+    , m_started(false)
+    , m_finished(false)
+    , m_stepIndex(-1)
+    , m_stepStartNs(0)
+    , m_awaitingReflection(false)
+    , m_packetNumber(0)
+    , m_fmsPackets(0)
+    , m_dsPackets(0)
+    , m_lastDsControl(0)
+    , m_heartbeats(0)
+    , m_heartbeatTeam(-1)
+    , m_lastHeartbeatNs(0)
+{
+    connect(m_statusSocket.get(), &QUdpSocket::readyRead, this, &FmsSimulator::readStatus);
+
+    m_packetTimer->setTimerType(Qt::PreciseTimer);
+    m_packetTimer->setInterval(qMax(1, 1000 / qMax(1, settings.packetRateHz)));
+    connect(m_packetTimer.get(), &QTimer::timeout, this, &FmsSimulator::sendControl);
+
+    m_stepTimer->setTimerType(Qt::PreciseTimer);
+    m_stepTimer->setSingleShot(true);
+    connect(m_stepTimer.get(), &QTimer::timeout, this, &FmsSimulator::nextStep);
+
+    m_dsTimer->setSingleShot(true);
+    m_dsTimer->setInterval(qMax(1, settings.dsTimeoutSeconds) * 1000);
+    connect(m_dsTimer.get(), &QTimer::timeout, this, &FmsSimulator::onDsTimeout);
+}
+
+FmsSimulator::~FmsSimulator() {
+    stop();
+}
+
+bool FmsSimulator::start() {
+    m_clock.start();
+
+    if (m_settings.script.isEmpty()) {
+        m_error = "Empty script";
+        return false;
+    }
+    if (!m_statusSocket->bind(m_settings.bindAddress, m_settings.statusPort)) {
+        m_error = QString("Status port %1: %2").arg(m_settings.statusPort).arg(m_statusSocket->errorString());
+        return false;
+    }
+    if (!m_controlSocket->bind(m_settings.bindAddress, 0)) {
+        m_error = QString("Control socket: %1").arg(m_controlSocket->errorString());
+        return false;
+    }
+
+    m_dsTimer->start();
+    return true;
+}
+
+void FmsSimulator::stop() {
+    m_packetTimer->stop();
+    m_stepTimer->stop();
+    m_dsTimer->stop();
+    m_controlSocket->close();
+    m_statusSocket->close();
+}
+
+bool FmsSimulator::passed() const {
+    if (!m_finished || m_results.size() != m_settings.script.size()) {
+        return false;
+    }
+    for (const StepResult &result : m_results) {
+        if (!result.passed()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FmsSimulator::observeControl(quint8 control) {
+    m_dsPackets++;
+    m_lastDsControl = control;
+
+    if (!m_started) {
+        if (m_heartbeats > 0) {
+            beginScript();
+        }
+        return;
+    }
+    if (!m_awaitingReflection) {
+        return;
+    }
+
+    const Step &step = m_settings.script.at(m_stepIndex);
+    if ((control & step.expectMask) == step.expectValue) {
+        m_awaitingReflection = false;
+        const qint64 latencyUs = (m_clock.nsecsElapsed() - m_stepStartNs) / 1000;
+        m_results[m_stepIndex].latencyUs = latencyUs;
+        m_latency.record(quint64(latencyUs));
+        emit stepReflected(step.name, latencyUs);
+    }
+}
+
+void FmsSimulator::readStatus() {
+    while (m_statusSocket->hasPendingDatagrams()) {
+        const qint64 size = m_statusSocket->readDatagram(m_receiveBuffer.data(), m_receiveBuffer.size());
+        const uchar *data = reinterpret_cast<const uchar *>(m_receiveBuffer.data());
+        if (size < HEARTBEAT_MIN_SIZE || data[2] != HEARTBEAT_TYPE_STATUS) {
+            continue;
+        }
+
+        const qint64 now = m_clock.nsecsElapsed();
+        if (m_lastHeartbeatNs != 0) {
+            m_heartbeatIntervals.record(quint64((now - m_lastHeartbeatNs) / 1000000));
+        }
+        m_lastHeartbeatNs = now;
+        m_heartbeatTeam = qFromBigEndian<quint16>(data);
+        m_heartbeats++;
+    }
+
+    if (!m_started && m_dsPackets > 0) {
+        beginScript();
+    }
+}
+
+void FmsSimulator::beginScript() {
+    m_started = true;
+    m_dsTimer->stop();
+    nextStep();
+}
+
+void FmsSimulator::sendControl() {
+    if (m_stepIndex < 0 || m_stepIndex >= m_settings.script.size()) {
+        return;
+    }
+    const Step &step = m_settings.script.at(m_stepIndex);
+    if (step.silent) {
+        return;
+    }
+
+    int timeRemaining = 0;
+    if (step.matchTime) {
+        const qint64 elapsedMs = (m_clock.nsecsElapsed() - m_stepStartNs) / 1000000;
+        timeRemaining = int(qMax<qint64>(0, step.durationMs - elapsedMs + 999) / 1000);
+    }
+
+    // Packet number (2), match type (1), match number (2), play number (1), time remaining (2), control (1)
+    uchar packet[9];
+    qToBigEndian<quint16>(m_packetNumber++, packet);
+    packet[2] = m_settings.matchType;
+    qToBigEndian<quint16>(m_settings.matchNumber, packet + 3);
+    packet[5] = 1;
+    qToBigEndian<quint16>(quint16(timeRemaining), packet + 6);
+    packet[8] = step.control | (m_settings.blueAlliance ? FmsBlueAlliance : 0);
+
+    m_controlSocket->writeDatagram(reinterpret_cast<const char *>(packet), sizeof(packet),
+                                   m_settings.dsAddress, m_settings.dsPort);
+    m_fmsPackets++;
+}
+
+void FmsSimulator::nextStep() {
+    m_stepIndex++;
+    if (m_stepIndex >= m_settings.script.size()) {
+        finish();
+        return;
+    }
+
+    const Step &step = m_settings.script.at(m_stepIndex);
+    StepResult result;
+    result.name = step.name;
+    result.deadlineMs = step.deadlineMs;
+    m_results.append(result);
+
+    // The clock starts with the step's first packet, the one the DS has to react to
+    m_stepStartNs = m_clock.nsecsElapsed();
+    m_awaitingReflection = true;
+    emit stepStarted(step.name);
+    sendControl();
+    m_packetTimer->start();     // Next periodic packet one interval after this one
+    m_stepTimer->start(qMax(1, step.durationMs));
+}
+
+void FmsSimulator::onDsTimeout() {
+    m_error = m_heartbeats == 0
+        ? QString("No DS heartbeat on port %1 (is the DS running with --fms-address?)").arg(m_settings.statusPort)
+        : QString("No DS control packets (is the DS running with --robot-address?)");
+    finish();
+}
+
+void FmsSimulator::finish() {
+    if (m_finished) {
+        return;
+    }
+    m_finished = true;
+    m_awaitingReflection = false;
+    m_packetTimer->stop();
+    m_stepTimer->stop();
+    m_dsTimer->stop();
+    emit finished(passed());
+}
+
+QString FmsSimulator::statusLine() const {
+    QString step = "waiting for DS";
+    if (m_started && m_stepIndex >= 0 && m_stepIndex < m_settings.script.size()) {
+        step = m_settings.script.at(m_stepIndex).name;
+    } else if (m_finished) {
+        step = "done";
+    }
+    return QString("step %1 | FMS packets %2 | DS control %3 (last 0x%4) | heartbeats %5 (team %6)")
+        .arg(step)
+        .arg(m_fmsPackets)
+        .arg(m_dsPackets)
+        .arg(uint(m_lastDsControl), 2, 16, QLatin1Char('0'))
+        .arg(m_heartbeats)
+        .arg(m_heartbeatTeam);
+}
+
+QString FmsSimulator::reportText() const {
+    QString text = statusLine() + "\n";
+    for (const StepResult &result : m_results) {
+        text += QString("  %1: %2 (deadline %3 ms) %4\n")
+            .arg(result.name, -12)
+            .arg(result.latencyUs >= 0 ? QString("%1 us").arg(result.latencyUs) : QString("not reflected"))
+            .arg(result.deadlineMs)
+            .arg(result.passed() ? "ok" : "FAIL");
+    }
+    text += QString("  FMS-to-robot latency: %1\n").arg(m_latency.summary("us"));
+    text += QString("  heartbeat interval: %1\n").arg(m_heartbeatIntervals.summary("ms"));
+    if (!m_error.isEmpty()) {
+        text += QString("  error: %1\n").arg(m_error);
+    }
+    text += passed() ? "PASS\n" : "FAIL\n";
+    return text;
+}
+
+QJsonObject FmsSimulator::report() const {
+    auto histogramObject = [](quint64 count, quint64 p50, quint64 p99, quint64 max) {
+        QJsonObject object;
+        object["count"] = double(count);
+        object["p50"] = double(p50);
+        object["p99"] = double(p99);
+        object["max"] = double(max);
+        return object;
+    };
+
+    QJsonArray steps;
+    for (const StepResult &result : m_results) {
+        QJsonObject step;
+        step["name"] = result.name;
+        step["latencyUs"] = double(result.latencyUs);
+        step["deadlineMs"] = result.deadlineMs;
+        step["passed"] = result.passed();
+        steps.append(step);
+    }
+
+    QJsonObject heartbeats;
+    heartbeats["count"] = double(m_heartbeats);
+    heartbeats["team"] = m_heartbeatTeam;
+    heartbeats["intervalMs"] = histogramObject(m_heartbeatIntervals.totalCount(), m_heartbeatIntervals.percentile(0.50),
+                                               m_heartbeatIntervals.percentile(0.99), m_heartbeatIntervals.maxValue());
+
+    QJsonObject object;
+    object["elapsedSeconds"] = double(m_clock.elapsed()) / 1000.0;
+    object["passed"] = passed();
+    object["steps"] = steps;
+    object["latencyUs"] = histogramObject(m_latency.totalCount(), m_latency.percentile(0.50),
+                                          m_latency.percentile(0.99), m_latency.maxValue());
+    object["fmsPackets"] = double(m_fmsPackets);
+    object["dsControlPackets"] = double(m_dsPackets);
+    object["heartbeats"] = heartbeats;
+    if (!m_error.isEmpty()) {
+        object["error"] = m_error;
+    }
+    return object;
+}
@@ -0,0 +1,172 @@
+#ifndef FMSSIMULATOR_H
+#define FMSSIMULATOR_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QList>
+#include <array>
+#include <memory>
+#include "backend/core/histogram.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Loopback stand-in for the Field Management System, for competition-mode testing
+ *
+ * This class manages:
+ * - A scripted match: a list of steps, each an FMS control byte held for a
+ *   while, or silence to make the DS time out
+ * - FMS control packets to the DS at a fixed rate, plus one the moment each step starts
+ * - The DS status heartbeats on the FMS status port
+ * - Measurements: for every step, the time from its first FMS packet to the
+ *   first robot-bound DS packet whose control byte reflects it, and the
+ *   heartbeat interval
+ *
+ * Design principles:
+ * - Speaks the wire format FMSHandler parses, not a model of the real FMS
+ * - The robot side is observed on the wire (see observeControl()), so a
+ *   measurement covers the DS's whole FMS-to-transmit path
+ * - The script starts only once the DS is heartbeating and sending control
+ *   packets, so DS startup never counts as latency
+ * - A step that is not reflected within its deadline fails the run
+ */
+class FmsSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Microseconds
+    using LatencyHistogram = Log2Histogram<24>;
+    // Milliseconds
+    using IntervalHistogram = Log2Histogram<20>;
+
+    // Ports the DS talks to (see FMSHandler)
+    static constexpr quint16 DEFAULT_DS_PORT = 1120;
+    static constexpr quint16 DEFAULT_STATUS_PORT = 1160;
+
+    // FMS -> DS control byte, as FMSHandler::decodeControlPacket() reads it
+    enum FmsControl : quint8 {
+        FmsEnabled = 0x01,
+        FmsAutonomous = 0x02,
+        FmsTest = 0x04,
+        FmsBlueAlliance = 0x08,
+        FmsEmergencyStop = 0x80
+    };
+
+    // DS -> robot control byte bits the steps are checked against
+    enum DsControl : quint8 {
+        DsTest = 0x01,
+        DsAutonomous = 0x02,
+        DsEnabled = 0x04,
+        DsFmsAttached = 0x08,
+        DsEmergencyStop = 0x80
+    };
+
+    struct Step {
+        QString name;
+        bool silent = false;        // Send nothing; the DS should notice the FMS is gone
+        quint8 control = 0;         // FmsControl bits sent while the step runs
+        int durationMs = 0;
+        bool matchTime = false;     // Count the step down in the packets' time remaining
+        quint8 expectMask = 0;      // DsControl bits that must equal expectValue
+        quint8 expectValue = 0;
+        int deadlineMs = 0;         // Reflected later than this fails the step
+    };
+
+    struct StepResult {
+        QString name;
+        qint64 latencyUs = -1;      // -1 until the DS reflects the step
+        int deadlineMs = 0;
+        bool passed() const { return latencyUs >= 0 && latencyUs <= qint64(deadlineMs) * 1000; }
+    };
+
+    struct Settings {
+        QHostAddress bindAddress = QHostAddress::LocalHost;
+        QHostAddress dsAddress = QHostAddress::LocalHost;
+        quint16 dsPort = DEFAULT_DS_PORT;
+        quint16 statusPort = DEFAULT_STATUS_PORT;
+
+        int packetRateHz = 2;
+        quint8 matchType = 2;       // Qualification
+        quint16 matchNumber = 1;
+        bool blueAlliance = false;
+        int dsTimeoutSeconds = 30;  // Give up if the DS does not show up
+
+        QList<Step> script;
+    };
+
+    // Pre-match, autonomous, transition, teleop, optionally e-stop, then abort (the FMS goes silent)
+    static QList<Step> matchScript(int preMatchSeconds, int autonomousSeconds, int teleopSeconds,
+                                   bool emergencyStop, int deadlineMs, int abortDeadlineMs);
+
+    explicit FmsSimulator(const Settings &settings, QObject *parent = nullptr);
+    ~FmsSimulator();
+
+    bool start();
+    void stop();
+    QString errorString() const { return m_error; }
+
+    bool isFinished() const { return m_finished; }
+    bool passed() const;
+
+    QString statusLine() const;
+    QString reportText() const;
+    QJsonObject report() const;
+
+public slots:
+    // Control byte of every robot-bound DS packet, e.g. from RobotSimulator::controlReceived
+    void observeControl(quint8 control);
+
+signals:
+    void stepStarted(const QString &name);
+    void stepReflected(const QString &name, qint64 latencyUs);
+    void finished(bool passed);
+
+private slots:
+    void readStatus();
+    void sendControl();
+    void nextStep();
+    void onDsTimeout();
+
+private:
+    void beginScript();
+    void finish();
+
+    Settings m_settings;
+    QString m_error;
+    QElapsedTimer m_clock;
+
+    std::unique_ptr<QUdpSocket> m_controlSocket;
+    std::unique_ptr<QUdpSocket> m_statusSocket;
+    std::unique_ptr<QTimer> m_packetTimer;
+    std::unique_ptr<QTimer> m_stepTimer;
+    std::unique_ptr<QTimer> m_dsTimer;
+    std::array<char, 1500> m_receiveBuffer;
+
+    // Script state
+    bool m_started;
+    bool m_finished;
+    int m_stepIndex;
+    qint64 m_stepStartNs;
+    bool m_awaitingReflection;
+    QList<StepResult> m_results;
+    LatencyHistogram m_latency;
+    quint16 m_packetNumber;
+    quint64 m_fmsPackets;
+
+    // DS side
+    quint64 m_dsPackets;
+    quint8 m_lastDsControl;
+    quint64 m_heartbeats;
+    int m_heartbeatTeam;
+    qint64 m_lastHeartbeatNs;
+    IntervalHistogram m_heartbeatIntervals;
+};
+
+} // namespace FRCDriverStation
+
+#endif // FMSSIMULATOR_H
@@ -0,0 +1,154 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+#include <atomic>
+#include <csignal>
+
+#include "fmssimulator.h"
+#include "robotsimulator.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+std::atomic<bool> s_stopRequested{false};
+
+void requestStop(int) {
+    s_stopRequested.store(true);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("yads-fms-sim");
+    app.setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Simulated FMS (and robot) for competition-mode testing of the driver station.\n"
+        "Runs a scripted match over loopback and measures how long the DS takes to\n"
+        "reflect each FMS state change in its robot-bound packets. Start the DS with\n"
+        "--fms-address 127.0.0.1 --robot-address 127.0.0.1.\n"
+        "Exit status is 0 if every step was reflected within its deadline, 2 if not.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QList<QCommandLineOption> options = {
+        {"bind", "Address to listen on (default: 127.0.0.1).", "address"},
+        {"ds", "Address of the DS (default: 127.0.0.1).", "address"},
+        {"pre-match", "Seconds of pre-match (disabled, autonomous) before the match starts.", "seconds", "3"},
+        {"autonomous", "Autonomous period in seconds.", "seconds", "15"},
+        {"teleop", "Teleop period in seconds.", "seconds", "135"},
+        {"no-estop", "Leave the FMS e-stop out of the script (the DS latches it until cleared locally)."},
+        {"max-latency", "Deadline for the DS to reflect each step, in ms (default: one 20 ms packet period).", "ms", "20"},
+        {"abort-deadline", "Deadline for the DS to detach once the FMS goes silent, in ms.", "ms", "6000"},
+        {"rate", "FMS control packets per second.", "hz", "2"},
+        {"match", "Match number.", "number", "1"},
+        {"blue", "Put the DS on the blue alliance."},
+        {"ds-timeout", "Give up if the DS has not connected after this many seconds.", "seconds", "30"},
+        {"stats-interval", "Seconds between status lines, 0 to disable.", "seconds", "5"},
+        {"report", "Write the final report as JSON to this file.", "file"},
+    };
+    parser.addOptions(options);
+    parser.process(app);
+
+    FmsSimulator::Settings settings;
+    RobotSimulator::Settings robot;
+    robot.bindAddress = QHostAddress::LocalHost;
+    if (parser.isSet("bind")) {
+        settings.bindAddress = QHostAddress(parser.value("bind"));
+        if (settings.bindAddress.isNull()) {
+            qCritical("Invalid --bind address: %s", qPrintable(parser.value("bind")));
+            return 1;
+        }
+        robot.bindAddress = settings.bindAddress;
+    }
+    if (parser.isSet("ds")) {
+        settings.dsAddress = QHostAddress(parser.value("ds"));
+        if (settings.dsAddress.isNull()) {
+            qCritical("Invalid --ds address: %s", qPrintable(parser.value("ds")));
+            return 1;
+        }
+    }
+
+    settings.packetRateHz = parser.value("rate").toInt();
+    settings.matchNumber = quint16(parser.value("match").toUInt());
+    settings.blueAlliance = parser.isSet("blue");
+    settings.dsTimeoutSeconds = parser.value("ds-timeout").toInt();
+    settings.script = FmsSimulator::matchScript(parser.value("pre-match").toInt(),
+                                                parser.value("autonomous").toInt(),
+                                                parser.value("teleop").toInt(),
+                                                !parser.isSet("no-estop"),
+                                                parser.value("max-latency").toInt(),
+                                                parser.value("abort-deadline").toInt());
+
+    // The robot end only has to answer control packets, so the DS sees a connected robot
+    robot.console = false;
+    robot.networkTables = false;
+    robot.http = false;
+    RobotSimulator robotSimulator(robot);
+    if (!robotSimulator.start()) {
+        qCritical("Cannot start robot endpoint: %s", qPrintable(robotSimulator.errorString()));
+        return 1;
+    }
+
+    FmsSimulator simulator(settings);
+    QObject::connect(&robotSimulator, &RobotSimulator::controlReceived, &simulator, &FmsSimulator::observeControl);
+    if (!simulator.start()) {
+        qCritical("Cannot start simulator: %s", qPrintable(simulator.errorString()));
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << "yads-fms-sim sending to " << settings.dsAddress.toString() << ":" << settings.dsPort
+        << ", heartbeats on port " << settings.statusPort << ", robot on " << robot.bindAddress.toString()
+        << "; waiting for the DS" << Qt::endl;
+
+    QObject::connect(&simulator, &FmsSimulator::stepStarted, [&out](const QString &name) {
+        out << "Step: " << name << Qt::endl;
+    });
+    QObject::connect(&simulator, &FmsSimulator::stepReflected, [&out](const QString &name, qint64 latencyUs) {
+        out << "  " << name << " on the wire after " << latencyUs << " us" << Qt::endl;
+    });
+    QObject::connect(&simulator, &FmsSimulator::finished, &app, &QCoreApplication::quit);
+
+    QTimer statsTimer;
+    const int statsInterval = parser.value("stats-interval").toInt();
+    if (statsInterval > 0) {
+        QObject::connect(&statsTimer, &QTimer::timeout, [&out, &simulator]() {
+            out << simulator.statusLine() << Qt::endl;
+        });
+        statsTimer.start(statsInterval * 1000);
+    }
+
+    // Ctrl+C and SIGTERM still produce the final report
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    QTimer stopPoll;
+    QObject::connect(&stopPoll, &QTimer::timeout, &app, []() {
+        if (s_stopRequested.load()) {
+            QCoreApplication::quit();
+        }
+    });
+    stopPoll.start(100);
+
+    app.exec();
+
+    out << simulator.reportText();
+    out.flush();
+
+    if (parser.isSet("report")) {
+        QFile file(parser.value("report"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(QJsonDocument(simulator.report()).toJson()) < 0) {
+            qCritical("Cannot write report to %s", qPrintable(parser.value("report")));
+            return 1;
+        }
+    }
+    return simulator.passed() ? 0 : 2;
+}
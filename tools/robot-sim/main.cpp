@@ -0,0 +1,157 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <QTimer>
+#include <atomic>
+#include <csignal>
+
+#include "robotsimulator.h"
+
+using namespace FRCDriverStation;
+
+namespace {
+
+std::atomic<bool> s_stopRequested{false};
+
+void requestStop(int) {
+    s_stopRequested.store(true);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("yads-robot-sim");
+    app.setApplicationVersion("1.0");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Simulated roboRIO for latency and load testing the driver station.\n"
+        "Impairments apply to each direction independently (one-way values).");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    const QList<QCommandLineOption> options = {
+        {"bind", "Address to listen on (default: any).", "address"},
+        {"latency", "One-way latency in ms.", "ms", "0"},
+        {"jitter", "Extra uniform one-way delay in ms.", "ms", "0"},
+        {"loss", "Datagram loss per direction in percent.", "percent", "0"},
+        {"reorder", "Share of datagrams held back so later ones overtake them, in percent.", "percent", "0"},
+        {"reorder-delay", "Extra hold for reordered datagrams in ms.", "ms", "30"},
+        {"uplink-loss", "Loss on DS -> robot only, overrides --loss.", "percent"},
+        {"downlink-loss", "Loss on robot -> DS only, overrides --loss.", "percent"},
+        {"seed", "Random seed for impairments.", "seed", "1"},
+        {"outage", "Simulate a robot reboot lasting this many ms.", "ms", "0"},
+        {"outage-every", "Seconds between simulated reboots.", "seconds", "30"},
+        {"console-rate", "Console lines per second.", "lines", "10"},
+        {"log-files", "Number of .wpilog files served on the HTTP log server.", "count", "3"},
+        {"log-file-kb", "Size of each served log file in KiB.", "kb", "1024"},
+        {"battery", "Nominal battery voltage reported.", "volts", "12.5"},
+        {"watch-pid", "Sample CPU use of this process (the DS) once a second (Linux).", "pid"},
+        {"duration", "Stop after this many seconds (default: run until interrupted).", "seconds", "0"},
+        {"stats-interval", "Seconds between status lines, 0 to disable.", "seconds", "5"},
+        {"report", "Write the final report as JSON to this file.", "file"},
+        {"no-console", "Do not serve the TCP console."},
+        {"no-nt", "Do not accept NetworkTables connections."},
+        {"no-http", "Do not serve the HTTP log server."},
+    };
+    parser.addOptions(options);
+    parser.process(app);
+
+    RobotSimulator::Settings settings;
+    if (parser.isSet("bind")) {
+        settings.bindAddress = QHostAddress(parser.value("bind"));
+        if (settings.bindAddress.isNull()) {
+            qCritical("Invalid --bind address: %s", qPrintable(parser.value("bind")));
+            return 1;
+        }
+    }
+
+    NetworkImpairment::Settings impairment;
+    impairment.latencyMs = parser.value("latency").toInt();
+    impairment.jitterMs = parser.value("jitter").toInt();
+    impairment.lossPercent = parser.value("loss").toDouble();
+    impairment.reorderPercent = parser.value("reorder").toDouble();
+    impairment.reorderDelayMs = parser.value("reorder-delay").toInt();
+    settings.uplink = impairment;
+    settings.downlink = impairment;
+    if (parser.isSet("uplink-loss")) {
+        settings.uplink.lossPercent = parser.value("uplink-loss").toDouble();
+    }
+    if (parser.isSet("downlink-loss")) {
+        settings.downlink.lossPercent = parser.value("downlink-loss").toDouble();
+    }
+
+    settings.seed = parser.value("seed").toUInt();
+    settings.outageMs = parser.value("outage").toInt();
+    settings.outageIntervalSeconds = parser.value("outage-every").toInt();
+    settings.consoleLinesPerSecond = parser.value("console-rate").toInt();
+    settings.logFileCount = parser.value("log-files").toInt();
+    settings.logFileBytes = parser.value("log-file-kb").toInt() * 1024;
+    settings.batteryVolts = parser.value("battery").toDouble();
+    settings.watchPid = parser.value("watch-pid").toLongLong();
+    settings.console = !parser.isSet("no-console");
+    settings.networkTables = !parser.isSet("no-nt");
+    settings.http = !parser.isSet("no-http");
+
+    RobotSimulator simulator(settings);
+    if (!simulator.start()) {
+        qCritical("Cannot start simulator: %s", qPrintable(simulator.errorString()));
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    out << "yads-robot-sim listening on " << (settings.bindAddress == QHostAddress::Any
+            ? QString("all addresses") : settings.bindAddress.toString())
+        << " (control " << settings.controlPort << ", status to DS port " << settings.statusPort << ")" << Qt::endl;
+
+    QObject::connect(&simulator, &RobotSimulator::outageStarted, [&out]() {
+        out << "Simulated reboot: robot offline" << Qt::endl;
+    });
+    QObject::connect(&simulator, &RobotSimulator::outageEnded, [&out]() {
+        out << "Simulated reboot: robot back" << Qt::endl;
+    });
+
+    QTimer statsTimer;
+    const int statsInterval = parser.value("stats-interval").toInt();
+    if (statsInterval > 0) {
+        QObject::connect(&statsTimer, &QTimer::timeout, [&out, &simulator]() {
+            out << simulator.statusLine() << Qt::endl;
+        });
+        statsTimer.start(statsInterval * 1000);
+    }
+
+    const int duration = parser.value("duration").toInt();
+    if (duration > 0) {
+        QTimer::singleShot(duration * 1000, &app, &QCoreApplication::quit);
+    }
+
+    // Ctrl+C and SIGTERM still produce the final report
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    QTimer stopPoll;
+    QObject::connect(&stopPoll, &QTimer::timeout, &app, []() {
+        if (s_stopRequested.load()) {
+            QCoreApplication::quit();
+        }
+    });
+    stopPoll.start(100);
+
+    const int result = app.exec();
+
+    out << simulator.reportText();
+    out.flush();
+
+    if (parser.isSet("report")) {
+        QFile file(parser.value("report"));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)
+            || file.write(QJsonDocument(simulator.report()).toJson()) < 0) {
+            qCritical("Cannot write report to %s", qPrintable(parser.value("report")));
+            return 1;
+        }
+    }
+    return result;
+}
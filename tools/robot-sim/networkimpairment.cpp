@@ -0,0 +1,76 @@
+#include "networkimpairment.h"
+
+using namespace FRCDriverStation;
+
+NetworkImpairment::NetworkImpairment(quint32 seed, QObject *parent)
+    : QObject(parent)
+    , m_random(seed)
+    , m_timer(std::make_unique<QTimer>(this))
+{
+    m_clock.start();
+    m_timer->setSingleShot(true);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer.get(), &QTimer::timeout, this, &NetworkImpairment::releaseDue);
+}
+
+bool NetworkImpairment::isTransparent() const {
+    return m_settings.latencyMs <= 0 && m_settings.jitterMs <= 0
+        && m_settings.lossPercent <= 0.0 && m_settings.reorderPercent <= 0.0;
+}
+
+void NetworkImpairment::submit(const QNetworkDatagram &datagram) {
+    m_stats.submitted++;
+
+    if (isTransparent()) {
+        m_stats.released++;
+        emit released(datagram);
+        return;
+    }
+
+    if (m_settings.lossPercent > 0.0 && m_random.bounded(100.0) < m_settings.lossPercent) {
+        m_stats.dropped++;
+        return;
+    }
+
+    qint64 delayMs = qMax(0, m_settings.latencyMs);
+    if (m_settings.jitterMs > 0) {
+        delayMs += m_random.bounded(m_settings.jitterMs + 1);
+    }
+    if (m_settings.reorderPercent > 0.0 && m_random.bounded(100.0) < m_settings.reorderPercent) {
+        delayMs += qMax(1, m_settings.reorderDelayMs);
+        m_stats.reordered++;
+    }
+
+    // Equal due times keep submission order (multimap inserts after equal keys)
+    m_inFlight.emplace(m_clock.nsecsElapsed() + delayMs * 1000000, datagram);
+    scheduleTimer();
+}
+
+void NetworkImpairment::clear() {
+    m_inFlight.clear();
+    m_timer->stop();
+}
+
+void NetworkImpairment::releaseDue() {
+    const qint64 now = m_clock.nsecsElapsed();
+    while (!m_inFlight.empty() && m_inFlight.begin()->first <= now) {
+        const QNetworkDatagram datagram = m_inFlight.begin()->second;
+        m_inFlight.erase(m_inFlight.begin());
+        m_stats.released++;
+        emit released(datagram);
+    }
+    scheduleTimer();
+}
+
+void NetworkImpairment::scheduleTimer() {
+    if (m_inFlight.empty()) {
+        m_timer->stop();
+        return;
+    }
+
+    const qint64 waitNs = m_inFlight.begin()->first - m_clock.nsecsElapsed();
+    const int waitMs = int(qMax<qint64>(0, (waitNs + 999999) / 1000000));
+    if (!m_timer->isActive() || m_timer->remainingTime() > waitMs) {
+        m_timer->start(waitMs);
+    }
+}
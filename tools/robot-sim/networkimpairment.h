@@ -0,0 +1,80 @@
+#ifndef NETWORKIMPAIRMENT_H
+#define NETWORKIMPAIRMENT_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QNetworkDatagram>
+#include <QRandomGenerator>
+#include <map>
+#include <memory>
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Delay line that injects latency, jitter, loss and reordering
+ *
+ * This class manages:
+ * - Dropping a configurable share of datagrams
+ * - Holding the rest for a base latency plus uniform jitter
+ * - Holding a configurable share for an extra delay so later datagrams overtake them
+ * - Releasing datagrams in due-time order from a single precise timer
+ *
+ * Design principles:
+ * - One instance per direction, so uplink and downlink can be impaired separately
+ * - A fixed seed makes a run reproducible: the same packet sequence sees the same fate
+ * - With everything at zero, datagrams are released synchronously and the line
+ *   adds no latency of its own
+ */
+class NetworkImpairment : public QObject
+{
+    Q_OBJECT
+
+public:
+    struct Settings {
+        int latencyMs = 0;           // One-way base delay
+        int jitterMs = 0;            // Uniform extra delay in [0, jitterMs]
+        double lossPercent = 0.0;
+        double reorderPercent = 0.0;
+        int reorderDelayMs = 30;     // Extra hold for reordered datagrams; > one control period
+    };
+
+    struct Statistics {
+        quint64 submitted = 0;
+        quint64 dropped = 0;
+        quint64 reordered = 0;
+        quint64 released = 0;
+    };
+
+    explicit NetworkImpairment(quint32 seed, QObject *parent = nullptr);
+
+    void setSettings(const Settings &settings) { m_settings = settings; }
+    const Settings &settings() const { return m_settings; }
+    const Statistics &statistics() const { return m_stats; }
+
+    bool isTransparent() const;
+    void submit(const QNetworkDatagram &datagram);
+
+    // Drops everything still in flight, e.g. when the simulated robot reboots
+    void clear();
+
+signals:
+    void released(const QNetworkDatagram &datagram);
+
+private slots:
+    void releaseDue();
+
+private:
+    void scheduleTimer();
+
+    Settings m_settings;
+    Statistics m_stats;
+    QRandomGenerator m_random;
+    QElapsedTimer m_clock;
+    std::unique_ptr<QTimer> m_timer;
+    std::multimap<qint64, QNetworkDatagram> m_inFlight;   // Keyed on due time (ns)
+};
+
+} // namespace FRCDriverStation
+
+#endif // NETWORKIMPAIRMENT_H
@@ -0,0 +1,563 @@
+#include "robotsimulator.h"
+#include <QDataStream>
+#include <QFile>
+#include <QNetworkDatagram>
+#include <QRegularExpression>
+#include <QtEndian>
+#include <cmath>
+#include <utility>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+using namespace FRCDriverStation;
+
+namespace {
+
+// Same 16-bit byte sum PacketBuilder::validateChecksum() expects
+quint16 byteSum(const QByteArray &data) {
+    quint32 sum = 0;
+    for (char byte : data) {
+        sum += static_cast<quint8>(byte);
+    }
+    return static_cast<quint16>(sum & 0xFFFF);
+}
+
+QByteArray httpResponse(int status, const QByteArray &reason, const QByteArray &contentType, const QByteArray &body) {
+    QByteArray response = "HTTP/1.1 " + QByteArray::number(status) + ' ' + reason + "\r\n";
+    response += "Content-Type: " + contentType + "\r\n";
+    response += "Content-Length: " + QByteArray::number(body.size()) + "\r\n";
+    response += "Connection: close\r\n\r\n";
+    response += body;
+    return response;
+}
+
+} // namespace
+
+RobotSimulator::RobotSimulator(const Settings &settings, QObject *parent)
+    : QObject(parent)
+    , m_settings(settings)
+    , m_controlSocket(std::make_unique<QUdpSocket>(this))
+    , m_pingSocket(std::make_unique<QUdpSocket>(this))
+    , m_statusSocket(std::make_unique<QUdpSocket>(this))
+    , m_consoleServer(std::make_unique<QTcpServer>(this))
+    , m_networkTablesServer(std::make_unique<QTcpServer>(this))
+    , m_httpServer(std::make_unique<QTcpServer>(this))
+    , m_uplink(std::make_unique<NetworkImpairment>(settings.seed, this))
+    , m_downlink(std::make_unique<NetworkImpairment>(settings.seed ^ 0x9E3779B9u, this))
+    , m_consoleTimer(std::make_unique<QTimer>(this))
+    , m_outageTimer(std::make_unique<QTimer>(this))
+    , m_cpuTimer(std::make_unique<QTimer>(this))
+    , m_lastControlNs(0)
+    , m_intervalSumUs(0.0)
+    , m_intervalSquareSumUs(0.0)
+    , m_intervalCount(0)
+    , m_statusIndex(0)
+    , m_controlPackets(0)
+    , m_statusPackets(0)
+    , m_pingEchoes(0)
+    , m_consoleBytes(0)
+    , m_consoleConnections(0)
+    , m_networkTablesConnections(0)
+    , m_httpRequestsServed(0)
+    , m_httpBytes(0)
+    , m_inOutage(false)
+    , m_outages(0)
+    , m_outageEndedNs(0)
+    , m_awaitingControl(false)
+    , m_awaitingConsole(false)
+    , m_lastCpuTicks(-1)
+    , m_lastCpuSampleNs(0)
+    , m_lastCpuPercent(0.0)
+    , m_cpuPercentSum(0.0)
+    , m_cpuPercentMax(0.0)
+    , m_cpuSamples(0)
+{
+    m_uplink->setSettings(settings.uplink);
+    m_downlink->setSettings(settings.downlink);
+
+    connect(m_controlSocket.get(), &QUdpSocket::readyRead, this, &RobotSimulator::readControl);
+    connect(m_pingSocket.get(), &QUdpSocket::readyRead, this, &RobotSimulator::readPing);
+    connect(m_uplink.get(), &NetworkImpairment::released, this, [this](const QNetworkDatagram &datagram) {
+        // Pings and control share the uplink; the DS tells them apart by the marker too
+        const QByteArray data = datagram.data();
+        if (data.size() >= 12 && qFromBigEndian<quint32>(data.constData()) == PING_MARKER) {
+            handlePing(datagram);
+        } else {
+            handleControl(datagram);
+        }
+    });
+    connect(m_downlink.get(), &NetworkImpairment::released, this, &RobotSimulator::sendDownlink);
+
+    connect(m_consoleServer.get(), &QTcpServer::newConnection, this, &RobotSimulator::onConsoleConnection);
+    connect(m_networkTablesServer.get(), &QTcpServer::newConnection, this, &RobotSimulator::onNetworkTablesConnection);
+    connect(m_httpServer.get(), &QTcpServer::newConnection, this, &RobotSimulator::onHttpConnection);
+
+    m_consoleTimer->setTimerType(Qt::PreciseTimer);
+    m_consoleTimer->setInterval(qMax(1, 1000 / qMax(1, settings.consoleLinesPerSecond)));
+    connect(m_consoleTimer.get(), &QTimer::timeout, this, &RobotSimulator::writeConsoleLines);
+
+    m_outageTimer->setInterval(qMax(1, settings.outageIntervalSeconds) * 1000);
+    connect(m_outageTimer.get(), &QTimer::timeout, this, &RobotSimulator::beginOutage);
+
+    m_cpuTimer->setInterval(1000);
+    connect(m_cpuTimer.get(), &QTimer::timeout, this, &RobotSimulator::sampleCpu);
+}
+
+RobotSimulator::~RobotSimulator() {
+    stop();
+}
+
+bool RobotSimulator::start() {
+    m_clock.start();
+
+    if (!m_controlSocket->bind(m_settings.bindAddress, m_settings.controlPort)) {
+        m_error = QString("Control port %1: %2").arg(m_settings.controlPort).arg(m_controlSocket->errorString());
+        return false;
+    }
+    if (!m_pingSocket->bind(m_settings.bindAddress, m_settings.pingPort)) {
+        m_error = QString("Ping port %1: %2").arg(m_settings.pingPort).arg(m_pingSocket->errorString());
+        return false;
+    }
+    // Status goes out from the robot's own address so it routes correctly inside a namespace
+    if (!m_statusSocket->bind(m_settings.bindAddress, 0)) {
+        m_error = QString("Status socket: %1").arg(m_statusSocket->errorString());
+        return false;
+    }
+    if (!listen()) {
+        return false;
+    }
+
+    if (m_settings.console) {
+        m_consoleTimer->start();
+    }
+    if (m_settings.outageMs > 0 && m_settings.outageIntervalSeconds > 0) {
+        m_outageTimer->start();
+    }
+#ifdef Q_OS_LINUX
+    if (m_settings.watchPid > 0) {
+        sampleCpu();
+        m_cpuTimer->start();
+    }
+#else
+    if (m_settings.watchPid > 0) {
+        qWarning("CPU sampling of another process is only supported on Linux; ignoring --watch-pid");
+    }
+#endif
+    return true;
+}
+
+void RobotSimulator::stop() {
+    m_consoleTimer->stop();
+    m_outageTimer->stop();
+    m_cpuTimer->stop();
+    m_uplink->clear();
+    m_downlink->clear();
+    closeServers();
+    m_controlSocket->close();
+    m_pingSocket->close();
+    m_statusSocket->close();
+}
+
+bool RobotSimulator::listen() {
+    struct Endpoint {
+        bool enabled;
+        QTcpServer *server;
+        quint16 port;
+        const char *name;
+    };
+    const Endpoint endpoints[] = {
+        {m_settings.console, m_consoleServer.get(), m_settings.consolePort, "Console"},
+        {m_settings.networkTables, m_networkTablesServer.get(), m_settings.networkTablesPort, "NetworkTables"},
+        {m_settings.http, m_httpServer.get(), m_settings.httpPort, "HTTP"},
+    };
+
+    for (const Endpoint &endpoint : endpoints) {
+        if (endpoint.enabled && !endpoint.server->isListening()
+            && !endpoint.server->listen(m_settings.bindAddress, endpoint.port)) {
+            m_error = QString("%1 port %2: %3").arg(endpoint.name).arg(endpoint.port)
+                .arg(endpoint.server->errorString());
+            return false;
+        }
+    }
+    return true;
+}
+
+void RobotSimulator::closeServers() {
+    m_consoleServer->close();
+    m_networkTablesServer->close();
+    m_httpServer->close();
+
+    // A rebooting robot resets every connection rather than closing it cleanly
+    const QList<QTcpServer *> servers = {m_consoleServer.get(), m_networkTablesServer.get(), m_httpServer.get()};
+    for (QTcpServer *server : servers) {
+        for (QTcpSocket *socket : server->findChildren<QTcpSocket *>()) {
+            socket->abort();
+            socket->deleteLater();
+        }
+    }
+    m_consoleClients.clear();
+    m_httpRequests.clear();
+}
+
+void RobotSimulator::readControl() {
+    while (m_controlSocket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = m_controlSocket->receiveDatagram();
+        if (!m_inOutage) {
+            m_uplink->submit(datagram);
+        }
+    }
+}
+
+void RobotSimulator::readPing() {
+    while (m_pingSocket->hasPendingDatagrams()) {
+        const QNetworkDatagram datagram = m_pingSocket->receiveDatagram();
+        if (!m_inOutage) {
+            m_uplink->submit(datagram);
+        }
+    }
+}
+
+void RobotSimulator::handleControl(const QNetworkDatagram &datagram) {
+    const QByteArray data = datagram.data();
+    if (m_inOutage || data.size() < 5) {
+        return;
+    }
+
+    const qint64 now = m_clock.nsecsElapsed();
+    if (m_lastControlNs != 0) {
+        const double intervalUs = double(now - m_lastControlNs) / 1000.0;
+        m_controlIntervals.record(quint64(intervalUs));
+        m_intervalSumUs += intervalUs;
+        m_intervalSquareSumUs += intervalUs * intervalUs;
+        m_intervalCount++;
+    }
+    m_lastControlNs = now;
+
+    if (m_awaitingControl) {
+        m_awaitingControl = false;
+        m_controlResume.record(quint64((now - m_outageEndedNs) / 1000000));
+    }
+
+    // DS packet: index (2), control (1), request (1), station (1), joysticks..., checksum (2)
+    const quint16 index = qFromBigEndian<quint16>(data.constData());
+    const quint8 control = static_cast<quint8>(data.at(2));
+    m_controlSequence.record(index);
+    m_controlPackets++;
+
+    m_downlink->submit(QNetworkDatagram(buildStatusPacket(control), datagram.senderAddress(), m_settings.statusPort));
+    emit controlReceived(control);
+}
+
+void RobotSimulator::handlePing(const QNetworkDatagram &datagram) {
+    const QByteArray data = datagram.data();
+    if (m_inOutage || data.size() < 12 || qFromBigEndian<quint32>(data.constData()) != PING_MARKER) {
+        return;
+    }
+
+    // The DS matches the echoed timestamp, so the payload goes back untouched
+    m_pingEchoes++;
+    m_downlink->submit(QNetworkDatagram(data, datagram.senderAddress(), m_settings.statusPort));
+}
+
+void RobotSimulator::sendDownlink(const QNetworkDatagram &datagram) {
+    if (m_inOutage) {
+        return;
+    }
+    m_statusSocket->writeDatagram(datagram.data(), datagram.destinationAddress(), quint16(datagram.destinationPort()));
+    if (datagram.data().size() >= 4 && qFromBigEndian<quint32>(datagram.data().constData()) != PING_MARKER) {
+        m_statusPackets++;
+    }
+}
+
+QByteArray RobotSimulator::buildStatusPacket(quint8 control) {
+    // Field order follows PacketBuilder::parseRobotPacket(): header, diagnostics, timing
+    const double seconds = double(m_clock.elapsed()) / 1000.0;
+    const double volts = m_settings.batteryVolts - 0.3 * (0.5 + 0.5 * std::sin(seconds * 0.7));
+
+    QByteArray packet;
+    QDataStream stream(&packet, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::BigEndian);
+
+    stream << m_statusIndex++;
+    stream << control;                                   // Echo the mode the DS asked for
+    stream << control;                                   // Status mirrors it on a healthy robot
+    stream << quint16(qRound(volts * 256.0));            // 8.8 fixed point
+
+    stream << quint8(20 + int(seconds) % 10);            // CPU %
+    stream << quint8(45);                                // RAM %
+    stream << quint8(30);                                // Disk %
+    stream << quint8(15 + int(seconds * 3) % 20);        // CAN utilisation %
+    stream << quint8(0);                                 // CAN bus-off count
+    stream << quint8(1);                                 // Robot code running
+
+    stream << quint8(0);                                 // Match phase
+    stream << quint16(0);                                // Match time remaining
+
+    stream << byteSum(packet);
+    return packet;
+}
+
+void RobotSimulator::onConsoleConnection() {
+    while (QTcpSocket *socket = m_consoleServer->nextPendingConnection()) {
+        m_consoleConnections++;
+        m_consoleClients.append(socket);
+
+        if (m_awaitingConsole) {
+            m_awaitingConsole = false;
+            m_consoleReconnect.record(quint64((m_clock.nsecsElapsed() - m_outageEndedNs) / 1000000));
+        }
+
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_consoleClients.removeAll(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void RobotSimulator::writeConsoleLines() {
+    if (m_consoleClients.isEmpty()) {
+        return;
+    }
+
+    const QByteArray line = QString("[%1] Simulated robot: %2 control packets, loop time 20.0ms\n")
+        .arg(double(m_clock.elapsed()) / 1000.0, 0, 'f', 3)
+        .arg(m_controlPackets)
+        .toLatin1();
+    for (QTcpSocket *socket : std::as_const(m_consoleClients)) {
+        socket->write(line);
+        m_consoleBytes += quint64(line.size());
+    }
+}
+
+void RobotSimulator::onNetworkTablesConnection() {
+    while (QTcpSocket *socket = m_networkTablesServer->nextPendingConnection()) {
+        // The DS only probes that the port accepts; anything it sends is discarded
+        m_networkTablesConnections++;
+        connect(socket, &QTcpSocket::readyRead, socket, [socket]() { socket->readAll(); });
+        connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+    }
+}
+
+void RobotSimulator::onHttpConnection() {
+    while (QTcpSocket *socket = m_httpServer->nextPendingConnection()) {
+        connect(socket, &QTcpSocket::readyRead, this, [this, socket]() {
+            QByteArray &request = m_httpRequests[socket];
+            request += socket->readAll();
+            if (request.contains("\r\n\r\n")) {
+                serveHttp(socket);
+            } else if (request.size() > 16 * 1024) {
+                socket->abort();
+            }
+        });
+        connect(socket, &QTcpSocket::disconnected, this, [this, socket]() {
+            m_httpRequests.remove(socket);
+            socket->deleteLater();
+        });
+    }
+}
+
+void RobotSimulator::serveHttp(QTcpSocket *socket) {
+    const QByteArray requestLine = m_httpRequests.take(socket).split('\r').value(0);
+    const QList<QByteArray> parts = requestLine.split(' ');
+    const QString path = parts.size() >= 2 ? QString::fromLatin1(parts.at(1)) : QString();
+
+    QByteArray response;
+    static const QRegularExpression filePattern("^/logs/sim_(\\d+)\\.wpilog$");
+    const QRegularExpressionMatch match = filePattern.match(path);
+
+    if (parts.value(0) != "GET") {
+        response = httpResponse(405, "Method Not Allowed", "text/plain", "GET only\n");
+    } else if (path == "/logs" || path == "/logs/") {
+        QByteArray listing = "<html><body><h1>Index of /logs/</h1>\n";
+        for (int i = 0; i < m_settings.logFileCount; ++i) {
+            const QByteArray name = "sim_" + QByteArray::number(i) + ".wpilog";
+            listing += "<a href=\"" + name + "\">" + name + "</a><br>\n";
+        }
+        listing += "</body></html>\n";
+        response = httpResponse(200, "OK", "text/html", listing);
+    } else if (match.hasMatch() && match.captured(1).toInt() < m_settings.logFileCount) {
+        response = httpResponse(200, "OK", "application/octet-stream", logFileContents(match.captured(1).toInt()));
+    } else {
+        response = httpResponse(404, "Not Found", "text/plain", "Not found\n");
+    }
+
+    m_httpRequestsServed++;
+    m_httpBytes += quint64(response.size());
+    socket->write(response);
+    socket->disconnectFromHost();
+}
+
+QByteArray RobotSimulator::logFileContents(int index) const {
+    // Deterministic filler behind a WPILOG magic so downloads can be verified by size and content
+    QByteArray contents("WPILOG");
+    contents.reserve(m_settings.logFileBytes);
+    quint32 state = 0x12345678u ^ quint32(index);
+    while (contents.size() < m_settings.logFileBytes) {
+        state = state * 1664525u + 1013904223u;
+        contents.append(char(state >> 24));
+    }
+    contents.truncate(m_settings.logFileBytes);
+    return contents;
+}
+
+void RobotSimulator::beginOutage() {
+    if (m_inOutage) {
+        return;
+    }
+    m_inOutage = true;
+    m_outages++;
+    m_uplink->clear();
+    m_downlink->clear();
+    closeServers();
+    emit outageStarted();
+    QTimer::singleShot(m_settings.outageMs, this, &RobotSimulator::endOutage);
+}
+
+void RobotSimulator::endOutage() {
+    if (!listen()) {
+        qWarning("Could not resume after outage: %s", qPrintable(m_error));
+    }
+    m_inOutage = false;
+    m_outageEndedNs = m_clock.nsecsElapsed();
+    m_awaitingControl = true;
+    m_awaitingConsole = m_settings.console;
+
+    // The robot restarts its counters; the DS keeps its own sequence running
+    m_lastControlNs = 0;
+    m_statusIndex = 0;
+    m_controlSequence.reset();
+    emit outageEnded();
+}
+
+void RobotSimulator::sampleCpu() {
+#ifdef Q_OS_LINUX
+    QFile stat(QString("/proc/%1/stat").arg(m_settings.watchPid));
+    if (!stat.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    // Fields after the parenthesised command name; utime and stime are fields 14 and 15
+    const QByteArray line = stat.readAll();
+    const QList<QByteArray> fields = line.mid(line.lastIndexOf(')') + 2).split(' ');
+    if (fields.size() < 13) {
+        return;
+    }
+    const qint64 ticks = fields.at(11).toLongLong() + fields.at(12).toLongLong();
+    const qint64 now = m_clock.nsecsElapsed();
+
+    if (m_lastCpuTicks >= 0 && now > m_lastCpuSampleNs) {
+        const double cpuSeconds = double(ticks - m_lastCpuTicks) / double(sysconf(_SC_CLK_TCK));
+        m_lastCpuPercent = 100.0 * cpuSeconds / (double(now - m_lastCpuSampleNs) / 1e9);
+        m_cpuPercentSum += m_lastCpuPercent;
+        m_cpuPercentMax = qMax(m_cpuPercentMax, m_lastCpuPercent);
+        m_cpuSamples++;
+    }
+    m_lastCpuTicks = ticks;
+    m_lastCpuSampleNs = now;
+#endif
+}
+
+QString RobotSimulator::statusLine() const {
+    const SequenceTracker::Statistics &sequence = m_controlSequence.statistics();
+    const double meanUs = m_intervalCount > 0 ? m_intervalSumUs / double(m_intervalCount) : 0.0;
+    const double varianceUs = m_intervalCount > 0
+        ? qMax(0.0, m_intervalSquareSumUs / double(m_intervalCount) - meanUs * meanUs) : 0.0;
+
+    QString line = QString("control %1 (interval %2 us, jitter %3 us, p99 <= %4 us, loss %5%, reordered %6)"
+                           " | status %7 | pings %8 | console %9 B")
+        .arg(m_controlPackets)
+        .arg(meanUs, 0, 'f', 0)
+        .arg(std::sqrt(varianceUs), 0, 'f', 0)
+        .arg(m_controlIntervals.percentile(0.99))
+        .arg(sequence.lossPercent(), 0, 'f', 2)
+        .arg(sequence.reordered)
+        .arg(m_statusPackets)
+        .arg(m_pingEchoes)
+        .arg(m_consoleBytes);
+    if (m_cpuSamples > 0) {
+        line += QString(" | DS CPU %1%").arg(m_lastCpuPercent, 0, 'f', 1);
+    }
+    if (m_inOutage) {
+        line += " | OUTAGE";
+    }
+    return line;
+}
+
+QString RobotSimulator::reportText() const {
+    QString text = statusLine() + "\n";
+    text += QString("  control interval: %1\n").arg(m_controlIntervals.summary("us"));
+    text += QString("  uplink: %1 dropped, %2 reordered of %3 | downlink: %4 dropped, %5 reordered of %6\n")
+        .arg(m_uplink->statistics().dropped).arg(m_uplink->statistics().reordered)
+        .arg(m_uplink->statistics().submitted)
+        .arg(m_downlink->statistics().dropped).arg(m_downlink->statistics().reordered)
+        .arg(m_downlink->statistics().submitted);
+    text += QString("  connections: console %1, NetworkTables %2, HTTP requests %3 (%4 KB)\n")
+        .arg(m_consoleConnections).arg(m_networkTablesConnections)
+        .arg(m_httpRequestsServed).arg(m_httpBytes / 1024);
+    if (m_outages > 0) {
+        text += QString("  %1 outages; first control after resume: %2; console reconnect: %3\n")
+            .arg(m_outages)
+            .arg(m_controlResume.summary("ms"))
+            .arg(m_consoleReconnect.summary("ms"));
+    }
+    if (m_cpuSamples > 0) {
+        text += QString("  DS CPU: mean %1%, max %2% over %3 s\n")
+            .arg(m_cpuPercentSum / double(m_cpuSamples), 0, 'f', 1)
+            .arg(m_cpuPercentMax, 0, 'f', 1)
+            .arg(m_cpuSamples);
+    }
+    return text;
+}
+
+QJsonObject RobotSimulator::report() const {
+    const SequenceTracker::Statistics &sequence = m_controlSequence.statistics();
+    const double meanUs = m_intervalCount > 0 ? m_intervalSumUs / double(m_intervalCount) : 0.0;
+    const double varianceUs = m_intervalCount > 0
+        ? qMax(0.0, m_intervalSquareSumUs / double(m_intervalCount) - meanUs * meanUs) : 0.0;
+
+    auto histogramObject = [](quint64 count, quint64 p50, quint64 p99, quint64 max) {
+        QJsonObject object;
+        object["count"] = double(count);
+        object["p50"] = double(p50);
+        object["p99"] = double(p99);
+        object["max"] = double(max);
+        return object;
+    };
+
+    QJsonObject control;
+    control["packets"] = double(m_controlPackets);
+    control["meanIntervalUs"] = meanUs;
+    control["jitterUs"] = std::sqrt(varianceUs);
+    control["intervalUs"] = histogramObject(m_controlIntervals.totalCount(), m_controlIntervals.percentile(0.50),
+                                            m_controlIntervals.percentile(0.99), m_controlIntervals.maxValue());
+    control["lost"] = double(sequence.lost);
+    control["reordered"] = double(sequence.reordered);
+    control["duplicates"] = double(sequence.duplicates);
+    control["lossPercent"] = sequence.lossPercent();
+
+    QJsonObject reconnect;
+    reconnect["outages"] = double(m_outages);
+    reconnect["controlResumeMs"] = histogramObject(m_controlResume.totalCount(), m_controlResume.percentile(0.50),
+                                                   m_controlResume.percentile(0.99), m_controlResume.maxValue());
+    reconnect["consoleReconnectMs"] = histogramObject(m_consoleReconnect.totalCount(), m_consoleReconnect.percentile(0.50),
+                                                      m_consoleReconnect.percentile(0.99), m_consoleReconnect.maxValue());
+
+    QJsonObject object;
+    object["elapsedSeconds"] = double(m_clock.elapsed()) / 1000.0;
+    object["seed"] = double(m_settings.seed);
+    object["control"] = control;
+    object["statusPackets"] = double(m_statusPackets);
+    object["pingEchoes"] = double(m_pingEchoes);
+    object["consoleBytes"] = double(m_consoleBytes);
+    object["consoleConnections"] = double(m_consoleConnections);
+    object["networkTablesConnections"] = double(m_networkTablesConnections);
+    object["httpRequests"] = double(m_httpRequestsServed);
+    object["reconnect"] = reconnect;
+    if (m_cpuSamples > 0) {
+        object["dsCpuMeanPercent"] = m_cpuPercentSum / double(m_cpuSamples);
+        object["dsCpuMaxPercent"] = m_cpuPercentMax;
+    }
+    return object;
+}
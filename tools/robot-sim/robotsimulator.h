@@ -0,0 +1,182 @@
+#ifndef ROBOTSIMULATOR_H
+#define ROBOTSIMULATOR_H
+
+#include <QObject>
+#include <QUdpSocket>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QHostAddress>
+#include <QJsonObject>
+#include <QList>
+#include <QHash>
+#include <memory>
+#include "networkimpairment.h"
+#include "backend/core/histogram.h"
+#include "backend/robot/comms/sequencetracker.h"
+
+namespace FRCDriverStation {
+
+/**
+ * @brief Loopback stand-in for a roboRIO, for latency and load testing the DS
+ *
+ * This class manages:
+ * - The UDP control endpoint: every DS control packet is answered with a status packet
+ * - The UDP ping echo the DS uses for round-trip latency
+ * - The TCP console stream, NetworkTables endpoint and the HTTP log server on port 5800
+ * - Independent impairment of the uplink (DS -> robot) and downlink (robot -> DS)
+ * - Scheduled outages that look like a robot reboot, to measure DS reconnect time
+ * - Measurements: control packet interval and jitter, control stream loss and
+ *   reordering, reconnect times, and optionally the DS process' CPU use
+ *
+ * Design principles:
+ * - Speaks the wire format the DS parses, not a model of the real robot
+ * - Everything runs on one event loop with no sleeps, so the simulator itself
+ *   adds as little timing noise as possible
+ * - Runs are reproducible: impairments are seeded and all rates are explicit
+ */
+class RobotSimulator : public QObject
+{
+    Q_OBJECT
+
+public:
+    // Microseconds
+    using IntervalHistogram = Log2Histogram<24>;
+    // Milliseconds
+    using ReconnectHistogram = Log2Histogram<20>;
+
+    // Ports the DS talks to (see CommunicationHandler); overridable for namespaces
+    static constexpr quint16 DEFAULT_CONTROL_PORT = 1110;
+    static constexpr quint16 DEFAULT_PING_PORT = 1111;
+    static constexpr quint16 DEFAULT_STATUS_PORT = 1150;
+    static constexpr quint16 DEFAULT_CONSOLE_PORT = 1740;
+    static constexpr quint16 DEFAULT_NETWORKTABLES_PORT = 1735;
+    static constexpr quint16 DEFAULT_HTTP_PORT = 5800;
+
+    static constexpr quint32 PING_MARKER = 0xDEADBEEF;
+
+    struct Settings {
+        QHostAddress bindAddress = QHostAddress::Any;
+        quint16 controlPort = DEFAULT_CONTROL_PORT;
+        quint16 pingPort = DEFAULT_PING_PORT;
+        quint16 statusPort = DEFAULT_STATUS_PORT;
+        quint16 consolePort = DEFAULT_CONSOLE_PORT;
+        quint16 networkTablesPort = DEFAULT_NETWORKTABLES_PORT;
+        quint16 httpPort = DEFAULT_HTTP_PORT;
+
+        bool console = true;
+        bool networkTables = true;
+        bool http = true;
+
+        NetworkImpairment::Settings uplink;
+        NetworkImpairment::Settings downlink;
+        quint32 seed = 1;
+
+        int consoleLinesPerSecond = 10;
+        int logFileCount = 3;
+        int logFileBytes = 1024 * 1024;
+        double batteryVolts = 12.5;
+
+        int outageMs = 0;            // Simulated reboot length, 0 disables
+        int outageIntervalSeconds = 0;
+
+        qint64 watchPid = 0;         // DS process to sample for CPU use (Linux)
+    };
+
+    explicit RobotSimulator(const Settings &settings, QObject *parent = nullptr);
+    ~RobotSimulator();
+
+    bool start();
+    void stop();
+    QString errorString() const { return m_error; }
+
+    QString statusLine() const;
+    QString reportText() const;
+    QJsonObject report() const;
+
+signals:
+    void outageStarted();
+    void outageEnded();
+    // Control byte of every DS packet that got through the uplink, for tools that script the DS
+    void controlReceived(quint8 control);
+
+private slots:
+    void readControl();
+    void readPing();
+    void onConsoleConnection();
+    void onNetworkTablesConnection();
+    void onHttpConnection();
+    void writeConsoleLines();
+    void beginOutage();
+    void endOutage();
+    void sampleCpu();
+
+private:
+    void handleControl(const QNetworkDatagram &datagram);
+    void handlePing(const QNetworkDatagram &datagram);
+    void sendDownlink(const QNetworkDatagram &datagram);
+    QByteArray buildStatusPacket(quint8 control);
+    void serveHttp(QTcpSocket *socket);
+    QByteArray logFileContents(int index) const;
+    bool listen();
+    void closeServers();
+
+    Settings m_settings;
+    QString m_error;
+    QElapsedTimer m_clock;
+
+    std::unique_ptr<QUdpSocket> m_controlSocket;
+    std::unique_ptr<QUdpSocket> m_pingSocket;
+    std::unique_ptr<QUdpSocket> m_statusSocket;
+    std::unique_ptr<QTcpServer> m_consoleServer;
+    std::unique_ptr<QTcpServer> m_networkTablesServer;
+    std::unique_ptr<QTcpServer> m_httpServer;
+    QList<QTcpSocket *> m_consoleClients;
+    QHash<QTcpSocket *, QByteArray> m_httpRequests;
+
+    std::unique_ptr<NetworkImpairment> m_uplink;
+    std::unique_ptr<NetworkImpairment> m_downlink;
+
+    std::unique_ptr<QTimer> m_consoleTimer;
+    std::unique_ptr<QTimer> m_outageTimer;
+    std::unique_ptr<QTimer> m_cpuTimer;
+
+    // Control stream as seen after uplink impairment
+    SequenceTracker m_controlSequence;
+    IntervalHistogram m_controlIntervals;
+    qint64 m_lastControlNs;
+    double m_intervalSumUs;
+    double m_intervalSquareSumUs;
+    quint64 m_intervalCount;
+    quint16 m_statusIndex;
+    quint64 m_controlPackets;
+    quint64 m_statusPackets;
+    quint64 m_pingEchoes;
+    quint64 m_consoleBytes;
+    quint64 m_consoleConnections;
+    quint64 m_networkTablesConnections;
+    quint64 m_httpRequestsServed;
+    quint64 m_httpBytes;
+
+    // Reconnect measurements, from the end of an outage
+    bool m_inOutage;
+    quint64 m_outages;
+    qint64 m_outageEndedNs;
+    bool m_awaitingControl;
+    bool m_awaitingConsole;
+    ReconnectHistogram m_controlResume;
+    ReconnectHistogram m_consoleReconnect;
+
+    // DS CPU use from /proc/<pid>/stat
+    qint64 m_lastCpuTicks;
+    qint64 m_lastCpuSampleNs;
+    double m_lastCpuPercent;
+    double m_cpuPercentSum;
+    double m_cpuPercentMax;
+    quint64 m_cpuSamples;
+};
+
+} // namespace FRCDriverStation
+
+#endif // ROBOTSIMULATOR_H